@@ -0,0 +1,91 @@
+/*
+    Motor de fundidos para un canal LEDC, manejado por un temporizador.
+
+    El fundido con delay(5) dentro de loop() bloqueaba el programa y el
+    ritmo dependía de lo que tardara cada vuelta. Acá cada paso lo da un
+    esp_timer periódico (temporizador de hardware; el callback corre en
+    la tarea esp_timer, no en loop()) y el duty sale de la tabla gamma:
+
+        FadeLed<TablaGamma<256, 12>> fade;
+
+        // En setup(), después de ledcSetup() y ledcAttachPin():
+        fade.begin(CANAL);
+        fade.fundido(255, 1000);   // Encender en 1 s
+        fade.respirar(1280);       // O subir y bajar sin fin (1.28 s por tramo)
+
+    El fundido por hardware del LEDC (ledc_set_fade_with_time) varía el
+    duty en forma lineal, sin corrección gamma, y el core Arduino 2.x no
+    lo expone: por eso los pasos los da el temporizador.
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+#include "gamma_lut.h"
+
+template <typename Tabla>
+class FadeLed {
+public:
+    static const uint32_t PASO_MS = 5;  // 200 actualizaciones por segundo
+
+    bool begin(uint8_t canal) {
+        _canal = canal;
+        esp_timer_create_args_t args = {};
+        args.callback = &FadeLed::alVencer;
+        args.arg = this;
+        args.name = "fade_led";
+        if (esp_timer_create(&args, &_timer) != ESP_OK) return false;
+        return esp_timer_start_periodic(_timer, PASO_MS * 1000) == ESP_OK;
+    }
+
+    // Del nivel actual a hasta (0 a Tabla::ENTRADAS - 1) en duracionMs
+    void fundido(uint16_t hasta, uint32_t duracionMs) {
+        portENTER_CRITICAL(&_mux);
+        _respirando = false;
+        _rampa.iniciar(_rampa.nivel(), hasta, duracionMs / PASO_MS);
+        portEXIT_CRITICAL(&_mux);
+    }
+
+    // Sube y baja entre 0 y el máximo, mediaOndaMs por tramo
+    void respirar(uint32_t mediaOndaMs) {
+        portENTER_CRITICAL(&_mux);
+        _respirando = true;
+        _mediaOnda = mediaOndaMs / PASO_MS;
+        _rampa.iniciar(_rampa.nivel(), Tabla::ENTRADAS - 1, _mediaOnda);
+        portEXIT_CRITICAL(&_mux);
+    }
+
+    bool enCurso() const { return _respirando || _rampa.enCurso(); }
+    uint16_t nivel() const { return _rampa.nivel(); }
+
+private:
+    static void alVencer(void *arg) { static_cast<FadeLed *>(arg)->paso(); }
+
+    void paso() {
+        portENTER_CRITICAL(&_mux);
+        if (!_rampa.avanzar() && _respirando) {
+            // Fin de un tramo: invertir el sentido
+            uint16_t destino = _rampa.nivel() == 0 ? Tabla::ENTRADAS - 1 : 0;
+            _rampa.iniciar(_rampa.nivel(), destino, _mediaOnda);
+            _rampa.avanzar();
+        }
+        uint16_t duty = _rampa.pwm();
+        portEXIT_CRITICAL(&_mux);
+
+        // Solo escribir al LEDC si el duty cambió (sin fundido en curso no hay trabajo)
+        if (duty != _ultimoDuty) {
+            ledcWrite(_canal, duty);
+            _ultimoDuty = duty;
+        }
+    }
+
+    RampaGamma<Tabla> _rampa;
+    esp_timer_handle_t _timer = nullptr;
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+    uint8_t _canal = 0;
+    bool _respirando = false;
+    uint32_t _mediaOnda = 0;
+    int32_t _ultimoDuty = -1;
+};
@@ -0,0 +1,133 @@
+/*
+    Tabla de corrección gamma (2.2) calculada al compilar.
+
+    pow(x, 2.2) en cada cambio de brillo cuesta cientos de ciclos (miles
+    en el ESP32-C3, que no tiene FPU). Como la entrada tiene pocos
+    valores posibles (0-100 % o 0-255), la curva entera se calcula con
+    constexpr y queda guardada en flash: cada cambio es un acceso a la tabla.
+
+        // Brillo 0-100 % → duty de 8 bits
+        ledcWrite(CANAL, GammaPorcentaje::pwm(brillo));
+
+        // Nivel 0-255 → duty de 12 bits (más escalones en brillos bajos)
+        ledcSetup(CANAL, 5000, 12);
+        ledcWrite(CANAL, TablaGamma<256, 12>::pwm(nivel));
+
+        Entradas │ Bits PWM │ Flash    │ Duty máximo
+        ─────────┼──────────┼──────────┼────────────
+          101    │    8     │ 202 B    │ 255
+          256    │    8     │ 512 B    │ 255
+          256    │ 10 - 14  │ 512 B    │ 1023 - 16383
+
+    Con 8 bits los niveles 0 a 20 (de 256) dan duty 0: la curva gamma es
+    muy plana cerca de cero. Con 12 bits solo los niveles 0 a 5 quedan
+    apagados y el fundido arranca sin saltos.
+
+    RampaGamma reparte un cambio de brillo en pasos iguales de la tabla;
+    fade_led.h (2.1 Led con PWM) la usa desde un temporizador para que
+    loop() quede libre.
+
+    No depende de Arduino.h: 2.1 Led con PWM/tools/bench_gamma.cpp lo
+    compila en la PC para comparar cada tabla con pow() y medir ciclos
+    por actualización.
+
+    Está copiado sin cambios en 2.1 Led con PWM y 4.5 Dashboard Completo,
+    porque cada sketch se compila solo. Al corregirlo hay que actualizar
+    las dos copias (python3 Clases/verificar_copias.py las compara).
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace gamma_detalle {
+
+// x^(1/5) por Newton (y ← (4y + x/y⁴) / 5), 40 pasos desde y = 1.
+// Recursión en lugar de un bucle: constexpr de C++11 admite un solo return
+constexpr double raiz5(double x, double y, int pasos) {
+    return pasos == 0 ? y : raiz5(x, (4 * y + x / (y * y * y * y)) / 5, pasos - 1);
+}
+
+// x^2.2 = x² · x^(1/5)
+constexpr double potencia22(double x) {
+    return x <= 0 ? 0 : x * x * raiz5(x, 1, 40);
+}
+
+// Duty truncado, igual que (uint8_t)(pow(x, 2.2) * 255)
+constexpr uint16_t nivel(uint16_t i, uint16_t ultimo, uint16_t maximo) {
+    return (uint16_t)(potencia22((double)i / ultimo) * maximo);
+}
+
+// Secuencia 0, 1, ..., N-1 para inicializar la tabla (std::index_sequence es de C++14)
+template <uint16_t... I>
+struct Indices {};
+
+template <uint16_t N, uint16_t... I>
+struct HacerIndices : HacerIndices<N - 1, N - 1, I...> {};
+
+template <uint16_t... I>
+struct HacerIndices<0, I...> {
+    typedef Indices<I...> Tipo;
+};
+
+}  // namespace gamma_detalle
+
+template <uint16_t N, uint8_t BITS, typename = typename gamma_detalle::HacerIndices<N>::Tipo>
+struct TablaGamma;
+
+template <uint16_t N, uint8_t BITS, uint16_t... I>
+struct TablaGamma<N, BITS, gamma_detalle::Indices<I...>> {
+    static_assert(N >= 2, "La tabla necesita al menos 2 entradas");
+    static_assert(BITS >= 8 && BITS <= 14, "Resolución PWM entre 8 y 14 bits");
+
+    static const uint16_t ENTRADAS = N;
+    static const uint16_t MAXIMO = (1u << BITS) - 1;  // Duty a brillo máximo
+    static constexpr uint16_t valores[N] = {gamma_detalle::nivel(I, N - 1, MAXIMO)...};
+
+    // Duty para el nivel i (0 a N-1; más allá se satura al máximo)
+    static uint16_t pwm(uint16_t i) { return valores[i < N ? i : N - 1]; }
+};
+
+template <uint16_t N, uint8_t BITS, uint16_t... I>
+constexpr uint16_t TablaGamma<N, BITS, gamma_detalle::Indices<I...>>::valores[N];
+
+typedef TablaGamma<101, 8> GammaPorcentaje;  // Brillo 0-100 % → duty de 8 bits
+typedef TablaGamma<256, 8> Gamma8;           // Nivel 0-255 → duty de 8 bits
+
+// Rampa lineal sobre los índices de la tabla: como la tabla ya corrige
+// la gamma, el ojo percibe el cambio de brillo uniforme
+template <typename Tabla>
+class RampaGamma {
+public:
+    // De nivel desde a nivel hasta en la cantidad de pasos indicada
+    // (0 = salto inmediato)
+    void iniciar(uint16_t desde, uint16_t hasta, uint32_t pasos) {
+        _desde = limitar(desde);
+        _hasta = limitar(hasta);
+        _pasos = pasos;
+        _paso = 0;
+        _nivel = pasos ? _desde : _hasta;
+    }
+
+    // Un paso de la rampa. Devuelve false cuando ya llegó (no cambia nada)
+    bool avanzar() {
+        if (_paso >= _pasos) return false;
+        _paso++;
+        int32_t delta = (int32_t)_hasta - _desde;
+        _nivel = _desde + (int32_t)((int64_t)delta * _paso / _pasos);
+        return true;
+    }
+
+    bool enCurso() const { return _paso < _pasos; }
+    uint16_t nivel() const { return _nivel; }
+    uint16_t pwm() const { return Tabla::pwm(_nivel); }
+
+private:
+    static uint16_t limitar(uint16_t n) { return n < Tabla::ENTRADAS ? n : Tabla::ENTRADAS - 1; }
+
+    uint16_t _desde = 0;
+    uint16_t _hasta = 0;
+    uint16_t _nivel = 0;
+    uint32_t _pasos = 0;
+    uint32_t _paso = 0;
+};
@@ -21,36 +21,41 @@
 
 #include <Arduino.h>
 
+#include "gamma_lut.h"
+#include "fade_led.h"
+
 #define PIN_LED 2
+#define CANAL_PWM 0
+
+// 8 a 14 bits. Con 12 bits los brillos bajos tienen 16 veces más
+// escalones que con 8 y el fundido no "salta" al encender
+#define RESOLUCION_PWM 12
+
+typedef TablaGamma<256, RESOLUCION_PWM> Gamma;  // Nivel 0-255 → duty corregido
+
+FadeLed<Gamma> fade;
 
 void setup() {
 
 	// Configura el canal 0 en 5 kHz
-	// con 8 bits de resolución (0–255).
-	ledcSetup(0, 5000, 8);
+	// con 12 bits de resolución (0–4095).
+	ledcSetup(CANAL_PWM, 5000, RESOLUCION_PWM);
 
 	// Asocia el pin LED al canal 0 de PWM.
-	ledcAttachPin(PIN_LED, 0);
+	ledcAttachPin(PIN_LED, CANAL_PWM);
 
-	// Envía un duty cycle del 50% (128/255)
-	// → LED a mitad de brillo.
-	ledcWrite(0, 128);
+	// Fade in / fade out con corrección de gamma: 256 niveles en 1.28 s
+	// por tramo (el mismo ritmo que el bucle original con delay(5)).
+	// Los pasos los da un temporizador, no loop()
+	fade.begin(CANAL_PWM);
+	fade.respirar(1280);
 
 }
 
 void loop() {
 
-	// Flashea el LED con un fade in / fade out con corrección de Gamma
-	static uint8_t up = true;
-	static uint8_t dutyCycle = 0;
-	if (up) {
-		if (dutyCycle == 255) up = false; else dutyCycle++;
-	} else {
-		if (dutyCycle == 0) up = true; else dutyCycle--;
-	}
-	uint8_t dutyGamma = pow(dutyCycle / 255.0, 2.2) * 255.0;
-	ledcWrite(0, dutyGamma);
-	delay(5);
+	// Libre: el fundido sigue solo. Acá puede ir el resto del programa
+	// sin afectar la suavidad del LED
 
 }
 
@@ -74,6 +79,41 @@ CORRECCIÓN GAMMA:
 Los LEDs no son lineales. Una curva gamma (2.2) hace que el fade
 se perciba uniforme al ojo humano.
 
+  duty = (nivel / 255)^2.2 · duty_máximo
+
+En lugar de llamar a pow() en cada paso, src/gamma_lut.h calcula la
+curva completa al compilar (constexpr) y la deja en flash:
+
+  ledcWrite(0, Gamma8::pwm(nivel));                 // 8 bits
+  ledcWrite(0, TablaGamma<256, 12>::pwm(nivel));    // 12 bits
+
+RESOLUCIÓN Y BRILLOS BAJOS:
+Con 8 bits la curva gamma da duty 0 para los niveles 0 a 20: el LED
+enciende "de golpe" en el nivel 21. Con 12 bits solo los niveles 0 a 5
+quedan apagados y el arranque del fundido es continuo.
+
+  ┌──────┬────────────┬─────────────────────────┐
+  │ Bits │ Duty máx.  │ Frecuencia máx. (80 MHz)│
+  ├──────┼────────────┼─────────────────────────┤
+  │  8   │ 255        │ 312 kHz                 │
+  │ 10   │ 1023       │ 78 kHz                  │
+  │ 12   │ 4095       │ 19.5 kHz                │
+  │ 14   │ 16383      │ 4.9 kHz                 │
+  └──────┴────────────┴─────────────────────────┘
+
+FUNDIDO POR TEMPORIZADOR (src/fade_led.h):
+Con delay(5) en loop() el programa no podía hacer nada más y el ritmo
+dependía de cuánto tardara cada vuelta. FadeLed usa un esp_timer
+periódico de 5 ms: cada vencimiento avanza un paso de la rampa y
+escribe el duty solo si cambió.
+
+  fade.fundido(255, 1000);   // Encender en 1 s
+  fade.fundido(0, 300);      // Apagar en 300 ms
+  fade.respirar(1280);       // Subir y bajar sin fin
+
+El fundido por hardware del LEDC cambia el duty en forma lineal (sin
+gamma), por eso los pasos se dan desde el temporizador con la tabla.
+
 LEDC (LED Control):
 Controlador PWM del ESP32 con 16 canales independientes.
 Permite control preciso de LEDs, motores, servos, etc.
@@ -105,6 +145,10 @@ Control con potenciómetro:
   int brillo = map(adc, 0, 4095, 0, 255);
   ledcWrite(0, brillo);
 
+Verificar la tabla gamma en la PC (compara con pow() y mide ciclos):
+  g++ -O2 -std=c++11 -o bench_gamma tools/bench_gamma.cpp
+  ./bench_gamma
+
 Diferentes frecuencias:
   ledcSetup(0, 1000, 8);   // 1 kHz - puede ser audible
   ledcSetup(0, 5000, 8);   // 5 kHz - estándar
@@ -114,7 +158,7 @@ Diferentes frecuencias:
 
 • ESP32 tiene 16 canales PWM independientes
 • Frecuencia típica: 5 kHz (imperceptible para humanos)
-• Resolución: 8 bits (0-255) es suficiente para LEDs
+• Resolución: 8 bits (0-255) alcanza para brillo fijo; 12 bits para fundidos suaves
 • Mayor resolución (16 bits) útil para control preciso de motores
 • Corrección gamma mejora percepción visual del fade
 
@@ -122,7 +166,8 @@ Diferentes frecuencias:
 
 LED parpadea: Frecuencia muy baja, usar mínimo 1000 Hz
 Brillo no cambia: Verificar que canal y pin coincidan
-Fade no suave: Aplicar corrección gamma
+Fade no suave: Aplicar corrección gamma o subir RESOLUCION_PWM
+Saltos al encender: Con 8 bits es normal (niveles 0-20 = duty 0)
 
 ===============================================================================
 */
@@ -0,0 +1,148 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Benchmark y verificación en la PC de src/gamma_lut.h (no se compila
+    con PlatformIO)
+
+        g++ -O2 -std=c++11 -o bench_gamma tools/bench_gamma.cpp
+        ./bench_gamma
+
+    1. Cada tabla (101 y 256 entradas, 8 a 14 bits) contra la cuenta
+       original con pow(): deben coincidir todos los valores. Verifica
+       también que RampaGamma llegue al destino en la cantidad de pasos
+       pedida sin saltear niveles. Devuelve 1 si algo falla.
+    2. Ciclos por actualización (contador de ciclos en x86, si no ns)
+       de pow() contra la tabla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAY_CICLOS 1
+#endif
+
+#include "../src/gamma_lut.h"
+
+static int fallas = 0;
+
+static void comprobar(bool ok, const char *tabla, const char *que) {
+    printf("  [%s] %-16s %s\n", ok ? " OK " : "FALLA", tabla, que);
+    if (!ok) fallas++;
+}
+
+// Cuenta original: (uint8_t)(pow(nivel / 255.0, 2.2) * 255.0), para
+// cualquier cantidad de entradas y de bits
+static uint16_t gammaPow(uint16_t i, uint16_t entradas, uint16_t maximo) {
+    return (uint16_t)(pow((double)i / (entradas - 1), 2.2) * maximo);
+}
+
+template <typename Tabla>
+static void verificarTabla(const char *nombre) {
+    int distintos = 0, apagados = 0;
+    for (uint16_t i = 0; i < Tabla::ENTRADAS; i++) {
+        uint16_t esperado = gammaPow(i, Tabla::ENTRADAS, Tabla::MAXIMO);
+        if (Tabla::pwm(i) != esperado) {
+            if (distintos < 3) printf("    nivel %u: %u (pow %u)\n", i, Tabla::pwm(i), esperado);
+            distintos++;
+        }
+        if (Tabla::pwm(i) == 0) apagados++;
+    }
+    char texto[96];
+    snprintf(texto, sizeof(texto), "igual a pow() en los %u niveles (%d con duty 0)", Tabla::ENTRADAS, apagados);
+    comprobar(distintos == 0, nombre, texto);
+}
+
+template <typename Tabla>
+static void verificarRampa(const char *nombre, uint16_t desde, uint16_t hasta, uint32_t pasos) {
+    RampaGamma<Tabla> rampa;
+    rampa.iniciar(desde, hasta, pasos);
+    uint32_t dados = 0;
+    bool monotona = true;
+    uint16_t anterior = rampa.pwm();
+    while (rampa.avanzar()) {
+        dados++;
+        uint16_t duty = rampa.pwm();
+        monotona &= hasta >= desde ? duty >= anterior : duty <= anterior;
+        anterior = duty;
+    }
+    char texto[96];
+    snprintf(texto, sizeof(texto), "rampa %u → %u en %u pasos, duty monótono", desde, hasta, (unsigned)pasos);
+    comprobar(dados == pasos && rampa.nivel() == hasta && monotona, nombre, texto);
+}
+
+static void verificar() {
+    printf("Tablas contra pow(x, 2.2):\n");
+    verificarTabla<GammaPorcentaje>("101 x 8 bits");
+    verificarTabla<Gamma8>("256 x 8 bits");
+    verificarTabla<TablaGamma<256, 10>>("256 x 10 bits");
+    verificarTabla<TablaGamma<256, 12>>("256 x 12 bits");
+    verificarTabla<TablaGamma<256, 14>>("256 x 14 bits");
+
+    // Dashboard 4.5: brillo 0-100 % pasaba por dutyCycle = brillo/100 · 255
+    int distintos = 0;
+    for (uint8_t b = 1; b <= 100; b++) {
+        float dutyCycle = (b / 100.0) * 255.0;
+        uint8_t original = pow(dutyCycle / 255.0, 2.2) * 255.0;
+        if (GammaPorcentaje::pwm(b) != original) distintos++;
+    }
+    comprobar(distintos == 0, "101 x 8 bits", "igual a brightnessToGammaPWM() de 4.5");
+
+    printf("\nRampas:\n");
+    verificarRampa<TablaGamma<256, 12>>("256 x 12 bits", 0, 255, 256);  // Fundido del sketch 2.1
+    verificarRampa<TablaGamma<256, 12>>("256 x 12 bits", 255, 0, 256);
+    verificarRampa<TablaGamma<256, 12>>("256 x 12 bits", 40, 200, 1000);  // Más pasos que niveles
+    verificarRampa<GammaPorcentaje>("101 x 8 bits", 100, 30, 7);
+    RampaGamma<Gamma8> salto;
+    salto.iniciar(10, 500, 0);  // Destino fuera de la tabla: se satura
+    comprobar(!salto.avanzar() && salto.nivel() == 255 && salto.pwm() == 255, "256 x 8 bits", "0 pasos: salto inmediato, satura en 255");
+}
+
+static const uint32_t VECES = 10000000;
+
+template <typename Funcion>
+static void medir(const char *nombre, Funcion f) {
+    volatile uint32_t sumidero = 0;
+    volatile uint16_t nivel = 0;  // volatile: que el compilador no precalcule pow()
+    auto inicio = std::chrono::steady_clock::now();
+#ifdef HAY_CICLOS
+    uint64_t c0 = __rdtsc();
+#endif
+    for (uint32_t i = 0; i < VECES; i++) {
+        nivel = i & 255;
+        sumidero = sumidero + f(nivel);
+    }
+#ifdef HAY_CICLOS
+    double ciclos = (double)(__rdtsc() - c0) / VECES;
+#endif
+    std::chrono::duration<double, std::nano> dt = std::chrono::steady_clock::now() - inicio;
+#ifdef HAY_CICLOS
+    printf("  %-28s %6.1f ciclos/actualización  %6.2f ns\n", nombre, ciclos, dt.count() / VECES);
+#else
+    printf("  %-28s %6.2f ns/actualización\n", nombre, dt.count() / VECES);
+#endif
+}
+
+static void benchmark() {
+    printf("\nCosto por actualización (%u actualizaciones):\n", (unsigned)VECES);
+    medir("pow() double (sketch 2.1)", [](uint16_t n) { return (uint32_t)(uint8_t)(pow(n / 255.0, 2.2) * 255.0); });
+    medir("powf() float", [](uint16_t n) { return (uint32_t)(uint8_t)(powf(n / 255.0f, 2.2f) * 255.0f); });
+    medir("Gamma8 (tabla)", [](uint16_t n) { return (uint32_t)Gamma8::pwm(n); });
+    medir("TablaGamma<256, 12>", [](uint16_t n) { return (uint32_t)TablaGamma<256, 12>::pwm(n); });
+}
+
+int main() {
+    verificar();
+    benchmark();
+    printf("\n%s\n", fallas ? "FALLA: revisar las comprobaciones marcadas" : "OK: las tablas coinciden con pow()");
+    return fallas ? 1 : 0;
+}
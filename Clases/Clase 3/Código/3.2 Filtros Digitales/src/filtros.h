@@ -0,0 +1,234 @@
+/*
+    Biblioteca de filtros digitales en punto fijo (solo header, sin heap).
+
+    Todos los filtros trabajan con enteros (int32_t) y tienen el mismo
+    método procesar(x), así que se pueden encadenar al compilar:
+
+        FiltroEMA<51>             ema;        // α = 51/256 ≈ 0.2
+        FiltroPromedio<8>         promedio;   // Promedio de las últimas 8
+        FiltroMediana<5>          mediana;    // Mediana de las últimas 5
+        FiltroBiquad              pasaBajos;  // IIR de 2° orden
+
+        // Mediana (saca picos) → pasa bajos (suaviza)
+        CadenaFiltros<FiltroMediana<5>, FiltroBiquad> cadena;
+        cadena.etapa<1>().pasaBajos(0.5, 10);   // fc = 0.5 Hz, fs = 10 Hz
+        int32_t y = cadena.procesar(analogRead(PIN_ADC));
+
+        Filtro              │ Memoria      │ Costo por muestra
+        ────────────────────┼──────────────┼──────────────────────────
+        FiltroEMA<α·256>    │ 1 int32      │ 1 multiplicación
+        FiltroPromedio<N>   │ N int32      │ 1 suma, 1 resta, 1 división
+        FiltroMediana<N>    │ 2N int32     │ O(N): mover la ventana ordenada
+        FiltroBiquad        │ 4 int32      │ 5 multiplicaciones
+
+    No depende de Arduino.h: tools/bench_filtros.cpp lo compila en la PC
+    para medir ciclos por muestra y verificar respuesta al escalón e impulso.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+// EMA en punto fijo: y += α·(x - y), con α = ALFA_Q8 / 256.
+// El estado guarda 8 bits de decimales para no perder resolución
+// (entradas de hasta 14 bits para que α·(x - y) entre en 32 bits).
+template <uint16_t ALFA_Q8>
+class FiltroEMA {
+    static_assert(ALFA_Q8 > 0 && ALFA_Q8 <= 256, "ALFA_Q8 debe estar entre 1 y 256");
+
+public:
+    int32_t procesar(int32_t x) {
+        if (!_iniciado) {
+            _y = x * 256;  // Arranca en la primera lectura (sin rampa desde 0)
+            _iniciado = true;
+        }
+        _y += (ALFA_Q8 * (x * 256 - _y)) >> 8;
+        return (_y + 128) >> 8;
+    }
+
+    void reiniciar() { _iniciado = false; }
+
+private:
+    int32_t _y = 0;
+    bool _iniciado = false;
+};
+
+// Promedio móvil de N muestras con suma acumulada: cada muestra nueva
+// suma su valor y resta la que sale de la ventana (no recorre el array)
+template <uint8_t N>
+class FiltroPromedio {
+    static_assert(N > 0, "N debe ser mayor que 0");
+
+public:
+    int32_t procesar(int32_t x) {
+        if (_cuenta == N) {
+            _suma -= _ventana[_indice];
+        } else {
+            _cuenta++;
+        }
+        _ventana[_indice] = x;
+        _suma += x;
+        _indice = (_indice + 1 == N) ? 0 : _indice + 1;
+
+        if (_cuenta == N) return _suma / N;  // N constante: el compilador evita la división
+        return _suma / _cuenta;              // Mientras se llena la ventana
+    }
+
+    void reiniciar() { _suma = 0; _indice = 0; _cuenta = 0; }
+
+private:
+    int32_t _ventana[N];
+    int32_t _suma = 0;
+    uint8_t _indice = 0;
+    uint8_t _cuenta = 0;
+};
+
+// Mediana de las últimas N muestras (N impar). Además de la ventana en
+// orden de llegada guarda una copia ordenada: por muestra se saca la más
+// vieja y se inserta la nueva en su lugar, sin reordenar todo
+template <uint8_t N>
+class FiltroMediana {
+    static_assert(N % 2 == 1, "N debe ser impar");
+
+public:
+    int32_t procesar(int32_t x) {
+        if (_cuenta == N) {
+            // Quitar de la copia ordenada la muestra que sale de la ventana
+            int32_t vieja = _ventana[_indice];
+            uint8_t i = 0;
+            while (_ordenada[i] != vieja) i++;
+            for (; i < N - 1; i++) _ordenada[i] = _ordenada[i + 1];
+            _cuenta--;
+        }
+        _ventana[_indice] = x;
+        _indice = (_indice + 1 == N) ? 0 : _indice + 1;
+
+        // Inserción ordenada de la muestra nueva
+        uint8_t i = _cuenta;
+        while (i > 0 && _ordenada[i - 1] > x) {
+            _ordenada[i] = _ordenada[i - 1];
+            i--;
+        }
+        _ordenada[i] = x;
+        _cuenta++;
+
+        return _ordenada[_cuenta / 2];
+    }
+
+    void reiniciar() { _indice = 0; _cuenta = 0; }
+
+private:
+    int32_t _ventana[N];   // Orden de llegada (circular)
+    int32_t _ordenada[N];  // Mismas muestras, de menor a mayor
+    uint8_t _indice = 0;
+    uint8_t _cuenta = 0;
+};
+
+// IIR de 2° orden (biquad) en forma directa I, coeficientes en Q14:
+//   y[n] = b0·x[n] + b1·x[n-1] + b2·x[n-2] - a1·y[n-1] - a2·y[n-2]
+// El resto del redondeo se suma a la muestra siguiente (error feedback),
+// así la ganancia en continua es exacta aunque la salida sea entera
+class FiltroBiquad {
+public:
+    static const uint8_t Q = 14;
+    static const int32_t UNO = 1L << Q;
+
+    // Por defecto no filtra (b0 = 1)
+    FiltroBiquad() { coeficientes(UNO, 0, 0, 0, 0); }
+
+    void coeficientes(int32_t b0, int32_t b1, int32_t b2, int32_t a1, int32_t a2) {
+        _b0 = b0; _b1 = b1; _b2 = b2; _a1 = a1; _a2 = a2;
+        reiniciar();
+    }
+
+    // Pasa bajos Butterworth (q = 0.7071) con frecuencia de corte fc para
+    // una frecuencia de muestreo fs (fórmulas del "Audio EQ Cookbook").
+    // Se llama una vez en setup(): usa float solo para los coeficientes
+    void pasaBajos(float fc, float fs, float q = 0.7071f) {
+        float w0 = 2 * (float)M_PI * fc / fs;
+        float alfa = sinf(w0) / (2 * q);
+        float a0 = 1 + alfa;
+        float c = cosf(w0);
+
+        int32_t a1 = lroundf(-2 * c / a0 * UNO);
+        int32_t a2 = lroundf((1 - alfa) / a0 * UNO);
+        int32_t b0 = lroundf((1 - c) / 2 / a0 * UNO);
+        // b1 se ajusta para que b0 + b1 + b2 = 1 + a1 + a2 (ganancia 1 en continua)
+        int32_t b1 = UNO + a1 + a2 - 2 * b0;
+        coeficientes(b0, b1, b0, a1, a2);
+    }
+
+    int32_t procesar(int32_t x) {
+        int64_t acc = (int64_t)_b0 * x + (int64_t)_b1 * _x1 + (int64_t)_b2 * _x2
+                    - (int64_t)_a1 * _y1 - (int64_t)_a2 * _y2 + _resto;
+        int32_t y = (int32_t)(acc >> Q);
+        _resto = (int32_t)(acc - ((int64_t)y << Q));
+
+        _x2 = _x1; _x1 = x;
+        _y2 = _y1; _y1 = y;
+        return y;
+    }
+
+    void reiniciar() { _x1 = _x2 = _y1 = _y2 = _resto = 0; }
+
+private:
+    int32_t _b0, _b1, _b2, _a1, _a2;
+    int32_t _x1, _x2, _y1, _y2;
+    int32_t _resto;
+};
+
+// Cadena de filtros resuelta al compilar: la salida de cada etapa es la
+// entrada de la siguiente, sin punteros ni llamadas virtuales
+template <typename... Etapas>
+class CadenaFiltros;
+
+template <>
+class CadenaFiltros<> {
+public:
+    int32_t procesar(int32_t x) { return x; }
+    void reiniciar() {}
+};
+
+// Tipo y acceso a la etapa I de una cadena (ver CadenaFiltros::etapa<I>)
+template <size_t I, typename... Etapas>
+struct EtapaFiltro;
+
+template <typename Primera, typename... Resto>
+struct EtapaFiltro<0, Primera, Resto...> {
+    typedef Primera Tipo;
+    static Tipo &de(CadenaFiltros<Primera, Resto...> &cadena) { return cadena.primera(); }
+};
+
+template <size_t I, typename Primera, typename... Resto>
+struct EtapaFiltro<I, Primera, Resto...> {
+    typedef typename EtapaFiltro<I - 1, Resto...>::Tipo Tipo;
+    static Tipo &de(CadenaFiltros<Primera, Resto...> &cadena) {
+        return EtapaFiltro<I - 1, Resto...>::de(cadena.resto());
+    }
+};
+
+template <typename Primera, typename... Resto>
+class CadenaFiltros<Primera, Resto...> {
+public:
+    int32_t procesar(int32_t x) { return _resto.procesar(_primera.procesar(x)); }
+
+    void reiniciar() {
+        _primera.reiniciar();
+        _resto.reiniciar();
+    }
+
+    // Acceso a una etapa para configurarla: cadena.etapa<1>().pasaBajos(...)
+    template <size_t I>
+    typename EtapaFiltro<I, Primera, Resto...>::Tipo &etapa() {
+        return EtapaFiltro<I, Primera, Resto...>::de(*this);
+    }
+
+    Primera &primera() { return _primera; }
+    CadenaFiltros<Resto...> &resto() { return _resto; }
+
+private:
+    Primera _primera;
+    CadenaFiltros<Resto...> _resto;
+};
@@ -15,24 +15,36 @@
     Implementación de filtro EMA (Exponential Moving Average) para
     suavizar lecturas ruidosas del ADC. Compara señal cruda vs filtrada
     en Serial Plotter para visualizar mejora en estabilidad.
+    Incluye filtros en punto fijo (EMA, promedio móvil, mediana y
+    biquad) encadenables al compilar (src/filtros.h).
     
     ─────────────────────────────────────────────────────────────────────
 */
 
 #include <Arduino.h>
+#include "filtros.h"
 
 const int PIN_ADC = 1;
 float ema = 0;
 
+// Mismos filtros en punto fijo (sin float ni memoria dinámica)
+FiltroEMA<51> emaFijo;                                // α = 51/256 ≈ 0.2
+FiltroPromedio<8> promedio;                           // Últimas 8 muestras
+FiltroMediana<5> mediana;                             // Elimina picos aislados
+CadenaFiltros<FiltroMediana<5>, FiltroBiquad> cadena; // Mediana → pasa bajos
+
 void setup() {
     Serial.begin(115200);
+    cadena.etapa<1>().pasaBajos(0.5, 10);  // fc = 0.5 Hz con fs = 10 Hz (delay de 100ms)
 }
 
 void loop() {
     int x = analogRead(PIN_ADC);
     ema = 0.2 * x + 0.8 * ema;
     // Serial.printf("%d,%.1f", x, ema);
-    Serial.printf(">raw:%d,filtrada:%.1f", x, ema); // Serial Plotter format
+    Serial.printf(">raw:%d,filtrada:%.1f,ema_fijo:%d,promedio:%d,mediana:%d,cadena:%d",
+                  x, ema, (int)emaFijo.procesar(x), (int)promedio.procesar(x),
+                  (int)mediana.procesar(x), (int)cadena.procesar(x)); // Serial Plotter format
     Serial.println();
     delay(100);
 }
@@ -105,6 +117,33 @@ Promedio móvil alternativo:
   index = (index + 1) % WINDOW;
   float avg = sum(buffer) / WINDOW;
 
+--- BIBLIOTECA DE FILTROS (src/filtros.h) ---
+
+Todos en punto fijo (int32_t), sin float ni heap, con procesar(x):
+
+  FiltroEMA<51>       → EMA con α = 51/256 ≈ 0.2 (1 multiplicación)
+  FiltroPromedio<N>   → Promedio móvil con suma acumulada: suma la
+                        muestra nueva y resta la que sale, O(1)
+                        (no recorre el buffer como sum() arriba)
+  FiltroMediana<N>    → Mediana de N (impar) con ventana ordenada:
+                        saca la más vieja e inserta la nueva, O(N)
+  FiltroBiquad        → IIR de 2° orden, pasaBajos(fc, fs) calcula
+                        los coeficientes (Butterworth) en setup()
+
+Encadenados al compilar (sin punteros ni funciones virtuales):
+
+  CadenaFiltros<FiltroMediana<5>, FiltroBiquad> cadena;
+  cadena.etapa<1>().pasaBajos(0.5, 10);
+  int32_t y = cadena.procesar(raw);   // raw → mediana → biquad → y
+
+Respuesta típica a un pico aislado (un solo valor muy alto):
+  EMA / promedio / biquad → lo "desparraman" en varias muestras
+  Mediana                 → lo elimina por completo
+
+tools/bench_filtros.cpp (en la PC) verifica la respuesta al escalón e
+impulso de cada filtro y mide ciclos por muestra:
+  g++ -O2 -std=c++11 -o bench tools/bench_filtros.cpp && ./bench
+
 --- VISUALIZACIÓN SERIAL PLOTTER ---
 
 Formato correcto (separado por comas):
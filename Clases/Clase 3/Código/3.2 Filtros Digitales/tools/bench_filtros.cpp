@@ -0,0 +1,175 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Benchmark y verificación en la PC de src/filtros.h (no se compila con
+    PlatformIO)
+
+        g++ -O2 -std=c++11 -o bench_filtros tools/bench_filtros.cpp
+        ./bench_filtros
+
+    1. Respuesta al escalón (0 → 1000) y al impulso (un pico de 1000) de
+       cada filtro, comparada con lo que predice la teoría. Devuelve 1 si
+       alguna comprobación falla.
+    2. Ciclos por muestra (contador de ciclos en x86, si no ns por
+       muestra) de cada filtro y de la cadena, contra el EMA en float del
+       sketch original.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAY_CICLOS 1
+#endif
+
+#include "../src/filtros.h"
+
+static const int32_t ESCALON = 1000;
+static int fallas = 0;
+
+static void comprobar(bool ok, const char *filtro, const char *que) {
+    printf("  [%s] %-24s %s\n", ok ? " OK " : "FALLA", filtro, que);
+    if (!ok) fallas++;
+}
+
+// Respuesta de un filtro a una señal: out[n] para n en [0, largo)
+template <typename Filtro>
+static void responder(Filtro &f, const int32_t *entrada, int32_t *salida, int largo) {
+    f.reiniciar();
+    for (int n = 0; n < largo; n++) salida[n] = f.procesar(entrada[n]);
+}
+
+static const int LARGO = 200;
+static int32_t escalon[LARGO], impulso[LARGO], salida[LARGO];
+
+static void verificar() {
+    // Escalón después de 10 muestras en 0, impulso aislado en la muestra 10
+    for (int n = 0; n < LARGO; n++) {
+        escalon[n] = n < 10 ? 0 : ESCALON;
+        impulso[n] = n == 10 ? ESCALON : 0;
+    }
+
+    printf("Respuesta al escalón (0 → %d) y al impulso:\n", ESCALON);
+
+    FiltroEMA<51> ema;  // α ≈ 0.2
+    responder(ema, escalon, salida, LARGO);
+    // Teoría: 1 - (1-α)^k tras k muestras; con α = 0.2 supera el 63% en la 5ª
+    comprobar(salida[10 + 3] < 632 && salida[10 + 4] >= 632, "EMA<51>", "63% en la 5ª muestra");
+    comprobar(abs(salida[LARGO - 1] - ESCALON) <= 1, "EMA<51>", "llega al escalón (±1)");
+    responder(ema, impulso, salida, LARGO);
+    comprobar(salida[10] == 199 && salida[11] < salida[10] && salida[LARGO - 1] == 0,
+              "EMA<51>", "impulso: α·1000 y decae a 0");
+
+    FiltroPromedio<8> promedio;
+    responder(promedio, escalon, salida, LARGO);
+    bool rampa = true;
+    for (int k = 0; k < 8; k++) rampa &= salida[10 + k] == ESCALON * (k + 1) / 8;
+    comprobar(rampa && salida[10 + 8] == ESCALON, "Promedio<8>", "rampa lineal en 8 muestras");
+    responder(promedio, impulso, salida, LARGO);
+    bool meseta = true;
+    for (int k = 0; k < 8; k++) meseta &= salida[10 + k] == ESCALON / 8;
+    comprobar(meseta && salida[10 + 8] == 0, "Promedio<8>", "impulso: 1000/8 durante 8");
+
+    FiltroMediana<5> mediana;
+    responder(mediana, escalon, salida, LARGO);
+    comprobar(salida[10 + 1] == 0 && salida[10 + 2] == ESCALON, "Mediana<5>", "escalón pasa a las 3 muestras");
+    responder(mediana, impulso, salida, LARGO);
+    bool rechazado = true;
+    for (int n = 0; n < LARGO; n++) rechazado &= salida[n] == 0;
+    comprobar(rechazado, "Mediana<5>", "impulso eliminado por completo");
+
+    FiltroBiquad biquad;
+    biquad.pasaBajos(0.5, 10);
+    responder(biquad, escalon, salida, LARGO);
+    int32_t pico = 0;
+    for (int n = 0; n < LARGO; n++) if (salida[n] > pico) pico = salida[n];
+    comprobar(salida[LARGO - 1] == ESCALON, "Biquad pasa bajos", "ganancia 1 en continua");
+    comprobar(pico <= ESCALON * 105 / 100, "Biquad pasa bajos", "sobrepico < 5% (Butterworth)");
+    responder(biquad, impulso, salida, LARGO);
+    int32_t suma = 0;
+    for (int n = 0; n < LARGO; n++) suma += salida[n];
+    // Área = ganancia en continua × 1000 (±1%: la cola por debajo de 1 LSB se pierde)
+    comprobar(abs(suma - ESCALON) <= ESCALON / 100 && salida[LARGO - 1] == 0, "Biquad pasa bajos", "impulso: área ≈ 1000, decae a 0");
+
+    CadenaFiltros<FiltroMediana<5>, FiltroBiquad> cadena;
+    cadena.etapa<1>().pasaBajos(0.5, 10);
+    responder(cadena, impulso, salida, LARGO);
+    rechazado = true;
+    for (int n = 0; n < LARGO; n++) rechazado &= salida[n] == 0;
+    comprobar(rechazado, "Mediana<5> → Biquad", "el pico no llega al biquad");
+    responder(cadena, escalon, salida, LARGO);
+    comprobar(salida[LARGO - 1] == ESCALON, "Mediana<5> → Biquad", "llega al escalón");
+}
+
+// EMA en float del sketch original (referencia de velocidad)
+struct EmaFloat {
+    float ema = 0;
+    int32_t procesar(int32_t x) {
+        ema = 0.2 * x + 0.8 * ema;
+        return (int32_t)ema;
+    }
+};
+
+static const uint32_t MUESTRAS = 10000000;
+static int32_t senal[4096];
+
+template <typename Filtro>
+static void medir(const char *nombre, Filtro &f) {
+    volatile int32_t sumidero = 0;
+    auto inicio = std::chrono::steady_clock::now();
+#ifdef HAY_CICLOS
+    uint64_t c0 = __rdtsc();
+#endif
+    for (uint32_t i = 0; i < MUESTRAS; i++) sumidero = sumidero + f.procesar(senal[i & 4095]);
+#ifdef HAY_CICLOS
+    double ciclos = (double)(__rdtsc() - c0) / MUESTRAS;
+#endif
+    std::chrono::duration<double, std::nano> dt = std::chrono::steady_clock::now() - inicio;
+#ifdef HAY_CICLOS
+    printf("  %-24s %6.1f ciclos/muestra  %6.2f ns/muestra\n", nombre, ciclos, dt.count() / MUESTRAS);
+#else
+    printf("  %-24s %6.2f ns/muestra\n", nombre, dt.count() / MUESTRAS);
+#endif
+}
+
+static void benchmark() {
+    // ADC simulado: 2000 ± ruido, con algún pico aislado
+    srand(1);
+    for (int i = 0; i < 4096; i++) senal[i] = 2000 + rand() % 41 - 20 + (i % 97 == 0 ? 800 : 0);
+
+    printf("\nCosto por muestra (%u muestras):\n", (unsigned)MUESTRAS);
+    EmaFloat emaFloat;
+    FiltroEMA<51> ema;
+    FiltroPromedio<8> promedio;
+    FiltroPromedio<32> promedio32;
+    FiltroMediana<5> mediana;
+    FiltroMediana<15> mediana15;
+    FiltroBiquad biquad;
+    biquad.pasaBajos(0.5, 10);
+    CadenaFiltros<FiltroMediana<5>, FiltroBiquad> cadena;
+    cadena.etapa<1>().pasaBajos(0.5, 10);
+
+    medir("EMA float (original)", emaFloat);
+    medir("EMA<51> punto fijo", ema);
+    medir("Promedio<8>", promedio);
+    medir("Promedio<32>", promedio32);
+    medir("Mediana<5>", mediana);
+    medir("Mediana<15>", mediana15);
+    medir("Biquad", biquad);
+    medir("Mediana<5> → Biquad", cadena);
+}
+
+int main() {
+    verificar();
+    benchmark();
+    printf("\n%s\n", fallas ? "FALLA: revisar las comprobaciones marcadas" : "OK: todas las respuestas coinciden con la teoría");
+    return fallas ? 1 : 0;
+}
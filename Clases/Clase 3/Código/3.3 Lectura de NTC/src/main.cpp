@@ -23,6 +23,7 @@
 
 #include <Arduino.h>
 #include <math.h>
+#include "ntc_lut.h"
 
 const int PIN_ADC = 1; 
 const int PIN_LED = 2;
@@ -31,6 +32,9 @@ const float VREF = 3.3, R_FIXED = 10000, R0 = 10000, CT0 = 298.15, BETA = 3950;
 // Factor de calibración (V_real / V_medido)
 const float ADC_CORRECTION = 1.73 / 1.91;
 
+// Temperatura precalculada para cada código del ADC (centésimas de °C)
+NtcLut<NTC_LUT_SHIFT> ntcLut;
+
 void setup() {
     Serial.begin(115200);
     pinMode(PIN_LED, OUTPUT);    
@@ -39,14 +43,26 @@ void setup() {
     gpio_pulldown_dis((gpio_num_t)PIN_ADC);
     analogSetAttenuation(ADC_11db);
     analogReadResolution(12);
+
+    // Calcular una sola vez V, R y Steinhart-Hart para los 4096 códigos
+    NtcParams params = {VREF, R_FIXED, R0, CT0, BETA};
+    ntcLut.build(params, [](uint16_t raw) {
+        return raw * (VREF / 4095.0f) * ADC_CORRECTION * 1000.0f;
+    });
 }
 
 void loop() {
     int raw = analogRead(PIN_ADC);
     float v = raw * (VREF / 4095.0) * ADC_CORRECTION;
-    float R = R_FIXED * v / (VREF - v);
-    float Tc = (1 / (1 / CT0 + log(R / R0) / BETA)) - 273.15;
-    Serial.printf("V=%.3fV | R=%.0fΩ | T=%.2f°C", v, R, Tc);
+    int16_t centigrados = ntcLut.centigrados(raw);
+    if (centigrados == NTC_LUT_ERROR) {
+        Serial.printf("V=%.3fV | ADC=%d | T=ERROR (fuera de rango)", v, raw);
+        Serial.println();
+        delay(500);
+        return;
+    }
+    float Tc = centigrados / 100.0;
+    Serial.printf("V=%.3fV | ADC=%d | T=%.2f°C", v, raw, Tc);
     Serial.println();    
     digitalWrite(PIN_LED, Tc > 30 ? HIGH : LOW);
     delay(500);
@@ -97,6 +113,17 @@ Cálculo de resistencia NTC:
 4. Aplicar Steinhart-Hart → T(K) = 1/(1/T0 + ln(R/R0)/β)
 5. Convertir a Celsius → T(°C) = T(K) - 273.15
 
+Los pasos 2 a 5 dependen solo del código raw (0-4095), así que se
+calculan una vez en setup() y se guardan en una tabla (src/ntc_lut.h):
+
+  loop(): raw ──► ntcLut.centigrados(raw) ──► 2345 (= 23.45°C)
+
+Sin log() ni divisiones en cada muestra. Las entradas fuera de rango
+(sensor abierto o en corto) quedan marcadas como NTC_LUT_ERROR.
+Con -D NTC_LUT_SHIFT=1 o 2 en build_flags la tabla ocupa la mitad
+(~4KB) o un cuarto (~2KB) e interpola entre entradas vecinas.
+Si se cambia ADC_CORRECTION o BETA, la tabla se rearma al reiniciar.
+
 --- CALIBRACIÓN DEL ADC ---
 
 PROBLEMA: 
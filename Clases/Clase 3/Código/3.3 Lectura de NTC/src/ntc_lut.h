@@ -0,0 +1,123 @@
+/*
+    Tabla de conversión NTC: código crudo del ADC → centésimas de °C.
+
+    Cada muestra del NTC pasaba por la calibración del ADC, una división
+    para la resistencia, log() y otras dos divisiones. Como el ADC de 12
+    bits solo puede devolver 4096 códigos distintos, todo ese cálculo se
+    hace una sola vez al arrancar y la lectura queda en un acceso a la tabla.
+
+        NtcLut<NTC_LUT_SHIFT> ntcLut;
+        NtcParams params = {VREF, R_FIXED, R0, CT0, BETA};
+
+        // En setup(), después de esp_adc_cal_characterize():
+        ntcLut.build(params, [](uint16_t raw) {
+            return (float)esp_adc_cal_raw_to_voltage(raw, &adc_chars);
+        });
+
+        // En loop():
+        int16_t cc = ntcLut.centigrados(analogRead(NTC_PIN));  // 2345 = 23.45 °C
+
+    SHIFT elige el tamaño de la tabla para placas con poca RAM:
+
+        SHIFT │ Entradas │ RAM     │ Lectura
+        ──────┼──────────┼─────────┼──────────────────────────────
+          0   │ 4097     │ ~8 KB   │ Acceso directo
+          1   │ 2049     │ ~4 KB   │ Interpolación lineal (cada 2)
+          2   │ 1025     │ ~2 KB   │ Interpolación lineal (cada 4)
+
+    No depende de Arduino.h: 4.4 Lectura de Sensores/tools/bench_ntc_lut.cpp
+    lo compila en la PC para medir velocidad y error contra la cuenta en float.
+
+    Está copiado sin cambios en 3.3 Lectura de NTC, 3.3.1 Lectura de NTC
+    - Calibrado Interno y 4.4 Lectura de Sensores, porque cada sketch se
+    compila solo. Al corregirlo hay que actualizar las tres copias
+    (python3 Clases/verificar_copias.py las compara).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#ifndef NTC_LUT_SHIFT
+#define NTC_LUT_SHIFT 0  // Tabla completa (4096 códigos)
+#endif
+
+#define NTC_LUT_ERROR INT16_MIN  // Lectura inválida (sensor abierto/en corto)
+
+// Rango válido de temperatura (fuera de él se considera sensor con falla)
+#define NTC_T_MIN -50.0f
+#define NTC_T_MAX 150.0f
+
+struct NtcParams {
+    float vref;     // Tensión del divisor (V)
+    float rFixed;   // Resistencia fija (Ω)
+    float r0;       // Resistencia del NTC a T0 (Ω)
+    float t0;       // T0 en Kelvin (298.15)
+    float beta;     // Coeficiente Beta (K)
+};
+
+// Cálculo en float (camino original, desde la tensión calibrada). Devuelve -999.0 si la lectura no
+// es válida. Se usa para armar la tabla y como referencia en el benchmark
+inline float ntcTemperatura(float mv, const NtcParams &p) {
+    float v = mv / 1000.0f;
+    if (v < 0.1f || v > (p.vref - 0.1f)) return -999.0;          // Voltaje fuera de rango
+
+    float R = p.rFixed * v / (p.vref - v);
+    if (R < 100 || R > 1000000) return -999.0;                   // Resistencia fuera de rango
+
+    float Tc = (1 / (1 / p.t0 + logf(R / p.r0) / p.beta)) - 273.15f;
+    if (Tc < NTC_T_MIN || Tc > NTC_T_MAX) return -999.0;         // Temperatura fuera de rango
+    return Tc;
+}
+
+template <uint8_t SHIFT>
+class NtcLut {
+public:
+    static const uint16_t CODIGOS = 4096;                        // ADC de 12 bits
+    static const uint16_t ENTRADAS = (CODIGOS >> SHIFT) + 1;     // +1: extremo para interpolar
+
+    // rawAMilivoltios(raw) devuelve la tensión calibrada en mV (eFuse o
+    // factor de corrección manual, según el sketch)
+    template <typename RawAMilivoltios>
+    void build(const NtcParams &p, RawAMilivoltios rawAMilivoltios) {
+        for (uint16_t i = 0; i < ENTRADAS; i++) {
+            uint32_t raw = (uint32_t)i << SHIFT;
+            if (raw > CODIGOS - 1) raw = CODIGOS - 1;
+            float Tc = ntcTemperatura(rawAMilivoltios((uint16_t)raw), p);
+            _tabla[i] = Tc < -900 ? NTC_LUT_ERROR : (int16_t)lroundf(Tc * 100.0f);
+        }
+    }
+
+    // Temperatura en centésimas de °C, o NTC_LUT_ERROR
+    int16_t centigrados(uint16_t raw) const {
+        if (raw > CODIGOS - 1) raw = CODIGOS - 1;
+        if (SHIFT == 0) return _tabla[raw];
+
+        uint16_t i = raw >> SHIFT;
+        int16_t a = _tabla[i], b = _tabla[i + 1];
+        // Cerca del borde del rango válido no se interpola contra un error
+        if (a == NTC_LUT_ERROR || b == NTC_LUT_ERROR) return NTC_LUT_ERROR;
+        int32_t frac = raw & ((1 << SHIFT) - 1);
+        return (int16_t)(a + (((int32_t)(b - a) * frac) >> SHIFT));
+    }
+
+    // Código sobremuestreado de 12 + bitsExtra bits (ver decimador.h): los
+    // bits extra interpolan entre entradas vecinas de la tabla
+    int16_t centigradosFino(uint32_t codigo, uint8_t bitsExtra) const {
+        uint8_t desplazamiento = SHIFT + bitsExtra;
+        uint32_t i = codigo >> desplazamiento;
+        if (i > ENTRADAS - 2) return _tabla[ENTRADAS - 1];
+
+        int16_t a = _tabla[i], b = _tabla[i + 1];
+        if (a == NTC_LUT_ERROR || b == NTC_LUT_ERROR) return NTC_LUT_ERROR;
+        int32_t frac = codigo & ((1UL << desplazamiento) - 1);
+        return (int16_t)(a + (((int32_t)(b - a) * frac) >> desplazamiento));
+    }
+
+    size_t bytes() const { return sizeof(_tabla); }
+
+private:
+    int16_t _tabla[ENTRADAS];
+};
@@ -0,0 +1,78 @@
+/*
+    Decimador por sobremuestreo para el ADC continuo (DMA).
+
+    Suma 4^n muestras de 12 bits y desplaza n bits a la derecha: el
+    resultado tiene 12 + n bits. El ruido del ADC (aleatorio, de al menos
+    1 LSB) hace de "dither" y los bits extra son resolución real.
+
+        Factor │ Bits extra │ Código resultante
+        ───────┼────────────┼──────────────────
+          16   │     2      │ 14 bits (0-16380)
+          64   │     3      │ 15 bits (0-32760)
+         256   │     4      │ 16 bits (0-65520)
+
+        Decimador decimador(256);
+        for (cada muestra del buffer DMA) {
+            if (decimador.agregar(muestra)) {
+                uint32_t codigo = decimador.codigo();   // Trama lista (16 bits)
+            }
+        }
+
+    No depende de Arduino.h: tools/replay_decimador.cpp lo compila en la
+    PC y lo alimenta con capturas crudas del ADC para verificar la cuenta.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+class Decimador {
+public:
+    explicit Decimador(uint16_t factor = 64) {
+        configurar(factor);
+    }
+
+    // Factor de sobremuestreo: 16, 64 o 256. Devuelve false si no es válido
+    bool configurar(uint16_t factor) {
+        uint8_t bits;
+        switch (factor) {
+            case 16:  bits = 2; break;
+            case 64:  bits = 3; break;
+            case 256: bits = 4; break;
+            default:  return false;
+        }
+        _factor = factor;
+        _bitsExtra = bits;
+        _suma = 0;
+        _cuenta = 0;
+        return true;
+    }
+
+    // Acumula una muestra de 12 bits. Devuelve true al completar una trama
+    bool agregar(uint16_t muestra) {
+        _suma += muestra & 0x0FFF;
+        if (++_cuenta < _factor) return false;
+
+        _codigo = _suma >> _bitsExtra;  // 256 × 4095 entra de sobra en 32 bits
+        _suma = 0;
+        _cuenta = 0;
+        _tramas++;
+        return true;
+    }
+
+    uint32_t codigo() const { return _codigo; }        // Última trama (12 + bitsExtra bits)
+    uint8_t bitsExtra() const { return _bitsExtra; }
+    uint16_t factor() const { return _factor; }
+    uint32_t tramas() const { return _tramas; }        // Tramas completadas
+
+    // Última trama expresada en la escala de 12 bits (con decimales)
+    float codigo12() const { return _codigo / (float)(1 << _bitsExtra); }
+
+private:
+    uint16_t _factor = 64;      // Si configurar() recibe un factor inválido
+    uint8_t _bitsExtra = 3;
+    uint32_t _suma = 0;
+    uint16_t _cuenta = 0;
+    uint32_t _codigo = 0;
+    uint32_t _tramas = 0;
+};
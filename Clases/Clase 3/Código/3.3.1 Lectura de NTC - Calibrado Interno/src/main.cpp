@@ -18,6 +18,8 @@
     Utiliza calibración automática del ADC mediante valores eFuse 
     grabados de fábrica en cada chip ESP32 para mayor precisión sin
     necesidad de calibración manual con multímetro.
+    El ADC muestrea en modo continuo por DMA y cada trama promedia
+    256 muestras (sobremuestreo) para ganar resolución y bajar el ruido.
     
     ─────────────────────────────────────────────────────────────────────
 */
@@ -25,36 +27,182 @@
 #include <Arduino.h>
 #include <math.h>
 #include <esp_adc_cal.h>
-
-const int PIN_ADC = 1; 
+#include <driver/adc.h>
+#include "ntc_lut.h"
+#include "decimador.h"
+
+// El modo continuo solo muestrea ADC1: GPIO 1 es ADC1_CH1 en el C3, pero
+// en el ESP32 clásico no es un pin analógico (ADC1 son los GPIO 32-39)
+#if CONFIG_IDF_TARGET_ESP32
+const int PIN_ADC = 34;  // ADC1_CH6
+#else
+const int PIN_ADC = 1;   // ADC1_CH1
+#endif
 const int PIN_LED = 2;
 const float VREF = 3.3, R_FIXED = 10000, R0 = 10000, CT0 = 298.15, BETA = 3950;
 
+// ADC continuo: el DMA llena el buffer circular del driver sin usar la CPU
+#define FRECUENCIA_ADC     20000  // Muestras/s (ESP32: 20k-2M, ESP32-C3: 611-83333)
+#define SOBREMUESTREO      256    // 16, 64 o 256 muestras por trama (+2, +3 o +4 bits)
+#define MUESTRAS_POR_BLOQUE 256   // Muestras que entrega el DMA por interrupción
+#define CAPTURA_MUESTRAS   2048   // Captura cruda para tools/replay_decimador.cpp
+
+#if CONFIG_IDF_TARGET_ESP32
+#define FORMATO_ADC ADC_DIGI_OUTPUT_FORMAT_TYPE1  // 16 bits por muestra
+#else
+#define FORMATO_ADC ADC_DIGI_OUTPUT_FORMAT_TYPE2  // 32 bits por muestra
+#endif
+
 // Para calibración eFuse
 esp_adc_cal_characteristics_t adc_chars;
 
+// Temperatura precalculada para cada código del ADC (centésimas de °C)
+NtcLut<NTC_LUT_SHIFT> ntcLut;
+
+Decimador decimador(SOBREMUESTREO);
+uint8_t bufferDMA[MUESTRAS_POR_BLOQUE * SOC_ADC_DIGI_RESULT_BYTES];
+uint8_t canalADC;
+bool adcIniciado = false;
+
+// Última trama convertida (la actualiza procesarADC, la muestra loop)
+int16_t centigrados = NTC_LUT_ERROR;
+
+// Captura cruda pedida por Serial ('c')
+uint16_t captura[CAPTURA_MUESTRAS];
+uint16_t capturadas = 0;
+bool capturando = false;
+
+uint32_t previousMillis = 0;
+const uint32_t interval = 500;
+
+// false (y el motivo por Serial) si el pin no es de ADC1 o el driver
+// falla: el programa sigue sin reiniciarse en lugar de abortar
+bool iniciarADCContinuo() {
+    int canal = digitalPinToAnalogChannel(PIN_ADC);  // -1 si no es analógico
+    if (canal < 0 || canal >= SOC_ADC_CHANNEL_NUM(0)) {  // Los de ADC2 vienen después de ADC1
+        Serial.printf("Error: GPIO %d no es un canal de ADC1 (canal %d)", PIN_ADC, canal);
+        Serial.println();
+        return false;
+    }
+    canalADC = canal;
+
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = sizeof(bufferDMA) * 4;  // Buffer circular del driver
+    init.conv_num_each_intr = sizeof(bufferDMA);
+    init.adc1_chan_mask = BIT(canalADC);
+    esp_err_t r = adc_digi_initialize(&init);
+
+    adc_digi_pattern_config_t patron = {};
+    patron.atten = ADC_ATTEN_DB_12;
+    patron.channel = canalADC;
+    patron.unit = 0;  // ADC1
+    patron.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = CONFIG_IDF_TARGET_ESP32;  // El ESP32 clásico lo exige
+    config.conv_limit_num = 250;
+    config.pattern_num = 1;
+    config.adc_pattern = &patron;
+    config.sample_freq_hz = FRECUENCIA_ADC;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = FORMATO_ADC;
+    if (r == ESP_OK) r = adc_digi_controller_configure(&config);
+    if (r == ESP_OK) r = adc_digi_start();
+    if (r != ESP_OK) {
+        Serial.printf("Error: ADC continuo (%s)", esp_err_to_name(r));
+        Serial.println();
+        return false;
+    }
+    return true;
+}
+
+// Vacía lo que el DMA haya acumulado (sin esperar) y decima cada muestra
+void procesarADC() {
+    uint32_t leidos = 0;
+    esp_err_t r = adc_digi_read_bytes(bufferDMA, sizeof(bufferDMA), &leidos, 0);
+    if (r == ESP_ERR_TIMEOUT) return;  // Todavía no hay un bloque completo
+
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= leidos; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        adc_digi_output_data_t *dato = (adc_digi_output_data_t *)&bufferDMA[i];
+#if CONFIG_IDF_TARGET_ESP32
+        if (dato->type1.channel != canalADC) continue;
+        uint16_t muestra = dato->type1.data;
+#else
+        if (dato->type2.channel != canalADC) continue;
+        uint16_t muestra = dato->type2.data;
+#endif
+        if (capturando && capturadas < CAPTURA_MUESTRAS) captura[capturadas++] = muestra;
+
+        // Trama completa: pasa a la etapa de conversión (tabla NTC)
+        if (decimador.agregar(muestra)) {
+            centigrados = ntcLut.centigradosFino(decimador.codigo(), decimador.bitsExtra());
+        }
+    }
+}
+
+// Una muestra por línea entre marcadores: copiar del monitor serie a un
+// archivo y pasarlo a tools/replay_decimador.cpp
+void enviarCaptura() {
+    Serial.printf("--- CAPTURA %d muestras @ %d Hz ---", CAPTURA_MUESTRAS, FRECUENCIA_ADC);
+    Serial.println();
+    for (uint16_t i = 0; i < CAPTURA_MUESTRAS; i++) {
+        Serial.println(captura[i]);
+    }
+    Serial.println("--- FIN CAPTURA ---");
+}
+
 void setup() {
     Serial.begin(115200);
     pinMode(PIN_LED, OUTPUT);
        
     // Calibrar ADC con valores eFuse de fábrica (compensa variaciones individuales)
     esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_12, ADC_WIDTH_BIT_12, 1100, &adc_chars);
+
+    // Con la calibración cargada, precalcular la temperatura de los 4096 códigos
+    NtcParams params = {VREF, R_FIXED, R0, CT0, BETA};
+    ntcLut.build(params, [](uint16_t raw) {
+        return (float)esp_adc_cal_raw_to_voltage(raw, &adc_chars);
+    });
+
+    adcIniciado = iniciarADCContinuo();
+    if (!adcIniciado) return;
+    Serial.printf("ADC continuo: %d muestras/s, sobremuestreo %dx (%d bits), %.1f tramas/s",
+                  FRECUENCIA_ADC, SOBREMUESTREO, 12 + decimador.bitsExtra(),
+                  (float)FRECUENCIA_ADC / SOBREMUESTREO);
+    Serial.println();
 }
 
 void loop() {
-
-    int raw = analogRead(PIN_ADC);
-    
-    uint32_t voltage_mv = esp_adc_cal_raw_to_voltage(raw, &adc_chars);
-    float v = voltage_mv / 1000.0;
-    
-    float R = R_FIXED * v / (VREF - v);
-    float Tc = (1 / (1 / CT0 + log(R / R0) / BETA)) - 273.15;
+    if (!adcIniciado) {  // El error ya se informó en setup()
+        delay(1000);
+        return;
+    }
+    procesarADC();
+
+    // 'c' por Serial: capturar muestras crudas para reproducirlas en la PC
+    if (Serial.available() && Serial.read() == 'c') {
+        capturadas = 0;
+        capturando = true;
+    }
+    if (capturando && capturadas == CAPTURA_MUESTRAS) {
+        enviarCaptura();
+        capturando = false;
+    }
+
+    uint32_t currentMillis = millis();
+    if (currentMillis - previousMillis < interval) return;
+    previousMillis = currentMillis;
+
+    if (centigrados == NTC_LUT_ERROR) {
+        Serial.printf("ADC=%.2f | T=ERROR (fuera de rango)", decimador.codigo12());
+        Serial.println();
+        return;
+    }
+    float Tc = centigrados / 100.0;
     
-    Serial.printf("V=%.3fV | R=%.0fΩ | T=%.2f°C", v, R, Tc);
+    Serial.printf("ADC=%.2f | T=%.2f°C | tramas=%u", decimador.codigo12(), Tc, (unsigned)decimador.tramas());
     Serial.println();    
     digitalWrite(PIN_LED, Tc > 30 ? HIGH : LOW);
-    delay(500);
 }
 
 /*
@@ -143,6 +291,58 @@ COMPATIBILIDAD:
 5. Aplicar Steinhart-Hart → T(K) = 1/(1/T0 + ln(R/R0)/β)
 6. Convertir a Celsius → T(°C) = T(K) - 273.15
 
+Los pasos 2 a 6 dependen solo del código raw (0-4095) y de la
+calibración eFuse de este chip, que no cambia. Se calculan una vez en
+setup() y se guardan en una tabla (src/ntc_lut.h):
+
+  trama ──► ntcLut.centigradosFino(código, bits) ──► 2345 (= 23.45°C)
+
+Sin esp_adc_cal_raw_to_voltage(), log() ni divisiones en cada
+muestra. Con -D NTC_LUT_SHIFT=1 o 2 en build_flags la tabla ocupa la
+mitad (~4KB) o un cuarto (~2KB) e interpola entre entradas vecinas.
+
+--- ADC CONTINUO (DMA) Y SOBREMUESTREO ---
+
+Con analogRead() + delay(500) se tomaba UNA muestra cada 500ms: el
+ruido de esa muestra pasaba entero al resultado. En modo continuo el
+controlador digital del ADC muestrea solo a FRECUENCIA_ADC y el DMA
+deja los resultados en el buffer circular del driver, sin usar la CPU:
+
+  ADC ──DMA──► buffer circular ──► procesarADC() ──► Decimador
+  (20k/s)      (driver IDF)        (en loop, sin     (256 muestras
+                                    esperar)          → 1 trama)
+                                                          │
+                                    ntcLut.centigradosFino ◄┘
+
+Sobremuestreo: sumar 4^n muestras y desplazar n bits da un código de
+12 + n bits. El ruido (≥1 LSB) hace de "dither" y la dispersión baja
+√N veces:
+
+  SOBREMUESTREO │ Bits │ Tramas/s (20k/s) │ Ruido relativo
+  ──────────────┼──────┼──────────────────┼───────────────
+       16       │  14  │ 1250             │ 1/4
+       64       │  15  │ 312              │ 1/8
+      256       │  16  │ 78               │ 1/16
+
+Los bits extra interpolan entre entradas vecinas de la tabla NTC
+(centigradosFino). loop() solo muestra la última trama cada 500ms.
+
+APIs usadas (driver/adc.h, ESP-IDF 4.4 del core Arduino 2.x):
+  adc_digi_initialize()            → buffer circular y canal
+  adc_digi_controller_configure()  → frecuencia, atenuación, formato
+  adc_digi_start()                 → arranca el muestreo por DMA
+  adc_digi_read_bytes(..., 0)      → lo acumulado, sin bloquear
+
+Límites de FRECUENCIA_ADC: ESP32 20kHz-2MHz, ESP32-C3 611Hz-83kHz.
+En modo continuo no se puede usar analogRead() en el mismo ADC.
+
+VERIFICACIÓN EN LA PC:
+  Enviar 'c' por el monitor serie: se capturan 2048 muestras crudas
+  y se imprimen una por línea. Guardarlas en un archivo y correr
+    g++ -O2 -std=c++11 -o replay tools/replay_decimador.cpp
+    ./replay captura.txt
+  que compara cada trama del Decimador con el promedio en double.
+
 --- VALORES TÍPICOS ---
 
 Temperaturas y resistencias:
@@ -209,7 +409,9 @@ Lecturas inestables/con ruido:
 Temperatura no responde:
   → Verificar NTC conectado correctamente
   → Probar con otro NTC (puede estar dañado)
-  → Verificar que GPIO 1 sea pin ADC válido
+  → Verificar que PIN_ADC sea un pin de ADC1 (GPIO 34 en el ESP32,
+    GPIO 1 en el C3); si no lo es, setup() imprime "no es un canal de
+    ADC1" y el programa no mide en lugar de reiniciarse
 
 Diferencia con otro sensor:
   → Normal: NTCs tienen ±5% tolerancia
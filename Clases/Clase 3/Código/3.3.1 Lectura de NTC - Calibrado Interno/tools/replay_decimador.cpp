@@ -0,0 +1,129 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Reproducción en la PC de src/decimador.h (no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o replay_decimador tools/replay_decimador.cpp
+        ./replay_decimador captura.txt     # Captura real del ESP32
+        ./replay_decimador                 # Señal sintética con ruido
+
+    Para grabar una captura: enviar 'c' por el monitor serie y copiar a
+    un archivo las líneas entre "--- CAPTURA" y "--- FIN CAPTURA ---"
+    (las líneas que no son números se ignoran, se puede pegar el log).
+
+    Para cada factor (16x, 64x, 256x) pasa la secuencia por el Decimador
+    y verifica cada trama contra el promedio calculado en double. Informa
+    la dispersión de las tramas: con ruido blanco baja √N veces respecto
+    de las muestras sueltas (cada 4x de sobremuestreo, 1 bit efectivo).
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "../src/decimador.h"
+
+static std::vector<uint16_t> leerCaptura(const char *ruta) {
+    std::vector<uint16_t> muestras;
+    FILE *f = fopen(ruta, "r");
+    if (!f) {
+        perror(ruta);
+        exit(1);
+    }
+    char linea[64];
+    while (fgets(linea, sizeof(linea), f)) {
+        char *fin;
+        long v = strtol(linea, &fin, 10);
+        if (fin == linea || v < 0 || v > 4095) continue;  // Marcadores y otras líneas del log
+        muestras.push_back((uint16_t)v);
+    }
+    fclose(f);
+    return muestras;
+}
+
+// Valor fijo de 2048.3 LSB con ruido gaussiano de 2 LSB, cuantizado a 12 bits
+static std::vector<uint16_t> senalSintetica(size_t n) {
+    std::vector<uint16_t> muestras;
+    srand(1);
+    for (size_t i = 0; i < n; i++) {
+        double u1 = (rand() + 1.0) / (RAND_MAX + 2.0), u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+        double ruido = sqrt(-2 * log(u1)) * cos(2 * M_PI * u2) * 2.0;
+        muestras.push_back((uint16_t)lround(2048.3 + ruido));
+    }
+    return muestras;
+}
+
+static double desvio(const std::vector<double> &v) {
+    double media = 0, suma2 = 0;
+    for (double x : v) media += x;
+    media /= v.size();
+    for (double x : v) suma2 += (x - media) * (x - media);
+    return sqrt(suma2 / v.size());
+}
+
+// Devuelve la cantidad de tramas que no coinciden con la referencia
+static int reproducir(const std::vector<uint16_t> &muestras, uint16_t factor, double desvioCrudo) {
+    Decimador decimador(factor);
+    std::vector<double> tramas;
+    int errores = 0;
+    double suma = 0;
+    size_t enTrama = 0;
+
+    for (uint16_t m : muestras) {
+        suma += m;
+        enTrama++;
+        if (!decimador.agregar(m)) continue;
+
+        // Referencia: promedio exacto escalado a 12 + bitsExtra bits (truncado)
+        uint32_t esperado = (uint32_t)floor(suma / enTrama * (1 << decimador.bitsExtra()));
+        if (decimador.codigo() != esperado) {
+            if (errores < 5) printf("    trama %u: %u (esperado %u)\n", (unsigned)tramas.size(), (unsigned)decimador.codigo(), (unsigned)esperado);
+            errores++;
+        }
+        tramas.push_back(decimador.codigo12());
+        suma = 0;
+        enTrama = 0;
+    }
+
+    if (tramas.size() < 2) {
+        printf("  %3ux: %zu tramas (faltan muestras para medir dispersión)\n", factor, tramas.size());
+        return errores;
+    }
+    double media = 0;
+    for (double t : tramas) media += t;
+    media /= tramas.size();
+    double d = desvio(tramas);
+    printf("  %3ux: %5zu tramas de %2u bits | media %9.3f LSB | desvío %.3f LSB (%.1fx menos)%s\n",
+           factor, tramas.size(), 12 + decimador.bitsExtra(), media, d,
+           d > 0 ? desvioCrudo / d : 0, errores ? " | ERROR" : "");
+    return errores;
+}
+
+int main(int argc, char **argv) {
+    std::vector<uint16_t> muestras = argc > 1 ? leerCaptura(argv[1]) : senalSintetica(256 * 200);
+    if (muestras.empty()) {
+        fprintf(stderr, "Sin muestras válidas (0-4095) en %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<double> crudo(muestras.begin(), muestras.end());
+    double desvioCrudo = desvio(crudo);
+    printf("%zu muestras %s | desvío crudo %.3f LSB\n\n", muestras.size(),
+           argc > 1 ? argv[1] : "(sintéticas: 2048.3 LSB + ruido de 2 LSB)", desvioCrudo);
+
+    int errores = 0;
+    errores += reproducir(muestras, 16, desvioCrudo);
+    errores += reproducir(muestras, 64, desvioCrudo);
+    errores += reproducir(muestras, 256, desvioCrudo);
+
+    printf("\n%s\n", errores ? "FALLA: hay tramas distintas de la referencia" : "OK: todas las tramas coinciden con la referencia");
+    return errores ? 1 : 0;
+}
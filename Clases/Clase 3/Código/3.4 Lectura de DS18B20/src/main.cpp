@@ -28,12 +28,23 @@
 // =====================================================================
 #define PIN_DS18B20  3    // Pin GPIO para el DS18B20 (1-Wire)
 
+#define TIEMPO_CONVERSION_MS  1000  // 750 ms (12 bits) + margen para modo parásito
+#define INTERVALO_LECTURA_MS  2000  // Una lectura cada 2 segundos
+
 OneWire oneWire(PIN_DS18B20);
 DallasTemperature ds(&oneWire);
 
+// Estado de la lectura en dos fases
+bool convirtiendo = false;
+uint32_t inicioConversion = 0;
+uint32_t ultimaLectura = 0;
+
 void setup(){ 
     Serial.begin(115200); 
     ds.begin();
+
+    // Control manual del tiempo: requestTemperatures() no espera la conversión
+    ds.setWaitForConversion(false);
     
     Serial.println("\n=== DS18B20 Sensor Digital ===");
     Serial.printf("Pin DS18B20: GPIO%d\n", PIN_DS18B20);
@@ -42,16 +53,25 @@ void setup(){
 
 void loop(){
   
-    // Control manual del tiempo para modo parásito
-    ds.setWaitForConversion(false);
-    ds.requestTemperatures();
-    // Tiempo necesario para conversión en modo parásito
-    delay(1000);
-
-    float t = ds.getTempCByIndex(0);
-    Serial.printf("DS18B20: %.2f °C", t);
-    Serial.println();
-    delay(1000);
+    // Fase 1: pedir la conversión (CONVERT T) y seguir sin esperar
+    if (!convirtiendo && millis() - ultimaLectura >= INTERVALO_LECTURA_MS) {
+        ds.requestTemperatures();
+        inicioConversion = millis();
+        ultimaLectura = inicioConversion;
+        convirtiendo = true;
+    }
+
+    // Fase 2: pasado el tiempo de conversión, leer el resultado
+    if (convirtiendo && millis() - inicioConversion >= TIEMPO_CONVERSION_MS) {
+        convirtiendo = false;
+        float t = ds.getTempCByIndex(0);
+        Serial.printf("DS18B20: %.2f °C", t);
+        Serial.println();
+    }
+
+    // Mientras el sensor convierte, loop() queda libre para otras tareas
+    // (botones, display, WiFi...). No tocar el bus 1-Wire en ese tiempo:
+    // en modo parásito el sensor se alimenta de la línea de datos
 }
 
 /*
@@ -113,6 +133,12 @@ ds.requestTemperatures()
   Solicita conversión de temperatura
   Bloqueante según resolución (hasta 750ms)
   
+ds.setWaitForConversion(false)
+  requestTemperatures() vuelve enseguida (el tiempo lo controla el programa)
+  
+ds.millisToWaitForConversion(bits)
+  Tiempo de conversión en ms para una resolución (94 a 750)
+  
 ds.getTempCByIndex(index)
   Obtiene temperatura en Celsius
   index: 0 para primer sensor
@@ -124,6 +150,19 @@ ds.getDeviceCount()
 ds.setResolution(bits)
   Configura resolución (9-12 bits)
 
+--- LECTURA SIN BLOQUEAR (DOS FASES) ---
+
+Con delay() el ESP32 queda 1 segundo sin hacer nada mientras el sensor
+convierte. Este ejemplo divide la lectura en dos fases con millis():
+
+  Fase 1: ds.requestTemperatures()      → envía CONVERT T, vuelve enseguida
+          inicioConversion = millis()
+  Fase 2: millis() - inicioConversion >= TIEMPO_CONVERSION_MS
+          t = ds.getTempCByIndex(0)     → lee el resultado (scratchpad)
+
+Entre las dos fases loop() sigue ejecutándose: se pueden atender
+botones, actualizar un display o un servidor web al mismo tiempo.
+
 --- EJEMPLO PRÁCTICO ---
 
 Múltiples sensores en mismo bus:
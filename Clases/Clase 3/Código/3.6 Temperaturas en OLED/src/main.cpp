@@ -31,6 +31,7 @@
 #include <esp_adc_cal.h>
 
 #include <math.h>
+#include "punto_fijo.h"
 
 // Configuración de pines
 #define PIN_NTC_ADC   1    // Pin ADC para NTC
@@ -44,9 +45,39 @@ DallasTemperature ds(&oneWire);
 
 const float VREF = 3.3, R_FIXED = 10000, R0 = 10000, PT0 = 298.15, BETA = 3950;
 
+// Filtro EMA del NTC (α = 0.2)
+#ifdef PUNTO_FIJO
+// Camino solo con enteros (ESP32-C3 sin FPU): ver punto_fijo.h
+const Q16 ALFA_EMA = Q16::desdeFraccion(1, 5);
+// Las mismas constantes del NTC en enteros (mV, Ω, K) para ntcCelsiusFijo()
+const uint32_t VREF_MV = VREF * 1000 + 0.5f, R_FIXED_OHM = R_FIXED, R0_OHM = R0, BETA_K = BETA;
+Q16 ntcFiltrada;
+DeviceAddress direccionDS;          // getTemp() entrega 1/128 °C en un entero
+#else
+float ntcFiltrada = NAN;
+#endif
+bool hayNtc = false;                // false hasta la primera lectura válida
+
 // Para calibración eFuse
 esp_adc_cal_characteristics_t adc_chars;
 
+// Tiempos (sin delay: el loop nunca se detiene)
+#define TIEMPO_CONVERSION_MS  1000  // DS18B20 12 bits: 750 ms + margen modo parásito
+#define INTERVALO_OLED_MS     500   // Refresco de pantalla y lectura del NTC
+
+// Lectura del DS18B20 en dos fases
+bool convirtiendo = false;
+uint32_t inicioConversion = 0;
+#ifdef PUNTO_FIJO
+Q16 Td;                             // Última temperatura DS18B20
+#else
+float Td;
+#endif
+bool hayTd = false;                 // false = primera conversión en curso
+bool tdValida = false;              // false = sensor desconectado (CRC o sin respuesta)
+
+uint32_t ultimoRefresco = 0;
+
 void setup() {
     // ESP32-C3 SDA = GPIO8, SCL = GPIO9 (mismo que 3.5 OLED)
     Wire.begin(8, 9);
@@ -55,26 +86,81 @@ void setup() {
 
     // Calibrar ADC con valores eFuse de fábrica (compensa variaciones individuales)
     esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_12, ADC_WIDTH_BIT_12, 1100, &adc_chars);
+
+    // Control manual del tiempo para modo parásito
+    ds.setWaitForConversion(false);
+#ifdef PUNTO_FIJO
+    ds.getAddress(direccionDS, 0);
+#endif
 }
 
-void loop() {
-    // Leer NTC
+#ifdef PUNTO_FIJO
+// NTC → EMA → texto, solo con enteros
+void leerNTC(char *texto, size_t size) {
+    int raw = analogRead(PIN_NTC_ADC);
+    uint32_t voltage_mv = esp_adc_cal_raw_to_voltage(raw, &adc_chars);
+    Q16 Tc;
+    if (!ntcCelsiusFijo(voltage_mv, VREF_MV, R_FIXED_OHM, R0_OHM, BETA_K, Tc)) {
+        snprintf(texto, size, "ERR");
+        return;
+    }
+    ntcFiltrada = hayNtc ? ntcFiltrada + (Tc - ntcFiltrada) * ALFA_EMA : Tc;
+    hayNtc = true;
+    ntcFiltrada.formatear(texto, size, 1);
+}
+
+// Desconectado se revisa en crudo: DEVICE_DISCONNECTED_RAW (-7040) pasado
+// a Q16 sería un -55.0 °C creíble en la pantalla
+void leerDS18B20() {
+    int32_t raw = ds.getTemp(direccionDS);
+    tdValida = raw != DEVICE_DISCONNECTED_RAW;
+    if (tdValida) Td = Q16::desdeRaw(raw * 512);  // 1/128 °C → Q16 (2^16 / 2^7)
+    hayTd = true;
+}
+#else
+void leerNTC(char *texto, size_t size) {
     int raw = analogRead(PIN_NTC_ADC);
     uint32_t voltage_mv = esp_adc_cal_raw_to_voltage(raw, &adc_chars);
     float v = voltage_mv / 1000.0;
     float R = R_FIXED * v / (VREF - v);
     float Tc = (1 / (1 / PT0 + log(R / R0) / BETA)) - 273.15;
+    if (!isfinite(Tc)) {
+        snprintf(texto, size, "ERR");
+        return;
+    }
+    ntcFiltrada = hayNtc ? 0.2 * Tc + 0.8 * ntcFiltrada : Tc;
+    hayNtc = true;
+    snprintf(texto, size, "%.1f", ntcFiltrada);
+}
 
-    // Leer DS18B20
-
-    // Control manual del tiempo para modo parásito
-    ds.setWaitForConversion(false);
-    ds.requestTemperatures();
-
-    // Tiempo necesario para conversión en modo parásito
-    delay(1000);
+void leerDS18B20() {
+    Td = ds.getTempCByIndex(0);
+    tdValida = Td != DEVICE_DISCONNECTED_C;  // -127 °C
+    hayTd = true;
+}
+#endif
 
-    float Td = ds.getTempCByIndex(0);
+void loop() {
+    // DS18B20 fase 1: iniciar conversión y seguir sin esperar
+    if (!convirtiendo) {
+        ds.requestTemperatures();
+        inicioConversion = millis();
+        convirtiendo = true;
+    }
+
+    // DS18B20 fase 2: pasado el tiempo de conversión, leer el resultado
+    if (convirtiendo && millis() - inicioConversion >= TIEMPO_CONVERSION_MS) {
+        leerDS18B20();
+        convirtiendo = false;  // La próxima vuelta inicia otra conversión
+    }
+
+    // NTC y pantalla cada 500 ms, independiente de la conversión
+    if (millis() - ultimoRefresco < INTERVALO_OLED_MS) return;
+    ultimoRefresco = millis();
+
+    // Leer NTC (ya filtrado y formateado con 1 decimal)
+    char textoNtc[12];
+    leerNTC(textoNtc, sizeof(textoNtc));
 
     // Mostrar en OLED con U8G2
     u8g2.clearBuffer();
@@ -85,12 +171,24 @@ void loop() {
     // Mostrar temperaturas
     u8g2.setCursor(0, 15);
     u8g2.print("NTC:     ");
-    u8g2.print(Tc, 1);
+    u8g2.print(textoNtc);
     u8g2.print(" C");
     
     u8g2.setCursor(0, 30);
     u8g2.print("DS18B20: ");
-    u8g2.print(Td, 1);
+    if (!hayTd) {
+        u8g2.print("--.-");  // Primera conversión en curso
+    } else if (!tdValida) {
+        u8g2.print("ERR");   // Desconectado, igual en float y en Q16
+    } else {
+#ifdef PUNTO_FIJO
+        char textoDs[12];
+        Td.formatear(textoDs, sizeof(textoDs), 1);
+        u8g2.print(textoDs);
+#else
+        u8g2.print(Td, 1);
+#endif
+    }
     u8g2.print(" C");
     
     // Título UNSE al final
@@ -99,7 +197,6 @@ void loop() {
     u8g2.drawStr(xUnse, 60, "UNSE");
     
     u8g2.sendBuffer();
-    delay(500);
 }
 
 /*
@@ -130,15 +227,16 @@ VENTAJAS DE DUAL-SENSOR:
 
 --- ARQUITECTURA DEL SISTEMA ---
 
-Flujo de datos:
-  1. Leer NTC (ADC con calibración eFuse)
-  2. Convertir voltaje → resistencia → temperatura
-  3. Solicitar conversión DS18B20 (modo parásito)
-  4. Esperar 1 segundo (conversión 12-bit)
-  5. Leer temperatura DS18B20
-  6. Actualizar buffer OLED con ambas lecturas
-  7. Renderizar en pantalla
-  8. Esperar 500ms y repetir
+Flujo de datos (loop sin delay, dos tareas independientes):
+  DS18B20 (cada ~1 s):
+    1. Solicitar conversión (modo parásito) y seguir
+    2. Pasados 1000 ms, leer temperatura y guardarla en Td
+  NTC + OLED (cada 500 ms):
+    3. Leer NTC (ADC con calibración eFuse)
+    4. Convertir voltaje → resistencia → temperatura
+    5. Filtro EMA (α = 0.2) y texto con 1 decimal
+    6. Actualizar buffer OLED con Tc y la última Td
+    7. Renderizar en pantalla
 
 Configuración de pines (ESP32-C3):
   NTC:     GPIO 1  (ADC - Divisor de tensión)
@@ -165,17 +263,28 @@ Esto mejora la precisión del NTC de ±10% a ±2-3% sin calibración manual.
 
 El DS18B20 funciona en modo parásito (alimentado desde línea de datos):
 
-  ds.setWaitForConversion(false);  // Control manual
-  ds.requestTemperatures();         // Iniciar conversión
-  delay(1000);                      // Esperar conversión
-  float temp = ds.getTempCByIndex(0);
+  ds.setWaitForConversion(false);  // Control manual (en setup)
+
+  // Fase 1: iniciar conversión y seguir
+  ds.requestTemperatures();
+  inicioConversion = millis();
+
+  // Fase 2 (en una vuelta posterior del loop)
+  if (millis() - inicioConversion >= TIEMPO_CONVERSION_MS) {
+    Td = ds.getTempCByIndex(0);
+  }
+
+Con delay(1000) la pantalla y el NTC quedaban congelados 1 segundo
+en cada ciclo. Con las dos fases el OLED se refresca cada 500 ms
+mientras el DS18B20 convierte. Durante la conversión no se usa el
+bus 1-Wire (en modo parásito el sensor se alimenta de la línea).
 
 VENTAJAS modo parásito:
 - Solo 2 cables (datos + GND), sin VCC separado
 - Simplifica cableado en instalaciones
 
 CONSIDERACIONES:
-- Delay de 1000ms necesario para conversión 12-bit (750ms típico + margen)
+- Esperar 1000ms para conversión 12-bit (750ms típico + margen), sin delay()
 - Resistor pull-up 4.7kΩ necesario en línea de datos
 - Limitación de distancia (~10m máximo)
 
@@ -225,28 +334,54 @@ Alarma por discrepancia (>5°C):
     u8g2.drawStr(20, 8, "CHECK SENSORS");
   }
 
-Filtro EMA para suavizar NTC:
-  static float ema = 0;
-  if(ema == 0) ema = Tc;
-  ema = 0.2 * Tc + 0.8 * ema;
-
 Validación cruzada (detectar fallo):
   if(abs(Tc - Td) > 10.0) {
     if(Td == -127.0 || Td == 85.0) usar_NTC();
     if(Tc < -50 || Tc > 100) usar_DS18B20();
   }
 
+--- PUNTO FIJO (-D PUNTO_FIJO) ---
+
+El ESP32-C3 (RISC-V) no tiene FPU: cada operación en float es una
+llamada a una rutina que la emula con enteros, y log(), pow() o
+printf("%f") cuestan miles de instrucciones. El entorno esp32c3 compila
+con -D PUNTO_FIJO y todo el camino sensor → pantalla usa enteros Q16
+(src/punto_fijo.h: int32_t con 16 bits de decimales):
+
+  Etapa        │ float (ESP32)                │ Q16 (ESP32-C3)
+  ─────────────┼──────────────────────────────┼──────────────────────────────
+  NTC          │ log(R / R0)                  │ log2 bit a bit (ntcCelsiusFijo)
+  EMA          │ 0.2·Tc + 0.8·ema             │ ema + (Tc - ema)·α, α = 1/5
+  DS18B20      │ getTempCByIndex() (float)    │ getTemp() en 1/128 °C · 512
+  Texto        │ print(Tc, 1)                 │ formatear(buf, size, 1)
+
+  Q16 Tc;
+  if (ntcCelsiusFijo(voltage_mv, VREF_MV, R_FIXED_OHM, R0_OHM, BETA_K, Tc)) {
+    ntcFiltrada = ntcFiltrada + (Tc - ntcFiltrada) * ALFA_EMA;
+    ntcFiltrada.formatear(texto, sizeof(texto), 1);   // "23.4"
+  }
+
+El DS18B20 desconectado se detecta antes de convertir: getTemp()
+devuelve DEVICE_DISCONNECTED_RAW (-7040), que en Q16 sería -55.0 °C,
+una lectura posible. Con float o con Q16 la pantalla muestra "ERR".
+
+Precisión: la diferencia con el cálculo en double es < 0.001 °C, muy
+por debajo de la resolución del ADC. tools/bench_punto_fijo.cpp lo
+verifica en la PC y compara el costo de los tres caminos (float con
+FPU, float emulado y Q16):
+
+  g++ -O2 -std=gnu++11 -o bench_punto_fijo tools/bench_punto_fijo.cpp -lquadmath
+  ./bench_punto_fijo
+
 --- TIMING Y PERFORMANCE ---
 
-Ciclo completo: ~1.5 segundos
-  • Leer NTC: ~1ms
-  • Conversión DS18B20: 1000ms (modo parásito)
-  • Actualizar OLED: ~20ms
-  • Delay adicional: 500ms
+Tareas independientes (ninguna bloquea a la otra):
+  • NTC + OLED: cada 500ms (~1ms ADC + ~20ms OLED)
+  • DS18B20: una lectura nueva cada ~1s (conversión en segundo plano)
 
 --- NOTAS IMPORTANTES ---
 
-• DS18B20 modo parásito requiere pull-up 4.7kΩ y delay 1000ms
+• DS18B20 modo parásito requiere pull-up 4.7kΩ y 1000ms de conversión
 • NTC responde más rápido que DS18B20 por inercia térmica
 • OLED consume ~8mA durante actualización
 • Direcciones I2C típicas: 0x3C o 0x3D
@@ -255,9 +390,9 @@ Ciclo completo: ~1.5 segundos
 --- TROUBLESHOOTING ---
 
 OLED no muestra: Verificar dirección I2C y conexiones SDA/SCL
-DS18B20 lee -127°C: Sensor desconectado o sin pull-up 4.7kΩ
-DS18B20 lee 85°C: Conversión no completada, aumentar delay
-NTC erráticos: Añadir filtro EMA o verificar conexiones
+DS18B20 muestra ERR: Sensor desconectado o sin pull-up 4.7kΩ (-127°C)
+DS18B20 lee 85°C: Conversión no completada, aumentar TIEMPO_CONVERSION_MS
+NTC erráticos: Bajar α del filtro EMA o verificar conexiones
 Gran diferencia: Normal por inercia térmica, esperar 2 minutos
 
 ===============================================================================
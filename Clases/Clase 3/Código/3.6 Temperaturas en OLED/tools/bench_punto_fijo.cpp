@@ -0,0 +1,251 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Benchmark y verificación en la PC de src/punto_fijo.h (no se compila
+    con PlatformIO)
+
+        g++ -O2 -std=gnu++11 -o bench_punto_fijo tools/bench_punto_fijo.cpp -lquadmath
+        ./bench_punto_fijo
+
+    1. Error máximo del camino Q16 contra una referencia en double para
+       cada etapa: NTC (mV → °C), filtro EMA, gamma del LED y formateo
+       con 1 decimal. Devuelve 1 si alguna supera su tolerancia.
+    2. Instrucciones por operación (contador de la CPU vía perf, si el
+       sistema no lo permite ns por operación) de tres caminos:
+         - float:      con FPU, como en el ESP32 clásico
+         - float soft: __float128, emulado por software en la PC; sirve
+                       de referencia de lo que cuesta float sin FPU
+                       (ESP32-C3), donde cada operación es una llamada
+         - Q16:        solo enteros, el camino de -D PUNTO_FIJO
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <quadmath.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "../src/punto_fijo.h"
+
+static int fallas = 0;
+
+static void comprobar(bool ok, const char *etapa, const char *que) {
+    printf("  [%s] %-10s %s\n", ok ? " OK " : "FALLA", etapa, que);
+    if (!ok) fallas++;
+}
+
+// Mismos valores que el sketch
+static const uint32_t VREF_MV = 3300, R_FIXED = 10000, R0 = 10000, BETA = 3950;
+
+// ─── Los tres caminos de cada etapa ───
+
+// log() y pow() no existen para __float128: se usan los de libquadmath
+static __float128 log(__float128 x) { return logq(x); }
+static __float128 pow(__float128 x, __float128 y) { return powq(x, y); }
+
+template <typename T>
+static T ntcReal(uint32_t mv) {
+    T v = mv / (T)1000;
+    T R = (T)R_FIXED * v / ((T)VREF_MV / 1000 - v);
+    return 1 / (1 / (T)298.15 + log(R / (T)R0) / (T)BETA) - (T)273.15;
+}
+
+static Q16 ntcQ16(uint32_t mv) {
+    Q16 c;
+    ntcCelsiusFijo(mv, VREF_MV, R_FIXED, R0, BETA, c);
+    return c;
+}
+
+// Gamma del LED en 4.5 Dashboard: (brillo/100)^2.2 · 255, truncado
+template <typename T>
+static uint8_t gammaReal(uint8_t brillo) {
+    return (uint8_t)(int)(pow((T)brillo / 100, (T)2.2) * 255);
+}
+
+static uint8_t gammaQ16(uint8_t brillo) {
+    if (brillo == 0) return 0;
+    const Q16 GAMMA = Q16::desdeFraccion(22, 10);
+    return (powFijo(Q16::desdeFraccion(brillo, 100), GAMMA) * 255).raw >> 16;
+}
+
+// ─── 1. Verificación ───
+
+// Con un buffer sin lugar para "-12.3\0" no escribe nada
+static bool formatearBufferChico() {
+    char buf[8];
+    memset(buf, 'x', sizeof(buf));
+    size_t largo = Q16::desdeFraccion(-123, 10).formatear(buf, 5, 1);
+    return largo == 0 && buf[0] == 'x' && Q16::desdeFraccion(-123, 10).formatear(buf, 6, 1) == 5 &&
+           strcmp(buf, "-12.3") == 0;
+}
+
+static void verificar() {
+    printf("Error contra la referencia en double:\n");
+
+    // NTC en todo el rango válido (-50 a 150 °C)
+    double maxFloat = 0, maxQ16 = 0;
+    for (uint32_t mv = 100; mv <= VREF_MV - 100; mv++) {
+        double ref = ntcReal<double>(mv);
+        if (ref < -50 || ref > 150) continue;
+        Q16 c;
+        if (!ntcCelsiusFijo(mv, VREF_MV, R_FIXED, R0, BETA, c)) {
+            printf("    %u mV: Q16 rechaza una lectura válida (%.2f °C)\n", (unsigned)mv, ref);
+            maxQ16 = 1e9;
+            continue;
+        }
+        maxFloat = fmax(maxFloat, fabs(ntcReal<float>(mv) - ref));
+        maxQ16 = fmax(maxQ16, fabs(c.raw / 65536.0 - ref));
+    }
+    char texto[96];
+    snprintf(texto, sizeof(texto), "NTC: float %.4f °C, Q16 %.4f °C (tolerancia 0.01)", maxFloat, maxQ16);
+    comprobar(maxQ16 < 0.01, "NTC", texto);
+    Q16 c;
+    comprobar(!ntcCelsiusFijo(50, VREF_MV, R_FIXED, R0, BETA, c) &&
+              !ntcCelsiusFijo(VREF_MV - 50, VREF_MV, R_FIXED, R0, BETA, c),
+              "NTC", "rechaza lecturas fuera de rango");
+
+    // EMA α = 0.2 sobre un escalón de 20 a 30 °C con ruido
+    const Q16 ALFA = Q16::desdeFraccion(1, 5);
+    double ema = 20;
+    Q16 emaQ = Q16::desdeEntero(20);
+    double maxEma = 0;
+    srand(1);
+    for (int n = 0; n < 2000; n++) {
+        double x = (n < 100 ? 20 : 30) + (rand() % 201 - 100) / 100.0;
+        ema += 0.2 * (x - ema);
+        emaQ = emaQ + (Q16::desdeFloat(x) - emaQ) * ALFA;
+        maxEma = fmax(maxEma, fabs(emaQ.raw / 65536.0 - ema));
+    }
+    snprintf(texto, sizeof(texto), "EMA: Q16 %.5f °C tras 2000 muestras (tolerancia 0.001)", maxEma);
+    comprobar(maxEma < 0.001, "EMA", texto);
+
+    // Gamma: los 101 niveles de brillo
+    int distintos = 0, maxGamma = 0;
+    for (int b = 0; b <= 100; b++) {
+        int d = abs((int)gammaQ16(b) - (int)gammaReal<double>(b));
+        if (d) distintos++;
+        if (d > maxGamma) maxGamma = d;
+    }
+    snprintf(texto, sizeof(texto), "gamma: %d de 101 niveles difieren, máximo %d LSB (tolerancia 1)", distintos, maxGamma);
+    comprobar(maxGamma <= 1, "Gamma", texto);
+
+    // Formateo: mismo texto que printf("%.1f") salvo en los empates
+    // exactos (x.x5), donde printf redondea al par y formatear() hacia afuera
+    int difieren = 0;
+    for (int32_t raw = -50 * 65536; raw <= 150 * 65536; raw += 97) {
+        Q16 x = Q16::desdeRaw(raw);
+        if ((int64_t)raw * 10 % 65536 == 32768 || (int64_t)raw * 10 % 65536 == -32768) continue;
+        char a[16], b[16];
+        x.formatear(a, sizeof(a), 1);
+        snprintf(b, sizeof(b), "%.1f", raw / 65536.0);
+        if (strcmp(a, b) && strcmp(b, "-0.0")) {
+            if (difieren < 5) printf("    %.6f: \"%s\" (printf \"%s\")\n", raw / 65536.0, a, b);
+            difieren++;
+        }
+    }
+    comprobar(difieren == 0, "Formato", "formatear() coincide con printf(\"%.1f\") de -50 a 150");
+    comprobar(formatearBufferChico(), "Formato", "buffer chico: devuelve 0 sin escribir de más");
+}
+
+// ─── 2. Costo por operación ───
+
+// Contador de instrucciones de la CPU (Linux). Sin permiso, -1 y se usan ns
+static int contador = -1;
+
+static void abrirContador() {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    contador = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+static const uint32_t VECES = 200000;
+
+template <typename Funcion>
+static void medir(const char *nombre, Funcion f) {
+    volatile int32_t sumidero = 0;
+#ifdef __linux__
+    if (contador >= 0) {
+        ioctl(contador, PERF_EVENT_IOC_RESET, 0);
+        ioctl(contador, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    auto inicio = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < VECES; i++) sumidero = sumidero + f(i);
+    std::chrono::duration<double, std::nano> dt = std::chrono::steady_clock::now() - inicio;
+#ifdef __linux__
+    if (contador >= 0) {
+        ioctl(contador, PERF_EVENT_IOC_DISABLE, 0);
+        long long instrucciones = 0;
+        if (read(contador, &instrucciones, sizeof(instrucciones)) == sizeof(instrucciones)) {
+            printf("  %-22s %8.0f instrucciones/op  %8.1f ns/op\n", nombre, (double)instrucciones / VECES, dt.count() / VECES);
+            return;
+        }
+    }
+#endif
+    printf("  %-22s %8.1f ns/op\n", nombre, dt.count() / VECES);
+}
+
+static void benchmark() {
+    abrirContador();
+    printf("\nCosto por operación (%u operaciones, %s):\n", (unsigned)VECES,
+           contador >= 0 ? "contador de instrucciones" : "sin acceso al contador, solo ns");
+
+    // Lecturas entre 500 y 2800 mV (≈ -10 a 90 °C)
+    medir("NTC float", [](uint32_t i) { return (int32_t)ntcReal<float>(500 + i % 2300); });
+    medir("NTC float soft", [](uint32_t i) { return (int32_t)ntcReal<__float128>(500 + i % 2300); });
+    medir("NTC Q16", [](uint32_t i) { return ntcQ16(500 + i % 2300).raw; });
+
+    static float ema = 0;
+    static __float128 emaSoft = 0;
+    static Q16 emaQ;
+    const Q16 ALFA = Q16::desdeFraccion(1, 5);
+    medir("EMA float", [](uint32_t i) { ema = 0.2f * (float)(i & 63) + 0.8f * ema; return (int32_t)ema; });
+    medir("EMA float soft", [](uint32_t i) {
+        emaSoft = (__float128)0.2 * (__float128)(i & 63) + (__float128)0.8 * emaSoft;
+        return (int32_t)emaSoft;
+    });
+    medir("EMA Q16", [&ALFA](uint32_t i) { emaQ = emaQ + (Q16::desdeEntero(i & 63) - emaQ) * ALFA; return emaQ.raw; });
+
+    medir("Gamma float", [](uint32_t i) { return (int32_t)gammaReal<float>(1 + i % 100); });
+    medir("Gamma float soft", [](uint32_t i) { return (int32_t)gammaReal<__float128>(1 + i % 100); });
+    medir("Gamma Q16", [](uint32_t i) { return (int32_t)gammaQ16(1 + i % 100); });
+
+    // printf("%f") en el ESP32-C3 también opera en software
+    medir("Formato printf %.1f", [](uint32_t i) {
+        char t[16];
+        return (int32_t)snprintf(t, sizeof(t), "%.1f", (float)(i % 2000) / 10);
+    });
+    medir("Formato Q16", [](uint32_t i) {
+        char t[16];
+        return (int32_t)Q16::desdeRaw((int32_t)(i % 2000) * 6554).formatear(t, sizeof(t), 1);
+    });
+}
+
+int main() {
+    verificar();
+    benchmark();
+    printf("\n%s\n", fallas ? "FALLA: revisar las comprobaciones marcadas" : "OK: el camino Q16 está dentro de las tolerancias");
+    return fallas ? 1 : 0;
+}
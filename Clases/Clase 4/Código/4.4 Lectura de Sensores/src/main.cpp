@@ -24,7 +24,11 @@
 #include <OneWire.h>
 #include <DallasTemperature.h>
 #include <esp_adc_cal.h>
+#include <Preferences.h>
 #include <math.h>
+#include "ntc_lut.h"
+#include "sondas_ds18b20.h"
+#include "resolucion_ds18b20.h"
 
 // Configuración WiFi - COMPLETAR CON TUS CREDENCIALES
 const char *ssid = "TU_NOMBRE_DE_RED";
@@ -44,6 +48,10 @@ const float BETA = 3950;      // Coeficiente Beta del NTC
 // Calibración ADC eFuse
 esp_adc_cal_characteristics_t adc_chars;
 
+// Tabla código ADC → centésimas de °C, armada en setup(). Con
+// -D NTC_LUT_SHIFT=1 o 2 ocupa la mitad o un cuarto (interpolada)
+NtcLut<NTC_LUT_SHIFT> ntcLut;
+
 // Configuración según el modelo
 #ifdef ESP32C3
 const int NTC_PIN = 1;        // ESP32-C3: GPIO1 (ADC1_CH0) - Compatible con WiFi
@@ -57,9 +65,34 @@ const int DS18B20_PIN = 4;    // ESP32 DevKit: GPIO4
 OneWire oneWire(DS18B20_PIN);
 DallasTemperature sensorDS(&oneWire);
 
+// Varias sondas DS18B20 en el mismo bus: las ROM se buscan una sola vez
+// (y se guardan en flash, con su orden) para leer cada sonda por su dirección.
+// Lectura en dos fases: ver src/sondas_ds18b20.h
+SondasDS18B20<DallasTemperature> sondas(sensorDS);
+Preferences prefs;                      // NVS: ROM y su orden entre reinicios
+
 // Variables para almacenar temperaturas
 float temperaturaNTC = 0.0;
-float temperaturaDS18B20 = 0.0;
+float temperaturaDS18B20 = 0.0;         // Primera sonda (compatibilidad)
+
+// Snapshot de todos los sensores con una sola marca de tiempo
+struct SensorSnapshot {
+    uint32_t seq;        // Número de secuencia (+1 en cada lectura completa)
+    uint32_t timestamp;  // millis() al completar la lectura
+    float ntc;           // -999.0 si hay error
+    float ds18b20;       // -999.0 si hay error
+    uint8_t numSondas;
+    float sondas[MAX_SONDAS];  // Mismo orden que sondas.roms[]
+    uint8_t resolucion;  // Bits del DS18B20 (9-12)
+    float muestrasHz;    // Lecturas completas por segundo (medidas)
+    float ruido;         // Piso de ruido de cuantización en °C
+};
+
+// Doble buffer: la lectura en curso se arma en el buffer inactivo y recién
+// al terminar se publica cambiando el índice. /api/snapshot siempre lee el
+// último snapshot completo, nunca uno a medio actualizar
+SensorSnapshot snapshots[2] = {};
+uint8_t snapshotActivo = 0;
 
 // Control de tiempo para mensajes de estado periódicos
 uint32_t previousStatusMillis = 0;
@@ -67,55 +100,78 @@ const uint32_t statusInterval = 3000; // 3 segundos
 
 // Control de tiempo para lectura de sensores
 uint32_t previousSensorMillis = 0;
-const uint32_t sensorInterval = 2000; // 2 segundos
+uint32_t sensorInterval = 2000; // 2 segundos (ajustable con /api/muestreo)
+
+// Control adaptativo de la resolución del DS18B20 (src/resolucion_ds18b20.h)
+ResolucionAdaptativa resolucion;
 
-// Función para leer temperatura del NTC
+// Función para leer temperatura del NTC: un acceso a la tabla precalculada
+// (calibración eFuse + Steinhart-Hart ya resueltos para cada código del ADC)
 float leerNTC() {
     int raw = analogRead(NTC_PIN);
-    
-    // Convertir ADC a voltaje calibrado con eFuse
-    uint32_t voltage_mv = esp_adc_cal_raw_to_voltage(raw, &adc_chars);
-    float v = voltage_mv / 1000.0;
-    
-    // Validar lectura
-    if (v < 0.1 || v > (VREF - 0.1)) {
-        Serial.printf("Advertencia NTC: voltaje fuera de rango (%.3fV, ADC=%d)\n", v, raw);
-        return -999.0; // Valor de error
-    }
-    
-    // Calcular resistencia del NTC
-    float R = R_FIXED * v / (VREF - v);
-    
-    // Validar resistencia calculada
-    if (R < 100 || R > 1000000) {
-        Serial.printf("Advertencia NTC: resistencia fuera de rango (%.2f ohms)\n", R);
+    int16_t centigrados = ntcLut.centigrados(raw);
+
+    // Validar lectura (voltaje, resistencia o temperatura fuera de rango)
+    if (centigrados == NTC_LUT_ERROR) {
+        Serial.printf("Advertencia NTC: lectura fuera de rango (ADC=%d)\n", raw);
         return -999.0; // Valor de error
     }
-    
-    // Ecuación de Steinhart-Hart simplificada (Beta)
-    float Tc = (1 / (1 / CT0 + log(R / R0) / BETA)) - 273.15;
-    
-    // Validar temperatura resultante
-    if (Tc < -50 || Tc > 150) {
-        Serial.printf("Advertencia NTC: temperatura fuera de rango (%.2f°C)\n", Tc);
-        return -999.0; // Valor de error
+
+    return centigrados / 100.0;
+}
+
+// Fase 1: un solo CONVERT T para todas las sondas (SKIP ROM) y volver
+// enseguida. Todas convierten a la vez mientras loop() atiende el servidor
+void iniciarConversionDS18B20() {
+    sondas.iniciarConversion(resolucion.bits(), millis());
+}
+
+// Fase 2: se llama en cada vuelta de loop(). Pasado el tiempo de conversión
+// lee UNA sonda por vuelta (MATCH ROM + READ SCRATCHPAD) para no frenar el
+// servidor. Devuelve true cuando se leyeron todas
+bool leerDS18B20() {
+    if (!sondas.leer(millis())) return false;
+
+    // -127 (sin respuesta o CRC inválido) y 85 (sin convertir) ya vienen como error
+    for (uint8_t i = 0; i < sondas.cantidad; i++) {
+        if (sondas.temperaturas[i] != DS18B20_ERROR) continue;
+        char rom[17];
+        romATexto(sondas.roms[i], rom);
+        Serial.printf("Advertencia DS18B20 %s: sensor no responde o error de CRC\n", rom);
     }
-    
-    return Tc;
+    temperaturaDS18B20 = sondas.cantidad > 0 ? sondas.temperaturas[0] : -999.0;
+    return true;
 }
 
-// Función para leer temperatura del DS18B20
-float leerDS18B20() {
-    sensorDS.requestTemperatures();
-    float temp = sensorDS.getTempCByIndex(0);
-    
-    // Validar lectura (-127°C indica error del sensor)
-    if (temp == -127.0 || temp == 85.0) {
-        Serial.println("Advertencia DS18B20: sensor no detectado o error de lectura");
-        return -999.0; // Valor de error
+// Se llama al completar cada lectura: mide el período real y la velocidad
+// de cambio, y decide la resolución para la próxima conversión
+void ajustarResolucion() {
+    uint8_t anterior = resolucion.bits();
+    uint8_t nueva = resolucion.ajustar(sondas.temperaturas, sondas.cantidad, millis(), sensorInterval);
+
+    if (nueva != anterior) {
+        // Se escribe en el scratchpad de cada sonda por su ROM (sin conversión
+        // en curso ni SEARCH ROM). setAutoSaveScratchPad(false) evita gastar
+        // la EEPROM
+        sondas.fijarResolucion(nueva);
+        Serial.printf("DS18B20: resolución %d -> %d bits (%.3f °C/s)\n", anterior, nueva, resolucion.velocidad());
     }
-    
-    return temp;
+}
+
+// Arma el snapshot en el buffer inactivo y lo publica
+void publicarSnapshot(float ntc, float ds18b20) {
+    uint8_t siguiente = snapshotActivo ^ 1;
+    SensorSnapshot &snap = snapshots[siguiente];
+    snap.seq = snapshots[snapshotActivo].seq + 1;
+    snap.timestamp = millis();
+    snap.ntc = ntc;
+    snap.ds18b20 = ds18b20;
+    snap.numSondas = sondas.cantidad;
+    memcpy(snap.sondas, sondas.temperaturas, sizeof(snap.sondas));
+    snap.resolucion = resolucion.bits();
+    snap.muestrasHz = 1000.0 / resolucion.periodoMs();
+    snap.ruido = ruidoCuantizacion(resolucion.bits());
+    snapshotActivo = siguiente;  // Publicar: a partir de acá lo ven los handlers
 }
 
 // Función para servir la página principal
@@ -147,14 +203,20 @@ void handleRoot() {
     }
     html += "</div>";
 
-    // Mostrar DS18B20
+    // Mostrar DS18B20 (una línea por sonda)
     html += "<div class='sensor'>";
     html += "Sensor DS18B20 (Digital):<br>";
-    if (temperaturaDS18B20 > -900) {
-        html += "<span class='temp'>" + String(temperaturaDS18B20, 1) + " &deg;C</span>";
-    } else {
+    if (sondas.cantidad == 0) {
         html += "<span class='error'>ERROR - Sensor no conectado</span>";
     }
+    for (uint8_t i = 0; i < sondas.cantidad; i++) {
+        if (i > 0) html += "<br>";
+        if (sondas.temperaturas[i] > -900) {
+            html += "<span class='temp'>" + String(sondas.temperaturas[i], 1) + " &deg;C</span>";
+        } else {
+            html += "<span class='error'>ERROR - Sonda " + String(i) + " sin respuesta</span>";
+        }
+    }
     html += "</div>";
 
     html += "<hr>";
@@ -162,7 +224,8 @@ void handleRoot() {
     html += "<p>GET <a href='/'>/ - Esta pagina</a><br>";
     html += "GET <a href='/temperaturas'>/temperaturas - Ver todas las temperaturas</a><br>";
     html += "GET <a href='/ntc'>/ntc - Solo temperatura NTC</a><br>";
-    html += "GET <a href='/ds18b20'>/ds18b20 - Solo temperatura DS18B20</a></p>";
+    html += "GET <a href='/ds18b20'>/ds18b20 - Solo temperatura DS18B20</a><br>";
+    html += "GET <a href='/api/snapshot'>/api/snapshot - Todos los sensores (JSON)</a></p>";
 
     html += "</body>";
     html += "</html>";
@@ -207,18 +270,100 @@ void handleNTC() {
     Serial.println("Temperatura NTC consultada via GET");
 }
 
-// GET: Consultar solo temperatura DS18B20
+// GET: Consultar solo temperatura DS18B20 (todas las sondas del bus)
 void handleDS18B20() {
     String mensaje;
-    if (temperaturaDS18B20 > -900) {
-        mensaje = "Temperatura DS18B20: " + String(temperaturaDS18B20, 2) + " C";
-    } else {
+    if (sondas.cantidad == 0) {
         mensaje = "Temperatura DS18B20: ERROR - Sensor no conectado o fuera de rango";
     }
+    for (uint8_t i = 0; i < sondas.cantidad; i++) {
+        char rom[17];
+        romATexto(sondas.roms[i], rom);
+        mensaje += "Temperatura DS18B20 [" + String(rom) + "]: ";
+        if (sondas.temperaturas[i] > -900) {
+            mensaje += String(sondas.temperaturas[i], 2) + " C\n";
+        } else {
+            mensaje += "ERROR - Sin respuesta o error de CRC\n";
+        }
+    }
     server.send(200, "text/plain", mensaje);
     Serial.println("Temperatura DS18B20 consultada via GET");
 }
 
+// Escribe una temperatura con 2 decimales, o null si hubo error
+void formatearTemperatura(char *buf, size_t size, float temp) {
+    if (temp > -900) {
+        snprintf(buf, size, "%.2f", temp);
+    } else {
+        snprintf(buf, size, "null");
+    }
+}
+
+// GET: Todos los sensores en una sola respuesta JSON compacta
+// {"seq":42,"timestamp":84000,"ntc":23.45,"ds18b20":23.82,
+//  "resolucion":12,"muestras_hz":0.50,"ruido":0.018,
+//  "sondas":[{"rom":"28FF641E0F16034C","temp":23.82}, ...]}
+void handleSnapshot() {
+    const SensorSnapshot &snap = snapshots[snapshotActivo];
+
+    char ntc[12], ds18b20[12];
+    formatearTemperatura(ntc, sizeof(ntc), snap.ntc);
+    formatearTemperatura(ds18b20, sizeof(ds18b20), snap.ds18b20);
+
+    // ~150 bytes de cabecera + ~40 por sonda. snprintf() devuelve lo que
+    // habría escrito: si no entra, len pasaría el final del buffer
+    char json[160 + MAX_SONDAS * 48];
+    int len = snprintf(json, sizeof(json),
+                       "{\"seq\":%u,\"timestamp\":%u,\"ntc\":%s,\"ds18b20\":%s,"
+                       "\"resolucion\":%u,\"muestras_hz\":%.2f,\"ruido\":%.3f,\"sondas\":[",
+                       (unsigned)snap.seq, (unsigned)snap.timestamp, ntc, ds18b20,
+                       snap.resolucion, snap.muestrasHz, snap.ruido);
+    bool entra = len >= 0 && len < (int)sizeof(json);
+    for (uint8_t i = 0; entra && i < snap.numSondas; i++) {
+        char rom[17], temp[12];
+        romATexto(sondas.roms[i], rom);
+        formatearTemperatura(temp, sizeof(temp), snap.sondas[i]);
+        int n = snprintf(json + len, sizeof(json) - len, "%s{\"rom\":\"%s\",\"temp\":%s}",
+                         i > 0 ? "," : "", rom, temp);
+        entra = n >= 0 && n < (int)sizeof(json) - len;
+        if (entra) len += n;
+    }
+    if (entra) {
+        int n = snprintf(json + len, sizeof(json) - len, "]}");
+        entra = n >= 0 && n < (int)sizeof(json) - len;
+    }
+    if (!entra) {  // JSON cortado: mejor un error que una respuesta inválida
+        server.send(500, "text/plain", "Snapshot demasiado grande");
+        Serial.println("Error: el snapshot no entra en el buffer");
+        return;
+    }
+    server.send(200, "application/json", json);
+    Serial.println("Snapshot consultado via GET");
+}
+
+// GET: Consultar o pedir una tasa de muestreo. Con ?intervalo_ms=200 el
+// DS18B20 baja a la resolución cuya conversión entra en 200 ms (10 bits)
+void handleMuestreo() {
+    if (server.hasArg("intervalo_ms")) {
+        long intervalo = server.arg("intervalo_ms").toInt();
+        sensorInterval = constrain(intervalo, 100, 60000);
+        uint8_t maxima = resolucionMaxima(sensorInterval);
+        if (resolucion.bits() > maxima && !sondas.convirtiendo()) {
+            resolucion.fijar(maxima);
+            sondas.fijarResolucion(maxima);
+        }
+        Serial.printf("Muestreo pedido: cada %u ms\n", (unsigned)sensorInterval);
+    }
+
+    char json[160];
+    snprintf(json, sizeof(json),
+             "{\"intervalo_ms\":%u,\"resolucion\":%u,\"resolucion_max\":%u,"
+             "\"conversion_ms\":%u,\"muestras_hz\":%.2f,\"ruido\":%.3f}",
+             (unsigned)sensorInterval, resolucion.bits(), resolucionMaxima(sensorInterval),
+             (unsigned)sensorDS.millisToWaitForConversion(resolucion.bits()),
+             1000.0 / resolucion.periodoMs(), ruidoCuantizacion(resolucion.bits()));
+    server.send(200, "application/json", json);
+}
 
 // Función para páginas no encontradas (404)
 void handleNotFound() {
@@ -241,6 +386,14 @@ void setup() {
     esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100, &adc_chars);
     Serial.println("ADC calibrado con valores eFuse");
 
+    // Precalcular la temperatura de los 4096 códigos del ADC
+    uint32_t inicioTabla = millis();
+    NtcParams ntcParams = {VREF, R_FIXED, R0, CT0, BETA};
+    ntcLut.build(ntcParams, [](uint16_t raw) {
+        return (float)esp_adc_cal_raw_to_voltage(raw, &adc_chars);
+    });
+    Serial.printf("Tabla NTC: %u bytes en %u ms\n", (unsigned)ntcLut.bytes(), (unsigned)(millis() - inicioTabla));
+
     // Configurar pin NTC
     pinMode(NTC_PIN, INPUT);
     Serial.printf("Sensor NTC configurado en pin %d\n", NTC_PIN);
@@ -259,10 +412,41 @@ void setup() {
     int numSensores = sensorDS.getDeviceCount();
     Serial.printf("  - Sensores DS18B20 detectados: %d\n", numSensores);
 
+    // begin() ya recorrió el bus para contarlas. ROM de las sondas: de la
+    // flash si siguen siendo las mismas, si no
+    // se busca en el bus y se guarda (el orden de las sondas se mantiene
+    // entre reinicios mientras no cambie el cableado)
+    if (sondas.cargarGuardadas(prefs)) {
+        Serial.printf("  - ROM de %d sondas cargadas de la flash\n", sondas.cantidad);
+    } else {
+        sondas.buscar(oneWire);
+        sondas.guardar(prefs);
+        Serial.printf("  - Bus recorrido: %d sondas guardadas en la flash\n", sondas.cantidad);
+    }
+    for (uint8_t i = 0; i < sondas.cantidad; i++) {
+        char rom[17];
+        romATexto(sondas.roms[i], rom);
+        Serial.printf("    [%d] %s\n", i, rom);
+    }
+
+    // requestTemperatures() no espera la conversión: el tiempo lo controla
+    // loop() con millis() (ver leerDS18B20)
+    sensorDS.setWaitForConversion(false);
+
+    // La resolución cambia seguido: escribir solo el scratchpad (RAM), no
+    // la EEPROM del sensor (vida útil limitada de escrituras)
+    sensorDS.setAutoSaveScratchPad(false);
+    resolucion.fijar(sensorDS.getResolution());
+    Serial.printf("  - Resolución inicial: %d bits\n", resolucion.bits());
+
     // Realizar primera lectura de sensores
     Serial.println("\n--- Primera lectura de sensores ---");
     temperaturaNTC = leerNTC();
-    temperaturaDS18B20 = leerDS18B20();
+    iniciarConversionDS18B20();
+    delay(sondas.tiempoConversion());  // En setup() todavía no hay servidor que atender
+    while (!leerDS18B20()) {}
+    ajustarResolucion();  // Primera lectura: punto de partida de la velocidad
+    publicarSnapshot(temperaturaNTC, temperaturaDS18B20);
     
     if (temperaturaNTC > -900) {
         Serial.printf("✓ NTC: %.2f°C\n", temperaturaNTC);
@@ -307,6 +491,8 @@ void setup() {
     server.on("/temperaturas", handleTemperaturas);  // GET: Todas las temperaturas
     server.on("/ntc", handleNTC);                    // GET: Solo NTC
     server.on("/ds18b20", handleDS18B20);            // GET: Solo DS18B20
+    server.on("/api/snapshot", handleSnapshot);      // GET: Todos los sensores (JSON)
+    server.on("/api/muestreo", handleMuestreo);      // GET: Resolución / tasa de muestreo
     server.onNotFound(handleNotFound);
 
     // Iniciar servidor
@@ -316,6 +502,7 @@ void setup() {
     Serial.println("Todas las temperaturas");
     Serial.println("Solo temperatura NTC");
     Serial.println("Solo temperatura DS18B20");
+    Serial.println("Snapshot JSON de todos los sensores");
     Serial.println();
 }
 
@@ -323,14 +510,21 @@ void loop() {
     // Manejar peticiones del servidor web
     server.handleClient();
 
-    // Leer sensores periódicamente
+    // Leer sensores periódicamente: el NTC se lee al instante y el DS18B20
+    // solo recibe la orden de convertir
     uint32_t currentMillis = millis();
-    if (currentMillis - previousSensorMillis >= sensorInterval) {
+    // Si la temperatura cambia rápido se encadenan conversiones sin esperar
+    bool toca = resolucion.siguiendoCambio() || currentMillis - previousSensorMillis >= sensorInterval;
+    if (toca && !sondas.convirtiendo()) {
         previousSensorMillis = currentMillis;
-        
-        // Actualizar temperaturas
         temperaturaNTC = leerNTC();
-        temperaturaDS18B20 = leerDS18B20();
+        iniciarConversionDS18B20();
+    }
+
+    // Cuando termina la conversión del DS18B20 se publica la lectura completa
+    if (leerDS18B20()) {
+        ajustarResolucion();
+        publicarSnapshot(temperaturaNTC, temperaturaDS18B20);
         
         // Mostrar en serial
         Serial.print("Sensores - ");
@@ -404,11 +598,14 @@ AUTO-REFRESH:
   GET  /              → Página web con interfaz visual (auto-refresh cada 5s)
   GET  /temperaturas  → Todas las temperaturas (texto plano)
   GET  /ntc           → Solo temperatura del NTC (texto plano)
-  GET  /ds18b20       → Solo temperatura del DS18B20 (texto plano)
+  GET  /ds18b20       → Temperatura de cada sonda DS18B20 (texto plano)
+  GET  /api/snapshot  → Todos los sensores en JSON (una sola consulta)
+  GET  /api/muestreo  → Resolución y tasa de muestreo (?intervalo_ms=N)
 
 --- CÓMO FUNCIONA ---
 
-1. El ESP32 lee los sensores cada 2 segundos en el loop()
+1. El ESP32 lee los sensores cada 2 segundos en el loop() sin bloquearlo
+   (el DS18B20 convierte mientras se atienden peticiones)
 2. Almacena las últimas lecturas en variables globales
 3. Valida cada lectura y detecta errores (retorna -999.0 si hay error)
 4. El servidor web sirve estas lecturas cuando se solicitan
@@ -416,6 +613,149 @@ AUTO-REFRESH:
 6. La página se auto-actualiza cada 5 segundos
 7. Los endpoints de texto plano permiten consultas directas con links
 
+--- SNAPSHOT DE SENSORES (/api/snapshot) ---
+
+Un cliente que quiere todas las lecturas (por ejemplo un gráfico o un
+script que registra datos) tendría que consultar /ntc y /ds18b20 por
+separado: dos peticiones y valores de momentos distintos. /api/snapshot
+devuelve todo junto con una sola marca de tiempo:
+
+  {"seq":42,"timestamp":84000,"ntc":23.45,"ds18b20":23.82}
+
+  seq        → Número de lectura. Si no cambió entre dos consultas, el
+               cliente ya tiene ese dato (y si salta, se perdió alguna)
+  timestamp  → millis() del ESP32 al completar la lectura
+  ntc/ds18b20 → °C con 2 decimales, o null si el sensor dio error
+  sondas     → Tabla con la ROM y temperatura de cada DS18B20 del bus
+
+DOBLE BUFFER:
+  SensorSnapshot snapshots[2];
+  uint8_t snapshotActivo;    // Índice del último snapshot completo
+
+  La lectura nueva se escribe en snapshots[snapshotActivo ^ 1] y solo al
+  final se cambia snapshotActivo. El handler lee snapshots[snapshotActivo]:
+  nunca espera una conversión en curso ni ve valores mezclados de dos
+  lecturas distintas.
+
+--- LECTURA NO BLOQUEANTE DEL DS18B20 ---
+
+Con la configuración por defecto, sensorDS.requestTemperatures() envía
+CONVERT T y ESPERA a que termine la conversión: hasta 750 ms a 12 bits.
+Durante ese tiempo server.handleClient() no se ejecuta y cualquier
+petición queda esperando.
+
+La lectura se divide en dos fases controladas con millis()
+(src/sondas_ds18b20.h, llamada desde iniciarConversionDS18B20() y
+leerDS18B20()):
+
+  sensorDS.setWaitForConversion(false);          // En setup()
+
+  // Fase 1 (cada sensorInterval): sondas.iniciarConversion()
+  sensorDS.requestTemperatures();                // Envía CONVERT T y vuelve
+  tiempoConversion = sensorDS.millisToWaitForConversion(resolución);
+
+  // Fase 2 (en cada loop): sondas.leer(), una sonda por llamada
+  if (millis() - inicio >= tiempoConversion) {
+      temp = sensorDS.getTempC(roms[i]);         // MATCH ROM + scratchpad
+      if (temp == -127 || temp == 85) temp = -999.0;  // Error o sin convertir
+  }
+
+Tiempo de conversión según resolución:
+  9 bits: 94 ms | 10 bits: 188 ms | 11 bits: 375 ms | 12 bits: 750 ms
+
+Mientras el sensor convierte, loop() sigue atendiendo el servidor. Al
+terminar la fase 2 se publica el snapshot con ambas temperaturas.
+
+tools/sim_ds18b20.cpp prueba las dos fases en la PC contra sondas
+simuladas que tardan lo que dice la hoja de datos en convertir,
+responden 85 °C si se las lee antes y pueden desconectarse o
+devolver un scratchpad con el CRC inválido.
+
+--- VARIAS SONDAS DS18B20 EN EL MISMO BUS ---
+
+getTempCByIndex(i) es cómodo pero lento: cada llamada vuelve a
+recorrer el bus (SEARCH ROM) para encontrar el sensor número i, y
+con requestTemperatures() bloqueante cada sonda suma su espera.
+
+Este programa:
+  1. En setup() obtiene la ROM (64 bits) de cada sonda UNA sola vez:
+     - Si hay ROM guardadas en la flash (Preferences, NVS) y siguen
+       respondiendo las mismas sondas, las usa
+     - Si no, recorre el bus con oneWire.search() (verificando el CRC
+       de cada ROM) y las guarda
+     La cantidad se compara con getDS18Count(), no con getDeviceCount():
+     otro dispositivo 1-Wire en el bus (una memoria, un DS2401) no es
+     una sonda y no debe forzar una búsqueda en cada arranque
+     sensorDS.begin() recorre el bus igual en cada arranque (así cuenta
+     los dispositivos): la NVS ahorra la segunda búsqueda, la de
+     buscar(), y sobre todo mantiene el orden de las sondas entre
+     reinicios aunque cambie su lugar en el cable
+  2. Fase 1: un solo comando para todas las sondas
+       SKIP ROM (0xCC) + CONVERT T (0x44)   → requestTemperatures()
+     Todas convierten en paralelo: 750 ms en total, no N × 750 ms
+  3. Fase 2: lee cada sonda por su ROM, una por vuelta de loop()
+       MATCH ROM (0x55) + ROM + READ SCRATCHPAD (0xBE)
+                                            → getTempC(sondas.roms[i])
+     getTempC() verifica el CRC de los 9 bytes del scratchpad; si hay
+     error de transmisión devuelve -127 y se marca la sonda con error
+
+La tabla completa (ROM + temperatura) se publica en /api/snapshot y
+en /ds18b20. Hasta MAX_SONDAS (8) sondas por bus.
+
+Si se cambia una sonda, la cantidad o las ROM ya no coinciden con
+las guardadas y se vuelve a recorrer el bus automáticamente.
+
+tools/sim_ds18b20.cpp arma un bus simulado con varias sondas y prueba
+el arranque con la NVS vacía y con las mismas sondas, una ROM leída
+con error de CRC, una sonda reemplazada, agregada o cambiada de lugar,
+otro dispositivo 1-Wire en el bus, más de MAX_SONDAS sondas y una NVS
+con datos incompletos.
+
+--- RESOLUCIÓN ADAPTATIVA DEL DS18B20 ---
+
+La resolución define a la vez la precisión y el tiempo de conversión
+(ver tabla en 3.4 Lectura de DS18B20):
+
+  Bits │ Paso (LSB) │ Conversión │ Ruido (LSB/√12) │ Máx. muestras/s
+  ─────┼────────────┼────────────┼─────────────────┼────────────────
+   9   │ 0.5    °C  │  93.75 ms  │ 0.144 °C        │ ~10
+   10  │ 0.25   °C  │ 187.5  ms  │ 0.072 °C        │ ~5
+   11  │ 0.125  °C  │ 375    ms  │ 0.036 °C        │ ~2.5
+   12  │ 0.0625 °C  │ 750    ms  │ 0.018 °C        │ ~1.3
+
+ajustarResolucion() se ejecuta al terminar cada lectura
+(src/resolucion_ds18b20.h):
+  • Cambio rápido (> 0.05 °C/s, más de un paso de cuantización y en
+    el mismo sentido que la lectura anterior): baja 1 bit y encadena
+    conversiones sin esperar sensorInterval (se sigue el cambio con
+    más muestras por segundo). Con ruido de ±1 código dos lecturas
+    pueden diferir en 2 pasos, pero nunca dos veces hacia el mismo lado
+  • Estable (< 0.01 °C/s) durante 5 lecturas: sube 1 bit y vuelve al
+    intervalo normal (más precisión cuando sobra tiempo)
+  • Nunca supera la resolución cuya conversión entra en sensorInterval
+
+tools/replay_resolucion.cpp reproduce trazas de temperatura (estable
+con ruido, rampa, deriva lenta, escalón, intervalos cortos) con los
+tiempos de conversión de cada resolución y verifica las elegidas.
+También acepta una traza propia "segundos temperatura".
+
+GET /api/muestreo?intervalo_ms=200 pide una lectura cada 200 ms: la
+resolución queda limitada a 10 bits (187.5 ms). La respuesta y
+/api/snapshot informan la resolución, las muestras por segundo medidas
+y el piso de ruido de cuantización:
+
+  {"intervalo_ms":200,"resolucion":10,"resolucion_max":10,
+   "conversion_ms":188,"muestras_hz":4.98,"ruido":0.072}
+
+sondas.fijarResolucion() escribe la resolución de cada sonda por su
+ROM guardada: setResolution(bits) sin ROM recorrería el bus con
+SEARCH ROM en cada cambio, justo cuando la temperatura cambia rápido.
+
+setAutoSaveScratchPad(false): setResolution() escribe solo el
+scratchpad (RAM del sensor). Copiarlo a la EEPROM en cada cambio la
+desgastaría (vida útil limitada de escrituras); al reiniciar el sensor
+vuelve a su resolución guardada y el controlador la ajusta de nuevo.
+
 --- HARDWARE Y CONEXIONES ---
 
 ESP32 DevKit (clásico):
@@ -455,9 +795,15 @@ curl http://192.168.1.100/temperaturas
 # Solo NTC (texto plano)
 curl http://192.168.1.100/ntc
 
-# Solo DS18B20 (texto plano)
+# DS18B20, una línea por sonda (texto plano)
 curl http://192.168.1.100/ds18b20
 
+# Todos los sensores en JSON
+curl http://192.168.1.100/api/snapshot
+
+# Pedir una lectura cada 200 ms (baja la resolución a 10 bits)
+curl "http://192.168.1.100/api/muestreo?intervalo_ms=200"
+
 --- VALIDACIÓN Y MANEJO DE ERRORES ---
 
 El programa valida las lecturas y detecta:
@@ -496,6 +842,29 @@ Donde:
 La resistencia se calcula del divisor de voltaje:
   R_NTC = R_FIXED × (VREF / V_medido - 1)
 
+--- TABLA DE CONVERSIÓN NTC (src/ntc_lut.h) ---
+
+El ADC de 12 bits solo devuelve 4096 códigos distintos, así que la
+cuenta anterior (eFuse + divisor + log + divisiones) se hace una vez
+por código en setup() y leerNTC() queda en un acceso a la tabla:
+
+  raw ──► ntcLut.centigrados(raw) ──► 2345 (= 23.45 °C)
+
+Las entradas fuera de rango (voltaje, resistencia o temperatura) se
+guardan como NTC_LUT_ERROR y leerNTC() devuelve -999.0 como antes.
+
+Para placas con poca RAM, -D NTC_LUT_SHIFT=N en build_flags guarda un
+código de cada 2^N e interpola linealmente entre vecinos:
+
+  NTC_LUT_SHIFT │ RAM    │ Error máx. vs. float (ver tools/)
+  ──────────────┼────────┼──────────────────────────────────
+        0       │ ~8 KB  │ 0.005 °C (redondeo a centésimas)
+        1       │ ~4 KB  │ ~0.14 °C (en los extremos de la curva)
+        2       │ ~2 KB  │ ~0.21 °C
+
+tools/bench_ntc_lut.cpp compila ntc_lut.h en la PC y mide
+conversiones por segundo y error máximo de cada variante.
+
 --- PROGRESIÓN DEL CURSO ---
 
 Este proyecto sigue la línea didáctica:
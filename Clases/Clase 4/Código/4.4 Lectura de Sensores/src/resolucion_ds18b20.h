@@ -0,0 +1,136 @@
+/*
+    Resolución adaptativa del DS18B20 (9-12 bits) según la velocidad de
+    cambio de la temperatura.
+
+    Se llama a ajustar() al completar cada lectura de todas las sondas;
+    devuelve la resolución para la próxima conversión:
+
+      - Cambio rápido (> UMBRAL_RAPIDO, más de un paso de cuantización y
+        en el mismo sentido que la lectura anterior): baja 1 bit y pide
+        conversiones seguidas (siguiendoCambio()).
+      - Estable (< UMBRAL_ESTABLE, o saltos de un solo paso) durante
+        LECTURAS_PARA_AFINAR lecturas: sube 1 bit y vuelve al intervalo.
+      - Entre los dos umbrales no cambia (histéresis).
+      - Nunca pasa de la resolución cuya conversión entra en el intervalo.
+
+        ResolucionAdaptativa resolucion;
+
+        resolucion.fijar(sensorDS.getResolution());           // setup()
+        uint8_t bits = resolucion.ajustar(temps, n, millis(), sensorInterval);
+        if (bits != anterior) sondas.fijarResolucion(bits);
+
+    No depende de Arduino.h ni del driver: tools/replay_resolucion.cpp
+    reproduce en la PC trazas de temperatura y verifica las resoluciones
+    elegidas.
+*/
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sondas_ds18b20.h"  // MAX_SONDAS
+
+#define UMBRAL_RAPIDO        0.05f  // °C/s: más rápido → bajar resolución
+#define UMBRAL_ESTABLE       0.01f  // °C/s: más lento → puede subir
+#define LECTURAS_PARA_AFINAR 5      // Lecturas estables antes de subir 1 bit
+
+// Paso de cuantización (LSB) según resolución: 0.5, 0.25, 0.125, 0.0625 °C
+inline float pasoResolucion(uint8_t bits) {
+    return 0.5f / (1 << (bits - 9));
+}
+
+// Ruido de cuantización RMS = LSB / √12 (piso de ruido de la medición)
+inline float ruidoCuantizacion(uint8_t bits) {
+    return pasoResolucion(bits) / sqrtf(12.0f);
+}
+
+// Espera de la conversión, igual que millisToWaitForConversion()
+inline uint32_t conversionMs(uint8_t bits) {
+    return bits <= 9 ? 94 : bits == 10 ? 188 : bits == 11 ? 375 : 750;
+}
+
+// Mayor resolución cuya conversión entra en el intervalo pedido
+inline uint8_t resolucionMaxima(uint32_t intervaloMs) {
+    uint8_t bits = 12;
+    while (bits > 9 && conversionMs(bits) > intervaloMs) bits--;
+    return bits;
+}
+
+class ResolucionAdaptativa {
+public:
+    // Resolución actual de las sondas (al arrancar o si la cambia la API)
+    void fijar(uint8_t bits) { _bits = bits; }
+
+    // La primera llamada solo guarda el punto de partida
+    uint8_t ajustar(const float *temperaturas, uint8_t cantidad, uint32_t ahora, uint32_t intervaloMs) {
+        uint32_t dt = ahora - _ultimaLectura;
+        _ultimaLectura = ahora;
+        if (!_hayAnterior) {
+            memcpy(_anteriores, temperaturas, cantidad * sizeof(float));
+            _hayAnterior = true;
+            return _bits;
+        }
+        _periodoMs = 0.8f * _periodoMs + 0.2f * dt;  // Promedio EMA
+
+        // Mayor velocidad de cambio entre todas las sondas. Un salto de un
+        // solo paso de cuantización no cuenta como cambio rápido, ni uno
+        // que no sigue en el mismo sentido al anterior: con ruido de ±1
+        // código dos lecturas pueden diferir en 2 pasos, pero nunca dos
+        // veces seguidas hacia el mismo lado
+        float lsb = pasoResolucion(_bits);
+        bool saltoGrande = false;
+        _velocidad = 0;
+        for (uint8_t i = 0; i < cantidad; i++) {
+            float t = temperaturas[i], anterior = _anteriores[i];
+            _anteriores[i] = t;
+            float delta = t - anterior, deltaAnterior = _deltas[i];
+            _deltas[i] = 0;
+            if (t < -900 || anterior < -900 || dt == 0) continue;
+            _deltas[i] = delta;
+            float v = fabsf(delta) * 1000.0f / dt;
+            if (v > _velocidad) _velocidad = v;
+            if (fabsf(delta) > lsb && delta * deltaAnterior > 0) saltoGrande = true;
+        }
+
+        uint8_t nueva = _bits;
+        if (_velocidad > UMBRAL_RAPIDO && saltoGrande) {
+            // Cambio rápido: menos bits y conversiones seguidas
+            if (nueva > 9) nueva--;
+            _siguiendoCambio = true;
+            _lecturasEstables = 0;
+        } else if (_velocidad < UMBRAL_ESTABLE || !saltoGrande) {
+            // Estable: después de varias lecturas, un bit más de precisión
+            if (++_lecturasEstables >= LECTURAS_PARA_AFINAR) {
+                nueva++;
+                _siguiendoCambio = false;
+                _lecturasEstables = 0;
+            }
+        } else {
+            _lecturasEstables = 0;
+        }
+
+        // Sin pasarse de la resolución que permite el intervalo pedido
+        uint8_t maxima = resolucionMaxima(intervaloMs);
+        if (nueva > maxima) nueva = maxima;
+        _bits = nueva;
+        return _bits;
+    }
+
+    uint8_t bits() const { return _bits; }
+    bool siguiendoCambio() const { return _siguiendoCambio; }  // true: leer sin pausa
+    float velocidad() const { return _velocidad; }             // °C/s de la última lectura
+    float periodoMs() const { return _periodoMs; }             // Entre lecturas completas
+
+private:
+    uint8_t _bits = 12;
+    uint8_t _lecturasEstables = 0;
+    bool _siguiendoCambio = false;
+    bool _hayAnterior = false;
+    float _anteriores[MAX_SONDAS];
+    float _deltas[MAX_SONDAS] = {};  // Cambio de la lectura anterior, con signo
+    uint32_t _ultimaLectura = 0;
+    float _periodoMs = 2000;
+    float _velocidad = 0;
+};
@@ -0,0 +1,158 @@
+/*
+    Varias sondas DS18B20 en el mismo bus, leídas por su ROM.
+
+    Las ROM se obtienen una sola vez al arrancar:
+
+      - cargarGuardadas(): las de la NVS (Preferences), si siguen siendo
+        las mismas sondas (misma cantidad de DS18B20 y todas responden).
+      - buscar(): si no, SEARCH ROM por todo el bus, descartando las ROM
+        con CRC inválido y las familias que no son de temperatura.
+        guardar() las deja en la NVS para el próximo arranque.
+
+    cargarGuardadas() compara con getDS18Count(), que cuenta
+    DallasTemperature::begin() recorriendo el bus: con la NVS el arranque
+    hace una búsqueda en vez de dos y el orden de las sondas (sus índices)
+    no cambia entre reinicios.
+
+    Lectura en dos fases, sin bloquear loop() durante la conversión:
+
+      - iniciarConversion(): un solo CONVERT T para todas las sondas
+        (SKIP ROM) y vuelve enseguida.
+      - leer(): pasado el tiempo de conversión lee UNA sonda por llamada
+        (MATCH ROM + READ SCRATCHPAD). Devuelve true al leer la última.
+
+        SondasDS18B20<DallasTemperature> sondas(sensorDS);
+
+        if (!sondas.cargarGuardadas(prefs)) {            // En setup()
+            sondas.buscar(oneWire);
+            sondas.guardar(prefs);
+        }
+        sondas.fijarResolucion(resolucion);              // Sin SEARCH ROM
+        sondas.iniciarConversion(resolucion, millis());  // Fase 1
+        if (sondas.leer(millis())) {                     // Fase 2, en cada loop()
+            // sondas.temperaturas[i], DS18B20_ERROR si la sonda falló
+        }
+
+    Es una plantilla sobre el driver (DallasTemperature en el ESP32), el
+    bus (OneWire) y la NVS (Preferences), y el tiempo entra como
+    parámetro, así tools/sim_ds18b20.cpp la prueba en la PC contra un
+    bus de sondas simuladas.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define MAX_SONDAS       8
+#define DS18B20_ERROR    -999.0f
+#define DS18B20_SIN_BUS  -127.0f  // getTempC(): no responde o CRC inválido
+#define DS18B20_RESET    85.0f    // Scratchpad al encender, sin conversión
+#define DS18B20_NVS      "ds18b20"  // Espacio de nombres en Preferences
+#define DS18B20_NVS_ROMS "roms"
+
+// ROM en hexadecimal (16 caracteres + '\0'), ej: 28FF641E0F16034C
+inline void romATexto(const uint8_t *rom, char *texto) {
+    static const char hex[] = "0123456789ABCDEF";
+    for (int i = 0; i < 8; i++) {
+        texto[i * 2] = hex[rom[i] >> 4];
+        texto[i * 2 + 1] = hex[rom[i] & 0x0F];
+    }
+    texto[16] = '\0';
+}
+
+template <class Sensores>
+class SondasDS18B20 {
+public:
+    explicit SondasDS18B20(Sensores &sensores) : _sensores(sensores) {}
+
+    // SEARCH ROM: recorre el bus y se queda con cada DS18B20 encontrado
+    template <class Bus>
+    void buscar(Bus &bus) {
+        uint8_t rom[8];
+        cantidad = 0;
+        bus.reset_search();
+        while (cantidad < MAX_SONDAS && bus.search(rom)) {
+            if (Bus::crc8(rom, 7) != rom[7]) continue;   // ROM leída con error
+            if (!_sensores.validFamily(rom)) continue;   // No es sensor de temperatura
+            memcpy(roms[cantidad++], rom, sizeof(rom));
+        }
+    }
+
+    // ROM guardadas en la NVS. Solo sirven si son las mismas sondas que
+    // hay ahora en el bus; si no, cantidad queda en 0 y devuelve false
+    template <class Memoria>
+    bool cargarGuardadas(Memoria &nvs) {
+        nvs.begin(DS18B20_NVS, true);  // Solo lectura
+        size_t bytes = nvs.getBytesLength(DS18B20_NVS_ROMS);
+        bool completo = bytes > 0 && bytes <= sizeof(roms) && bytes % sizeof(roms[0]) == 0;
+        if (completo) nvs.getBytes(DS18B20_NVS_ROMS, roms, bytes);
+        nvs.end();
+
+        cantidad = completo ? bytes / sizeof(roms[0]) : 0;
+        // getDS18Count(): otros dispositivos 1-Wire del bus no cuentan
+        bool mismas = cantidad > 0 && cantidad == _sensores.getDS18Count();
+        for (uint8_t i = 0; mismas && i < cantidad; i++) {
+            mismas = _sensores.isConnected(roms[i]);
+        }
+        if (!mismas) cantidad = 0;
+        return mismas;
+    }
+
+    template <class Memoria>
+    void guardar(Memoria &nvs) {
+        nvs.begin(DS18B20_NVS, false);
+        nvs.putBytes(DS18B20_NVS_ROMS, roms, cantidad * sizeof(roms[0]));
+        nvs.end();
+    }
+
+    // Fase 1: CONVERT T para todas (requestTemperatures() no espera si se
+    // llamó setWaitForConversion(false))
+    void iniciarConversion(uint8_t resolucion, uint32_t ahora) {
+        _sensores.requestTemperatures();
+        _inicio = ahora;
+        _tiempoConversion = _sensores.millisToWaitForConversion(resolucion);
+        _leyendo = 0;
+        _enCurso = true;
+    }
+
+    // Fase 2: false mientras convierten o queden sondas por leer
+    bool leer(uint32_t ahora) {
+        if (!_enCurso) return false;
+        if (ahora - _inicio < _tiempoConversion) return false;  // Todavía convirtiendo
+
+        if (_leyendo < cantidad) {
+            // getTempC() verifica el CRC del scratchpad: si falla devuelve -127.
+            // 85 °C es el valor de encendido: la sonda no llegó a convertir
+            float temp = _sensores.getTempC(roms[_leyendo]);
+            if (temp == DS18B20_SIN_BUS || temp == DS18B20_RESET) temp = DS18B20_ERROR;
+            temperaturas[_leyendo++] = temp;
+            if (_leyendo < cantidad) return false;  // La siguiente en la próxima llamada
+        }
+
+        _enCurso = false;
+        return true;
+    }
+
+    // Resolución de cada sonda por su ROM (MATCH ROM + WRITE SCRATCHPAD).
+    // setResolution(bits) sin ROM vuelve a recorrer el bus con SEARCH ROM
+    // para encontrarlas; skipGlobal = true tampoco relee la resolución de
+    // todas después de cada escritura. Llamar sin conversión en curso
+    void fijarResolucion(uint8_t bits) {
+        for (uint8_t i = 0; i < cantidad; i++) _sensores.setResolution(roms[i], bits, true);
+    }
+
+    bool convirtiendo() const { return _enCurso; }
+    uint32_t tiempoConversion() const { return _tiempoConversion; }
+
+    uint8_t roms[MAX_SONDAS][8];        // ROM de 64 bits de cada sonda
+    float temperaturas[MAX_SONDAS];     // Última lectura, mismo orden que roms[]
+    uint8_t cantidad = 0;
+
+private:
+    Sensores &_sensores;
+    bool _enCurso = false;
+    uint32_t _inicio = 0;
+    uint32_t _tiempoConversion = 750;   // Según resolución (750 ms a 12 bits)
+    uint8_t _leyendo = 0;               // Próxima sonda a leer
+};
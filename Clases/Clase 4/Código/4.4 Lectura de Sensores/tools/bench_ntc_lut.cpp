@@ -0,0 +1,94 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Benchmark en la PC de src/ntc_lut.h (no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o bench_ntc_lut tools/bench_ntc_lut.cpp
+        ./bench_ntc_lut
+
+    Compara el cálculo en float de leerNTC() (calibración + divisor +
+    log) contra la tabla completa, la de media y la de un cuarto:
+    conversiones por segundo y error máximo sobre los 4096 códigos.
+
+    La calibración eFuse se reemplaza por una recta típica de un ESP32
+    con atenuación de 11 dB (~0.81 mV por código + 142 mV de offset).
+    Los valores absolutos de velocidad son los de la PC; en el ESP32 la
+    diferencia es mayor porque log() y las divisiones en float son más
+    caras (y sin FPU en el ESP32-C3).
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "../src/ntc_lut.h"
+
+static const NtcParams PARAMS = {3.3f, 10000, 10000, 298.15f, 3950};
+static const uint32_t CONVERSIONES = 20000000;
+
+// Reemplazo de esp_adc_cal_raw_to_voltage() (resultado en mV enteros)
+static float rawAMilivoltios(uint16_t raw) {
+    return (float)(uint32_t)(raw * 0.8055f + 142.0f);
+}
+
+// Secuencia de códigos pseudoaleatoria, igual para todos los métodos
+static uint16_t codigos[4096];
+
+template <typename Conversion>
+static void medir(const char *nombre, Conversion convertir) {
+    volatile int32_t sumidero = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < CONVERSIONES; i++) {
+        sumidero = sumidero + convertir(codigos[i & 4095]);
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - inicio;
+    printf("  %-22s %8.1f M conv/s", nombre, CONVERSIONES / dt.count() / 1e6);
+}
+
+// Error máximo (°C) contra el float en los códigos válidos para ambos
+template <uint8_t SHIFT>
+static void comparar(const char *nombre) {
+    static NtcLut<SHIFT> lut;
+    lut.build(PARAMS, rawAMilivoltios);
+
+    medir(nombre, [](uint16_t raw) { return (int32_t)lut.centigrados(raw); });
+
+    float errorMax = 0;
+    int bordes = 0;
+    for (uint16_t raw = 0; raw < 4096; raw++) {
+        float ref = ntcTemperatura(rawAMilivoltios(raw), PARAMS);
+        int16_t cc = lut.centigrados(raw);
+        if (ref < -900 || cc == NTC_LUT_ERROR) {
+            if ((ref < -900) != (cc == NTC_LUT_ERROR)) bordes++;
+            continue;
+        }
+        float error = fabsf(cc / 100.0f - ref);
+        if (error > errorMax) errorMax = error;
+    }
+    printf(" | %5u bytes | error máx %.4f °C | bordes perdidos: %d\n",
+           (unsigned)lut.bytes(), errorMax, bordes);
+}
+
+int main() {
+    srand(1);
+    for (int i = 0; i < 4096; i++) codigos[i] = rand() & 4095;
+
+    printf("NTC: %u conversiones por método\n\n", (unsigned)CONVERSIONES);
+
+    medir("Float (leerNTC)", [](uint16_t raw) {
+        return (int32_t)(ntcTemperatura(rawAMilivoltios(raw), PARAMS) * 100.0f);
+    });
+    printf("\n");
+
+    comparar<0>("Tabla completa");
+    comparar<1>("Tabla 1/2 (interpola)");
+    comparar<2>("Tabla 1/4 (interpola)");
+    return 0;
+}
@@ -0,0 +1,332 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Reproducción en la PC de src/resolucion_ds18b20.h con trazas de
+    temperatura (no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o replay_resolucion tools/replay_resolucion.cpp
+        ./replay_resolucion                      # Trazas sintéticas + verificación
+        ./replay_resolucion traza.txt [ms]       # Traza propia, intervalo en ms
+
+    Una traza propia tiene una línea "segundos temperatura" por punto
+    (por ejemplo de un registrador o de otro termómetro); entre puntos
+    se interpola y las líneas que no son dos números se ignoran. Se
+    imprime cada cambio de resolución.
+
+    loop() se reproduce en tiempo simulado con la misma regla que el
+    sketch: una conversión cada sensorInterval o seguidas mientras
+    siguiendoCambio() es true, cada una tarda conversionMs(bits) y la
+    sonda entrega la temperatura cuantizada a esa resolución. Las trazas
+    sintéticas verifican:
+
+    1. Temperatura estable con ruido de ±1 código: siempre 12 bits.
+    2. Rampa de 0.5 °C/s: baja la resolución en pocos segundos y muestrea
+       más rápido. Mientras dura se queda entre 10 y 11 bits (donde cada
+       lectura cambia alrededor de un paso) y al terminar vuelve a 12.
+    3. Deriva lenta (0.03 °C/s, entre los dos umbrales): no cambia.
+    4. Escalón de 40 °C (sonda al agua caliente): baja hasta 9 bits.
+    5. Intervalo de 200 y 100 ms: nunca más de 10 y 9 bits.
+    6. Un código que alterna entre dos valores vecinos y una sonda con
+       error por unas lecturas: no cuentan como cambio rápido.
+
+    Devuelve 1 si alguna comprobación falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../src/resolucion_ds18b20.h"
+
+// Temperatura real de cada sonda en el instante t (ms)
+struct Traza {
+    virtual float temperatura(uint8_t sonda, uint32_t t) const = 0;
+    virtual bool error(uint8_t, uint32_t) const { return false; }  // La sonda no responde
+};
+
+struct Lectura {
+    uint32_t t;       // Fin de la conversión
+    uint8_t bits;     // Resolución con la que se convirtió
+    uint8_t nueva;    // La que eligió ajustar() para la próxima
+    bool seguidas;    // siguiendoCambio() después de ajustar()
+    float velocidad;  // °C/s
+};
+
+// La sonda: cuantiza al paso de la resolución (descarta los bits bajos)
+static float cuantizar(float temperatura, uint8_t bits) {
+    int32_t cuentas = lroundf(temperatura * 16);
+    cuentas &= ~((1 << (12 - bits)) - 1);
+    return cuentas / 16.0f;
+}
+
+// loop() + leerDS18B20() + ajustarResolucion() en tiempo simulado
+static std::vector<Lectura> reproducir(const Traza &traza, uint8_t sondas, uint32_t duracionMs,
+                                       uint32_t intervaloMs, uint8_t bitsIniciales = 12) {
+    std::vector<Lectura> lecturas;
+    ResolucionAdaptativa resolucion;
+    // Como handleMuestreo(): el intervalo pedido limita la resolución enseguida
+    uint8_t maxima = resolucionMaxima(intervaloMs);
+    resolucion.fijar(bitsIniciales > maxima ? maxima : bitsIniciales);
+    float temperaturas[MAX_SONDAS];
+    uint32_t t = 0, previo = 0;
+    bool primera = true;  // setup(): conversión sin esperar el intervalo
+
+    while (t < duracionMs) {
+        bool toca = primera || resolucion.siguiendoCambio() || t - previo >= intervaloMs;
+        if (!toca) {
+            t = previo + intervaloMs;
+            continue;
+        }
+        if (!primera) previo = t;
+
+        uint8_t bits = resolucion.bits();
+        t += conversionMs(bits) + sondas;  // Más una vuelta de loop() por sonda leída
+        for (uint8_t i = 0; i < sondas; i++) {
+            temperaturas[i] = traza.error(i, t) ? DS18B20_ERROR : cuantizar(traza.temperatura(i, t), bits);
+        }
+        uint8_t nueva = resolucion.ajustar(temperaturas, sondas, t, intervaloMs);
+        if (!primera) lecturas.push_back({t, bits, nueva, resolucion.siguiendoCambio(), resolucion.velocidad()});
+        primera = false;
+    }
+    return lecturas;
+}
+
+// Resumen de las lecturas que terminaron en [desde, hasta)
+struct Tramo {
+    uint32_t lecturas = 0, subidas = 0, bajadas = 0;
+    uint8_t minBits = 12, maxBits = 9;
+    float muestrasHz = 0;
+};
+
+static Tramo tramo(const std::vector<Lectura> &lecturas, uint32_t desde, uint32_t hasta) {
+    Tramo r;
+    for (const Lectura &l : lecturas) {
+        if (l.t < desde || l.t >= hasta) continue;
+        r.lecturas++;
+        if (l.bits < r.minBits) r.minBits = l.bits;
+        if (l.bits > r.maxBits) r.maxBits = l.bits;
+        if (l.nueva > l.bits) r.subidas++;
+        if (l.nueva < l.bits) r.bajadas++;
+    }
+    r.muestrasHz = r.lecturas * 1000.0f / (hasta - desde);
+    return r;
+}
+
+static void imprimirTramo(const char *nombre, const Tramo &r) {
+    printf("    %-22s %4u lecturas (%5.2f/s) │ bits %u-%u │ bajadas %u, subidas %u\n", nombre,
+           (unsigned)r.lecturas, r.muestrasHz, r.minBits, r.maxBits, (unsigned)r.bajadas, (unsigned)r.subidas);
+}
+
+// Primera lectura en [desde, ...) que cumple la condición; UINT32_MAX si no hay
+template <typename Condicion>
+static uint32_t primera(const std::vector<Lectura> &lecturas, uint32_t desde, Condicion cumple) {
+    for (const Lectura &l : lecturas) {
+        if (l.t >= desde && cumple(l)) return l.t;
+    }
+    return UINT32_MAX;
+}
+
+static int fallas = 0;
+
+static void comprobar(bool ok, const char *que) {
+    printf("  [%s] %s\n", ok ? " OK " : "FALLA", que);
+    if (!ok) fallas++;
+}
+
+// ±1 código de 12 bits, pseudoaleatorio pero igual en cada corrida
+static float ruido(uint8_t sonda, uint32_t t) {
+    uint32_t x = (t / 50 + 1) * 2654435761u + sonda * 40503u;
+    return ((int)((x >> 16) % 3) - 1) / 16.0f;
+}
+
+struct Estable : Traza {
+    float temperatura(uint8_t sonda, uint32_t t) const override { return 23.2f + ruido(sonda, t); }
+};
+
+// 20 °C, rampa de 0.5 °C/s entre los 60 y los 90 s, 35 °C después
+struct Rampa : Traza {
+    float temperatura(uint8_t, uint32_t t) const override {
+        float s = t / 1000.0f;
+        return 20 + 0.5f * (s < 60 ? 0 : s < 90 ? s - 60 : 30);
+    }
+};
+
+struct Deriva : Traza {
+    float temperatura(uint8_t, uint32_t t) const override { return 18 + 0.03f * t / 1000.0f; }
+};
+
+// 20 °C y a los 30 s la sonda entra en agua a 60 °C (constante de 8 s)
+struct Escalon : Traza {
+    float temperatura(uint8_t, uint32_t t) const override {
+        return t < 30000 ? 20 : 60 - 40 * expf(-(float)(t - 30000) / 8000.0f);
+    }
+};
+
+// Justo en el límite entre dos códigos de 10 bits: cada lectura cae en uno u otro
+struct Limite : Traza {
+    float temperatura(uint8_t, uint32_t t) const override { return 22.125f + ((t / 200) % 2 ? 0.01f : -0.01f); }
+};
+
+// Dos sondas estables; la segunda no responde entre los 40 y los 46 s
+struct ConError : Traza {
+    float temperatura(uint8_t sonda, uint32_t) const override { return sonda ? 31.5f : 24.0f; }
+    bool error(uint8_t sonda, uint32_t t) const override { return sonda == 1 && t >= 40000 && t < 46000; }
+};
+
+static void estable() {
+    std::vector<Lectura> l = reproducir(Estable(), 1, 300000, 2000);
+    Tramo r = tramo(l, 0, 300000);
+    imprimirTramo("5 min a 23.2 °C", r);
+    comprobar(r.minBits == 12 && r.bajadas == 0, "temperatura estable con ruido de ±1 código: siempre 12 bits");
+    comprobar(fabsf(r.muestrasHz - 0.5f) < 0.01f, "una lectura cada 2 s");
+}
+
+static void rampa() {
+    std::vector<Lectura> l = reproducir(Rampa(), 1, 240000, 2000);
+    Tramo antes = tramo(l, 0, 60000), durante = tramo(l, 65000, 90000), despues = tramo(l, 120000, 240000);
+    imprimirTramo("antes (0-60 s)", antes);
+    imprimirTramo("rampa (65-90 s)", durante);
+    imprimirTramo("después (120-240 s)", despues);
+
+    uint32_t reaccion = primera(l, 60000, [](const Lectura &x) { return x.nueva < 12; });
+    uint32_t vuelta = primera(l, 90000, [](const Lectura &x) { return x.nueva == 12; });
+    printf("    Baja a los %.1f s de empezar la rampa, vuelve a 12 bits a los %.1f s de terminar\n",
+           (reaccion - 60000) / 1000.0, (vuelta - 90000) / 1000.0);
+
+    comprobar(antes.minBits == 12 && antes.bajadas == 0, "antes de la rampa: 12 bits");
+    comprobar(reaccion < 66000, "la resolución baja en menos de 6 s");
+    comprobar(durante.minBits == 10 && durante.maxBits == 11, "durante la rampa: entre 10 y 11 bits");
+    comprobar(durante.muestrasHz > 3 * antes.muestrasHz, "durante la rampa: más de 3 veces las muestras por segundo");
+    comprobar(vuelta < 110000 && despues.minBits == 12 && despues.bajadas == 0,
+              "al terminar vuelve a 12 bits en menos de 20 s y se queda ahí");
+    comprobar(fabsf(despues.muestrasHz - 0.5f) < 0.02f, "y vuelve al intervalo de 2 s");
+}
+
+static void deriva() {
+    std::vector<Lectura> l = reproducir(Deriva(), 1, 180000, 2000);
+    Tramo r = tramo(l, 0, 180000);
+    imprimirTramo("3 min a 0.03 °C/s", r);
+    comprobar(r.minBits == 12 && r.bajadas == 0, "deriva lenta (entre los umbrales): no baja la resolución");
+}
+
+static void escalon() {
+    std::vector<Lectura> l = reproducir(Escalon(), 1, 120000, 2000);
+    Tramo r = tramo(l, 30000, 60000);
+    imprimirTramo("escalón (30-60 s)", r);
+    uint32_t reaccion = primera(l, 30000, [](const Lectura &x) { return x.nueva < x.bits; });
+    comprobar(reaccion <= 32800, "la resolución baja en las dos primeras lecturas después del escalón");
+    comprobar(r.minBits == 9, "con el cambio más rápido llega a 9 bits");
+    comprobar(tramo(l, 100000, 120000).minBits == 12, "a los 70 s del escalón (9 constantes de tiempo) está en 12 bits");
+}
+
+static void intervalosCortos() {
+    std::vector<Lectura> l = reproducir(Rampa(), 1, 240000, 200);
+    Tramo r = tramo(l, 0, 240000);
+    imprimirTramo("rampa, cada 200 ms", r);
+    comprobar(r.maxBits <= 10 && l.front().bits == 10,
+              "intervalo de 200 ms: desde la primera lectura, nunca más de 10 bits (187.5 ms)");
+
+    l = reproducir(Rampa(), 1, 240000, 100);
+    r = tramo(l, 0, 240000);
+    imprimirTramo("rampa, cada 100 ms", r);
+    comprobar(r.maxBits == 9 && r.minBits == 9, "intervalo de 100 ms: 9 bits (93.75 ms)");
+}
+
+static void falsosCambios() {
+    std::vector<Lectura> l = reproducir(Limite(), 1, 60000, 200, 10);
+    Tramo r = tramo(l, 0, 60000);
+    imprimirTramo("código que alterna", r);
+    bool seguidas = false;
+    for (const Lectura &x : l) seguidas |= x.seguidas;
+    comprobar(r.minBits == 10 && !seguidas,
+              "un código que alterna entre vecinos (1.25 °C/s aparentes) no es un cambio rápido");
+
+    l = reproducir(ConError(), 2, 90000, 2000);
+    r = tramo(l, 0, 90000);
+    imprimirTramo("sonda con error", r);
+    comprobar(r.minBits == 12 && r.bajadas == 0, "una sonda que deja de responder y vuelve no cambia la resolución");
+}
+
+// Traza propia: puntos (s, °C) interpolados
+struct Archivo : Traza {
+    std::vector<float> segundos, grados;
+
+    float temperatura(uint8_t, uint32_t t) const override {
+        float s = t / 1000.0f;
+        if (s <= segundos.front()) return grados.front();
+        for (size_t i = 1; i < segundos.size(); i++) {
+            if (s > segundos[i]) continue;
+            float f = (s - segundos[i - 1]) / (segundos[i] - segundos[i - 1]);
+            return grados[i - 1] + f * (grados[i] - grados[i - 1]);
+        }
+        return grados.back();
+    }
+};
+
+static int reproducirArchivo(const char *ruta, uint32_t intervaloMs) {
+    FILE *f = fopen(ruta, "r");
+    if (!f) {
+        perror(ruta);
+        return 1;
+    }
+    Archivo traza;
+    char linea[128];
+    while (fgets(linea, sizeof(linea), f)) {
+        float s, c;
+        if (sscanf(linea, "%f %f", &s, &c) != 2) continue;
+        if (!traza.segundos.empty() && s <= traza.segundos.back()) continue;
+        traza.segundos.push_back(s);
+        traza.grados.push_back(c);
+    }
+    fclose(f);
+    if (traza.segundos.size() < 2) {
+        fprintf(stderr, "%s: hacen falta al menos dos puntos \"segundos temperatura\"\n", ruta);
+        return 1;
+    }
+
+    uint32_t duracion = (uint32_t)(traza.segundos.back() * 1000);
+    std::vector<Lectura> l = reproducir(traza, 1, duracion, intervaloMs);
+    printf("%s: %.0f s, intervalo %u ms\n\n", ruta, duracion / 1000.0, (unsigned)intervaloMs);
+    printf("    Tiempo    │ °C/s   │ Resolución\n");
+    for (const Lectura &x : l) {
+        if (x.nueva == x.bits) continue;
+        printf("    %8.1f s │ %6.3f │ %u -> %u bits%s\n", x.t / 1000.0, x.velocidad, x.bits, x.nueva,
+               x.seguidas ? " (seguidas)" : "");
+    }
+    printf("\n");
+    imprimirTramo("total", tramo(l, 0, duracion));
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) return reproducirArchivo(argv[1], argc > 2 ? (uint32_t)atoi(argv[2]) : 2000);
+
+    printf("1. Estable:\n");
+    estable();
+
+    printf("\n2. Rampa de 0.5 °C/s entre los 60 y 90 s:\n");
+    rampa();
+
+    printf("\n3. Deriva lenta:\n");
+    deriva();
+
+    printf("\n4. Escalón de 20 a 60 °C:\n");
+    escalon();
+
+    printf("\n5. Intervalos cortos pedidos por /api/muestreo:\n");
+    intervalosCortos();
+
+    printf("\n6. Falsos cambios:\n");
+    falsosCambios();
+
+    printf("\n%s\n", fallas ? "FALLA: revisar las comprobaciones marcadas" : "OK: resolución adaptativa verificada");
+    return fallas ? 1 : 0;
+}
@@ -0,0 +1,551 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Pruebas en la PC de src/sondas_ds18b20.h contra sondas DS18B20
+    simuladas (no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o sim_ds18b20 tools/sim_ds18b20.cpp
+        ./sim_ds18b20
+
+    Cada sonda simulada se comporta como dice la hoja de datos: CONVERT T
+    tarda 93.75 / 187.5 / 375 / 750 ms según su resolución, el registro
+    de temperatura vale 85 °C al encender hasta la primera conversión, y
+    READ SCRATCHPAD devuelve 9 bytes con CRC. SensoresSimulados,
+    BusSimulado y MemoriaSimulada exponen la misma interfaz de
+    DallasTemperature, OneWire y Preferences que usa el sketch. El reloj
+    solo avanza cuando la prueba lo indica.
+
+    1. La fase 1 no espera y la fase 2 no toca el bus antes de tiempo.
+    2. Una sonda por llamada, con el valor cuantizado a la resolución.
+    3. fijarResolucion() escribe cada sonda por su ROM y a 9 bits la
+       lectura está lista a los 94 ms.
+    4. Leer antes de que la sonda termine (85 °C de encendido) es error.
+    5. Sonda desconectada y scratchpad con CRC inválido: error solo en
+       esa sonda y la siguiente lectura vuelve a estar bien.
+    6. Sin conversión iniciada, sin sondas y con millis() desbordando.
+
+    Varias sondas en el bus, arranque con la NVS (buscar() y
+    cargarGuardadas()):
+
+    7. NVS vacía: se recorre el bus y se guardan las ROM; al reiniciar
+       con las mismas sondas se usan las guardadas. begin() recorre el
+       bus en cada arranque: con la NVS son 1 búsqueda en vez de 2.
+    8. ROM leída con error de CRC durante la búsqueda: se descarta y en
+       el próximo arranque la NVS no coincide y se vuelve a buscar.
+    9. Sonda reemplazada, agregada o quitada: la NVS no coincide. Sondas
+       cambiadas de lugar en el cable: el orden guardado se mantiene.
+    10. Otro dispositivo 1-Wire en el bus (DS2401): no es una sonda y no
+        invalida la NVS. Más de MAX_SONDAS sondas. NVS incompleta.
+
+    Devuelve 1 si alguna comprobación falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/sondas_ds18b20.h"
+
+static uint32_t relojMs = 0;  // Lo que sería millis()
+
+// CRC-8 de Dallas/Maxim (x^8 + x^5 + x^4 + 1), el de OneWire::crc8()
+static uint8_t crc8(const uint8_t *datos, uint8_t largo) {
+    uint8_t crc = 0;
+    while (largo--) {
+        uint8_t byte = *datos++;
+        for (int i = 0; i < 8; i++) {
+            uint8_t mezcla = (crc ^ byte) & 0x01;
+            crc >>= 1;
+            if (mezcla) crc ^= 0x8C;
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+// Tiempo de conversión máximo de la hoja de datos, en µs
+static uint32_t conversionUs(uint8_t bits) {
+    return 750000u >> (12 - bits);
+}
+
+struct SondaSimulada {
+    uint8_t rom[8];
+    float temperatura = 25.0f;   // La del ambiente
+    uint8_t resolucion = 12;     // Registro de configuración
+    bool conectada = true;
+    bool crcInvalido = false;    // La próxima lectura llega con un bit cambiado
+    bool convirtiendo = false;
+    uint32_t inicioMs = 0;
+    int16_t registro = 85 * 16;  // Valor de encendido
+
+    void crear(uint8_t familia, uint32_t serie) {
+        rom[0] = familia;
+        for (int i = 1; i < 7; i++) rom[i] = (uint8_t)(serie >> ((i - 1) * 5));
+        rom[7] = crc8(rom, 7);
+    }
+
+    // Si la conversión ya terminó, el registro tiene la temperatura nueva
+    // (se descartan los bits que no da la resolución)
+    void actualizar() {
+        if (!convirtiendo || (uint64_t)(relojMs - inicioMs) * 1000 < conversionUs(resolucion)) return;
+        int16_t cuentas = (int16_t)lroundf(temperatura * 16);
+        registro = cuentas & ~((1 << (12 - resolucion)) - 1);
+        convirtiendo = false;
+    }
+
+    void leerScratchpad(uint8_t *scratch) {
+        actualizar();
+        memset(scratch, 0, 9);
+        scratch[0] = (uint8_t)registro;
+        scratch[1] = (uint8_t)(registro >> 8);
+        scratch[4] = (uint8_t)(((resolucion - 9) << 5) | 0x1F);
+        scratch[5] = 0xFF;
+        scratch[7] = 0x10;
+        scratch[8] = crc8(scratch, 8);
+        if (crcInvalido) {
+            scratch[0] ^= 0x04;  // Ruido en el bus
+            crcInvalido = false;
+        }
+    }
+};
+
+// Familias de sensores de temperatura (DallasTemperature::validFamily)
+static bool familiaTemperatura(uint8_t familia) {
+    return familia == 0x10 || familia == 0x22 || familia == 0x28 || familia == 0x3B || familia == 0x42;
+}
+
+// Lo que usa src/sondas_ds18b20.h de DallasTemperature
+struct SensoresSimulados {
+    SondaSimulada *sondas = nullptr;
+    uint8_t cantidad = 0;
+    uint32_t conversiones = 0, lecturas = 0, escriturasResolucion = 0;  // Comandos en el bus
+    uint32_t busquedas = 0;  // Las de begin()
+    uint8_t dispositivos = 0, ds18 = 0;
+
+    bool validFamily(const uint8_t *rom) { return familiaTemperatura(rom[0]); }
+
+    // Como la librería: begin() recorre el bus con SEARCH ROM y cuenta los
+    // dispositivos con ROM válida y, de esos, los sensores de temperatura
+    void begin() {
+        busquedas++;
+        dispositivos = contar(false);
+        ds18 = contar(true);
+    }
+    uint8_t getDeviceCount() { return dispositivos; }
+    uint8_t getDS18Count() { return ds18; }
+
+    uint8_t contar(bool soloTemperatura) {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < cantidad; i++) {
+            if (sondas[i].conectada && (!soloTemperatura || familiaTemperatura(sondas[i].rom[0]))) n++;
+        }
+        return n;
+    }
+
+    bool isConnected(const uint8_t *rom) {  // Lee el scratchpad y verifica el CRC
+        for (uint8_t i = 0; i < cantidad; i++) {
+            if (memcmp(sondas[i].rom, rom, 8) != 0 || !sondas[i].conectada) continue;
+            uint8_t scratch[9];
+            sondas[i].leerScratchpad(scratch);
+            return crc8(scratch, 8) == scratch[8];
+        }
+        return false;
+    }
+
+    void requestTemperatures() {  // SKIP ROM + CONVERT T, sin esperar
+        conversiones++;
+        for (uint8_t i = 0; i < cantidad; i++) {
+            if (!sondas[i].conectada) continue;
+            sondas[i].convirtiendo = true;
+            sondas[i].inicioMs = relojMs;
+        }
+    }
+
+    int16_t millisToWaitForConversion(uint8_t bits) {  // Igual que la librería
+        switch (bits) {
+            case 9: return 94;
+            case 10: return 188;
+            case 11: return 375;
+            default: return 750;
+        }
+    }
+
+    // MATCH ROM + WRITE SCRATCHPAD a una sola sonda. La versión sin ROM
+    // de la librería buscaría cada sonda con SEARCH ROM: no se simula
+    void setResolution(const uint8_t *rom, uint8_t bits, bool) {
+        escriturasResolucion++;
+        for (uint8_t i = 0; i < cantidad; i++) {
+            if (memcmp(sondas[i].rom, rom, 8) == 0 && sondas[i].conectada) sondas[i].resolucion = bits;
+        }
+    }
+
+    float getTempC(const uint8_t *rom) {  // MATCH ROM + READ SCRATCHPAD
+        lecturas++;
+        for (uint8_t i = 0; i < cantidad; i++) {
+            if (memcmp(sondas[i].rom, rom, 8) != 0) continue;
+            if (!sondas[i].conectada) break;
+            uint8_t scratch[9];
+            sondas[i].leerScratchpad(scratch);
+            if (crc8(scratch, 8) != scratch[8]) break;
+            return (int16_t)(scratch[0] | (scratch[1] << 8)) * 0.0625f;
+        }
+        return DS18B20_SIN_BUS;
+    }
+};
+
+// Lo que usa src/sondas_ds18b20.h de OneWire: SEARCH ROM devuelve los
+// dispositivos conectados en orden. romConRuido lee mal la ROM de ese
+// índice en la próxima búsqueda (un bit cambiado, CRC inválido)
+struct BusSimulado {
+    SondaSimulada *sondas = nullptr;
+    uint8_t cantidad = 0;
+    uint8_t siguiente = 0;
+    int romConRuido = -1;
+    uint32_t busquedas = 0;
+
+    void reset_search() {
+        siguiente = 0;
+        busquedas++;
+    }
+
+    bool search(uint8_t *rom) {
+        while (siguiente < cantidad && !sondas[siguiente].conectada) siguiente++;
+        if (siguiente >= cantidad) return false;
+        memcpy(rom, sondas[siguiente].rom, 8);
+        if (romConRuido == siguiente) {
+            rom[3] ^= 0x10;
+            romConRuido = -1;
+        }
+        siguiente++;
+        return true;
+    }
+
+    static uint8_t crc8(const uint8_t *datos, uint8_t largo) { return ::crc8(datos, largo); }
+};
+
+// Lo que usa src/sondas_ds18b20.h de Preferences: una sola clave de bytes
+struct MemoriaSimulada {
+    uint8_t datos[128];
+    size_t largo = 0;
+    bool abierta = false, soloLectura = false;
+    uint32_t escrituras = 0;
+
+    bool begin(const char *, bool lectura) {
+        abierta = true;
+        soloLectura = lectura;
+        return true;
+    }
+    void end() { abierta = false; }
+    size_t getBytesLength(const char *) { return abierta ? largo : 0; }
+    size_t getBytes(const char *, void *destino, size_t max) {
+        size_t n = abierta && largo <= max ? largo : 0;
+        memcpy(destino, datos, n);
+        return n;
+    }
+    size_t putBytes(const char *, const void *origen, size_t n) {
+        if (!abierta || soloLectura || n > sizeof(datos)) return 0;
+        memcpy(datos, origen, n);
+        largo = n;
+        escrituras++;
+        return n;
+    }
+};
+
+static int fallas = 0;
+
+static void comprobar(bool ok, const char *que) {
+    printf("  [%s] %s\n", ok ? " OK " : "FALLA", que);
+    if (!ok) fallas++;
+}
+
+// Bus de prueba con tres sondas encendidas recién a 12 bits
+struct Banco {
+    SondaSimulada bus[3];
+    SensoresSimulados sensores;
+    SondasDS18B20<SensoresSimulados> sondas;
+
+    Banco() : sondas(sensores) {
+        float temperaturas[3] = {23.4567f, -10.3f, 41.02f};
+        for (int i = 0; i < 3; i++) {
+            bus[i].crear(0x28, 0x1E0F16u + i * 7919);
+            bus[i].temperatura = temperaturas[i];
+            memcpy(sondas.roms[i], bus[i].rom, 8);
+        }
+        sensores.sondas = bus;
+        sensores.cantidad = 3;
+        sondas.cantidad = 3;
+    }
+
+    // Llama a leer() como loop(): el reloj avanza 1 ms en cada vuelta que
+    // no leyó el bus (máximo 2 s). Devuelve el instante en que terminó
+    uint32_t leerHastaTerminar() {
+        for (uint32_t inicio = relojMs; relojMs - inicio < 2000;) {
+            uint32_t lecturas = sensores.lecturas;
+            if (sondas.leer(relojMs)) break;
+            if (sensores.lecturas == lecturas) relojMs++;
+        }
+        return relojMs;
+    }
+};
+
+// Lectura a menos de un paso de cuantización (0.5 °C a 9 bits, 0.0625 °C
+// a 12) de la temperatura real
+static bool cerca(float leida, float real, uint8_t bits) {
+    return fabsf(leida - real) <= 0.5f / (1 << (bits - 9));
+}
+
+static void dosFases() {
+    Banco b;
+    relojMs = 1000;
+    b.sondas.iniciarConversion(12, relojMs);
+    comprobar(relojMs == 1000 && b.sensores.conversiones == 1, "iniciarConversion() manda un solo CONVERT T y vuelve");
+
+    bool antes = false;
+    for (uint32_t t = 0; t < 750; t++) {
+        relojMs = 1000 + t;
+        antes |= b.sondas.leer(relojMs);
+    }
+    comprobar(!antes && b.sensores.lecturas == 0, "leer() no toca el bus durante los 750 ms de conversión");
+
+    relojMs = 1750;
+    bool r1 = b.sondas.leer(relojMs), r2 = b.sondas.leer(relojMs), r3 = b.sondas.leer(relojMs);
+    comprobar(!r1 && !r2 && r3 && b.sensores.lecturas == 3, "una sonda por llamada: false, false, true con 3 sondas");
+    comprobar(!b.sondas.convirtiendo() && !b.sondas.leer(relojMs) && b.sensores.lecturas == 3,
+              "después de la última, leer() no vuelve a leer hasta otra conversión");
+
+    bool bien = true;
+    for (int i = 0; i < 3; i++) bien &= cerca(b.sondas.temperaturas[i], b.bus[i].temperatura, 12);
+    printf("    Leídas: %.4f %.4f %.4f °C (reales %.4f %.4f %.4f)\n", b.sondas.temperaturas[0],
+           b.sondas.temperaturas[1], b.sondas.temperaturas[2], b.bus[0].temperatura, b.bus[1].temperatura,
+           b.bus[2].temperatura);
+    comprobar(bien, "cada sonda a 1/16 °C de su temperatura, incluida la negativa");
+}
+
+static void nueveBits() {
+    Banco b;
+    b.sondas.fijarResolucion(9);
+    comprobar(b.sensores.escriturasResolucion == 3 && b.bus[0].resolucion == 9 && b.bus[1].resolucion == 9 &&
+                  b.bus[2].resolucion == 9,
+              "fijarResolucion(9): una escritura por ROM guardada, sin recorrer el bus");
+    relojMs = 0;
+    b.sondas.iniciarConversion(9, relojMs);
+    uint32_t fin = b.leerHastaTerminar();
+    printf("    Lectura completa a los %u ms\n", (unsigned)fin);
+    comprobar(b.sondas.tiempoConversion() == 94 && fin == 94, "a 9 bits la lectura está lista a los 94 ms");
+
+    bool bien = true;
+    for (int i = 0; i < 3; i++) {
+        float t = b.sondas.temperaturas[i];
+        bien &= cerca(t, b.bus[i].temperatura, 9) && fmodf(fabsf(t), 0.5f) == 0;
+    }
+    comprobar(bien, "a 9 bits los valores vienen en pasos de 0.5 °C");
+}
+
+static void antesDeTiempo() {
+    Banco b;  // Sondas recién encendidas a 12 bits
+    relojMs = 0;
+    b.sondas.iniciarConversion(9, relojMs);  // Se espera como si fueran de 9 bits
+    b.leerHastaTerminar();
+    bool error = true;
+    for (int i = 0; i < 3; i++) error &= b.sondas.temperaturas[i] == DS18B20_ERROR;
+    comprobar(error, "leer antes de que termine la conversión (85 °C de encendido) se marca como error");
+
+    relojMs = 1000;
+    b.sondas.iniciarConversion(12, relojMs);
+    b.leerHastaTerminar();
+    comprobar(cerca(b.sondas.temperaturas[0], b.bus[0].temperatura, 12),
+              "con el tiempo de la resolución real la lectura vuelve a estar bien");
+}
+
+static void fallasDeSonda() {
+    Banco b;
+    b.bus[1].conectada = false;
+    b.bus[2].crcInvalido = true;
+    relojMs = 0;
+    b.sondas.iniciarConversion(12, relojMs);
+    uint32_t fin = b.leerHastaTerminar();
+    comprobar(fin == 750 && b.sensores.lecturas == 3, "una sonda que no responde no frena la lectura de las demás");
+    comprobar(cerca(b.sondas.temperaturas[0], b.bus[0].temperatura, 12) &&
+                  b.sondas.temperaturas[1] == DS18B20_ERROR && b.sondas.temperaturas[2] == DS18B20_ERROR,
+              "desconectada y CRC inválido: error solo en esas sondas");
+
+    b.bus[1].conectada = true;
+    relojMs = 2000;
+    b.sondas.iniciarConversion(12, relojMs);
+    b.leerHastaTerminar();
+    comprobar(cerca(b.sondas.temperaturas[1], b.bus[1].temperatura, 12) &&
+                  cerca(b.sondas.temperaturas[2], b.bus[2].temperatura, 12),
+              "reconectada y sin ruido, la siguiente lectura es válida");
+}
+
+static void bordes() {
+    Banco b;
+    relojMs = 5000;
+    comprobar(!b.sondas.leer(relojMs) && b.sensores.lecturas == 0, "sin iniciarConversion(), leer() devuelve false");
+
+    SensoresSimulados vacio;
+    SondasDS18B20<SensoresSimulados> ninguna(vacio);
+    ninguna.iniciarConversion(12, relojMs);
+    relojMs += 750;
+    comprobar(ninguna.leer(relojMs) && vacio.lecturas == 0, "sin sondas la lectura termina sin leer el bus");
+
+    relojMs = 0xFFFFFFFFu - 100;
+    b.sondas.iniciarConversion(12, relojMs);
+    relojMs += 749;
+    bool antes = b.sondas.leer(relojMs);
+    relojMs += 1;
+    b.sondas.leer(relojMs);
+    b.sondas.leer(relojMs);
+    bool despues = b.sondas.leer(relojMs);
+    comprobar(!antes && despues && cerca(b.sondas.temperaturas[2], b.bus[2].temperatura, 12),
+              "millis() desbordando en medio de la conversión");
+}
+
+// Bus con hasta 12 dispositivos, la NVS y el arranque de setup()
+struct Instalacion {
+    SondaSimulada bus[12];
+    SensoresSimulados sensores;
+    BusSimulado oneWire;
+    MemoriaSimulada nvs;
+    SondasDS18B20<SensoresSimulados> sondas;
+
+    explicit Instalacion(uint8_t cantidad) : sondas(sensores) {
+        for (uint8_t i = 0; i < 12; i++) {
+            bus[i].crear(0x28, 0x51A0u + i * 104729u);
+            bus[i].conectada = i < cantidad;
+        }
+        sensores.sondas = oneWire.sondas = bus;
+        sensores.cantidad = oneWire.cantidad = 12;
+    }
+
+    // Lo que hace setup(): true si usó las ROM guardadas
+    bool arrancar() {
+        sensores.begin();
+        sondas.cantidad = 0;
+        if (sondas.cargarGuardadas(nvs)) return true;
+        sondas.buscar(oneWire);
+        sondas.guardar(nvs);
+        return false;
+    }
+
+    bool tiene(uint8_t i, uint8_t sonda) const { return memcmp(sondas.roms[i], bus[sonda].rom, 8) == 0; }
+};
+
+static void arranqueConNvs() {
+    Instalacion inst(3);
+    bool cache = inst.arrancar();
+    comprobar(!cache && inst.sondas.cantidad == 3 && inst.nvs.largo == 24 && inst.oneWire.busquedas == 1,
+              "NVS vacía: se recorre el bus y se guardan 3 ROM (24 bytes)");
+    comprobar(inst.sensores.busquedas == 1, "primer arranque: 2 búsquedas, la de begin() y la de buscar()");
+    comprobar(inst.tiene(0, 0) && inst.tiene(1, 1) && inst.tiene(2, 2), "las ROM quedan en el orden de la búsqueda");
+
+    cache = inst.arrancar();
+    comprobar(cache && inst.sondas.cantidad == 3 && inst.oneWire.busquedas == 1 && inst.nvs.escrituras == 1,
+              "reinicio con las mismas sondas: se usan las ROM guardadas, sin buscar() ni escribir la flash");
+    comprobar(inst.sensores.busquedas == 2, "el reinicio hace 1 búsqueda (la de begin(), siempre) en vez de 2");
+}
+
+static void romConError() {
+    Instalacion inst(3);
+    inst.oneWire.romConRuido = 1;
+    inst.arrancar();
+    comprobar(inst.sondas.cantidad == 2 && inst.tiene(0, 0) && inst.tiene(1, 2),
+              "la ROM leída con error de CRC se descarta, las otras dos se guardan");
+
+    bool cache = inst.arrancar();
+    comprobar(!cache && inst.sondas.cantidad == 3 && inst.oneWire.busquedas == 2,
+              "próximo arranque: 2 guardadas contra 3 en el bus, se vuelve a buscar y aparecen las 3");
+}
+
+static void cambiosEnElBus() {
+    Instalacion inst(3);
+    inst.arrancar();
+
+    inst.bus[1].crear(0x28, 0xCAFE01u);  // Sonda reemplazada: otra ROM
+    bool cache = inst.arrancar();
+    comprobar(!cache && inst.sondas.cantidad == 3 && inst.tiene(1, 1),
+              "sonda reemplazada (misma cantidad, otra ROM): se detecta y se guarda la nueva");
+
+    inst.bus[3].conectada = true;  // Una sonda más
+    cache = inst.arrancar();
+    comprobar(!cache && inst.sondas.cantidad == 4, "sonda agregada: la NVS no coincide y se guardan 4");
+
+    inst.bus[0].conectada = false;  // Una sonda menos
+    cache = inst.arrancar();
+    comprobar(!cache && inst.sondas.cantidad == 3 && inst.tiene(0, 1), "sonda quitada: se guardan las 3 que quedan");
+
+    // Cambiar de lugar dos sondas en el cable no cambia su ROM
+    SondaSimulada tmp = inst.bus[1];
+    inst.bus[1] = inst.bus[3];
+    inst.bus[3] = tmp;
+    cache = inst.arrancar();
+    comprobar(cache && inst.tiene(0, 3) && inst.tiene(2, 1),
+              "sondas cambiadas de lugar: se usan las guardadas y cada índice sigue siendo la misma sonda");
+}
+
+static void otrosDispositivos() {
+    Instalacion inst(3);
+    inst.bus[3].crear(0x01, 0x2401u);  // DS2401: número de serie, no mide
+    inst.bus[3].conectada = true;
+    inst.arrancar();
+    comprobar(inst.sondas.cantidad == 3, "un DS2401 en el bus no se guarda como sonda");
+    bool cache = inst.arrancar();
+    printf("    getDeviceCount() = %u, getDS18Count() = %u\n", inst.sensores.getDeviceCount(),
+           inst.sensores.getDS18Count());
+    comprobar(cache && inst.oneWire.busquedas == 1,
+              "y no invalida la NVS: se compara con getDS18Count(), no con getDeviceCount()");
+
+    Instalacion muchas(10);
+    muchas.arrancar();
+    comprobar(muchas.sondas.cantidad == MAX_SONDAS && muchas.nvs.largo == MAX_SONDAS * 8,
+              "10 sondas en el bus: se guardan las primeras MAX_SONDAS (8)");
+
+    Instalacion rota(3);
+    rota.arrancar();
+    rota.nvs.largo = 20;  // Escritura cortada a mitad de una ROM
+    bool cacheRota = rota.arrancar();
+    comprobar(!cacheRota && rota.sondas.cantidad == 3 && rota.nvs.largo == 24,
+              "NVS con 20 bytes (no múltiplo de 8): se descarta y se vuelve a buscar");
+    rota.nvs.largo = 72;  // Más que MAX_SONDAS ROM
+    cacheRota = rota.arrancar();
+    comprobar(!cacheRota && rota.sondas.cantidad == 3, "NVS con más ROM que MAX_SONDAS: se descarta");
+}
+
+int main() {
+    printf("1-2. Dos fases con 3 sondas a 12 bits:\n");
+    dosFases();
+
+    printf("\n3. Resolución de 9 bits:\n");
+    nueveBits();
+
+    printf("\n4. Sondas recién encendidas leídas antes de tiempo:\n");
+    antesDeTiempo();
+
+    printf("\n5. Sonda desconectada y error de CRC:\n");
+    fallasDeSonda();
+
+    printf("\n6. Casos borde:\n");
+    bordes();
+
+    printf("\n7. Arranque con la NVS:\n");
+    arranqueConNvs();
+
+    printf("\n8. Error de CRC en una ROM durante la búsqueda:\n");
+    romConError();
+
+    printf("\n9. Sondas reemplazadas, agregadas, quitadas y cambiadas de lugar:\n");
+    cambiosEnElBus();
+
+    printf("\n10. Otros dispositivos, demasiadas sondas y NVS incompleta:\n");
+    otrosDispositivos();
+
+    printf("\n%s\n", fallas ? "FALLA: revisar las comprobaciones marcadas" : "OK: sondas DS18B20 verificadas");
+    return fallas ? 1 : 0;
+}
@@ -8,70 +8,137 @@ let userInteracting = false;
 let lastUserAction = 0;
 let brightnessTimeout;
 
-// Función para actualizar los datos desde el ESP32
+// true mientras el canal /api/stream (Server-Sent Events) está abierto
+let streaming = false;
+let pollTimer = null;
+
+// Canal WebSocket para el LED: tramas binarias [operación, valor]
+const WS_OP_TOGGLE = 0x01;
+const WS_OP_BRIGHTNESS = 0x02;
+let ws = null;
+
+// Mostrar los datos de /api/sensors (o del evento "sensors")
+function showSensors(d) {
+    document.getElementById('temp').innerHTML = d.temperature.toFixed(1) + '°C';
+    document.getElementById('time').innerHTML = new Date().toLocaleTimeString();
+}
+
+// Mostrar los datos de /api/led (o del evento "led")
+function showLed(d) {
+    // Solo actualizar LED si el usuario no lo está tocando (evita parpadeos)
+    const timeSinceLastAction = Date.now() - lastUserAction;
+    if (userInteracting || timeSinceLastAction <= 1000) return;
+
+    const toggle = document.getElementById('toggleLed');
+    const status = document.getElementById('ledStatus');
+    const ledVisual = document.getElementById('ledVisual');
+    
+    // Actualizar switch solo si cambió
+    if (toggle.checked !== d.state) {
+        toggle.checked = d.state;
+    }
+    
+    // Actualizar texto del estado
+    status.innerHTML = d.state ? 'LED Encendido' : 'LED Apagado';
+    
+    // Actualizar la bolita LED visual
+    if (d.state) {
+        ledVisual.classList.add('on');
+        const opacity = d.brightness / 100;
+        ledVisual.style.opacity = 0.3 + (opacity * 0.7);
+        
+        const glowIntensity = d.brightness / 100;
+        ledVisual.style.boxShadow = `
+            0 0 ${10 + glowIntensity * 10}px rgba(255,235,59,${0.3 + glowIntensity * 0.3}), 
+            0 0 ${20 + glowIntensity * 20}px rgba(255,235,59,${0.2 + glowIntensity * 0.2}),
+            0 0 ${30 + glowIntensity * 30}px rgba(255,235,59,${0.1 + glowIntensity * 0.1})
+        `;
+    } else {
+        ledVisual.classList.remove('on');
+        ledVisual.style.opacity = 1;
+        ledVisual.style.boxShadow = '0 0 10px rgba(0,0,0,0.3)';
+    }
+    
+    // Actualizar slider solo si cambió bastante
+    const currentSliderValue = parseInt(document.getElementById('brightness').value);
+    if (Math.abs(currentSliderValue - d.brightness) > 2) {
+        document.getElementById('brightValue').innerHTML = d.brightness;
+        document.getElementById('brightness').value = d.brightness;
+    }
+}
+
+// Función para actualizar los datos desde el ESP32 (modo polling)
 function update() {
     
     // Obtener temperatura del ESP32
-    fetch('/api/sensors').then(r => r.json()).then(d => {
-        document.getElementById('temp').innerHTML = d.temperature.toFixed(1) + '°C';
-        document.getElementById('time').innerHTML = new Date().toLocaleTimeString();
-    }).catch(() => {
+    fetch('/api/sensors').then(r => r.json()).then(showSensors).catch(() => {
         document.getElementById('temp').innerHTML = '--°C';
     });
     
-    // Solo actualizar LED si el usuario no lo está tocando (evita parpadeos)
-    const timeSinceLastAction = Date.now() - lastUserAction;
-    if (!userInteracting && timeSinceLastAction > 1000) {
-        fetch('/api/led').then(r => r.json()).then(d => {
-            const toggle = document.getElementById('toggleLed');
-            const status = document.getElementById('ledStatus');
-            const ledVisual = document.getElementById('ledVisual');
-            
-            // Actualizar switch solo si cambió
-            if (toggle.checked !== d.state) {
-                toggle.checked = d.state;
-            }
-            
-            // Actualizar texto del estado
-            status.innerHTML = d.state ? 'LED Encendido' : 'LED Apagado';
-            
-            // Actualizar la bolita LED visual
-            if (d.state) {
-                ledVisual.classList.add('on');
-                const opacity = d.brightness / 100;
-                ledVisual.style.opacity = 0.3 + (opacity * 0.7);
-                
-                const glowIntensity = d.brightness / 100;
-                ledVisual.style.boxShadow = `
-                    0 0 ${10 + glowIntensity * 10}px rgba(255,235,59,${0.3 + glowIntensity * 0.3}), 
-                    0 0 ${20 + glowIntensity * 20}px rgba(255,235,59,${0.2 + glowIntensity * 0.2}),
-                    0 0 ${30 + glowIntensity * 30}px rgba(255,235,59,${0.1 + glowIntensity * 0.1})
-                `;
-            } else {
-                ledVisual.classList.remove('on');
-                ledVisual.style.opacity = 1;
-                ledVisual.style.boxShadow = '0 0 10px rgba(0,0,0,0.3)';
-            }
-            
-            // Actualizar slider solo si cambió bastante
-            const currentSliderValue = parseInt(document.getElementById('brightness').value);
-            if (Math.abs(currentSliderValue - d.brightness) > 2) {
-                document.getElementById('brightValue').innerHTML = d.brightness;
-                document.getElementById('brightness').value = d.brightness;
-            }
-        }).catch(() => {
-            document.getElementById('ledStatus').innerHTML = 'Error de conexión';
-        });
+    fetch('/api/led').then(r => r.json()).then(showLed).catch(() => {
+        document.getElementById('ledStatus').innerHTML = 'Error de conexión';
+    });
+}
+
+// Consultar cada 3 segundos (solo si no hay canal SSE)
+function startPolling() {
+    if (pollTimer) return;
+    update();
+    pollTimer = setInterval(update, 3000);
+}
+
+// Recibir los cambios por Server-Sent Events: una sola conexión abierta y
+// el ESP32 envía datos solo cuando cambian (más un heartbeat cada 15 s)
+function startStream() {
+    if (!window.EventSource) {
+        startPolling();  // Navegador sin soporte SSE
+        return;
     }
+
+    const source = new EventSource('/api/stream');
+    source.addEventListener('sensors', e => showSensors(JSON.parse(e.data)));
+    source.addEventListener('led', e => showLed(JSON.parse(e.data)));
+
+    source.onopen = () => {
+        streaming = true;
+        clearInterval(pollTimer);  // Si se estaba consultando, dejar de hacerlo
+        pollTimer = null;
+    };
+
+    // EventSource reconecta solo; mientras tanto se vuelve al polling
+    source.onerror = () => {
+        streaming = false;
+        startPolling();
+    };
+}
+
+// Abrir el WebSocket de control (si se corta, se reintenta a los 3 s)
+function startSocket() {
+    if (!window.WebSocket) return;
+    ws = new WebSocket(`ws://${window.location.host}/api/ws`);
+    ws.binaryType = 'arraybuffer';
+    ws.onclose = () => setTimeout(startSocket, 3000);
+}
+
+function socketReady() {
+    return ws && ws.readyState === WebSocket.OPEN;
 }
 
-// Función para enviar comandos al ESP32
+// Función para enviar comandos al ESP32: por WebSocket si está abierto
+// (2 bytes por comando), si no con un POST como antes
 function sendCmd(action, value = null) {
+    if (socketReady()) {
+        const op = action === 'toggle' ? WS_OP_TOGGLE : WS_OP_BRIGHTNESS;
+        ws.send(new Uint8Array([op, value === null ? 0 : value]));
+        return;
+    }
+
     const fd = new FormData();
     fd.append('action', action);
     if (value !== null) fd.append('value', value);
+    // Con SSE el nuevo estado llega solo como evento "led"
     fetch('/api/led', {method: 'POST', body: fd})
-        .then(() => setTimeout(update, 100))
+        .then(() => { if (!streaming) setTimeout(update, 100); })
         .catch(console.error);
 }
 
@@ -137,7 +204,14 @@ function setupBrightnessEvents() {
         // Actualizar la bolita LED inmediatamente
         updateLedVisual(brightness);
         
-        // Esperar 300ms después de que pare de mover para enviar al ESP32
+        // Con WebSocket se envía cada movimiento: el ESP32 aplica solo el
+        // último en cada tick de PWM (20 ms)
+        if (socketReady()) {
+            sendCmd('brightness', brightness);
+            return;
+        }
+        
+        // Sin WebSocket: esperar 300ms después de que pare de mover para enviar al ESP32
         clearTimeout(brightnessTimeout);
         brightnessTimeout = setTimeout(() => {
             sendCmd('brightness', brightness);
@@ -154,11 +228,11 @@ function initDashboard() {
     setupToggleEvents();
     setupBrightnessEvents();
     
-    // Primera actualización
-    update();
+    // Canal de control del LED
+    startSocket();
     
-    // Actualizar cada 3 segundos
-    setInterval(update, 3000);
+    // Recibir actualizaciones por SSE (o polling cada 3 s si no hay soporte)
+    startStream();
 }
 
 // Iniciar todo cuando la página esté lista
@@ -0,0 +1,328 @@
+/*
+    Registro de actuadores PWM: N canales LEDC con polaridad, curva de
+    brillo y estado, en una tabla de estructura de arreglos (SoA).
+
+    Cada propiedad es un arreglo (o una máscara de bits) indexado por el
+    id del actuador: recorrer "qué canales cambiaron" toca solo la máscara
+    de pendientes, y el estado de los 6 canales entra en unos 30 bytes.
+
+        Actuadores actuadores;
+
+        // En setup():
+        actuadores.configurarPwm(5000);        // Misma frecuencia para todos
+        uint8_t led = actuadores.agregar(LED_PIN, LED_ACTIVO_BAJO, CURVA_GAMMA);
+        actuadores.aplicar();
+
+        // Desde cualquier tarea (handlers HTTP, WebSocket):
+        actuadores.fijarBrillo(led, 75);       // Solo cambia la tabla
+
+        // En loop(), cada tick de PWM:
+        actuadores.aplicar();                  // Escribe al LEDC lo que cambió
+
+    Los cambios se guardan en la tabla con una sección crítica y se marcan
+    como pendientes; aplicar() escribe al LEDC una sola vez por canal y por
+    tick, aunque entre dos ticks hayan llegado muchos comandos.
+
+    Sin ARDUINO (tools/latencia_ws.cpp en la PC) la herramienta define
+    ledcSetup(), ledcWrite() y ledcAttachPin(), y la sección crítica es
+    un spinlock con std::atomic_flag.
+*/
+
+#pragma once
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+double ledcSetup(uint8_t canal, double frecuencia, uint8_t bits);
+void ledcWrite(uint8_t canal, uint32_t duty);
+void ledcAttachPin(uint8_t pin, uint8_t canal);
+typedef std::atomic_flag portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED ATOMIC_FLAG_INIT
+#define portENTER_CRITICAL(mux) while ((mux)->test_and_set(std::memory_order_acquire)) {}
+#define portEXIT_CRITICAL(mux) (mux)->clear(std::memory_order_release)
+#endif
+
+#include "pwm_resolucion.h"
+
+// 6 = canales LEDC del ESP32-C3 (el ESP32 clásico tiene 16)
+#ifndef ACTUADORES_MAX
+#define ACTUADORES_MAX 6
+#endif
+
+#define ACTUADOR_INVALIDO 0xFF
+
+enum CurvaActuador : uint8_t {
+    CURVA_GAMMA,   // Brillo percibido lineal (LEDs)
+    CURVA_LINEAL,  // Duty proporcional (motores, ventiladores)
+};
+
+// Operaciones de un comando; los valores coinciden con las tramas del
+// WebSocket del dashboard ([operación, valor])
+enum OpActuador : uint8_t {
+    OP_ALTERNAR = 0x01,  // Valor ignorado
+    OP_BRILLO   = 0x02,  // Valor = brillo 0-100 (0 apaga)
+    OP_ESTADO   = 0x03,  // Valor = 0 apagado, 1 encendido
+};
+
+struct ComandoActuador {
+    uint8_t id;
+    OpActuador op;
+    uint8_t valor;
+};
+
+// Trama binaria del WebSocket: [operación, valor]. Solo alternar y brillo
+// (el brillo se limita a 100). false si la trama no es válida
+inline bool comandoDeTrama(const uint8_t *trama, size_t largo, uint8_t id, ComandoActuador &c) {
+    if (largo != 2) return false;
+    if (trama[0] == OP_BRILLO) {
+        c = {id, OP_BRILLO, (uint8_t)(trama[1] > 100 ? 100 : trama[1])};
+    } else if (trama[0] == OP_ALTERNAR) {
+        c = {id, OP_ALTERNAR, 0};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Reglas de un comando sobre el brillo y la máscara de encendidos: el
+// brillo define el estado (0 = apagado) y el toggle no toca el brillo.
+// Las usa la tabla y también quien quiera prever el resultado sin tocarla
+inline void aplicarAEstado(const ComandoActuador &c, uint8_t *brillo, uint32_t &encendidos) {
+    uint32_t bit = 1u << c.id;
+    switch (c.op) {
+        case OP_BRILLO:
+            brillo[c.id] = c.valor;
+            if (c.valor > 0) encendidos |= bit; else encendidos &= ~bit;
+            break;
+        case OP_ESTADO:
+            if (c.valor) encendidos |= bit; else encendidos &= ~bit;
+            break;
+        case OP_ALTERNAR:
+            encendidos ^= bit;
+            break;
+    }
+}
+
+// Lote de comandos en texto, "id:acción" separados por comas:
+//   "0:75,1:on,2:off,3:toggle"   (número = brillo 0-100)
+// Devuelve la cantidad de comandos o -1 si el texto no es válido
+inline int parsearComandos(const char *texto, ComandoActuador *comandos, uint8_t maximo) {
+    int cantidad = 0;
+    while (*texto) {
+        if (cantidad >= maximo) return -1;
+        ComandoActuador &c = comandos[cantidad++];
+
+        // id
+        if (*texto < '0' || *texto > '9') return -1;
+        uint32_t id = 0;
+        while (*texto >= '0' && *texto <= '9' && id < 256) id = id * 10 + (*texto++ - '0');
+        if (id > 255 || *texto++ != ':') return -1;
+        c.id = (uint8_t)id;
+
+        // acción
+        if (*texto >= '0' && *texto <= '9') {
+            uint32_t valor = 0;
+            while (*texto >= '0' && *texto <= '9' && valor <= 100) valor = valor * 10 + (*texto++ - '0');
+            if (valor > 100) return -1;
+            c.op = OP_BRILLO;
+            c.valor = (uint8_t)valor;
+        } else if (strncmp(texto, "on", 2) == 0) {
+            c.op = OP_ESTADO;
+            c.valor = 1;
+            texto += 2;
+        } else if (strncmp(texto, "off", 3) == 0) {
+            c.op = OP_ESTADO;
+            c.valor = 0;
+            texto += 3;
+        } else if (strncmp(texto, "toggle", 6) == 0) {
+            c.op = OP_ALTERNAR;
+            c.valor = 0;
+            texto += 6;
+        } else {
+            return -1;
+        }
+
+        if (*texto == ',') {
+            texto++;
+            if (!*texto) return -1;  // Coma final sin comando
+        } else if (*texto) {
+            return -1;
+        }
+    }
+    return cantidad;
+}
+
+class Actuadores {
+public:
+    // Registra un actuador en el canal LEDC siguiente. Devuelve su id o
+    // ACTUADOR_INVALIDO si no quedan canales. Solo desde setup()
+    uint8_t agregar(uint8_t pin, bool activoBajo, CurvaActuador curva) {
+        if (_cantidad >= ACTUADORES_MAX) return ACTUADOR_INVALIDO;
+        uint8_t id = _cantidad++;
+        _pin[id] = pin;
+        _curva[id] = curva;
+        _brillo[id] = 50;
+        if (activoBajo) _activoBajo |= 1u << id;
+        _pendientes |= 1u << id;
+        if (_bits) ledcSetup(id, _frecuencia, _bits);  // PWM ya configurado
+        ledcAttachPin(pin, id);
+        return id;
+    }
+
+    // Frecuencia común a todos los canales con la mayor resolución posible
+    // (pwm_resolucion.h). Se aplica en el próximo aplicar(). false si la
+    // frecuencia no admite al menos 8 bits
+    bool configurarPwm(uint32_t frecuencia) {
+        uint8_t bits = bitsParaFrecuencia(frecuencia);
+        if (bits == 0) return false;
+        const uint16_t *gamma = tablaGammaPorcentaje(bits);
+        uint8_t niveles = nivelesDistintos(gamma);
+
+        portENTER_CRITICAL(&_mux);
+        _frecuencia = frecuencia;
+        _bits = bits;
+        _gamma = gamma;
+        _niveles = niveles;
+        _reconfigurar = true;
+        _pendientes = mascaraTodos();  // El duty cambia de escala
+        portEXIT_CRITICAL(&_mux);
+        return true;
+    }
+
+    // Comandos: cambian la tabla y marcan el canal para el próximo tick
+    bool ejecutar(const ComandoActuador &c) { return ejecutarLote(&c, 1); }
+
+    // true si todos los comandos son aplicables (ids existentes, valores
+    // en rango). Solo lee la configuración fija después de setup()
+    bool validarLote(const ComandoActuador *comandos, uint8_t cantidad) const {
+        for (uint8_t i = 0; i < cantidad; i++) {
+            if (!valido(comandos[i])) return false;
+        }
+        return true;
+    }
+
+    // Todos los comandos o ninguno: si alguno no es válido no se aplica
+    // nada. Se toman juntos, así que salen al LEDC en el mismo tick
+    bool ejecutarLote(const ComandoActuador *comandos, uint8_t cantidad) {
+        if (!validarLote(comandos, cantidad)) return false;
+        portENTER_CRITICAL(&_mux);
+        for (uint8_t i = 0; i < cantidad; i++) aplicarComando(comandos[i]);
+        portEXIT_CRITICAL(&_mux);
+        return true;
+    }
+
+    bool fijarBrillo(uint8_t id, uint8_t brillo) { return ejecutar({id, OP_BRILLO, brillo}); }
+    bool fijarEstado(uint8_t id, bool encendido) { return ejecutar({id, OP_ESTADO, encendido}); }
+    bool alternar(uint8_t id) { return ejecutar({id, OP_ALTERNAR, 0}); }
+
+    // Tick de PWM (loop): escribe el duty de los canales pendientes.
+    // Devuelve la máscara de canales escritos (0 = nada cambió)
+    uint32_t aplicar() {
+        if (_bits == 0) return 0;  // Falta configurarPwm()
+        uint16_t duty[ACTUADORES_MAX];
+        portENTER_CRITICAL(&_mux);
+        uint32_t pendientes = _pendientes;
+        bool reconfigurar = _reconfigurar;
+        uint32_t frecuencia = _frecuencia;
+        uint8_t bits = _bits;
+        for (uint8_t id = 0; id < _cantidad; id++) {
+            if (pendientes & (1u << id)) duty[id] = calcularDuty(id);
+        }
+        _pendientes = 0;
+        _reconfigurar = false;
+        portEXIT_CRITICAL(&_mux);
+
+        // ledcSetup() y ledcWrite() fuera de la sección crítica (usan sus
+        // propios locks del driver). ledcSetup() devuelve 0 si el timer no
+        // admite la frecuencia: se vuelve a la última que funcionó
+        if (reconfigurar) {
+            bool ok = true;
+            for (uint8_t id = 0; id < _cantidad && ok; id++) ok = ledcSetup(id, frecuencia, bits) != 0;
+            if (!ok) return restaurarPwm();
+            _frecuenciaAplicada = frecuencia;
+        }
+        for (uint8_t id = 0; id < _cantidad; id++) {
+            if (pendientes & (1u << id)) ledcWrite(id, duty[id]);
+        }
+        return pendientes;
+    }
+
+    // Lecturas: cada valor ocupa una palabra, se pueden leer desde cualquier tarea
+    uint8_t cantidad() const { return _cantidad; }
+    uint8_t pin(uint8_t id) const { return _pin[id]; }
+    uint8_t brillo(uint8_t id) const { return _brillo[id]; }
+    bool encendido(uint8_t id) const { return _encendidos & (1u << id); }
+    bool activoBajo(uint8_t id) const { return _activoBajo & (1u << id); }
+    CurvaActuador curva(uint8_t id) const { return (CurvaActuador)_curva[id]; }
+    uint32_t frecuencia() const { return _frecuencia; }
+    uint8_t bits() const { return _bits; }
+    uint8_t niveles() const { return _niveles; }  // Duty distintos del slider (curva gamma)
+    uint32_t fallasPwm() const { return _fallasPwm; }  // ledcSetup() rechazados
+
+private:
+    static_assert(ACTUADORES_MAX <= 32, "Las máscaras de bits son de 32 bits");
+
+    uint32_t mascaraTodos() const { return _cantidad >= 32 ? 0xFFFFFFFFu : (1u << _cantidad) - 1; }
+
+    // ledcSetup() falló: la configuración anterior (o ninguna) se vuelve a
+    // aplicar en el próximo tick. No escribe nada en este
+    uint32_t restaurarPwm() {
+        _fallasPwm++;
+        uint32_t anterior = _frecuenciaAplicada;
+        _frecuenciaAplicada = 0;
+        portENTER_CRITICAL(&_mux);
+        _frecuencia = 0;
+        _bits = 0;  // aplicar() no escribe duty con una escala que no está en el LEDC
+        _niveles = 0;
+        _gamma = nullptr;
+        portEXIT_CRITICAL(&_mux);
+        if (anterior) configurarPwm(anterior);
+        return 0;
+    }
+
+    bool valido(const ComandoActuador &c) const {
+        if (c.id >= _cantidad) return false;
+        if (c.op == OP_BRILLO) return c.valor <= 100;
+        if (c.op == OP_ESTADO) return c.valor <= 1;
+        return c.op == OP_ALTERNAR;
+    }
+
+    // Dentro de la sección crítica
+    void aplicarComando(const ComandoActuador &c) {
+        aplicarAEstado(c, _brillo, _encendidos);
+        _pendientes |= 1u << c.id;
+    }
+
+    // Duty según curva y polaridad, en la escala de la resolución actual
+    uint16_t calcularDuty(uint8_t id) const {
+        uint16_t maximo = (1u << _bits) - 1;
+        uint16_t v = 0;
+        if (encendido(id)) {
+            v = _curva[id] == CURVA_GAMMA ? _gamma[_brillo[id]] : (uint32_t)_brillo[id] * maximo / 100;
+        }
+        return activoBajo(id) ? maximo - v : v;
+    }
+
+    // Tabla SoA: una entrada por actuador en cada arreglo
+    uint8_t _pin[ACTUADORES_MAX];
+    uint8_t _curva[ACTUADORES_MAX];
+    uint8_t _brillo[ACTUADORES_MAX];  // 0-100 %, se conserva al apagar
+    uint32_t _activoBajo = 0;         // Bit id: el LED enciende con el pin en LOW
+    uint32_t _encendidos = 0;         // Bit id: encendido
+    uint32_t _pendientes = 0;         // Bit id: duty por escribir en el próximo tick
+    uint8_t _cantidad = 0;
+
+    // Configuración PWM común
+    uint32_t _frecuencia = 0;
+    uint8_t _bits = 0;
+    uint8_t _niveles = 0;
+    const uint16_t *_gamma = nullptr;
+    bool _reconfigurar = false;
+    uint32_t _frecuenciaAplicada = 0;  // Última aceptada por ledcSetup() (solo aplicar())
+    uint32_t _fallasPwm = 0;
+
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+};
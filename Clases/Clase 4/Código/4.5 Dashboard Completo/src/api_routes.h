@@ -0,0 +1,28 @@
+/*
+    Endpoints de la API REST del dashboard.
+
+    tools/gen_route_table.py lee esta lista al compilar y la incluye en la
+    tabla de rutas con hash perfecto (src/route_table.h). Para agregar un
+    endpoint: sumar una línea a API_ROUTES (identificador y ruta) y su
+    entrada en apiHandlers[] de main.cpp.
+
+    /api/stream (Server-Sent Events) no figura acá: lo atiende
+    AsyncEventSource, registrado con server.addHandler() en setup().
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#define API_ROUTES(X)                       \
+    X(API_SENSORS,   "/api/sensors")        \
+    X(API_LED,       "/api/led")            \
+    X(API_ACTUATORS, "/api/actuators")   \
+    X(API_BOOT,      "/api/boot")
+
+enum ApiId : int8_t {
+#define X(id, path) id,
+    API_ROUTES(X)
+#undef X
+    API_COUNT
+};
@@ -0,0 +1,131 @@
+/*
+    Tamaño y ETag de los archivos estáticos, medidos al montar LittleFS.
+
+    route_table.h (generado al compilar) solo dice qué archivo abrir para
+    cada URL. Lo que depende del contenido se toma de la imagen LittleFS
+    que está realmente en la flash, leyendo cada archivo una sola vez:
+
+        archivos.cargar(LittleFS);                      // Al montar
+        RespuestaArchivo r = archivos.elegir(*route, aceptaGzip, ifNoneMatch);
+        // r.codigo: 200 (abrir r.archivo), 304 (sin cuerpo) o 404
+
+    El ETag es el FNV-1a del contenido de cada variante ("1a2b3c4d" y
+    "5e6f7a8b-gz"): si se sube una imagen LittleFS nueva sin recompilar,
+    los ETag cambian y el navegador no recibe un 304 viejo. Las rutas que
+    comparten archivo ("/" e "/index.html") comparten la medición.
+
+    No depende de Arduino.h: el sistema de archivos es cualquier clase con
+    open(ruta, "r") que devuelva un archivo con size(), read(buf, n),
+    close() y conversión a bool (LittleFS en el ESP32, uno simulado en
+    tools/).
+
+    Copia idéntica en 4.5 Dashboard Completo y en Final: cada carpeta es
+    un proyecto de PlatformIO independiente. Un cambio va en las dos;
+    python3 Clases/verificar_copias.py avisa si quedaron distintas.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "route_table.h"
+
+struct ArchivoEstatico {
+    uint32_t size;      // Tamaño del original
+    uint32_t gzSize;    // Tamaño de la variante .gz
+    char etag[11];      // "\"1a2b3c4d\"", vacío si el archivo no está
+    char etagGz[14];    // "\"1a2b3c4d-gz\"", vacío si no hay .gz
+};
+
+struct RespuestaArchivo {
+    uint16_t codigo;      // 200, 304 o 404
+    bool gzip;
+    const char *archivo;  // Qué abrir (solo con 200)
+    uint32_t bytes;       // Tamaño del cuerpo (solo con 200)
+    const char *etag;     // nullptr con 404
+};
+
+class ArchivosEstaticos {
+public:
+    // Mide todos los archivos de la tabla de rutas
+    template <typename Fs>
+    void cargar(Fs &fs) {
+        // Primero los archivos con su propia URL, después los alias
+        for (uint32_t i = 0; i < ROUTE_SIZE; i++) {
+            const Route &route = ROUTES[i];
+            _archivos[i] = ArchivoEstatico();
+            if (route.file && strcmp(route.path, route.file) == 0) medir(fs, route, _archivos[i]);
+        }
+        for (uint32_t i = 0; i < ROUTE_SIZE; i++) {
+            const Route &route = ROUTES[i];
+            if (!route.file || strcmp(route.path, route.file) == 0) continue;
+            const Route *original = findRoute(route.file);
+            if (original && original->file) {
+                _archivos[i] = _archivos[original - ROUTES];
+            } else {
+                medir(fs, route, _archivos[i]);
+            }
+        }
+    }
+
+    const ArchivoEstatico &info(const Route &route) const { return _archivos[&route - ROUTES]; }
+
+    // aceptaGzip: Accept-Encoding incluye gzip. ifNoneMatch: la cabecera o nullptr
+    RespuestaArchivo elegir(const Route &route, bool aceptaGzip, const char *ifNoneMatch) const {
+        RespuestaArchivo r = {404, false, nullptr, 0, nullptr};
+        const ArchivoEstatico &a = info(route);
+        if (!route.file || !a.etag[0]) return r;
+
+        // Elegir la variante comprimida si el navegador la acepta
+        r.gzip = aceptaGzip && a.etagGz[0];
+        r.etag = r.gzip ? a.etagGz : a.etag;
+
+        // El navegador ya tiene esta versión: 304 sin abrir el archivo
+        if (ifNoneMatch && strstr(ifNoneMatch, r.etag)) {
+            r.codigo = 304;
+            return r;
+        }
+        r.codigo = 200;
+        r.archivo = r.gzip ? route.gzFile : route.file;
+        r.bytes = r.gzip ? a.gzSize : a.size;
+        return r;
+    }
+
+private:
+    template <typename Fs>
+    static void medir(Fs &fs, const Route &route, ArchivoEstatico &a) {
+        uint32_t hash;
+        if (leer(fs, route.file, a.size, hash)) {
+            snprintf(a.etag, sizeof(a.etag), "\"%08x\"", (unsigned)hash);
+        }
+        if (route.gzFile && leer(fs, route.gzFile, a.gzSize, hash)) {
+            snprintf(a.etagGz, sizeof(a.etagGz), "\"%08x-gz\"", (unsigned)hash);
+        }
+    }
+
+    // Tamaño y FNV-1a de 32 bits del contenido, leyendo de a 256 bytes
+    template <typename Fs>
+    static bool leer(Fs &fs, const char *ruta, uint32_t &size, uint32_t &hash) {
+        auto file = fs.open(ruta, "r");
+        if (!file) return false;
+        size = file.size();
+        hash = 2166136261u;
+        uint8_t buf[256];
+        size_t n;
+        while ((n = file.read(buf, sizeof(buf))) > 0) {
+            for (size_t i = 0; i < n; i++) hash = (hash ^ buf[i]) * 16777619u;
+        }
+        file.close();
+        return true;
+    }
+
+    ArchivoEstatico _archivos[ROUTE_SIZE] = {};
+};
+
+// "/" e "/index.html". Si no se pueden servir desde LittleFS (no montó,
+// o LittleFS.begin(true) lo formateó vacío porque nunca se subió la
+// imagen con uploadfs) se responde con la página básica, no con 404
+inline bool esPaginaPrincipal(const Route &route) {
+    return route.file && strcmp(route.file, "/index.html") == 0;
+}
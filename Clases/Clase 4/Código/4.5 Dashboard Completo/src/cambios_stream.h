@@ -0,0 +1,59 @@
+/*
+    Qué enviar por /api/stream (SSE) en cada tick de la tarea de red.
+
+    Guarda los últimos valores enviados y devuelve qué eventos hacen
+    falta: "sensors" si la temperatura cambió 0.1°C o más, "led" si
+    cambió el estado o el brillo, y los dos si pasó el intervalo de
+    heartbeat sin enviar nada.
+
+        CambiosStream cambios(15000);
+
+        uint8_t enviar = cambios.revisar(temp, encendido, brillo, millis());
+        if (enviar & EVENTO_SENSORES) sendSensorsEvent(e);
+        if (enviar & EVENTO_LED) sendLedEvent(e);
+
+    No depende de Arduino.h: tools/comparar_sse.cpp la usa en la PC para
+    contar bytes y llamadas por minuto contra el polling.
+*/
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#define STREAM_UMBRAL_TEMPERATURA 0.1f  // °C
+
+enum EventoStream : uint8_t {
+    EVENTO_SENSORES = 1,
+    EVENTO_LED = 2,
+};
+
+class CambiosStream {
+public:
+    explicit CambiosStream(uint32_t heartbeatMs) : _heartbeatMs(heartbeatMs) {}
+
+    uint8_t revisar(float temperatura, bool encendido, uint8_t brillo, uint32_t ahora) {
+        bool heartbeat = ahora - _ultimoEnvio > _heartbeatMs;
+        uint8_t enviar = 0;
+
+        // !(x < umbral) también es verdadero con NaN (primer envío)
+        if (heartbeat || !(fabsf(temperatura - _temperatura) < STREAM_UMBRAL_TEMPERATURA)) {
+            _temperatura = temperatura;
+            enviar |= EVENTO_SENSORES;
+        }
+        if (heartbeat || encendido != _encendido || brillo != _brillo) {
+            _encendido = encendido;
+            _brillo = brillo;
+            enviar |= EVENTO_LED;
+        }
+        if (enviar) _ultimoEnvio = ahora;
+        return enviar;
+    }
+
+private:
+    uint32_t _heartbeatMs;
+    uint32_t _ultimoEnvio = 0;
+    float _temperatura = NAN;
+    bool _encendido = false;
+    uint8_t _brillo = 0;
+};
@@ -0,0 +1,141 @@
+/*
+    Cola sin locks de un productor y un consumidor (SPSC).
+
+    Un arreglo circular de N elementos con dos índices: solo el
+    productor escribe _escritura y solo el consumidor escribe _lectura.
+    Cada lado lee el índice del otro con acquire y publica el suyo con
+    release, así el elemento está completo antes de que el otro lado lo
+    vea. No hay secciones críticas ni mutex: enviar() y recibir() nunca
+    bloquean, y sirven entre tareas de distintos núcleos.
+
+        ColaSpsc<LecturaSensores, 8> colaLecturas;
+
+        // Tarea de sensores (único productor):
+        if (!colaLecturas.enviar(lectura)) {
+            // Llena: se descarta (colaLecturas.perdidos() lo cuenta)
+        }
+
+        // Tarea de control (único consumidor):
+        LecturaSensores l;
+        while (colaLecturas.recibir(l)) { ... }
+
+    Con más de un productor o más de un consumidor NO es segura: cada
+    lado tiene que ser siempre la misma tarea.
+
+    UltimoValor es un buzón de un solo byte para datos en los que solo
+    importa el más nuevo (el brillo del slider): dejar() sobrescribe y
+    tomar() se lleva el último, así una ráfaga nunca llena la cola ni
+    pierde el valor final.
+
+        UltimoValor brilloSlider;
+        brilloSlider.dejar(75);                // Productor
+        uint8_t b;
+        if (brilloSlider.tomar(b)) { ... }     // Consumidor
+
+    Si el buzón y una cola llevan comandos que se pisan entre sí (brillo
+    y toggle del mismo LED), el valor se deja con la posición de la cola
+    en ese momento (escritos()) y el consumidor lo toma con tomarHasta()
+    entre un elemento y el siguiente, así se aplica detrás de lo que se
+    encoló antes y delante de lo que vino después:
+
+        brilloSlider.dejar(75, colaPedidos.escritos());      // Productor
+
+        for (;;) {                                           // Consumidor
+            uint32_t indice = colaPedidos.leidos();
+            bool hay = colaPedidos.recibir(pedido);
+            if (brilloSlider.tomarHasta(indice, b)) { ... }  // Antes del pedido
+            if (!hay) break;
+            ...
+        }
+
+    Recién después de recibir se mira el buzón: el productor deja el
+    valor antes de encolar lo siguiente, así que si el pedido ya se ve,
+    el valor que iba antes también.
+
+    No depende de Arduino.h: tools/estres_concurrencia.cpp la prueba en
+    la PC con hilos y ThreadSanitizer.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, uint16_t N>
+class ColaSpsc {
+public:
+    // Productor. false (sin copiar) si la cola está llena
+    bool enviar(const T &valor) {
+        uint32_t escritura = _escritura.load(std::memory_order_relaxed);
+        if (escritura - _lectura.load(std::memory_order_acquire) >= N) {
+            _perdidos.store(_perdidos.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        _datos[escritura % N] = valor;
+        _escritura.store(escritura + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor. false si la cola está vacía
+    bool recibir(T &valor) {
+        uint32_t lectura = _lectura.load(std::memory_order_relaxed);
+        if (lectura == _escritura.load(std::memory_order_acquire)) return false;
+        valor = _datos[lectura % N];
+        _lectura.store(lectura + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Elementos descartados por cola llena (lo escribe solo el productor)
+    uint32_t perdidos() const { return _perdidos.load(std::memory_order_relaxed); }
+
+    // Posición del próximo elemento a encolar (productor) y del próximo a
+    // recibir (consumidor). Cuentan sin volver a 0; los descartados no
+    uint32_t escritos() const { return _escritura.load(std::memory_order_relaxed); }
+    uint32_t leidos() const { return _lectura.load(std::memory_order_relaxed); }
+
+private:
+    // Los índices cuentan sin volver a 0 (la resta sobrevive al desborde)
+    static_assert(N > 0 && (N & (N - 1)) == 0, "N tiene que ser potencia de 2");
+
+    T _datos[N];
+    std::atomic<uint32_t> _escritura{0};  // Próxima posición libre (productor)
+    std::atomic<uint32_t> _lectura{0};    // Próximo elemento a leer (consumidor)
+    std::atomic<uint32_t> _perdidos{0};
+};
+
+class UltimoValor {
+public:
+    // marca: posición de la cola que ordena al buzón (ColaSpsc::escritos())
+    void dejar(uint8_t valor, uint32_t marca = 0) {
+        _valor.store(LLENO | (marca & MARCA) << 8 | valor, std::memory_order_release);
+    }
+
+    // false si no hay nada nuevo desde el último tomar()
+    bool tomar(uint8_t &valor) {
+        uint32_t v = _valor.exchange(VACIO, std::memory_order_acq_rel);
+        if (!(v & LLENO)) return false;
+        valor = (uint8_t)v;
+        return true;
+    }
+
+    // Como tomar(), pero solo si el valor se dejó cuando la cola iba por
+    // indice o antes; si es posterior queda en el buzón
+    bool tomarHasta(uint32_t indice, uint8_t &valor) {
+        uint32_t v = _valor.load(std::memory_order_acquire);
+        do {
+            if (!(v & LLENO)) return false;
+            uint32_t marca = (v >> 8) & MARCA;
+            if (((indice - marca) & MARCA) > MARCA / 2) return false;  // Después de indice
+        } while (!_valor.compare_exchange_weak(v, VACIO, std::memory_order_acq_rel));
+        valor = (uint8_t)v;
+        return true;
+    }
+
+private:
+    // Valor (8 bits), marca (23 bits) y bit de lleno en una sola palabra,
+    // así se escriben y se toman juntos sin lock
+    static const uint32_t VACIO = 0;
+    static const uint32_t LLENO = 0x80000000u;
+    static const uint32_t MARCA = 0x7FFFFF;
+    std::atomic<uint32_t> _valor{VACIO};
+};
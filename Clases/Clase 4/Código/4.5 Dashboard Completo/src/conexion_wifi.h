@@ -0,0 +1,310 @@
+/*
+    Conexión WiFi como máquina de estados, sin delay().
+
+    Sigue los estados de Clase 4/Diagramas/wifi_conexion_estados.pu:
+
+        INICIALIZACION -> CONECTANDO ------------------> CONECTADO <-> VERIFICANDO
+                              | timeout o falla          ^    | corte        |
+                              v                          |    v              |
+                        ERROR_CONEXION            REINTENTANDO <- CONEXION_PERDIDA
+                              |  espera (backoff)   ^    |
+                              +---------------------+    | WIFI_INTENTOS_MAX
+                                                         v
+                                                   DESCONECTADO (reintenta cada ~30 s)
+
+    actualizar() revisa los eventos y el tiempo y devuelve enseguida: la
+    espera entre intentos es un instante futuro guardado, no un delay().
+    Los eventos de WiFi (IP obtenida, desconexión) llegan desde la tarea
+    de eventos de Arduino; alConectar() y alDesconectar() solo los marcan
+    en una variable atómica y actualizar() los procesa en su tarea.
+
+    Entre intentos fallidos la espera crece al doble (1 s, 2 s, 4 s...)
+    hasta 30 s, con jitter: se elige al azar entre la mitad y el total,
+    para que varios equipos que perdieron el mismo AP no reintenten todos
+    a la vez. Después de WIFI_INTENTOS_MAX intentos pasa a DESCONECTADO y
+    sigue probando cada ~30 s.
+
+    Conexión rápida: si la radio tiene guardados el BSSID, el canal y la
+    IP de la última conexión (cache_wifi.h), el primer intento va directo
+    a ese AP sin escanear ni pedir DHCP, con un timeout corto. Si falla
+    (el AP cambió de canal, otra red) se reintenta enseguida con el
+    escaneo completo, sin esperar el backoff.
+
+        RadioArduino radio(ssid, password);
+        ConexionWifi<RadioArduino> wifi(radio);
+
+        // En setup():
+        WiFi.onEvent(onWifiEvent);       // Llama a alConectar()/alDesconectar()
+        wifi.iniciar(millis());
+
+        // Periódicamente (tarea "wifi"):
+        wifi.actualizar(millis());
+
+    La radio es un parámetro: en el ESP32 usa WiFi.begin()/disconnect();
+    en la PC, tools/sim_conexion_wifi.cpp simula un AP que se cae para
+    medir cuánto bloquea cada llamada.
+
+    La misma máquina de estados está en 4.5 Dashboard Completo y en
+    Final, copiada tal cual porque cada sketch compila por separado; el
+    simulador vive en 4.5/tools. Un arreglo va en las dos copias
+    (python3 Clases/verificar_copias.py detecta si difieren).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+#ifndef WIFI_BACKOFF_BASE_MS
+#define WIFI_BACKOFF_BASE_MS     1000    // Espera después del primer fallo
+#endif
+#ifndef WIFI_BACKOFF_MAX_MS
+#define WIFI_BACKOFF_MAX_MS      30000   // Tope (y período en DESCONECTADO)
+#endif
+#define WIFI_TIMEOUT_CONEXION_MS 30000   // Primer WiFi.begin() (DHCP incluido)
+#define WIFI_TIMEOUT_RAPIDO_MS   3000    // Primer intento con BSSID, canal e IP guardados
+#define WIFI_TIMEOUT_INTENTO_MS  10000   // Cada reintento
+#define WIFI_INTENTOS_MAX        10      // Después: DESCONECTADO
+#define WIFI_VERIFICACION_MS     10000   // CONECTADO -> VERIFICANDO
+#define WIFI_RAZON_PROPIA        8       // WIFI_REASON_ASSOC_LEAVE: el corte lo pidió reconectar()
+
+enum EstadoWifi : uint8_t {
+    WIFI_INICIALIZACION,
+    WIFI_CONECTANDO,
+    WIFI_CONECTADO,
+    WIFI_VERIFICANDO,
+    WIFI_ERROR_CONEXION,
+    WIFI_REINTENTANDO,
+    WIFI_DESCONECTADO,
+    WIFI_CONEXION_PERDIDA,
+};
+
+inline const char *nombreEstadoWifi(EstadoWifi estado) {
+    static const char *const nombres[] = {"INICIALIZACION",  "CONECTANDO",   "CONECTADO",    "VERIFICANDO",
+                                          "ERROR_CONEXION",  "REINTENTANDO", "DESCONECTADO", "CONEXION_PERDIDA"};
+    return estado <= WIFI_CONEXION_PERDIDA ? nombres[estado] : "?";
+}
+
+// Radio: conectar() (primer begin; true si usa los datos guardados de la
+// última conexión), reconectar() (escaneo completo), conectada() (aviso
+// al conectar, para guardar esos datos), conectado() (estado actual, sin
+// esperar) y aleatorio() (para el jitter)
+template <typename Radio>
+class ConexionWifi {
+public:
+    typedef void (*AlCambiar)(EstadoWifi anterior, EstadoWifi nuevo);
+
+    explicit ConexionWifi(Radio &radio) : _radio(radio) {}
+
+    // Aviso en cada cambio de estado (log, banner con la IP). Se llama
+    // desde actualizar(), en la tarea dueña
+    void alCambiar(AlCambiar funcion) { _alCambiar = funcion; }
+
+    // INICIALIZACION -> CONECTANDO: inicia la conexión y vuelve
+    void iniciar(uint32_t ahoraMs) {
+        cambiar(WIFI_INICIALIZACION, ahoraMs);
+        _intentos = 1;
+        _rapido = _radio.conectar();
+        cambiar(WIFI_CONECTANDO, ahoraMs);
+        _limite = ahoraMs + (_rapido ? WIFI_TIMEOUT_RAPIDO_MS : WIFI_TIMEOUT_CONEXION_MS);
+    }
+
+    // Eventos, desde cualquier tarea: solo se marcan. El corte que provoca
+    // reconectar() (WiFi.disconnect()) no es una falla del intento nuevo
+    void alConectar() { _eventos.fetch_or(EVENTO_CONECTADO); }
+    void alDesconectar(uint8_t razon) {
+        if (razon == WIFI_RAZON_PROPIA) return;
+        _razon.store(razon);
+        _eventos.fetch_or(EVENTO_DESCONECTADO);
+    }
+
+    // Procesa eventos y tiempos. Nunca espera: como mucho llama a
+    // reconectar(), que solo inicia el intento
+    void actualizar(uint32_t ahoraMs) {
+        uint8_t eventos = _eventos.exchange(0);
+        // Con los dos eventos juntos no se sabe el orden: manda la radio
+        bool conectado = eventos == (EVENTO_CONECTADO | EVENTO_DESCONECTADO) ? _radio.conectado()
+                                                                             : eventos == EVENTO_CONECTADO;
+        bool desconectado = eventos && !conectado;
+        if (desconectado) _ultimaRazon = _razon.load();
+
+        switch (_estado) {
+            case WIFI_INICIALIZACION:
+                break;
+
+            case WIFI_CONECTANDO:
+            case WIFI_REINTENTANDO:
+                if (conectado) {
+                    conexionLista(ahoraMs);
+                } else if (desconectado || vencio(ahoraMs)) {
+                    if (_rapido) {
+                        // Los datos guardados ya no sirven: escaneo completo
+                        // enseguida, como primer intento
+                        cambiar(WIFI_ERROR_CONEXION, ahoraMs);
+                        _intentos = 0;
+                        reintentar(ahoraMs);
+                    } else if (_intentos >= WIFI_INTENTOS_MAX) {
+                        cambiar(WIFI_DESCONECTADO, ahoraMs);
+                        _limite = ahoraMs + espera(WIFI_BACKOFF_MAX_MS);
+                    } else {
+                        cambiar(WIFI_ERROR_CONEXION, ahoraMs);
+                        _limite = ahoraMs + espera(backoff());
+                    }
+                }
+                break;
+
+            case WIFI_CONECTADO:
+                if (desconectado) {
+                    perdida(ahoraMs);
+                } else if (vencio(ahoraMs)) {
+                    // Verificación periódica: por si se perdió un evento
+                    cambiar(WIFI_VERIFICANDO, ahoraMs);
+                    if (_radio.conectado()) {
+                        cambiar(WIFI_CONECTADO, ahoraMs);
+                        _limite = ahoraMs + WIFI_VERIFICACION_MS;
+                    } else {
+                        perdida(ahoraMs);
+                    }
+                }
+                break;
+
+            case WIFI_ERROR_CONEXION:
+            case WIFI_DESCONECTADO:
+                if (conectado) {  // El driver se reconectó solo
+                    conexionLista(ahoraMs);
+                } else if (vencio(ahoraMs)) {
+                    reintentar(ahoraMs);
+                }
+                break;
+
+            default:  // VERIFICANDO y CONEXION_PERDIDA son de paso
+                break;
+        }
+    }
+
+    EstadoWifi estado() const { return _estado; }
+    bool conectado() const { return _estado == WIFI_CONECTADO; }
+    uint8_t intentos() const { return _intentos; }            // Desde la última conexión
+    uint32_t reconexiones() const { return _reconexiones; }   // Conexiones perdidas en total
+    uint8_t ultimaRazon() const { return _ultimaRazon; }      // wifi_err_reason_t del último corte
+    uint32_t desde() const { return _desde; }                 // ms del último cambio de estado
+    bool rapido() const { return _rapido; }                   // Conexión (o intento) con datos guardados
+
+private:
+    enum : uint8_t { EVENTO_CONECTADO = 1, EVENTO_DESCONECTADO = 2 };
+
+    bool vencio(uint32_t ahoraMs) const { return (int32_t)(ahoraMs - _limite) >= 0; }
+
+    // 1 s, 2 s, 4 s... según los intentos fallidos, hasta el tope
+    uint32_t backoff() const {
+        uint32_t ms = WIFI_BACKOFF_BASE_MS;
+        for (uint8_t i = 1; i < _intentos && ms < WIFI_BACKOFF_MAX_MS; i++) ms *= 2;
+        return ms < WIFI_BACKOFF_MAX_MS ? ms : WIFI_BACKOFF_MAX_MS;
+    }
+
+    // Entre la mitad y el total, al azar
+    uint32_t espera(uint32_t ms) { return ms / 2 + _radio.aleatorio() % (ms / 2 + 1); }
+
+    void conexionLista(uint32_t ahoraMs) {
+        _intentos = 0;
+        cambiar(WIFI_CONECTADO, ahoraMs);
+        _limite = ahoraMs + WIFI_VERIFICACION_MS;
+        _radio.conectada();
+    }
+
+    // CONEXION_PERDIDA -> REINTENTANDO de inmediato, con los intentos en 0
+    void perdida(uint32_t ahoraMs) {
+        _reconexiones++;
+        _intentos = 0;
+        cambiar(WIFI_CONEXION_PERDIDA, ahoraMs);
+        reintentar(ahoraMs);
+    }
+
+    void reintentar(uint32_t ahoraMs) {
+        if (_intentos < 255) _intentos++;
+        _rapido = false;
+        _radio.reconectar();
+        cambiar(WIFI_REINTENTANDO, ahoraMs);
+        _limite = ahoraMs + WIFI_TIMEOUT_INTENTO_MS;
+    }
+
+    void cambiar(EstadoWifi nuevo, uint32_t ahoraMs) {
+        EstadoWifi anterior = _estado;
+        _estado = nuevo;
+        _desde = ahoraMs;
+        if (_alCambiar && anterior != nuevo) _alCambiar(anterior, nuevo);
+    }
+
+    Radio &_radio;
+    EstadoWifi _estado = WIFI_INICIALIZACION;
+    uint32_t _limite = 0;  // Timeout del intento, fin de la espera o próxima verificación
+    uint32_t _desde = 0;
+    uint8_t _intentos = 0;
+    uint8_t _ultimaRazon = 0;
+    bool _rapido = false;
+    uint32_t _reconexiones = 0;
+    std::atomic<uint8_t> _eventos{0};
+    std::atomic<uint8_t> _razon{0};
+    AlCambiar _alCambiar = nullptr;
+};
+
+#ifdef ARDUINO
+#include <WiFi.h>
+#include "cache_wifi.h"
+
+// Radio real: modo estación sin la reconexión automática del driver (la
+// maneja la máquina de estados, con backoff). El primer intento usa la
+// caché de la NVS si es de esta red; los reintentos escanean
+class RadioArduino {
+public:
+    RadioArduino(const char *ssid, const char *password) : _ssid(ssid), _password(password) {}
+
+    // IP fija opcional (antes de iniciar()). Sin llamarla: DHCP, y en la
+    // conexión rápida la última concesión guardada
+    void ipFija(IPAddress ip, IPAddress gateway, IPAddress mascara, IPAddress dns) {
+        _ip = ip;
+        _gateway = gateway;
+        _mascara = mascara;
+        _dns = dns;
+    }
+
+    bool conectar() {
+        WiFi.persistent(false);  // La configuración la guarda cache_wifi.h, no cada begin()
+        WiFi.mode(WIFI_STA);
+        WiFi.setAutoReconnect(false);
+        bool rapido = _cache.cargar(_ssid, _password);
+        const DatosWifi &d = _cache.datos();
+        if (rapido) {
+            configurarIp(IPAddress(d.ip), IPAddress(d.gateway), IPAddress(d.mascara), IPAddress(d.dns));
+            WiFi.begin(_ssid, _password, d.canal, d.bssid);
+        } else {
+            configurarIp(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE);
+            WiFi.begin(_ssid, _password);
+        }
+        return rapido;
+    }
+    void reconectar() {
+        WiFi.disconnect();
+        configurarIp(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE);
+        WiFi.begin(_ssid, _password);
+    }
+    void conectada() { _cache.guardar(_ssid, _password); }
+    bool conectado() const { return WiFi.status() == WL_CONNECTED; }
+    uint32_t aleatorio() const { return esp_random(); }
+
+private:
+    // La IP fija manda; si no, la concesión guardada o DHCP (INADDR_NONE)
+    void configurarIp(IPAddress ip, IPAddress gateway, IPAddress mascara, IPAddress dns) {
+        if ((uint32_t)_ip != 0) {
+            WiFi.config(_ip, _gateway, _mascara, _dns);
+        } else {
+            WiFi.config(ip, gateway, mascara, dns);
+        }
+    }
+
+    const char *_ssid;
+    const char *_password;
+    IPAddress _ip = INADDR_NONE, _gateway = INADDR_NONE, _mascara = INADDR_NONE, _dns = INADDR_NONE;
+    CacheWifi _cache;
+};
+#endif
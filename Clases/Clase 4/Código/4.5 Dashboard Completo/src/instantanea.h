@@ -0,0 +1,93 @@
+/*
+    Instantánea del estado protegida con un seqlock.
+
+    Un solo escritor publica una estructura completa y cualquier cantidad
+    de lectores la copian sin bloquearlo. El escritor incrementa un
+    contador de secuencia antes y después de escribir (impar = escritura
+    en curso); el lector copia la estructura y verifica que el contador
+    no haya cambiado ni sea impar. Si cambió, la copia pudo quedar mezcla
+    de dos versiones y vuelve a leer.
+
+        Instantanea<EstadoDashboard> estado;
+
+        // Tarea de control (único escritor):
+        estado.publicar(nuevo);
+
+        // Cualquier tarea (HTTP, OLED, SSE):
+        EstadoDashboard e;
+        estado.leer(e);        // Siempre una versión completa
+
+    A diferencia de un mutex, el escritor nunca espera a los lectores y
+    un lector lento no frena al control. Los datos se guardan en palabras
+    atómicas que se escriben con release y se leen con acquire: si el
+    lector vio una palabra nueva, también ve el contador ya impar. En el
+    ESP32 es una copia de 32 bits más una barrera (memw) por palabra, y
+    en la PC ThreadSanitizer lo puede verificar (no modela las barreras
+    sueltas, atomic_thread_fence).
+
+    Si un lector de mayor prioridad interrumpe al escritor en el mismo
+    núcleo, reintentar enseguida no lo dejaría terminar nunca: después de
+    algunos intentos leer() cede el procesador (vTaskDelay(1) en el ESP32).
+
+    No depende de Arduino.h: tools/estres_concurrencia.cpp la prueba en
+    la PC con hilos y ThreadSanitizer.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#define INSTANTANEA_CEDER() vTaskDelay(1)
+#else
+#include <thread>
+#define INSTANTANEA_CEDER() std::this_thread::yield()
+#endif
+
+#define INSTANTANEA_REINTENTOS 8  // Intentos seguidos antes de ceder
+
+template <typename T>
+class Instantanea {
+public:
+    // Solo desde una tarea (la dueña del estado)
+    void publicar(const T &valor) {
+        uint32_t palabras[PALABRAS];
+        memcpy(palabras, &valor, sizeof(T));
+
+        uint32_t secuencia = _secuencia.load(std::memory_order_relaxed);
+        _secuencia.store(secuencia + 1, std::memory_order_relaxed);  // Impar: escribiendo
+        for (uint16_t i = 0; i < PALABRAS; i++) _datos[i].store(palabras[i], std::memory_order_release);
+        _secuencia.store(secuencia + 2, std::memory_order_release);
+    }
+
+    // Desde cualquier tarea. Devuelve la versión leída (cantidad de
+    // publicar() anteriores)
+    uint32_t leer(T &valor) const {
+        uint32_t palabras[PALABRAS];
+        for (uint8_t intento = 1;; intento++) {
+            uint32_t antes = _secuencia.load(std::memory_order_acquire);
+            if (!(antes & 1)) {
+                for (uint16_t i = 0; i < PALABRAS; i++) palabras[i] = _datos[i].load(std::memory_order_acquire);
+                if (_secuencia.load(std::memory_order_relaxed) == antes) {
+                    memcpy(&valor, palabras, sizeof(T));
+                    return antes / 2;
+                }
+            }
+            if (intento % INSTANTANEA_REINTENTOS == 0) INSTANTANEA_CEDER();
+        }
+    }
+
+    uint32_t version() const { return _secuencia.load(std::memory_order_acquire) / 2; }
+
+private:
+    static_assert(std::is_trivially_copyable<T>::value, "T se copia por bytes");
+    static_assert(sizeof(T) % 4 == 0, "T tiene que ocupar palabras de 32 bits completas");
+    static const uint16_t PALABRAS = sizeof(T) / 4;
+
+    std::atomic<uint32_t> _secuencia{0};
+    std::atomic<uint32_t> _datos[PALABRAS] = {};
+};
@@ -0,0 +1,208 @@
+/*
+    Escritor JSON sin memoria dinámica para las respuestas de la API.
+
+    Formatea directamente en un buffer fijo (en el stack o un static del handler), sin
+    StaticJsonDocument ni String intermedios. Los números con decimales se
+    formatean con aritmética entera para que printf no use el heap.
+
+    Cada respuesta se describe con un esquema X-macro: tipo, clave y valor.
+
+        #define LED_JSON(FIELD)                    \
+            FIELD(Bool, "state",      ledState)    \
+            FIELD(U32,  "brightness", ledBrightness)
+
+        char body[JSON_MAX_LEN(LED_JSON)];         // Tamaño calculado al compilar
+        JsonWriter json(body, sizeof(body));
+        LED_JSON(JSON_WRITE_FIELD)                 // Usa la variable "json"
+        size_t len = json.finish();
+
+    El tamaño del buffer sale del esquema (largo de cada clave + largo
+    máximo de cada tipo), así que nunca puede desbordarse, y cada tipo se
+    escribe con su propia función (writeBool, writeU32, ...).
+
+    JSON_WRITE_FIELD verifica el esquema al compilar (static_assert):
+      - El valor es del tipo del campo: Bool solo bool, U32 enteros sin
+        signo de hasta 32 bits, I32 enteros que entran en 32 bits con
+        signo, Fixed2 float/double. Un uint64_t en U32 o un float en
+        U32 no compila en lugar de truncarse.
+      - La clave no está vacía y no tiene comillas, '\' ni caracteres
+        de control (se escribe tal cual, sin escapar).
+    Y una vez para todos: JSON_MAX_xxx alcanza para el valor más largo
+    que puede escribir cada tipo.
+
+    Un arreglo de objetos con el mismo esquema ("items":[{...},{...}]):
+
+        char body[JSON_MAX_LEN(RAIZ) + JSON_MAX_ARRAY("items", ITEM, N)];
+        json.beginArray("items");
+        for (...) { json.beginObject(); ITEM(JSON_WRITE_FIELD) json.endObject(); }
+        json.endArray();
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include <type_traits>
+
+// Largo máximo de cada tipo de valor ya formateado
+#define JSON_MAX_Bool    5   // false
+#define JSON_MAX_U32     10  // 4294967295
+#define JSON_MAX_I32     11  // -2147483648
+#define JSON_MAX_Fixed2  14  // -21474836.48
+
+// Fuera de ±JSON_FIXED2_LIMITE writeFixed2() escribe null (el valor por
+// 100 tiene que entrar en un int32_t)
+#define JSON_FIXED2_LIMITE 21474836.0f
+
+static_assert(sizeof("false") - 1 <= JSON_MAX_Bool, "JSON_MAX_Bool no alcanza");
+static_assert(sizeof("4294967295") - 1 <= JSON_MAX_U32, "JSON_MAX_U32 no alcanza");
+static_assert(sizeof("-2147483648") - 1 <= JSON_MAX_I32, "JSON_MAX_I32 no alcanza");
+static_assert(sizeof("-21474836.48") - 1 <= JSON_MAX_Fixed2 && sizeof("null") - 1 <= JSON_MAX_Fixed2,
+              "JSON_MAX_Fixed2 no alcanza");
+static_assert(JSON_FIXED2_LIMITE * 100.0 < 2147483647.0, "JSON_FIXED2_LIMITE no entra en int32_t");
+
+// Tipos de C++ que acepta cada tipo de campo
+template <typename T>
+struct JsonAcepta {
+    static const bool entero = std::is_integral<T>::value && !std::is_same<T, bool>::value;
+    static const bool Bool = std::is_same<T, bool>::value;
+    static const bool U32 = entero && std::is_unsigned<T>::value && sizeof(T) <= 4;
+    static const bool I32 = entero && (std::is_signed<T>::value ? sizeof(T) <= 4 : sizeof(T) < 4);
+    static const bool Fixed2 = std::is_floating_point<T>::value;
+};
+
+// Tipo del valor sin referencia ni const (e.brillo[id] es uint8_t&)
+template <typename T>
+using JsonValor = typename std::decay<T>::type;
+
+// La clave se escribe sin escapar: nada de comillas, '\' ni control
+constexpr bool jsonClaveValida(const char *key, size_t n) {
+    return n == 0 || ((unsigned char)key[0] >= 0x20 && key[0] != '"' && key[0] != '\\' &&
+                      jsonClaveValida(key + 1, n - 1));
+}
+
+// "clave":valor, → comillas, dos puntos y coma = 4 caracteres extra
+#define JSON_FIELD_MAX(type, key, value) + (sizeof(key) - 1 + 4 + JSON_MAX_##type)
+#define JSON_WRITE_FIELD(type, key, value)                                                         \
+    static_assert(JsonAcepta<JsonValor<decltype(value)>>::type,                                    \
+                  "campo \"" key "\": el valor no es " #type " (ver JsonAcepta en json_writer.h)"); \
+    static_assert(sizeof(key) > 1 && jsonClaveValida(key, sizeof(key) - 1),                       \
+                  "campo \"" key "\": clave vacía o con caracteres que habría que escapar");     \
+    json.write##type(key, value);
+
+// Llaves de apertura/cierre + terminador '\0'
+#define JSON_MAX_LEN(SCHEMA) (3 SCHEMA(JSON_FIELD_MAX))
+
+// ,"clave":[ ] + n objetos (cada uno con su coma en lugar del '\0')
+#define JSON_MAX_ARRAY(key, SCHEMA, n) (sizeof(key) - 1 + 6 + (n) * JSON_MAX_LEN(SCHEMA))
+
+class JsonWriter {
+public:
+    JsonWriter(char *buf, size_t size) : _buf(buf), _size(size), _len(0), _first(true) {
+        put('{');
+    }
+
+    void writeBool(const char *key, bool value) {
+        beginField(key);
+        puts(value ? "true" : "false");
+    }
+
+    void writeU32(const char *key, uint32_t value) {
+        beginField(key);
+        putU32(value);
+    }
+
+    void writeI32(const char *key, int32_t value) {
+        beginField(key);
+        if (value < 0) {
+            put('-');
+            putU32((uint32_t)0 - (uint32_t)value);
+        } else {
+            putU32((uint32_t)value);
+        }
+    }
+
+    // Número con 2 decimales (ej: 25.37). NaN/infinito se envían como null
+    void writeFixed2(const char *key, float value) {
+        beginField(key);
+        if (!isfinite(value) || fabsf(value) > JSON_FIXED2_LIMITE) {
+            puts("null");
+            return;
+        }
+        int32_t scaled = (int32_t)lroundf(value * 100.0f);
+        if (scaled < 0) {
+            put('-');
+            scaled = -scaled;
+        }
+        putU32((uint32_t)scaled / 100);
+        put('.');
+        put('0' + (scaled / 10) % 10);
+        put('0' + scaled % 10);
+    }
+
+    // Arreglo de objetos: beginArray, (beginObject, campos, endObject)..., endArray
+    void beginArray(const char *key) {
+        beginField(key);
+        put('[');
+        _first = true;
+    }
+
+    void beginObject() {
+        if (!_first) put(',');
+        put('{');
+        _first = true;
+    }
+
+    void endObject() {
+        put('}');
+        _first = false;
+    }
+
+    void endArray() {
+        put(']');
+        _first = false;
+    }
+
+    // Cierra el objeto y devuelve el largo (0 si no entró en el buffer)
+    size_t finish() {
+        put('}');
+        if (_len >= _size) return 0;
+        _buf[_len] = '\0';
+        return _len;
+    }
+
+private:
+    char *_buf;
+    size_t _size;
+    size_t _len;
+    bool _first;
+
+    void put(char c) {
+        if (_len < _size) _buf[_len] = c;
+        _len++;
+    }
+
+    void puts(const char *s) {
+        while (*s) put(*s++);
+    }
+
+    void putU32(uint32_t value) {
+        char digits[10];
+        int n = 0;
+        do {
+            digits[n++] = '0' + value % 10;
+            value /= 10;
+        } while (value);
+        while (n) put(digits[--n]);
+    }
+
+    void beginField(const char *key) {
+        if (!_first) put(',');
+        _first = false;
+        put('"');
+        puts(key);
+        put('"');
+        put(':');
+    }
+};
@@ -30,278 +30,957 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WebServer.h>
-#include <ArduinoJson.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
 #include <LittleFS.h>
 #include <U8g2lib.h>
 #include <Wire.h>
+#include <atomic>
+#include "json_writer.h"
+#include "gamma_lut.h"
+#include "actuadores.h"
+#include "punto_fijo.h"
+#include "oled_tarea.h"
+#include "planificador.h"
+#include "cola_spsc.h"
+#include "instantanea.h"
+#include "conexion_wifi.h"
+#include "perfil_arranque.h"
+#include "oled_layout.h"
+#include "route_table.h"  // Generado por tools/gen_route_table.py
+#include "archivos_estaticos.h"
+#include "cambios_stream.h"
 
 // Configuración WiFi - COMPLETAR CON TUS CREDENCIALES
 const char *ssid = "TU_NOMBRE_DE_RED";
 const char *password = "TU_CONTRASEÑA";
 
-// Servidor web
-WebServer server(80);
+// Conexión WiFi como máquina de estados (conexion_wifi.h): la tarea
+// "wifi" la avanza cada 100 ms sin esperar, los eventos del driver
+// avisan la conexión y los cortes
+RadioArduino radioWifi(ssid, password);
+ConexionWifi<RadioArduino> wifi(radioWifi);
+
+// IP fija opcional: con 0.0.0.0 se usa DHCP, y al arrancar la última
+// concesión guardada (cache_wifi.h)
+const IPAddress ipFija(0, 0, 0, 0);
+const IPAddress gatewayFijo(192, 168, 1, 1);
+const IPAddress mascaraFija(255, 255, 255, 0);
+const IPAddress dnsFijo(192, 168, 1, 1);
+
+// Arranque. Sin INICIO_DIFERIDO setup() hace todo en orden: espera 1 s
+// al Serial, monta LittleFS, lista los archivos y muestra el cartel.
+// Con INICIO_DIFERIDO ([env] en platformio.ini) no espera al Serial,
+// LittleFS se monta en una tarea de baja prioridad después de setup() y
+// el cartel y el listado solo salen con -D BANNER_SERIAL
+#ifdef INICIO_DIFERIDO
+const bool inicioDiferido = true;
+#else
+const bool inicioDiferido = false;
+#define BANNER_SERIAL
+#endif
+
+// Fases del arranque (identificador y clave en /api/boot). Cada marca es
+// el instante en que terminó la fase, en us desde que arrancó la
+// aplicación (perfil_arranque.h). "fs_us" queda en setup() o, diferido,
+// cuando termina la tarea montar_fs
+#define FASES_ARRANQUE(X)                       \
+    X(ARRANQUE_SETUP,       "setup_us")         \
+    X(ARRANQUE_SERIAL,      "serial_us")        \
+    X(ARRANQUE_PWM,         "pwm_us")           \
+    X(ARRANQUE_WIFI,        "wifi_start_us")    \
+    X(ARRANQUE_OLED,        "oled_us")          \
+    X(ARRANQUE_TAREAS,      "tasks_us")         \
+    X(ARRANQUE_SERVIDOR,    "server_us")        \
+    X(ARRANQUE_FIN_SETUP,   "setup_end_us")     \
+    X(ARRANQUE_IP,          "ip_us")            \
+    X(ARRANQUE_FS,          "fs_us")            \
+    X(ARRANQUE_PRIMERA_API, "first_api_us")
+
+enum FaseArranque : uint8_t {
+#define X(id, clave) id,
+    FASES_ARRANQUE(X)
+#undef X
+    ARRANQUE_FASES
+};
+
+const char *const clavesArranque[ARRANQUE_FASES] = {
+#define X(id, clave) clave,
+    FASES_ARRANQUE(X)
+#undef X
+};
+
+PerfilArranque<ARRANQUE_FASES> perfil;
+std::atomic<bool> arranqueRapido(false);  // La primera conexión usó la caché
+
+// true si es la primera vez que se marca la fase
+bool marcarArranque(FaseArranque fase) {
+    return perfil.marcar(fase, micros());
+}
+
+void mostrarArranque() {
+    Serial.print("Arranque (ms):");
+    for (uint8_t i = 0; i < ARRANQUE_FASES; i++) {
+        if (perfil.marca(i)) Serial.printf(" %s %.1f |", clavesArranque[i], perfil.marca(i) / 1000.0);
+    }
+    Serial.println(arranqueRapido.load() ? " conexión rápida" : " conexión completa");
+}
+
+// Servidor web asíncrono: atiende las conexiones desde la tarea de
+// AsyncTCP, independiente de loop() (OLED, sensores, reconexión WiFi)
+AsyncWebServer server(80);
+
+// Canal Server-Sent Events: una conexión abierta por pestaña por la que el
+// ESP32 envía los cambios (reemplaza el polling de /api/sensors y /api/led)
+AsyncEventSource events("/api/stream");
+
+// Canal WebSocket para controlar el LED con tramas binarias de 2 bytes
+// [operación, valor]: mucho más liviano que un POST por cada movimiento
+AsyncWebSocket ws("/api/ws");
+// Los códigos de operación son los de actuadores.h: 0x01 = OP_ALTERNAR
+// (valor ignorado), 0x02 = OP_BRILLO (valor = brillo 0-100)
 
 // Constructor para OLED I2C 128x64
 U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
 
-#define PWM_CHANNEL 0
+// Tarea que envía el OLED por I2C (doble buffer): loop() dibuja y publica,
+// la tarea manda solo las páginas que cambiaron sin bloquear loop()
+OledEnSegundoPlano oledFondo;
 
-// Variable para manejar lógica invertida del PWM
+// Posiciones y anchos de caracteres del OLED, medidos una vez en setup()
+LayoutOled layoutOled;
+
+#define PWM_FRECUENCIA_INICIAL 5000  // 5 kHz → 13 bits (ver pwm_resolucion.h)
+
+// Polaridad del LED de la placa
 #ifdef ESP32C3
 #define LED_PIN 8
-bool logicaInvertida = false;   // ESP32C3 usa lógica invertida
+#define LED_ACTIVO_BAJO true    // El LED del ESP32-C3 enciende con el pin en LOW
 #else
 #define LED_PIN 2
-bool logicaInvertida = true;  // Otros ESP32 usan lógica normal
+#define LED_ACTIVO_BAJO false
 #endif
 
-// Variables del sistema
-float temperature = 25.0;
-bool ledState = false;
-uint8_t ledBrightness = 50;  // 0-100%
+// Actuadores PWM (actuadores.h): canal, polaridad, curva y estado de cada
+// uno en una tabla. El LED del dashboard es el primero; se pueden agregar
+// más en setup() y controlarlos en lote con /api/actuators. Después de
+// setup() solo los toca controlar()
+Actuadores actuadores;
+uint8_t ledPrincipal = 0;
+
+// Datos entre tareas: nadie comparte variables sueltas. Las lecturas y
+// los pedidos van por colas SPSC a controlar(), única dueña de los
+// actuadores, que publica el estado completo en una instantánea (seqlock)
+// que leen los handlers HTTP, el OLED y SSE
+
+// Lectura de la tarea de sensores
+struct LecturaSensores {
+    float temperatura;
+};
+
+// Pedido de los handlers HTTP y WebSocket. Todos corren en la tarea de
+// AsyncTCP: la cola tiene un solo productor
+struct PedidoControl {
+    uint32_t frecuencia;  // Hz del PWM; 0 = no cambiar
+    uint8_t cantidad;
+    ComandoActuador comandos[ACTUADORES_MAX * 4];
+};
+
+// Estado que publica controlar()
+struct EstadoDashboard {
+    float temperatura;
+    uint32_t frecuencia;
+    uint32_t encendidos;        // Bit id: actuador encendido
+    uint8_t brillo[ACTUADORES_MAX];
+    uint8_t bits;
+    uint8_t niveles;
+
+    bool encendido(uint8_t id) const { return encendidos & (1u << id); }
+};
+
+ColaSpsc<LecturaSensores, 4> colaLecturas;  // Sensores -> control
+ColaSpsc<PedidoControl, 16> colaPedidos;    // AsyncTCP -> control
+UltimoValor brilloSlider;                   // WebSocket -> control (solo el último)
+Instantanea<EstadoDashboard> estado;        // Control -> todos
+EstadoDashboard previsto;                   // Solo la tarea de AsyncTCP (ver prever())
+
+// Períodos de las tareas
+const uint32_t sensorInterval = 2000;     // 2 segundos
+const uint32_t oledUpdateInterval = 500;  // 0.5 segundos
+const uint32_t ipShowInterval = 30000;    // 30 segundos
+const uint32_t wifiTickInterval = 100;    // 100 ms (máquina de estados, no bloquea)
+const uint32_t streamTickInterval = 20;   // 20 ms (cambios por SSE)
+const uint32_t controlInterval = 1000;    // Respaldo: normalmente se despierta con cada pedido
+
+#ifdef MULTITAREA
+// ESP32 de dos núcleos: cada parte en su propia tarea fijada a un núcleo
+// (ver setup()). controlar() corre cada vez que la despiertan
+#define TAREA_PILA          4096
+#define TAREAS_MAX          7   // Control, las 5 periódicas y oled_i2c
+#define CONTROL_PRIORIDAD   3   // Sobre sensores y red (2) y OLED, WiFi e IP (1)
+
+TaskHandle_t tareaControl = nullptr;
+TaskHandle_t tareas[TAREAS_MAX];  // Para mostrar la pila libre de cada una
+uint8_t cantidadTareas = 0;
+
+void despertarControl() {
+    if (tareaControl) xTaskNotifyGive(tareaControl);
+}
+#else
+// Un núcleo (ESP32-C3): todo corre en loop() con el planificador, que
+// duerme hasta la próxima tarea. Los pedidos despiertan a loop() con
+// planificador.solicitar(idControl)
+Planificador<RelojArduino> planificador;
+int8_t idControl = -1;
+TaskHandle_t tareaLoop = nullptr;
+
+void despertarLoop() {
+    if (tareaLoop) xTaskNotifyGive(tareaLoop);
+}
 
-// Función para convertir brillo lineal (0-100) a PWM con corrección gamma
-uint8_t brightnessToGammaPWM(uint8_t brightness) {
-    if (brightness == 0) return 0;
-    float dutyCycle = (brightness / 100.0) * 255.0;
-    uint8_t dutyGamma = pow(dutyCycle / 255.0, 2.2) * 255.0;
-    return dutyGamma;
+void despertarControl() {
+    planificador.solicitar(idControl);
 }
+#endif
 
-// Timing para diferentes procesos
-uint32_t lastSensorRead = 0;
-const uint32_t sensorInterval = 2000; // 2 segundos
+const uint32_t streamHeartbeatInterval = 15000; // 15 segundos sin cambios
 
-uint32_t lastOledUpdate = 0;
-const uint32_t oledUpdateInterval = 500; // 0.5 segundos
+// Eventos del driver WiFi (tarea de eventos de Arduino): solo se marcan,
+// la máquina de estados los procesa en la tarea "wifi"
+void onWifiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+        wifi.alConectar();
+    } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+        wifi.alDesconectar(info.wifi_sta_disconnected.reason);
+    }
+}
 
-uint32_t lastIpShow = 0;
-const uint32_t ipShowInterval = 30000; // 30 segundos
+// Log de los cambios de estado de la conexión y banner con la IP
+void alCambiarWifi(EstadoWifi anterior, EstadoWifi nuevo) {
+    // La verificación periódica (CONECTADO -> VERIFICANDO -> CONECTADO) no se muestra
+    if (nuevo == WIFI_VERIFICANDO || (anterior == WIFI_VERIFICANDO && nuevo == WIFI_CONECTADO)) return;
 
-uint32_t lastWiFiCheck = 0;
-const uint32_t wifiCheckInterval = 10000; // 10 segundos
+    Serial.printf("WiFi: %s -> %s", nombreEstadoWifi(anterior), nombreEstadoWifi(nuevo));
+    if (nuevo == WIFI_REINTENTANDO) Serial.printf(" (intento %u)", wifi.intentos());
+    if (nuevo == WIFI_CONEXION_PERDIDA) Serial.printf(" (razón %u)", wifi.ultimaRazon());
+    Serial.println();
 
-// Función para verificar y mantener conexión WiFi
-void checkWiFiConnection() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("WiFi desconectado, intentando reconectar...");
-        WiFi.reconnect();
+    if (nuevo == WIFI_CONECTADO) {
+        if (marcarArranque(ARRANQUE_IP)) arranqueRapido = wifi.rapido();
+        Serial.println("===========================================");
+        Serial.print("IP del dispositivo: ");
+        Serial.println(WiFi.localIP());
+        Serial.println("===========================================");
+        Serial.println("Abrir en el navegador:");
+        Serial.print("   http://");
+        Serial.println(WiFi.localIP());
+        Serial.println("===========================================");
+    }
+}
 
-        int attempts = 0;
-        while (WiFi.status() != WL_CONNECTED && attempts < 10) {
-            delay(500);
-            Serial.print(".");
-            attempts++;
-        }
+// Avanza la conexión WiFi: como mucho inicia un intento, nunca lo espera
+void actualizarWifi() {
+    wifi.actualizar(millis());
+}
 
-        if (WiFi.status() == WL_CONNECTED) {
-            Serial.println();
-            Serial.println("WiFi reconectado!");
-            Serial.println("IP: " + WiFi.localIP().toString());
-        } else {
-            Serial.println();
-            Serial.println("No se pudo reconectar WiFi");
-        }
+// LittleFS: sin INICIO_DIFERIDO se monta en setup(); con él, en la tarea
+// montar_fs, de baja prioridad. Nunca en un handler: LittleFS.begin(true)
+// puede formatear la flash y archivos.cargar() lee todos los archivos,
+// demasiado para la tarea de AsyncTCP (ver PRECAUCIONES). Los handlers
+// solo miran estadoFs, que se publica después de llenar archivos
+enum EstadoFs : uint8_t { FS_SIN_MONTAR, FS_MONTADO, FS_ERROR };
+std::atomic<EstadoFs> estadoFs{FS_SIN_MONTAR};
+
+// Tamaño y ETag de cada archivo de la tabla de rutas, medidos al montar
+ArchivosEstaticos archivos;
+
+#define MONTAR_FS_PILA      4096
+#define MONTAR_FS_PRIORIDAD 1   // La de loop(): debajo de control, sensores y red
+
+// Monta LittleFS y mide los archivos. Una sola vez, en setup() o en montar_fs
+void montarFs() {
+    bool montado = LittleFS.begin(true);  // true = formatear si es necesario
+    if (montado) archivos.cargar(LittleFS);  // Lee cada archivo una vez (ETag de la imagen subida)
+    estadoFs.store(montado ? FS_MONTADO : FS_ERROR, std::memory_order_release);
+    marcarArranque(ARRANQUE_FS);
+    if (!montado) {
+        Serial.println("Error montando LittleFS, usando modo básico");
+        Serial.println("El dashboard funcionará con página básica");
+        return;
     }
+    Serial.println("LittleFS montado correctamente");
+#ifdef BANNER_SERIAL
+    // Listar archivos en LittleFS para debug
+    Serial.println("Archivos disponibles:");
+    File root = LittleFS.open("/");
+    File file = root.openNextFile();
+    while (file) {
+        Serial.println("  - " + String(file.name()) + " (" + String(file.size()) + " bytes)");
+        file = root.openNextFile();
+    }
+#endif
 }
 
-// Función para obtener el tipo MIME de un archivo
-String getContentType(String filename) {
-    if (filename.endsWith(".html")) return "text/html";
-    else if (filename.endsWith(".css")) return "text/css";
-    else if (filename.endsWith(".js")) return "application/javascript";
-    else if (filename.endsWith(".png")) return "image/png";
-    else if (filename.endsWith(".jpg")) return "image/jpeg";
-    else if (filename.endsWith(".gif")) return "image/gif";
-    else if (filename.endsWith(".ico")) return "image/x-icon";
-    return "text/plain";
+#ifdef INICIO_DIFERIDO
+void tareaMontarFs(void *) {
+    montarFs();
+    vTaskDelete(nullptr);
 }
+#endif
 
-// Función para servir archivos estáticos desde LittleFS
-bool handleFileRead(String path) {
-    Serial.println("Solicitado: " + path);
+// Función para servir un archivo estático: la variante y el ETag salen de
+// lo medido al montar LittleFS, sin preguntarle a la flash si existe. Solo
+// se abre el archivo cuando hay que enviar el contenido
+bool handleFileRead(AsyncWebServerRequest *request, const Route &route) {
+    Serial.printf("Solicitado: %s\n", route.path);
 
-    if (path.endsWith("/")) path += "index.html";
+    if (estadoFs.load(std::memory_order_acquire) != FS_MONTADO) return false;
 
-    String contentType = getContentType(path);
+    AsyncWebHeader *encoding = request->getHeader("Accept-Encoding");
+    AsyncWebHeader *ifNoneMatch = request->getHeader("If-None-Match");
+    RespuestaArchivo elegida = archivos.elegir(route, encoding && encoding->value().indexOf("gzip") >= 0,
+                                               ifNoneMatch ? ifNoneMatch->value().c_str() : nullptr);
+    if (elegida.codigo == 404) return false;
 
-    if (LittleFS.exists(path)) {
-        File file = LittleFS.open(path, "r");
-        server.streamFile(file, contentType);
-        file.close();
-        Serial.println("Archivo servido: " + path);
-        return true;
+    AsyncWebServerResponse *response;
+    if (elegida.codigo == 304) {
+        response = request->beginResponse(304);
+        Serial.printf("No modificado (304): %s\n", route.path);
+    } else {
+        File file = LittleFS.open(elegida.archivo, "r");
+        if (!file) return false;
+
+        // La librería toma el largo de file.size(), agrega "Content-Encoding:
+        // gzip" sola cuando el archivo termina en .gz y la ruta pedida no, y
+        // lo envía por partes a medida que el cliente confirma lo recibido
+        response = request->beginResponse(file, route.path, route.mime);
+        Serial.printf("Archivo servido: %s%s\n", route.path, elegida.gzip ? " (gzip)" : "");
     }
 
-    Serial.println("Archivo no encontrado: " + path);
-    return false;
+    response->addHeader("ETag", elegida.etag);
+    response->addHeader("Cache-Control", "no-cache");  // Revalidar siempre (responde 304)
+    response->addHeader("Vary", "Accept-Encoding");
+    request->send(response);
+    return true;
 }
 
-// Función para leer sensores
+// Función para leer sensores: la lectura va a controlar() por la cola
 void readSensors() {
-    // Leer temperatura interna del ESP32
-    temperature = temperatureRead(); // Función incorporada del ESP32
+    LecturaSensores lectura;
+    lectura.temperatura = temperatureRead();  // Temperatura interna del ESP32
+    colaLecturas.enviar(lectura);
+    despertarControl();
 
     // Log básico sin intentar reconectar
     if (WiFi.status() == WL_CONNECTED) {
-        Serial.printf("Temp: %.1f°C | http:// %s", temperature, WiFi.localIP().toString().c_str());
+        Serial.printf("Temp: %.1f°C | http:// %s", lectura.temperatura, WiFi.localIP().toString().c_str());
         Serial.println();
     } else {
-        Serial.printf("Temp: %.1f°C | WiFi: DESCONECTADO", temperature);
+        Serial.printf("Temp: %.1f°C | WiFi: DESCONECTADO", lectura.temperatura);
         Serial.println();
     }
 }
 
-// Función para servir la página principal
-void handleRoot() {
-    if (!handleFileRead("/index.html")) {
-        // Fallback: servir página básica si LittleFS no está disponible
-        String basicPage = "<!DOCTYPE html><html><head><title>ESP32 IoT</title></head><body>";
-        basicPage += "<h1>ESP32 IoT Dashboard</h1>";
-        basicPage += "<p>Temperatura: <span id='temp'>--</span>°C</p>";
-        basicPage += "<p>Sistema funcionando sin archivos LittleFS</p>";
-        basicPage += "<p><a href='/upload'>Cargar archivos LittleFS</a></p>";
-        basicPage += "<script>setInterval(()=>{fetch('/api/sensors').then(r=>r.json()).then(d=>{document.getElementById('temp').innerHTML=d.temperature.toFixed(1)})},3000)</script>";
-        basicPage += "</body></html>";
-        server.send(200, "text/html", basicPage);
-        Serial.println("Sirviendo página básica (fallback)");
+// Temperatura: solo la usa controlar()
+float temperaturaActual = 25.0;
+
+void publicarEstado() {
+    EstadoDashboard e;
+    memset(&e, 0, sizeof(e));  // También el relleno: se copia por palabras
+    e.temperatura = temperaturaActual;
+    e.frecuencia = actuadores.frecuencia();
+    e.bits = actuadores.bits();
+    e.niveles = actuadores.niveles();
+    for (uint8_t id = 0; id < actuadores.cantidad(); id++) {
+        e.brillo[id] = actuadores.brillo(id);
+        if (actuadores.encendido(id)) e.encendidos |= 1u << id;
     }
+    estado.publicar(e);
 }
 
+// Control: toma las lecturas y los pedidos pendientes, escribe al PWM lo
+// que cambió y publica el estado nuevo. Si llegan varios movimientos del
+// slider antes de que corra, solo sale el último. Con MULTITAREA AsyncTCP
+// sigue encolando mientras esto corre en el otro núcleo: el brillo lleva
+// la posición de la cola en que se dejó y se aplica entre el pedido
+// anterior y el siguiente, no al final
+void controlar() {
+    bool cambio = false;
+
+    LecturaSensores lectura;
+    while (colaLecturas.recibir(lectura)) {
+        temperaturaActual = lectura.temperatura;
+        cambio = true;
+    }
+
+    PedidoControl pedido;
+    uint8_t brillo;
+    for (;;) {
+        uint32_t indice = colaPedidos.leidos();
+        bool hayPedido = colaPedidos.recibir(pedido);
+
+        // Brillo dejado antes de encolar este pedido (o con la cola vacía)
+        if (brilloSlider.tomarHasta(indice, brillo)) {
+            actuadores.fijarBrillo(ledPrincipal, brillo);
+            cambio = true;
+        }
+        if (!hayPedido) break;
+
+        if (pedido.frecuencia) {
+            actuadores.configurarPwm(pedido.frecuencia);
+            Serial.printf("PWM: %u Hz, %u bits (%u niveles distintos)\n",
+                          (unsigned)actuadores.frecuencia(), actuadores.bits(), actuadores.niveles());
+        }
+        actuadores.ejecutarLote(pedido.comandos, pedido.cantidad);  // Validado por el handler
+        cambio = true;
+    }
+
+    uint32_t fallasPwm = actuadores.fallasPwm();
+    if (actuadores.aplicar() & (1u << ledPrincipal)) {
+        Serial.printf("PWM -> Brillo: %d%% (Estado: %s)\n", actuadores.brillo(ledPrincipal),
+                      actuadores.encendido(ledPrincipal) ? "ON" : "OFF");
+    }
+    if (actuadores.fallasPwm() != fallasPwm) {  // El handler ya valida con el mismo límite
+        Serial.printf("PWM: ledcSetup() rechazó la frecuencia, queda en %u Hz\n", (unsigned)actuadores.frecuencia());
+        cambio = true;
+    }
+    if (cambio) publicarEstado();
+}
+
+// Estado de los actuadores después de todo lo enviado a controlar() (cola
+// y buzón del slider). Todos los cambios salen de la tarea de AsyncTCP,
+// así que un handler sabe cómo van a quedar sin esperar a que controlar()
+// los aplique: handleWsEvent() y los POST actualizan previsto al enviar
+void prever(const PedidoControl &pedido) {
+    if (pedido.frecuencia) {
+        previsto.frecuencia = pedido.frecuencia;
+        previsto.bits = bitsParaFrecuencia(pedido.frecuencia);
+        previsto.niveles = nivelesDistintos(tablaGammaPorcentaje(previsto.bits));
+    }
+    for (uint8_t i = 0; i < pedido.cantidad; i++) {
+        aplicarAEstado(pedido.comandos[i], previsto.brillo, previsto.encendidos);
+    }
+}
+
+// Handlers (tarea de AsyncTCP): encolan el pedido, lo anotan en previsto
+// y despiertan al control. false si la cola está llena (no se anota)
+bool enviarPedido(const PedidoControl &pedido) {
+    if (!colaPedidos.enviar(pedido)) return false;
+    prever(pedido);
+    despertarControl();
+    return true;
+}
+
+// Encola el pedido y devuelve el estado con el que responder: lo último
+// publicado (temperatura) con los actuadores como van a quedar. No espera
+// a controlar(): el handler no frena a la tarea de AsyncTCP. false si la
+// cola está llena
+bool pedirYPrever(const PedidoControl &pedido, EstadoDashboard &e) {
+    if (!enviarPedido(pedido)) return false;
+    estado.leer(e);
+    e.frecuencia = previsto.frecuencia;
+    e.bits = previsto.bits;
+    e.niveles = previsto.niveles;
+    e.encendidos = previsto.encendidos;
+    memcpy(e.brillo, previsto.brillo, sizeof(e.brillo));
+    return true;
+}
+
+// Página básica si LittleFS no está disponible o no tiene index.html
+void handleFallbackPage(AsyncWebServerRequest *request) {
+    String basicPage = "<!DOCTYPE html><html><head><title>ESP32 IoT</title></head><body>";
+    basicPage += "<h1>ESP32 IoT Dashboard</h1>";
+    basicPage += "<p>Temperatura: <span id='temp'>--</span>°C</p>";
+    basicPage += "<p>Sistema funcionando sin archivos LittleFS</p>";
+    basicPage += "<p><a href='/upload'>Cargar archivos LittleFS</a></p>";
+    basicPage += "<script>setInterval(()=>{fetch('/api/sensors').then(r=>r.json()).then(d=>{document.getElementById('temp').innerHTML=d.temperature.toFixed(1)})},3000)</script>";
+    basicPage += "</body></html>";
+    request->send(200, "text/html", basicPage);
+    Serial.println("Sirviendo página básica (fallback)");
+}
+
+// Esquemas de las respuestas JSON (tipo, clave, valor). El tamaño de cada
+// buffer se calcula al compilar a partir del esquema (ver json_writer.h)
+// e = EstadoDashboard leído de la instantánea al empezar cada respuesta
+#define SENSORS_JSON(FIELD)                                 \
+    FIELD(Fixed2, "temperature", e.temperatura)             \
+    FIELD(U32,    "timestamp",   millis())                  \
+    FIELD(U32,    "uptime",      millis() / 1000)           \
+    FIELD(U32,    "free_heap",   ESP.getFreeHeap())         \
+    FIELD(I32,    "wifi_rssi",   WiFi.RSSI())
+
+#define LED_JSON(FIELD)                                     \
+    FIELD(Bool,   "state",       e.encendido(ledPrincipal)) \
+    FIELD(U32,    "brightness",  e.brillo[ledPrincipal])    \
+    FIELD(U32,    "pwm_freq",    e.frecuencia)              \
+    FIELD(U32,    "pwm_bits",    e.bits)                    \
+    FIELD(U32,    "pwm_levels",  e.niveles)
+
+#define LED_POST_JSON(FIELD)                                \
+    FIELD(Bool,   "success",     true)                      \
+    LED_JSON(FIELD)
+
+// /api/actuators: configuración PWM común + un objeto por actuador
+#define ACTUATORS_JSON(FIELD)                               \
+    FIELD(U32,    "pwm_freq",    e.frecuencia)              \
+    FIELD(U32,    "pwm_bits",    e.bits)
+
+// /api/boot: cómo arrancó, más una clave por fase (FASES_ARRANQUE) que
+// se agrega en el handler. esp_reset_reason(): 1 = encendido, 3 = software...
+#define BOOT_JSON(FIELD)                                          \
+    FIELD(U32,    "reset_reason", (uint32_t)esp_reset_reason())   \
+    FIELD(Bool,   "fast_wifi",    arranqueRapido.load())          \
+    FIELD(Bool,   "lazy_init",    inicioDiferido)                 \
+    FIELD(Bool,   "fs_mounted",   estadoFs == FS_MONTADO)
+
+#define BOOT_FASE_MAX(id, clave) JSON_FIELD_MAX(U32, clave, 0)
+
+// Pin, curva y polaridad son configuración fija desde setup()
+#define ACTUATOR_JSON(FIELD)                                            \
+    FIELD(U32,    "id",          id)                                    \
+    FIELD(U32,    "pin",         actuadores.pin(id))                    \
+    FIELD(Bool,   "state",       e.encendido(id))                       \
+    FIELD(U32,    "brightness",  e.brillo[id])                          \
+    FIELD(Bool,   "gamma",       actuadores.curva(id) == CURVA_GAMMA)   \
+    FIELD(Bool,   "active_low",  actuadores.activoBajo(id))
+
+// Los handlers se ejecutan uno por vez en la tarea de AsyncTCP. El cuerpo
+// JSON (menos de 200 bytes) se copia al buffer TCP dentro de send_P(), por
+// eso alcanza con un buffer static por endpoint en lugar del stack
+
 // API REST para sensores
-void handleApiSensors() {
-    StaticJsonDocument<200> doc;
-    doc["temperature"] = temperature;
-    doc["timestamp"] = millis();
-    doc["uptime"] = millis() / 1000;
-    doc["free_heap"] = ESP.getFreeHeap();
-    doc["wifi_rssi"] = WiFi.RSSI();
-
-    String response;
-    serializeJson(doc, response);
-    server.send(200, "application/json", response);
+void handleApiSensors(AsyncWebServerRequest *request) {
+    EstadoDashboard e;
+    estado.leer(e);
+    static char body[JSON_MAX_LEN(SENSORS_JSON)];
+    JsonWriter json(body, sizeof(body));
+    SENSORS_JSON(JSON_WRITE_FIELD)
+    request->send_P(200, "application/json", (const uint8_t *)body, json.finish());
     Serial.println("API sensores consultada");
+    if (marcarArranque(ARRANQUE_PRIMERA_API)) mostrarArranque();
+}
+
+// Marcas del arranque en us (0 = la fase todavía no pasó)
+void handleApiBoot(AsyncWebServerRequest *request) {
+    static char body[JSON_MAX_LEN(BOOT_JSON) FASES_ARRANQUE(BOOT_FASE_MAX)];
+    JsonWriter json(body, sizeof(body));
+    BOOT_JSON(JSON_WRITE_FIELD)
+    for (uint8_t i = 0; i < ARRANQUE_FASES; i++) json.writeU32(clavesArranque[i], perfil.marca(i));
+    request->send_P(200, "application/json", (const uint8_t *)body, json.finish());
 }
 
 // API para estado del LED (GET)
-void handleApiLedGet() {
-    StaticJsonDocument<150> doc;
-    doc["state"] = ledState;
-    doc["brightness"] = ledBrightness;
-
-    String response;
-    serializeJson(doc, response);
-    server.send(200, "application/json", response);
+void handleApiLedGet(AsyncWebServerRequest *request) {
+    EstadoDashboard e;
+    estado.leer(e);
+    static char body[JSON_MAX_LEN(LED_JSON)];
+    JsonWriter json(body, sizeof(body));
+    LED_JSON(JSON_WRITE_FIELD)
+    request->send_P(200, "application/json", (const uint8_t *)body, json.finish());
     Serial.println("Estado LED consultado");
 }
 
-// API para control del LED (POST)
-void handleApiLedPost() {
-    bool stateChanged = false;
-    if (server.hasArg("action")) {
-        String action = server.arg("action");
+// API para control del LED (POST). El pedido lo aplica controlar() y la
+// respuesta lleva el estado previsto (el que va a quedar)
+void handleApiLedPost(AsyncWebServerRequest *request) {
+    PedidoControl pedido;
+    memset(&pedido, 0, sizeof(pedido));
+    // true = buscar en el cuerpo del POST (FormData), no en la URL
+    if (request->hasParam("action", true)) {
+        const String &action = request->getParam("action", true)->value();
         if (action == "toggle") {
-            ledState = !ledState;
-
-            // Aplicar PWM según el estado y brillo usando lógica invertida
-            if (ledState) {
-                int pwmValue = brightnessToGammaPWM(ledBrightness);
-                uint8_t raw = logicaInvertida ? pwmValue : (255 - pwmValue);
-                ledcWrite(PWM_CHANNEL, raw);
-            } else {
-                uint8_t raw = logicaInvertida ? 0 : 255;  // Apagado
-                ledcWrite(PWM_CHANNEL, raw);
-            }
-
-            stateChanged = true;
-            Serial.printf("LED %s", ledState ? "ON" : "OFF");
-            Serial.println();
-        } else if (action == "brightness" && server.hasArg("value")) {
-            int tempBrightness = server.arg("value").toInt();
-            // Validar rango y convertir a uint8_t
+            pedido.comandos[pedido.cantidad++] = {ledPrincipal, OP_ALTERNAR, 0};
+        } else if (action == "brightness" && request->hasParam("value", true)) {
+            int tempBrightness = request->getParam("value", true)->value().toInt();
+            // Validar rango; brillo 0 apaga el LED, mayor a 0 lo enciende
             if (tempBrightness < 0) tempBrightness = 0;
             if (tempBrightness > 100) tempBrightness = 100;
-            ledBrightness = (uint8_t)tempBrightness;
-
-            // Si el brillo es 0, apagar el LED
-            if (ledBrightness == 0) {
-                ledState = false;
-                uint8_t raw = logicaInvertida ? 0 : 255;  // Apagado según lógica
-                ledcWrite(PWM_CHANNEL, raw);
-            } else {
-                // Si se ajusta el brillo y es mayor a 0, encender el LED
-                ledState = true;
-                int pwmValue = brightnessToGammaPWM(ledBrightness);
-                uint8_t raw = logicaInvertida ? pwmValue : (255 - pwmValue);
-                ledcWrite(PWM_CHANNEL, raw);
+            pedido.comandos[pedido.cantidad++] = {ledPrincipal, OP_BRILLO, (uint8_t)tempBrightness};
+        } else if (action == "pwm" && request->hasParam("value", true)) {
+            // Frecuencia en Hz para todos los canales: la resolución se
+            // elige sola (máxima posible). Fuera de rango ledcSetup()
+            // fallaría en la tarea de control, después de responder
+            long frecuencia = request->getParam("value", true)->value().toInt();
+            if (frecuencia <= 0 || !bitsParaFrecuencia((uint32_t)frecuencia)) {
+                char texto[64];
+                snprintf(texto, sizeof(texto), "PWM frequency out of range (%u-%lu Hz)",
+                         (unsigned)frecuenciaMinima(PWM_BITS_MAX), PWM_RELOJ_HZ >> PWM_BITS_MIN);
+                request->send(400, "text/plain", texto);
+                return;
             }
-
-            stateChanged = true;
-            Serial.printf("Brillo: %d%% (Estado: %s)", ledBrightness, ledState ? "ON" : "OFF");
-            Serial.println();
+            pedido.frecuencia = (uint32_t)frecuencia;
         }
     }
 
-    if (stateChanged) {
-        StaticJsonDocument<200> doc;
-        doc["success"] = true;
-        doc["state"] = ledState;
-        doc["brightness"] = ledBrightness;
+    if (pedido.cantidad == 0 && pedido.frecuencia == 0) {
+        request->send(400, "text/plain", "Invalid parameters");
+        return;
+    }
+    EstadoDashboard e;
+    if (!pedirYPrever(pedido, e)) {
+        request->send(503, "text/plain", "Control busy");
+        return;
+    }
+    if (pedido.cantidad) {
+        Serial.printf("LED %s, brillo %u%%\n", e.encendido(ledPrincipal) ? "ON" : "OFF", e.brillo[ledPrincipal]);
+    }
+    static char body[JSON_MAX_LEN(LED_POST_JSON)];
+    JsonWriter json(body, sizeof(body));
+    LED_POST_JSON(JSON_WRITE_FIELD)
+    request->send_P(200, "application/json", (const uint8_t *)body, json.finish());
+}
+
+// Estado de todos los actuadores (GET y respuesta del POST)
+void sendActuators(AsyncWebServerRequest *request, const EstadoDashboard &e) {
+    static char body[JSON_MAX_LEN(ACTUATORS_JSON) + JSON_MAX_ARRAY("actuators", ACTUATOR_JSON, ACTUADORES_MAX)];
+    JsonWriter json(body, sizeof(body));
+    ACTUATORS_JSON(JSON_WRITE_FIELD)
+    json.beginArray("actuators");
+    for (uint8_t id = 0; id < actuadores.cantidad(); id++) {
+        json.beginObject();
+        ACTUATOR_JSON(JSON_WRITE_FIELD)
+        json.endObject();
+    }
+    json.endArray();
+    request->send_P(200, "application/json", (const uint8_t *)body, json.finish());
+}
 
-        String response;
-        serializeJson(doc, response);
-        server.send(200, "application/json", response);
+void handleApiActuatorsGet(AsyncWebServerRequest *request) {
+    EstadoDashboard e;
+    estado.leer(e);
+    sendActuators(request, e);
+}
+
+// Varios cambios en una sola petición: cmd=0:75,1:on,2:off,3:toggle
+// (número = brillo 0-100). Se validan todos antes de encolarlos y
+// controlar() los aplica juntos; si uno es inválido no se aplica ninguno
+void handleApiActuatorsPost(AsyncWebServerRequest *request) {
+    PedidoControl pedido;
+    memset(&pedido, 0, sizeof(pedido));
+    int cantidad = -1;
+    if (request->hasParam("cmd", true)) {
+        cantidad = parsearComandos(request->getParam("cmd", true)->value().c_str(), pedido.comandos,
+                                   sizeof(pedido.comandos) / sizeof(pedido.comandos[0]));
+    }
+    if (cantidad <= 0 || !actuadores.validarLote(pedido.comandos, (uint8_t)cantidad)) {
+        request->send(400, "text/plain", "Invalid commands");
+        return;
+    }
+    pedido.cantidad = (uint8_t)cantidad;
+    EstadoDashboard e;
+    if (!pedirYPrever(pedido, e)) {
+        request->send(503, "text/plain", "Control busy");
+        return;
+    }
+    Serial.printf("Actuadores: %d comandos en lote\n", cantidad);
+    sendActuators(request, e);
+}
+
+// Últimos valores enviados por /api/stream (para enviar solo los cambios)
+CambiosStream cambiosStream(streamHeartbeatInterval);
+
+// Eventos SSE: "sensors" y "led" llevan el mismo JSON que /api/sensors y
+// /api/led. Con client == nullptr se envían a todas las pestañas abiertas
+void sendSensorsEvent(const EstadoDashboard &e, AsyncEventSourceClient *client = nullptr) {
+    char body[JSON_MAX_LEN(SENSORS_JSON)];
+    JsonWriter json(body, sizeof(body));
+    SENSORS_JSON(JSON_WRITE_FIELD)
+    json.finish();
+    if (client) {
+        client->send(body, "sensors", millis());
     } else {
-        server.send(400, "text/plain", "Invalid parameters");
+        events.send(body, "sensors", millis());
+    }
+}
+
+void sendLedEvent(const EstadoDashboard &e, AsyncEventSourceClient *client = nullptr) {
+    char body[JSON_MAX_LEN(LED_JSON)];
+    JsonWriter json(body, sizeof(body));
+    LED_JSON(JSON_WRITE_FIELD)
+    json.finish();
+    if (client) {
+        client->send(body, "led", millis());
+    } else {
+        events.send(body, "led", millis());
+    }
+}
+
+// Pestaña nueva: recibe el estado completo (y el tiempo de reconexión)
+void handleStreamConnect(AsyncEventSourceClient *client) {
+    client->send("hola", nullptr, millis(), 3000);  // Reintentar a los 3 s si se corta
+    EstadoDashboard e;
+    estado.leer(e);
+    sendSensorsEvent(e, client);
+    sendLedEvent(e, client);
+    Serial.printf("Stream: cliente conectado (%u abiertos)\n", (unsigned)events.count());
+}
+
+// Tarea de red: envía solo lo que cambió y, si pasó el intervalo sin
+// enviar nada, un heartbeat con todo el estado
+void updateStream() {
+    if (events.count() == 0) return;  // Ninguna pestaña abierta
+
+    EstadoDashboard e;
+    estado.leer(e);
+    uint8_t enviar = cambiosStream.revisar(e.temperatura, e.encendido(ledPrincipal), e.brillo[ledPrincipal], millis());
+    if (enviar & EVENTO_SENSORES) sendSensorsEvent(e);
+    if (enviar & EVENTO_LED) sendLedEvent(e);
+}
+
+// Eventos del WebSocket (tarea de AsyncTCP): pasa el comando a
+// controlar(), sin esperar. El brillo va al buzón brilloSlider (cada
+// movimiento reemplaza al anterior) con la posición de la cola, para que
+// controlar() lo ordene con los toggles y POST; el toggle va por la cola,
+// y si está llena se descarta
+void handleWsEvent(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type,
+                   void *arg, uint8_t *data, size_t len) {
+    if (type == WS_EVT_CONNECT) {
+        Serial.printf("WebSocket: cliente %u conectado\n", client->id());
+        return;
     }
+    if (type != WS_EVT_DATA) return;
+
+    // Solo tramas binarias completas de 2 bytes
+    AwsFrameInfo *info = (AwsFrameInfo *)arg;
+    if (!info->final || info->index != 0 || info->len != 2 || info->opcode != WS_BINARY) return;
+
+    // Dos toggles seguidos se anulan; el brillo define el estado (0 = apagado)
+    ComandoActuador comando;
+    if (!comandoDeTrama(data, len, ledPrincipal, comando)) return;
+    if (comando.op == OP_BRILLO) {
+        brilloSlider.dejar(comando.valor, colaPedidos.escritos());
+        aplicarAEstado(comando, previsto.brillo, previsto.encendidos);
+        despertarControl();
+        return;
+    }
+
+    // Toggle: por la cola, detrás del brillo que ya esté en el buzón
+    PedidoControl pedido;
+    memset(&pedido, 0, sizeof(pedido));
+    pedido.comandos[pedido.cantidad++] = comando;
+    enviarPedido(pedido);
 }
 
-// Manejar 404 y archivos estáticos
-void handleNotFound() {
-    if (!handleFileRead(server.uri())) {
-        server.send(404, "text/plain", "Archivo no encontrado");
+// Handlers de la API indexados por ApiId (ver api_routes.h)
+struct ApiHandlers {
+    void (*get)(AsyncWebServerRequest *request);
+    void (*post)(AsyncWebServerRequest *request);
+};
+
+const ApiHandlers apiHandlers[API_COUNT] = {
+    {handleApiSensors, nullptr},          // API_SENSORS
+    {handleApiLedGet, handleApiLedPost},  // API_LED
+    {handleApiActuatorsGet, handleApiActuatorsPost},  // API_ACTUATORS
+    {handleApiBoot, nullptr},             // API_BOOT
+};
+
+// Punto de entrada único: busca la URI en la tabla de rutas con hash
+// perfecto y despacha a la API o al archivo estático correspondiente
+void handleRequest(AsyncWebServerRequest *request) {
+    const Route *route = findRoute(request->url().c_str());
+
+    if (route && route->api >= 0) {
+        const ApiHandlers &api = apiHandlers[route->api];
+        void (*handler)(AsyncWebServerRequest *) = request->method() == HTTP_POST ? api.post : api.get;
+        if (handler) {
+            handler(request);
+        } else {
+            request->send(405, "text/plain", "Metodo no permitido");
+        }
+        return;
+    }
+
+    // Diferido: LittleFS todavía se está montando en montar_fs. La página
+    // se recarga sola en 1 s (los demás archivos los pide después)
+    if (route && route->file && estadoFs.load(std::memory_order_acquire) == FS_SIN_MONTAR) {
+        AsyncWebServerResponse *response =
+            request->beginResponse(503, "text/html", "<meta http-equiv='refresh' content='1'>Iniciando...");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return;
     }
+
+    if (route && handleFileRead(request, *route)) return;
+
+    // Sin index.html en LittleFS (sin montar o vacío) la raíz muestra la
+    // página básica
+    if (route && esPaginaPrincipal(*route)) {
+        handleFallbackPage(request);
+        return;
+    }
+
+    request->send(404, "text/plain", "Archivo no encontrado");
 }
 
+// Valores que muestra el OLED. Si son los mismos que en el refresco
+// anterior no se redibuja ni se envía nada por I2C
+struct PantallaOled {
+    char temp[16];
+    uint8_t brillo;
+    bool encendido;
+};
+PantallaOled pantallaMostrada;
+bool pantallaValida = false;
+
 // Función para actualizar display OLED
 void updateOLED() {
-    u8g2.clearBuffer();
+    EstadoDashboard e;
+    estado.leer(e);
+    PantallaOled pantalla;
+#ifdef PUNTO_FIJO
+    // Un solo paso por float (temperatureRead() ya lo entrega así); el
+    // formateo es con enteros, sin String ni printf("%f")
+    size_t largo = Q16::desdeFloat(e.temperatura).formatear(pantalla.temp, sizeof(pantalla.temp) - 2, 1);
+    memcpy(pantalla.temp + largo, " C", 3);
+#else
+    snprintf(pantalla.temp, sizeof(pantalla.temp), "%.1f C", e.temperatura);
+#endif
+    pantalla.brillo = e.brillo[ledPrincipal];
+    pantalla.encendido = e.encendido(ledPrincipal);
 
-    // Fuente mediana para labels y valores
-    u8g2.setFont(u8g2_font_7x13_tf);
+    if (pantallaValida && strcmp(pantalla.temp, pantallaMostrada.temp) == 0 &&
+        pantalla.brillo == pantallaMostrada.brillo && pantalla.encendido == pantallaMostrada.encendido) {
+        return;  // Nada cambió: ni dibujar ni I2C
+    }
+    // Etiquetas en posiciones fijas, valores alineados a la derecha con
+    // los anchos ya medidos (sin getStrWidth() en cada refresco)
+    layoutOled.dibujar(u8g2, pantalla.temp, pantalla.brillo, pantalla.encendido);
+
+    // El I2C lo hace la tarea oled_i2c (solo las páginas que cambiaron:
+    // un dígito nuevo son ~90 bytes en lugar de ~1.2 KB). Si todavía está
+    // enviando el cuadro anterior, este queda pendiente y sale después
+    if (oledFondo.publicar(u8g2.getBufferPtr())) {
+        pantallaMostrada = pantalla;
+        pantallaValida = true;
+    }
+}
 
-    // Mostrar temperatura
-    u8g2.drawStr(0, 15, "Temp:");
-    String tempStr = String(temperature, 1) + " C";
-    int xTemp = 128 - u8g2.getStrWidth(tempStr.c_str());
-    u8g2.drawStr(xTemp, 15, tempStr.c_str());
-
-    // Mostrar brillo del LED
-    u8g2.drawStr(0, 30, "Brillo LED:");
-    String brightnessStr = String(ledBrightness) + " %";
-    int xBright = 128 - u8g2.getStrWidth(brightnessStr.c_str());
-    u8g2.drawStr(xBright, 30, brightnessStr.c_str());
-
-    // Mostrar estado del LED
-    u8g2.drawStr(0, 45, "Estado:");
-    String stateStr = ledState ? "ON" : "OFF";
-    int xState = 128 - u8g2.getStrWidth(stateStr.c_str());
-    u8g2.drawStr(xState, 45, stateStr.c_str());
-
-    // Logo UNSE centrado al final (fuente más pequeña)
-    u8g2.setFont(u8g2_font_helvB08_tf);
-    String unse = "UNSE IoT";
-    int xUnse = (128 - u8g2.getStrWidth(unse.c_str())) / 2;
-    u8g2.drawStr(xUnse, 62, unse.c_str());
+// Tarea de red: cambios por SSE a las pestañas conectadas
+void tickRed() {
+    updateStream();
+    ws.cleanupClients();  // Liberar conexiones cerradas
+}
 
-    u8g2.sendBuffer();
+// Por tarea: jitter y desbordes (planificador) o pila libre (MULTITAREA)
+void printTaskStats() {
+#ifdef MULTITAREA
+    for (uint8_t i = 0; i < cantidadTareas; i++) {
+        Serial.printf("  %-9s pila libre %5u bytes\n", pcTaskGetTaskName(tareas[i]),
+                      (unsigned)uxTaskGetStackHighWaterMark(tareas[i]));
+    }
+#else
+    for (uint8_t id = 0; id < planificador.cantidad(); id++) {
+        const EstadisticasTarea &e = planificador.estadisticas(id);
+        uint32_t porDeadline = e.ejecuciones - e.solicitadas;
+        Serial.printf("  %-9s %6u ejec. | jitter máx %5u us, medio %5u us | duración máx %6u us | desbordes %u\n",
+                      planificador.nombre(id), e.ejecuciones, e.jitterMaxUs,
+                      porDeadline ? (unsigned)(e.jitterSumaUs / porDeadline) : 0, e.duracionMaxUs, e.desbordes);
+    }
+    if (oledFondo.tarea()) {  // Tarea de FreeRTOS aparte del planificador
+        Serial.printf("  %-9s pila libre %5u bytes | último envío %u bytes en %u us\n", OLED_TAREA_NOMBRE,
+                      (unsigned)uxTaskGetStackHighWaterMark(oledFondo.tarea()), oledFondo.ultimosBytes(),
+                      (unsigned)oledFondo.ultimoEnvioUs());
+    }
+    planificador.reiniciarEstadisticas();
+#endif
+    Serial.printf("  Colas: %u lecturas y %u pedidos descartados\n", colaLecturas.perdidos(), colaPedidos.perdidos());
+}
+
+// Mostrar IP y estadísticas de las tareas periódicamente
+void showIp() {
+    EstadoDashboard e;
+    estado.leer(e);
+    if (WiFi.status() == WL_CONNECTED) {
+        Serial.println();
+        Serial.println("Dashboard: http://" + WiFi.localIP().toString() + " | Temp UC: " + String(e.temperatura, 1) + "°C | LED: " + String(e.encendido(ledPrincipal) ? "ON" : "OFF"));
+    } else {
+        Serial.println();
+        Serial.println("WiFi desconectado - dashboard no disponible");
+    }
+    printTaskStats();
+}
+
+// Tareas periódicas. Con MULTITAREA cada una es una tarea de FreeRTOS:
+//   núcleo 0 (PRO_CPU): pila WiFi/lwIP, AsyncTCP (HTTP) y lo que usa la red
+//   núcleo 1 (APP_CPU): control, sensores y OLED, sin esperas de la red
+// Sin MULTITAREA las corre el planificador en loop() (prioridad y núcleo
+// no se usan)
+struct TareaDashboard {
+    const char *nombre;
+    void (*funcion)();
+    uint32_t periodoMs;
+    uint32_t faseMs;  // Primera ejecución
+    UBaseType_t prioridad;
+    BaseType_t nucleo;
+};
+
+const TareaDashboard tareasDashboard[] = {
+    {"sensores", readSensors,         sensorInterval,     0,                 2, 1},
+    {"oled",     updateOLED,          oledUpdateInterval, 0,                 1, 1},
+    {"red",      tickRed,             streamTickInterval, 0,                 2, 0},
+    {"wifi",     actualizarWifi,      wifiTickInterval,   0,                 1, 0},
+    {"ip",       showIp,              ipShowInterval,     ipShowInterval,    1, 0},
+};
+
+#ifdef MULTITAREA
+void correrPeriodica(void *arg) {
+    const TareaDashboard *t = (const TareaDashboard *)arg;
+    vTaskDelay(pdMS_TO_TICKS(t->faseMs));
+    TickType_t ultimo = xTaskGetTickCount();
+    for (;;) {
+        t->funcion();
+        vTaskDelayUntil(&ultimo, pdMS_TO_TICKS(t->periodoMs));  // Sin deriva
+    }
+}
+
+// Control: duerme hasta que llega una lectura o un pedido
+void correrControl(void *arg) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(controlInterval));
+        controlar();
+    }
+}
+
+bool crearTarea(TaskFunction_t funcion, const char *nombre, void *arg, UBaseType_t prioridad,
+                BaseType_t nucleo, TaskHandle_t *handle) {
+    if (cantidadTareas >= TAREAS_MAX) return false;
+    if (xTaskCreatePinnedToCore(funcion, nombre, TAREA_PILA, arg, prioridad, handle, nucleo) != pdPASS) return false;
+    tareas[cantidadTareas++] = *handle;
+    return true;
+}
+#endif
+
+// Crea las tareas (MULTITAREA) o las registra en el planificador
+void iniciarTareas() {
+    publicarEstado();  // Estado inicial antes de que nadie lo lea
+    estado.leer(previsto);
+#ifdef MULTITAREA
+    bool ok = crearTarea(correrControl, "control", nullptr, CONTROL_PRIORIDAD, 1, &tareaControl);
+    for (const TareaDashboard &t : tareasDashboard) {
+        TaskHandle_t handle;
+        ok &= crearTarea(correrPeriodica, t.nombre, (void *)&t, t.prioridad, t.nucleo, &handle);
+    }
+    if (oledFondo.tarea() && cantidadTareas < TAREAS_MAX) {
+        tareas[cantidadTareas++] = oledFondo.tarea();  // Creada en setup(), también en las estadísticas
+    }
+    if (!ok) Serial.println("Error: no se pudieron crear todas las tareas");
+#else
+    tareaLoop = xTaskGetCurrentTaskHandle();  // setup() y loop() comparten tarea
+    planificador.alDespertar(despertarLoop);
+    idControl = planificador.agregar("control", controlar, controlInterval * 1000);
+    for (const TareaDashboard &t : tareasDashboard) {
+        planificador.agregar(t.nombre, t.funcion, t.periodoMs * 1000, t.faseMs * 1000);
+    }
+#endif
 }
 
 void setup() {
+    marcarArranque(ARRANQUE_SETUP);
     Serial.begin(115200);
+#ifndef INICIO_DIFERIDO
     delay(1000);  // Dar tiempo al Serial para inicializar
+#endif
+    marcarArranque(ARRANQUE_SERIAL);
 
     Serial.println();
     Serial.println("=== ESP32 IoT Dashboard Completo (LittleFS) ===");
@@ -309,100 +988,104 @@ void setup() {
     // Configurar pines ANTES de WiFi
     pinMode(LED_PIN, OUTPUT);
 
-    // Configurar PWM para control de brillo
-    ledcSetup(PWM_CHANNEL, 5000, 8);
-    ledcAttachPin(LED_PIN, PWM_CHANNEL);
+    // Actuadores PWM: frecuencia común y el LED de la placa como primer
+    // canal, apagado (aplicar() escribe el duty con la polaridad correcta)
+    actuadores.configurarPwm(PWM_FRECUENCIA_INICIAL);
+    ledPrincipal = actuadores.agregar(LED_PIN, LED_ACTIVO_BAJO, CURVA_GAMMA);
+    actuadores.fijarEstado(ledPrincipal, false);
+    actuadores.aplicar();
 
-    // Inicializar LED apagado usando lógica apropiada
-    uint8_t offValue = logicaInvertida ? 0 : 255;  // Valor para LED apagado
-    ledcWrite(PWM_CHANNEL, offValue);
-    ledState = false;
-
-    Serial.printf("LED configurado en pin %d (Lógica: %s)", LED_PIN, logicaInvertida ? "Invertida" : "Normal");
+    Serial.printf("LED configurado en pin %d (activo en %s, PWM %u Hz / %u bits)", LED_PIN,
+                  LED_ACTIVO_BAJO ? "LOW" : "HIGH", (unsigned)actuadores.frecuencia(), actuadores.bits());
     Serial.println();
+    marcarArranque(ARRANQUE_PWM);
+
+    // Iniciar la conexión WiFi sin esperarla: la tarea "wifi" la sigue y
+    // alCambiarWifi() muestra la IP al conectar. Se inicia antes del OLED
+    // (la asociación avanza mientras tanto) y antes de crear las tareas,
+    // que desde ahí son las únicas que la tocan
+    Serial.println("Conectando a WiFi " + String(ssid) + "...");
+    wifi.alCambiar(alCambiarWifi);
+    WiFi.onEvent(onWifiEvent);
+    if ((uint32_t)ipFija != 0) radioWifi.ipFija(ipFija, gatewayFijo, mascaraFija, dnsFijo);
+    wifi.iniciar(millis());
+    marcarArranque(ARRANQUE_WIFI);
+    if (wifi.rapido()) Serial.println("Conexión rápida con el AP y la IP guardados");
 
     // Inicializar OLED
     Wire.begin(20, 21); // ESP32-C3 SDA = GPIO20, SCL = GPIO21
     u8g2.begin();
+    layoutOled.iniciar(u8g2, u8g2_font_7x13_tf, u8g2_font_helvB08_tf);
     Serial.println("OLED inicializado correctamente");
 
-    // Mostrar mensaje de inicio en OLED
+#ifndef INICIO_DIFERIDO
+    // Mostrar mensaje de inicio en OLED (diferido no hace falta: la tarea
+    // del OLED dibuja la pantalla completa apenas arranca)
     u8g2.clearBuffer();
     u8g2.setFont(u8g2_font_helvB10_tf);
     String initMsg = "Iniciando...";
     int xInit = (128 - u8g2.getStrWidth(initMsg.c_str())) / 2;
     u8g2.drawStr(xInit, 32, initMsg.c_str());
     u8g2.sendBuffer();
+#endif
 
-    // Conectar WiFi PRIMERO
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(ssid, password);
-    Serial.print("Conectando a WiFi");
-
-    int wifiAttempts = 0;
-    while (WiFi.status() != WL_CONNECTED && wifiAttempts < 30) {
-        delay(1000);
-        Serial.print(".");
-        wifiAttempts++;
+    // Desde acá el I2C del display lo maneja la tarea oled_i2c, en el
+    // mismo núcleo que dibuja (1 en el ESP32, 0 en el C3), lejos de la red
+    if (!oledFondo.begin(u8g2.getU8x8(), ARDUINO_RUNNING_CORE)) {
+        Serial.println("Error: no se pudo crear la tarea del OLED");
     }
-
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println();
-        Serial.println("WiFi conectado!");
-        Serial.println("===========================================");
-        Serial.print("IP del dispositivo: ");
-        Serial.println(WiFi.localIP());
-        Serial.println("===========================================");
-        Serial.println("Abrir en el navegador:");
-        Serial.print("   http://");
-        Serial.println(WiFi.localIP());
-        Serial.println("===========================================");
-    } else {
-        Serial.println();
-        Serial.println("Error: No se pudo conectar a WiFi");
-        Serial.println("Continuando sin conexión...");
-        return;  // Salir si no hay WiFi
+    marcarArranque(ARRANQUE_OLED);
+
+    // Tareas: desde acá los actuadores, el OLED, los sensores y la
+    // conexión WiFi son de sus tareas
+    iniciarTareas();
+    marcarArranque(ARRANQUE_TAREAS);
+
+    // Inicializar LittleFS y el servidor aunque todavía no haya WiFi:
+    // empiezan a atender apenas llega la IP. Diferido, LittleFS se monta
+    // en su tarea mientras setup() sigue (la API no lo necesita; los
+    // archivos responden 503 hasta que termine)
+#ifdef INICIO_DIFERIDO
+    if (xTaskCreate(tareaMontarFs, "montar_fs", MONTAR_FS_PILA, nullptr, MONTAR_FS_PRIORIDAD, nullptr) != pdPASS) {
+        Serial.println("Error: no se pudo crear la tarea montar_fs, montando en setup()");
+        montarFs();
     }
+#else
+    montarFs();
+#endif
 
-    // Inicializar LittleFS DESPUÉS de WiFi
-    if (!LittleFS.begin(true)) {  // true = formatear si es necesario
-        Serial.println("Error montando LittleFS, usando modo básico");
-        Serial.println("El dashboard funcionará con página básica");
-        // Continuar sin LittleFS
-    } else {
-        Serial.println("LittleFS montado correctamente");
-        Serial.println("Archivos disponibles:");
-
-        // Listar archivos en LittleFS para debug
-        File root = LittleFS.open("/");
-        File file = root.openNextFile();
-        while (file) {
-            Serial.println("  - " + String(file.name()) + " (" + String(file.size()) + " bytes)");
-            file = root.openNextFile();
-        }
-    };
+    // Todas las rutas se resuelven con la tabla generada (route_table.h).
+    // AsyncWebServer guarda todas las cabeceras de la petición, no hace
+    // falta collectHeaders()
+    server.onNotFound(handleRequest);
 
-    // Configurar rutas del servidor
-    server.on("/", handleRoot);
-    server.on("/api/sensors", HTTP_GET, handleApiSensors);
-    server.on("/api/led", HTTP_GET, handleApiLedGet);
-    server.on("/api/led", HTTP_POST, handleApiLedPost);
-    server.onNotFound(handleNotFound);
+    // /api/stream lo atiende AsyncEventSource (tiene su propio handler)
+    events.onConnect(handleStreamConnect);
+    server.addHandler(&events);
+
+    // /api/ws: control del LED por WebSocket
+    ws.onEvent(handleWsEvent);
+    server.addHandler(&ws);
 
     // Iniciar servidor
     server.begin();
+    marcarArranque(ARRANQUE_SERVIDOR);
     Serial.println("Servidor web iniciado en puerto 80");
 
+#ifdef BANNER_SERIAL
     // Mostrar información de conexión de manera prominente
     Serial.println();
     Serial.println(String('=', 50));
     Serial.println("DASHBOARD COMPLETO INICIADO");
     Serial.println(String('=', 50));
-    Serial.println("IP Local: " + WiFi.localIP().toString());
-    Serial.println("URL: http://" + WiFi.localIP().toString());
+    Serial.println("IP: se muestra al conectar el WiFi");
     Serial.println("Puerto: 80");
     Serial.println("SSID: " + String(ssid));
+#ifdef INICIO_DIFERIDO
+    Serial.println("Sistema de archivos: LittleFS (se monta en la tarea montar_fs)");
+#else
     Serial.println("Sistema de archivos: LittleFS " + String(LittleFS.totalBytes()) + " bytes");
+#endif
     Serial.println("Funcionalidades:");
     Serial.println("  Archivos estáticos desde LittleFS");
     Serial.println("  Sensor temperatura ESP32");
@@ -412,50 +1095,27 @@ void setup() {
     Serial.println("  Dashboard interactivo");
     Serial.println(String('=', 50));
     Serial.println();
+#endif
+    marcarArranque(ARRANQUE_FIN_SETUP);
 
-    // Lectura inicial de sensores
-    readSensors();
-
-    // Actualización inicial del OLED
-    updateOLED();
+    // La lectura inicial de sensores y el primer refresco del OLED los
+    // hacen sus tareas apenas se crean (fase 0)
 }
 
 void loop() {
-    // Manejar clientes del servidor web
-    server.handleClient();
-
-    // Leer sensores periódicamente
-    if (millis() - lastSensorRead > sensorInterval) {
-        lastSensorRead = millis();
-        readSensors();
-    }
-
-    // Actualizar OLED periódicamente
-    if (millis() - lastOledUpdate > oledUpdateInterval) {
-        lastOledUpdate = millis();
-        updateOLED();
-    }
+    // El servidor web ya no se atiende acá: AsyncTCP procesa las conexiones
+    // en su propia tarea aunque loop() esté ocupado (OLED, reconexión WiFi)
 
-    // Verificar conexión WiFi periódicamente
-    if (millis() - lastWiFiCheck > wifiCheckInterval) {
-        lastWiFiCheck = millis();
-        checkWiFiConnection();
-    }
-
-    // Mostrar IP periódicamente
-    if (millis() - lastIpShow > ipShowInterval) {
-        lastIpShow = millis();
-        if (WiFi.status() == WL_CONNECTED) {
-            Serial.println();
-            Serial.println("Dashboard: http://" + WiFi.localIP().toString() + " | Temp UC: " + String(temperature, 1) + "°C | LED: " + String(ledState ? "ON" : "OFF"));
-        } else {
-            Serial.println();
-            Serial.println("WiFi desconectado - dashboard no disponible");
-        }
-    }
-
-    // Pequeña pausa para estabilidad
-    delay(10);
+#ifdef MULTITAREA
+    // Todo corre en las tareas creadas en setup()
+    vTaskDelete(nullptr);
+#else
+    // Correr las tareas vencidas (control, sensores, OLED, red, WiFi, IP)
+    // y dormir hasta la próxima, o hasta que llegue un pedido. El
+    // redondeo hacia arriba a ticks de 1 ms evita despertar antes de tiempo
+    uint32_t esperaUs = planificador.ejecutar();
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS((esperaUs + 999) / 1000));
+#endif
 }
 
 /*
@@ -479,7 +1139,7 @@ ARQUITECTURA COMPLETA:
 - Frontend Web (Browser): HTML/CSS/JS separados, responsive
 - Frontend Local (OLED): Visualización en tiempo real sin conectividad
 - Comunicación: JSON sobre HTTP (web) + I2C (OLED)
-- Actualización: Fetch API asíncrono (web) + polling periódico (OLED)
+- Actualización: Server-Sent Events (web) + refresco periódico (OLED)
 
 VENTAJAS DEL SISTEMA:
 ✓ Código organizado y mantenible
@@ -532,6 +1192,157 @@ LittleFS vs SPIFFS:
 - LittleFS: Más nuevo, rápido, confiable (recomendado)
 - SPIFFS: Legacy, compatible con código antiguo
 
+--- TABLA DE RUTAS CON HASH PERFECTO ---
+
+En lugar de registrar cada ruta con server.on() y dejar que lo demás
+caiga en onNotFound (que armaba Strings, comparaba extensiones y
+consultaba LittleFS), todas las peticiones entran por handleRequest():
+
+  server.onNotFound(handleRequest);
+  const Route *route = findRoute(request->url().c_str());
+
+tools/gen_route_table.py genera route_table.h al compilar con:
+  - Endpoints de api_routes.h → índice en apiHandlers[] (GET/POST)
+  - Archivos de data/ → tipo MIME, archivo a abrir ("/" abre
+    /index.html) y variante .gz
+
+El script busca una semilla para la que el hash FNV-1a de cada ruta cae
+en un casillero distinto de la tabla (hash perfecto). Buscar una ruta
+es un hash + un strcmp: sin memoria dinámica ni accesos a la flash.
+
+El tamaño y el ETag NO van en la tabla: al montar LittleFS se lee cada
+archivo una vez (archivos_estaticos.h), así subir solo la imagen
+LittleFS con data/ modificado sirve los tamaños y ETag nuevos. Agregar o
+renombrar archivos sí requiere recompilar (cambia la tabla).
+
+--- SERVIDOR ASÍNCRONO ---
+
+Con WebServer (síncrono) todas las peticiones se atendían desde
+server.handleClient() en loop(): mientras se dibujaba el OLED o
+checkWiFiConnection() esperaba la reconexión (hasta 5 s), ningún
+navegador recibía respuesta. Además atendía un cliente por vez.
+
+ESPAsyncWebServer (sobre AsyncTCP) funciona por eventos:
+  - AsyncTCP corre en su propia tarea de FreeRTOS y recibe los eventos
+    de lwIP (conexión nueva, datos recibidos, datos confirmados)
+  - Cada conexión tiene su AsyncWebServerRequest, una máquina de estados
+    que parsea la petición a medida que llegan los datos
+  - Varias conexiones avanzan a la vez: un archivo grande se envía por
+    partes cada vez que el cliente confirma lo recibido
+  - loop() ya no llama a handleClient()
+
+  AsyncWebServer server(80);
+  server.onNotFound(handleRequest);      // void handleRequest(AsyncWebServerRequest *request)
+  request->url()                         // Ruta pedida
+  request->getHeader("If-None-Match")    // Cabecera (nullptr si no vino)
+  request->getParam("action", true)      // Parámetro del cuerpo del POST
+  request->send(200, "text/plain", "OK");
+
+PRECAUCIONES:
+  • Los handlers corren en la tarea de AsyncTCP: NO usar delay() ni
+    operaciones largas dentro de ellos (se frenan todas las conexiones)
+  • No compartir variables sueltas con las otras tareas: este ejemplo
+    envía pedidos por una cola y lee el estado de una instantánea
+    (ver MULTITAREA)
+  • La librería cierra la conexión después de cada respuesta (no hay
+    keep-alive ni pipelining HTTP); el navegador abre varias en paralelo
+
+MEDICIÓN EN LA PC (tools/carga_http.cpp):
+  Un servidor de sockets imita a AsyncTCP (poll(), pool de 16
+  conexiones, una máquina de estados por conexión) y despacha con
+  findRoute(), ArchivosEstaticos y JsonWriter. Un generador de carga
+  con 1 a 32 clientes informa p50/p99 por pedido contra el loop()
+  anterior (una conexión por vuelta, OLED y delay(10)): con 8 clientes
+  ~80 ms de mediana contra menos de 1 ms. El mismo servidor con
+  keep-alive responde en orden los pedidos en pipeline; el del firmware
+  responde el primero y cierra, como ESPAsyncWebServer.
+
+platformio.ini:
+  lib_deps =
+    me-no-dev/AsyncTCP@^1.1.1
+    me-no-dev/ESP Async WebServer@^1.2.3
+
+--- SERVER-SENT EVENTS (/api/stream) ---
+
+Con polling cada pestaña pedía /api/sensors y /api/led cada 3 segundos:
+40 peticiones HTTP por minuto (conexión, cabeceras, JSON, cierre) aunque
+nada hubiera cambiado.
+
+Con SSE el navegador abre UNA conexión que queda abierta y el ESP32
+escribe en ella solo cuando hay algo nuevo:
+
+  AsyncEventSource events("/api/stream");
+  events.onConnect(handleStreamConnect);  // Estado completo al conectar
+  server.addHandler(&events);
+  events.send(json, "sensors", millis()); // Evento a todas las pestañas
+
+Formato en el cable (texto plano, Content-Type: text/event-stream):
+  id: 123456
+  event: led
+  data: {"state":true,"brightness":75}
+
+updateStream() (en loop) envía:
+  • "sensors" si la temperatura cambió 0.1°C o más
+  • "led" si cambió el estado o el brillo (por ejemplo desde otra pestaña)
+  • Heartbeat: todo el estado si pasaron 15 s sin enviar nada (mantiene
+    viva la conexión y corrige cualquier desincronización)
+
+En el navegador:
+  const source = new EventSource('/api/stream');
+  source.addEventListener('led', e => showLed(JSON.parse(e.data)));
+
+EventSource reconecta solo si se corta la conexión (a los 3 s, valor
+enviado en el primer mensaje). Mientras tanto, o si el navegador no
+soporta SSE, script.js vuelve a consultar la API cada 3 segundos.
+
+La decisión de qué enviar está en cambios_stream.h (CambiosStream), sin
+Arduino.h. tools/comparar_sse.cpp la usa en la PC sobre sockets reales
+y cuenta un minuto con una pestaña: con la temperatura estable el
+polling son 40 conexiones, ~57 KB en el cable y 160 llamadas de red
+del ESP32; SSE es una conexión, ~4.5 KB y 15 llamadas. Un cambio de
+brillo llega en el mismo tick en vez de hasta 3 s después.
+
+--- WEBSOCKET PARA EL LED (/api/ws) ---
+
+SSE solo va del ESP32 al navegador. Para el sentido contrario cada
+movimiento del slider era un POST multipart completo (~300 bytes de
+cabeceras + FormData) y, al arrastrar, los POST se encolaban.
+
+El WebSocket queda abierto y cada comando es una trama binaria de
+2 bytes (más 6 de encabezado WebSocket):
+
+  [0x01, 0]      → toggle
+  [0x02, 0-100]  → brillo (0 = apagado)
+
+  AsyncWebSocket ws("/api/ws");
+  ws.onEvent(handleWsEvent);             // WS_EVT_CONNECT, WS_EVT_DATA, ...
+  server.addHandler(&ws);
+
+  // Navegador
+  ws.send(new Uint8Array([0x02, 75]));
+
+COALESCENCIA DE COMANDOS:
+  handleWsEvent() corre en la tarea de AsyncTCP y NO escribe el PWM:
+  deja el brillo en un buzón de un solo valor (UltimoValor, cada
+  movimiento pisa al anterior) y despierta a controlar(). El toggle y
+  los POST van por colaPedidos. Para respetar el orden, el brillo se
+  deja junto con la posición de la cola en ese momento
+  (colaPedidos.escritos()): controlar() lo aplica entre el último pedido
+  encolado antes y el primero encolado después, aunque con MULTITAREA
+  AsyncTCP siga encolando en el otro núcleo mientras controlar() vacía
+  la cola. Recién después llama a actuadores.aplicar(): si llegan
+  varios valores antes de que corra, sale uno solo al LEDC, y el último
+  nunca se pierde aunque la ráfaga sea más rápida que el control (con
+  una cola de 16 la ráfaga la llenaba y el slider quedaba en un valor
+  intermedio).
+
+  tools/latencia_ws.cpp mide en la PC, con hilos y sockets, trama ->
+  ledcWrite y trama -> evento SSE a 10, 60 y 200 movimientos por
+  segundo y en ráfaga.
+
+El nuevo estado llega a todas las pestañas por el evento SSE "led".
+Si el WebSocket no está disponible, sendCmd() usa el POST /api/led.
+
 --- DISPLAY OLED ---
 
 TECNOLOGÍA OLED SSD1306:
@@ -557,10 +1368,49 @@ PATRÓN DE ACTUALIZACIÓN:
   2. Dibujar contenido
   3. sendBuffer()   → Mostrar
 
+ENVIAR SOLO LO QUE CAMBIÓ (oled_paginas.h):
+  sendBuffer() manda las 8 páginas (~1.2 KB, ~26 ms de I2C a 400 kHz)
+  cada 500 ms, aunque la pantalla sea la misma. updateOLED() guarda los
+  valores mostrados (PantallaOled) y si no cambiaron no dibuja ni envía.
+  Si cambiaron, OledPaginas compara el buffer con una copia de lo último
+  enviado y manda solo el tramo de cada página que cambió.
+
+ENVÍO EN SEGUNDO PLANO (oled_tarea.h):
+  Aun enviando solo lo que cambió, el primer cuadro son ~26 ms de I2C
+  con loop() detenido. Con doble buffer loop() dibuja en el buffer de
+  u8g2 y publicar() lo copia al buffer pendiente (1 KB, microsegundos);
+  la tarea "oled_i2c" (fijada al núcleo de loop()) intercambia los
+  punteros pendiente/enviando con el mutex tomado y hace el I2C fuera
+  de él. Mientras Wire espera cada transferencia la tarea queda
+  bloqueada y loop() sigue (tick de PWM, SSE), también en el ESP32-C3
+  de un solo núcleo.
+
+    oledFondo.begin(u8g2.getU8x8(), ARDUINO_RUNNING_CORE);  // setup()
+    oledFondo.publicar(u8g2.getBufferPtr());                // loop(), no espera
+
+  Si la tarea está enviando, el cuadro nuevo queda pendiente (uno más
+  nuevo lo reemplaza); publicar() no falla por eso. Modelo de tiempos
+  en la PC: tools/modelo_oled_tarea.cpp
+
+LAYOUT PRECALCULADO (oled_layout.h):
+  Alinear a la derecha con getStrWidth() recorre la fuente en cada
+  refresco. Las posiciones de las etiquetas son constantes
+  (oled_layout::Y_TEMP, ...) y los valores solo usan "0-9 . - % C O N F":
+  LayoutOled::iniciar() mide esos caracteres una vez y después el ancho
+  de "25.3 C" es una suma sobre la tabla. El brillo se formatea con
+  formatearPorcentaje() en un char[6], sin String ni printf.
+  tools/comparar_layout_oled.cpp verifica en la PC que la pantalla sea
+  idéntica, píxel por píxel, a la versión con getStrWidth().
+
+  Simulación de un minuto en la PC (tools/sim_oled_i2c.cpp):
+    sendBuffer() siempre  → ~139 KB de I2C por minuto (~3.1 s de bus)
+    Páginas con cambios   → ~2.9 KB por minuto (~65 ms de bus)
+
 TÉCNICAS DE ALINEACIÓN:
   Izquierda:  x = 0
   Derecha:    x = 128 - u8g2.getStrWidth("texto")
   Centro:     x = (128 - u8g2.getStrWidth("texto")) / 2
+  (updateOLED() usa anchos ya medidos, ver LAYOUT PRECALCULADO)
 
 --- ESTRUCTURA PROYECTO ---
 
@@ -568,15 +1418,29 @@ TÉCNICAS DE ALINEACIÓN:
   index.html           # Página principal
   style.css            # Estilos
   script.js            # Lógica frontend
+  *.gz                 # Generados por tools/gzip_data.py (no versionar)
+
+/tools/
+  gzip_data.py         # Script PlatformIO: comprime data/ antes de compilar
+  gen_route_table.py   # Script PlatformIO: genera la tabla de rutas
 
 /src/
   main.cpp             # Backend ESP32
+  api_routes.h         # Lista de endpoints de la API
+  json_writer.h        # Escritor JSON sin memoria dinámica
+  route_table.h        # Generado por tools/gen_route_table.py (no versionar)
+  archivos_estaticos.h # Tamaño y ETag de cada archivo, medidos al montar
+  cambios_stream.h     # Qué eventos SSE enviar en cada tick (cambios y heartbeat)
 
 platformio.ini:
   board_build.filesystem = littlefs
+  extra_scripts =
+    pre:tools/gzip_data.py
+    pre:tools/gen_route_table.py
   lib_deps =
-    bblanchon/ArduinoJson@^6.21.3
     olikraus/U8g2@^2.34.22
+    me-no-dev/AsyncTCP@^1.1.1
+    me-no-dev/ESP Async WebServer@^1.2.3
   build_flags = -D ESP32C3
 
 --- TIMING NO BLOQUEANTE ---
@@ -599,15 +1463,169 @@ PATRÓN EN LOOP:
 
 VENTAJA: Todas las tareas se ejecutan de forma independiente sin bloqueos.
 
+PLANIFICADOR (planificador.h):
+  Con cinco bloques así más delay(10) al final, loop() despierta 100
+  veces por segundo aunque no haya nada que hacer, y un comando que llega
+  espera hasta el próximo tick. Este ejemplo registra las tareas en un
+  planificador que las ordena por deadline (min-heap):
+
+    planificador.agregar("sensores", readSensors, 2000000);  // µs
+    idControl = planificador.agregar("control", controlar, 1000000);
+
+    void loop() {
+      uint32_t esperaUs = planificador.ejecutar();   // Corre las vencidas
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS((esperaUs + 999) / 1000));
+    }
+
+  loop() duerme exactamente hasta la próxima tarea. Los handlers del
+  WebSocket y de la API llaman a planificador.solicitar(idControl), que
+  despierta a loop() (xTaskNotifyGive) y el PWM se aplica enseguida.
+  Cada 30 s showIp() imprime por Serial el jitter (atraso respecto del
+  deadline), la duración máxima y los desbordes de cada tarea.
+  Pruebas con reloj virtual en la PC: tools/sim_planificador.cpp
+
+--- MULTITAREA (ESP32 DE DOS NÚCLEOS) ---
+
+En el ESP32-C3 (un núcleo) todo corre en loop() con el planificador.
+El ESP32 clásico tiene un segundo núcleo; con -D MULTITAREA ([env:esp32]
+en platformio.ini) cada parte es una tarea de FreeRTOS fijada a un núcleo:
+
+  Núcleo 0 (PRO_CPU, donde corre la pila WiFi/lwIP):
+    async_tcp   HTTP, SSE y WebSocket (CONFIG_ASYNC_TCP_RUNNING_CORE=0)
+    red         Cambios por SSE cada 20 ms
+    wifi        Máquina de estados de la conexión, cada 100 ms
+    ip          Log (puede bloquear en el Serial sin frenar al resto)
+  Núcleo 1 (APP_CPU):
+    control     Prioridad 3: duerme hasta que llega algo
+    sensores    Cada 2 s
+    oled        Cada 500 ms (y la tarea de oled_tarea.h que hace el I2C)
+
+Las tareas no comparten variables sueltas (temperature, ledState):
+
+  sensores ──ColaSpsc<LecturaSensores>──┐
+                                        ├──> controlar() ──> Instantanea<EstadoDashboard>
+  async_tcp ──ColaSpsc<PedidoControl>───┘     (actuadores)     │
+                                                                ├──> handlers HTTP, SSE
+                                                                └──> OLED, log
+
+  ColaSpsc (cola_spsc.h): un productor y un consumidor, sin locks. Cada
+    lado escribe solo su índice (acquire/release). Si se llena, el
+    envío se descarta y se cuenta (showIp() lo muestra).
+  Instantanea (instantanea.h): seqlock. controlar() es el único
+    escritor; los lectores copian el estado entero y reintentan si el
+    contador de secuencia cambió mientras copiaban. El escritor nunca
+    espera: un lector lento no atrasa al PWM.
+
+  Un POST encola su pedido y responde enseguida con el estado previsto:
+  todos los cambios de actuadores salen de la tarea de AsyncTCP, que
+  lleva en "previsto" cómo van a quedar (cola + buzón del slider). Antes
+  esperaba con vTaskDelay(1) hasta 50 veces a que controlar() lo
+  aplicara, y mientras tanto ninguna otra conexión avanzaba.
+
+La misma tabla tareasDashboard alimenta los dos modos: con MULTITAREA
+se crean las tareas (xTaskCreatePinnedToCore + vTaskDelayUntil) y sin
+él se registran en el planificador.
+
+Prueba de estrés en la PC con hilos y ThreadSanitizer:
+  tools/estres_concurrencia.cpp
+
+--- CONEXIÓN WIFI SIN BLOQUEOS ---
+
+Antes setup() esperaba hasta 30 s con delay(1000) y, si no conectaba,
+salía sin montar LittleFS ni iniciar el servidor. checkWiFiConnection()
+llamaba a WiFi.reconnect() y esperaba hasta 5 s con delay(500): con el
+AP caído, la tarea que la corría quedaba frenada 5 s cada 10 s.
+
+Ahora la conexión es la máquina de estados de
+Diagramas/wifi_conexion_estados.pu (conexion_wifi.h):
+
+  wifi.iniciar(millis());        // setup(): WiFi.begin() y sigue
+  wifi.actualizar(millis());     // Tarea "wifi", cada 100 ms
+
+  - actualizar() compara millis() con un instante guardado (timeout
+    del intento, fin de la espera) y devuelve enseguida
+  - WiFi.onEvent() avisa IP obtenida y desconexión; el evento solo se
+    marca y actualizar() lo procesa en su tarea
+  - Cada 10 s VERIFICANDO consulta WiFi.status() por si se perdió un
+    evento
+  - Entre intentos fallidos la espera se duplica: 1 s, 2 s, 4 s... hasta
+    30 s. Con jitter (al azar entre la mitad y el total) los equipos que
+    perdieron el mismo AP no reintentan todos juntos cuando vuelve
+  - Después de 10 intentos pasa a DESCONECTADO y prueba cada ~30 s
+  - setAutoReconnect(false): la reconexión del driver no compite con
+    la máquina de estados
+
+El servidor y LittleFS arrancan aunque no haya WiFi, y el OLED, los
+sensores y los actuadores siguen funcionando durante los cortes.
+
+Conexión rápida al arrancar (cache_wifi.h):
+  WiFi.begin(ssid, password) escanea todos los canales (~2 s) y después
+  pide IP por DHCP. Al conectar se guardan en la NVS (Preferences) el
+  BSSID, el canal y la concesión; en el próximo arranque:
+
+    WiFi.config(ip, gateway, mascara, dns);     // Sin DHCP
+    WiFi.begin(ssid, password, canal, bssid);   // Sin escaneo
+
+  Si en 3 s no conecta (el AP cambió de canal, otra red) se reintenta
+  enseguida con el escaneo completo y DHCP, y se guardan los datos
+  nuevos. Con ipFija distinta de 0.0.0.0 se usa siempre esa IP.
+  La concesión reutilizada no se renueva: reservar la IP en el router
+  (DHCP estático) evita que se la asigne a otro equipo.
+
+  La primera respuesta de /api/sensors imprime por Serial las marcas
+  del arranque, en ms, y si la conexión fue rápida o completa (ver
+  ARRANQUE Y /api/boot)
+
+--- ARRANQUE Y /api/boot ---
+
+setup() hacía todo en secuencia antes de poder atender el primer
+pedido: delay(1000) para el Serial, OLED con pantalla de inicio, WiFi,
+montar LittleFS, listar cada archivo y más de 30 líneas de cartel.
+
+perfil_arranque.h guarda el instante (micros()) en que termina cada
+fase, una sola vez, desde cualquier tarea. GET /api/boot las devuelve:
+
+  {"reset_reason":1,"fast_wifi":true,"lazy_init":true,"fs_mounted":false,
+   "setup_us":...,"serial_us":...,"pwm_us":...,"wifi_start_us":...,
+   "oled_us":...,"tasks_us":...,"server_us":...,"setup_end_us":...,
+   "ip_us":...,"fs_us":0,"first_api_us":...}
+
+  0 = la fase todavía no pasó. micros() cuenta desde que arranca la
+  aplicación: el bootloader y la carga del firmware no están incluidos.
+  Para medir desde el PC: reiniciar y pedir /api/sensors en un bucle
+  hasta que responda; después consultar /api/boot.
+
+Con -D INICIO_DIFERIDO (las dos [env] de platformio.ini):
+  - Sin delay(1000) esperando al Serial (los primeros mensajes pueden
+    perderse si el monitor no está abierto; /api/boot no)
+  - Sin pantalla "Iniciando..." en el OLED (~26 ms de I2C): la tarea
+    del OLED dibuja enseguida la pantalla real
+  - LittleFS se monta en la tarea montar_fs (prioridad 1, se borra al
+    terminar), no en setup() ni en un handler: formatear la flash o
+    medir los archivos frenaría a AsyncTCP y a todas sus conexiones.
+    Mientras tanto la API responde y los archivos dan 503 (la página
+    se recarga sola). El listado de archivos y el cartel (~1 KB, ~90 ms
+    a 115200 baudios) solo con -D BANNER_SERIAL
+  - El WiFi se inicia antes del OLED en los dos modos: la asociación
+    avanza mientras se inicializa el resto
+
+Sin INICIO_DIFERIDO el arranque es el de siempre (todo en setup(), con
+cartel), útil para comparar los dos con /api/boot.
+
+Simulación en la PC (AP que se cae, modelo anterior contra la máquina
+de estados): tools/sim_conexion_wifi.cpp
+
 --- EJEMPLO PRÁCTICO ---
 
 Cargar archivos a ESP32:
   pio run --target uploadfs
 
-Servidor archivos + API:
+Servidor archivos + API (asíncrono):
   server.serveStatic("/", LittleFS, "/");
-  server.on("/api/data", handleAPI);
-  server.begin();
+  server.on("/api/data", HTTP_GET, [](AsyncWebServerRequest *request) {
+    request->send(200, "application/json", "{\"ok\":true}");
+  });
+  server.begin();                        // No hace falta handleClient()
 
 JavaScript frontend:
   async function updateData() {
@@ -640,12 +1658,39 @@ EJEMPLO 4.3 (Simple):
 ESTE EJEMPLO 4.5 (Avanzado):
   POST /api/led    → JSON request/response, sin recargar página
                      {action: "toggle"} o {action: "brightness", value: 75}
-  GET /api/led     → Retorna JSON: {"state": true, "brightness": 75}
+                     o {action: "pwm", value: 19500} (frecuencia en Hz)
+  GET /api/led     → Retorna JSON: {"state": true, "brightness": 75,
+                     "pwm_freq": 5000, "pwm_bits": 13, "pwm_levels": 100}
   GET /api/sensors → Retorna JSON: {"temperature": 25.5, "uptime": 12345}
+  GET /api/stream  → Server-Sent Events con los mismos JSON al cambiar
+  WS  /api/ws      → Control del LED con tramas binarias de 2 bytes
+  GET /api/actuators  → Todos los actuadores: {"pwm_freq": 5000, ...,
+                        "actuators": [{"id": 0, "pin": 8, "state": true,
+                        "brightness": 75, "gamma": true, "active_low": true}]}
+  POST /api/actuators → Lote de cambios: cmd=0:75,1:on,2:off,3:toggle
   
   Ventaja: Actualización asíncrona, control fino, datos estructurados
   Desventaja: Más complejo, requiere JavaScript
 
+RESPUESTAS JSON SIN HEAP:
+  Cada navegador abierto consulta /api/sensors y /api/led varias veces
+  por minuto. En lugar de StaticJsonDocument + String, cada respuesta se
+  describe con un esquema y se formatea en un buffer fijo:
+
+  #define LED_JSON(FIELD)                    \
+      FIELD(Bool, "state",      actuadores.encendido(ledPrincipal))  \
+      FIELD(U32,  "brightness", actuadores.brillo(ledPrincipal))
+
+  static char body[JSON_MAX_LEN(LED_JSON)];  // Tamaño calculado al compilar
+  JsonWriter json(body, sizeof(body));
+  LED_JSON(JSON_WRITE_FIELD)
+  request->send_P(200, "application/json", (const uint8_t *)body, json.finish());
+
+  El esquema se verifica al compilar: un float en un campo U32, un
+  uint64_t (no entra en 32 bits) o una clave con comillas no compilan.
+  /api/actuators con 6 canales: ~4x más rápido y 0 reservas de heap
+  contra 18 (pico ~1 KB) con ArduinoJson + String (tools/bench_json.cpp).
+
 CUANDO USAR CADA UNO:
   • Proyectos simples/educativos → GET/POST con forms (4.3)
   • Dashboards profesionales → API REST con JSON (4.5)
@@ -655,17 +1700,52 @@ CUANDO USAR CADA UNO:
 --- CONTROL LED CON PWM ---
 
 CONFIGURACIÓN PWM:
-  ledcSetup(PWM_CHANNEL, 5000, 8);     // Canal, frecuencia, resolución
-  ledcAttachPin(LED_PIN, PWM_CHANNEL);  // Asociar pin
-  ledcWrite(PWM_CHANNEL, dutyCycle);    // Escribir valor 0-255
+  actuadores.configurarPwm(5000);       // Frecuencia → resolución máxima
+  led = actuadores.agregar(LED_PIN, LED_ACTIVO_BAJO, CURVA_GAMMA);
+  actuadores.fijarBrillo(led, 75);      // Solo cambia la tabla
+  actuadores.aplicar();                 // ledcWrite() de lo que cambió
+
+VARIOS ACTUADORES (actuadores.h):
+  El LED ocupaba un canal fijo (PWM_CHANNEL) con su estado en variables
+  sueltas. La clase Actuadores guarda N canales LEDC (hasta 6, los del
+  ESP32-C3) como estructura de arreglos: pin, curva y brillo en arreglos
+  indexados por id; polaridad, encendido y pendiente en máscaras de bits.
+  Cada canal puede ser un LED (CURVA_GAMMA) o un motor/ventilador
+  (CURVA_LINEAL), todos a la misma frecuencia.
+
+  POST /api/actuators recibe varios cambios juntos ("0:75,1:on"): se
+  validan todos (si uno falla no se aplica ninguno), se guardan en la
+  tabla en una sola sección crítica y salen al PWM en el mismo tick de
+  loop(), así que los canales cambian a la vez.
+
+RESOLUCIÓN SEGÚN LA FRECUENCIA (pwm_resolucion.h):
+  El LEDC cuenta con el reloj de 80 MHz: frecuencia · 2^bits ≤ 80 MHz.
+  Con 8 bits fijos la corrección gamma dejaba en duty 0 los brillos
+  1-8 % y repetía valores en el extremo bajo del slider (88 duty
+  distintos para 101 posiciones). configurarPwm() usa la mayor
+  resolución posible (13 bits a 5 kHz, 100 distintos) y la tabla gamma
+  de esa resolución. POST /api/led action=pwm la cambia en marcha
+  (para todos los canales);
+  GET /api/led informa pwm_freq, pwm_bits y pwm_levels.
+
+  Frecuencias bajas dan más bits pero por debajo de ~1 kHz se percibe
+  parpadeo (sobre todo en cámaras y con la vista en movimiento).
+  El divisor del timer no pasa de 1023.99: con 14 bits la mínima es
+  5 Hz y la máxima con 8 bits 312.5 kHz. Fuera de ese rango la
+  respuesta es 400 y, si ledcSetup() igual devolviera 0, aplicar()
+  vuelve a la última frecuencia que funcionó.
+  Simulación en la PC: tools/sim_pwm_niveles.cpp
 
 CORRECCIÓN GAMMA:
   Convierte brillo lineal (0-100%) a PWM con corrección gamma 2.2
-  para percepción visual más natural.
+  para percepción visual más natural. Los 101 valores se calculan al
+  compilar (gamma_lut.h): cada cambio de brillo es un acceso a tabla
+  en lugar de pow(), que en el ESP32-C3 (sin FPU) es muy costoso.
 
-LÓGICA INVERTIDA (ESP32-C3):
-  Algunos ESP32 requieren lógica invertida en el LED:
-  raw = logicaInvertida ? (255 - pwmValue) : pwmValue;
+LED ACTIVO EN BAJO (ESP32-C3):
+  El LED de la placa ESP32-C3 enciende con el pin en LOW; cada actuador
+  guarda su polaridad y aplicar() invierte el duty:
+  duty = activoBajo ? maximo - valor : valor;
 
 --- RESPONSIVE DESIGN ---
 
@@ -683,11 +1763,22 @@ Minificar archivos:
 - HTML/CSS/JS minificados reducen tamaño
 - Herramientas: UglifyJS, CSSNano
 
-Caché browser:
-  server.sendHeader("Cache-Control", "max-age=86400");
+Caché browser con ETag:
+  Al montar LittleFS se calcula un hash (FNV-1a) de cada archivo.
+  Cada respuesta lleva:
+    ETag: "1a2b3c4d"            (o "1a2b3c4d-gz" para la variante gzip)
+    Cache-Control: no-cache     (el navegador revalida en cada carga)
+  Si el navegador envía If-None-Match con el mismo ETag se responde
+  304 Not Modified sin abrir el archivo ni enviar el contenido.
 
 Compresión gzip:
-  Archivos .gz servidos automáticamente si existen
+  tools/gzip_data.py (extra_scripts en platformio.ini) genera
+  index.html.gz, style.css.gz y script.js.gz dentro de data/ al compilar
+  o ejecutar uploadfs. Si la petición trae "Accept-Encoding: gzip" se
+  envía el .gz (CSS/JS bajan a ~25% del tamaño original).
+
+  request->getHeader("If-None-Match")    // Leer cabecera de la petición
+  request->beginResponse(304)            // Respuesta sin cuerpo + addHeader("ETag", ...)
 
 Actualización OLED eficiente:
 - Intervalo de 500ms balanceo entre suavidad y CPU
@@ -717,10 +1808,10 @@ PROGRESIÓN DE APRENDIZAJE:
 
 404 en archivos: Verificar uploadfs ejecutado correctamente
 SPIFFS mount failed: Cambiar a LittleFS en platformio.ini
-Dashboard no carga: Verificar rutas y servidor serveStatic
+Dashboard no carga: Verificar que route_table.h se regeneró al compilar
 OLED no enciende: Verificar conexiones I2C y voltaje (3.3V)
 OLED texto cortado: Revisar coordenadas y ancho de fuente
-LED no responde: Verificar lógica invertida según modelo ESP32
+LED no responde: Verificar LED_ACTIVO_BAJO según modelo ESP32
 WiFi desconectado: Sistema sigue funcionando con OLED local
 JSON parse error: Verificar formato con JSONLint.com
 Fetch no funciona: Revisar consola browser (F12) para errores
@@ -736,6 +1827,8 @@ Fetch no funciona: Revisar consola browser (F12) para errores
    - GET /api/sensors → Estado de sensores
    - GET /api/led → Estado LED
    - POST /api/led → Control LED (toggle, brightness)
+   - GET/POST /api/actuators → Todos los canales PWM, cambios en lote
+   - GET /api/boot → Tiempos de cada fase del arranque
 
 3. DISPLAY OLED LOCAL:
    - Temperatura en tiempo real
@@ -754,7 +1847,7 @@ Fetch no funciona: Revisar consola browser (F12) para errores
 
 6. COMUNICACIÓN:
    - WiFi STA mode
-   - Auto-reconexión WiFi
+   - Reconexión no bloqueante con backoff exponencial y jitter
    - Monitoreo periódico de conexión
 
 ===============================================================================
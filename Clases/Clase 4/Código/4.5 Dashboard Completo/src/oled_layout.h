@@ -0,0 +1,138 @@
+/*
+    Layout del OLED resuelto de antemano: posiciones fijas al compilar y
+    anchos de los caracteres medidos una sola vez.
+
+    Para alinear un valor a la derecha hay que saber su ancho, y
+    u8g2.getStrWidth() lo calcula recorriendo la fuente carácter por
+    carácter en cada refresco. Los valores del dashboard solo usan unos
+    pocos caracteres (dígitos, '.', '-', '%', "C", "ON", "OFF"): se mide
+    cada uno al arrancar y después el ancho es una suma sobre una tabla.
+
+        LayoutOled layoutOled;
+
+        // En setup(), después de u8g2.begin():
+        layoutOled.iniciar(u8g2, u8g2_font_7x13_tf, u8g2_font_helvB08_tf);
+
+        // En cada refresco: dibuja la pantalla completa en el buffer
+        layoutOled.dibujar(u8g2, "25.3 C", 75, true);
+
+    Misma regla que getStrWidth(): cada carácter suma lo que avanza el
+    cursor, salvo el último, que suma su ancho dibujado. Por eso se
+    guardan dos anchos por carácter.
+
+    No depende de Arduino.h: tools/comparar_layout_oled.cpp lo compila
+    en la PC y compara, píxel por píxel, la pantalla que dibuja contra la
+    de la versión con getStrWidth().
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// Caracteres que pueden aparecer en los valores (los que se miden);
+// "naif" por si printf("%.1f") recibe nan o inf
+#define OLED_CARACTERES_VALORES "0123456789.- %CONFnaif"
+
+// Posiciones fijas: etiquetas a la izquierda, valores alineados a la
+// derecha sobre la misma línea base, logo centrado abajo
+namespace oled_layout {
+constexpr int16_t ANCHO = 128;
+constexpr int16_t ALTO = 64;
+constexpr int16_t X_ETIQUETA = 0;
+constexpr int16_t Y_TEMP = 15;
+constexpr int16_t Y_BRILLO = 30;
+constexpr int16_t Y_ESTADO = 45;
+constexpr int16_t Y_LOGO = 62;
+constexpr char LOGO[] = "UNSE IoT";
+
+static_assert(Y_TEMP < Y_BRILLO && Y_BRILLO < Y_ESTADO && Y_ESTADO < Y_LOGO && Y_LOGO < ALTO,
+              "Las líneas deben quedar en orden y dentro de la pantalla");
+}  // namespace oled_layout
+
+// Anchos de los caracteres imprimibles (ASCII 32-126) de una fuente
+class AnchosFuente {
+public:
+    // Con la fuente ya seleccionada en d. Para cada carácter c:
+    //   final  = getStrWidth("c")               (si es el último)
+    //   avance = getStrWidth("c0") - getStrWidth("0")
+    template <typename Display>
+    void medir(Display &d, const char *caracteres) {
+        int16_t referencia = d.getStrWidth("0");
+        for (; *caracteres; caracteres++) {
+            char uno[2] = {*caracteres, 0};
+            char par[3] = {*caracteres, '0', 0};
+            uint8_t i = indice(*caracteres);
+            _final[i] = d.getStrWidth(uno);
+            _avance[i] = d.getStrWidth(par) - referencia;
+        }
+    }
+
+    // Igual a getStrWidth(texto) si todos sus caracteres fueron medidos
+    int16_t ancho(const char *texto) const {
+        if (!*texto) return 0;
+        int16_t total = 0;
+        for (; texto[1]; texto++) total += _avance[indice(*texto)];
+        return total + _final[indice(*texto)];
+    }
+
+private:
+    static uint8_t indice(char c) { return c >= ' ' && c <= '~' ? c - ' ' : 0; }
+
+    int8_t _avance[95] = {};
+    int8_t _final[95] = {};
+};
+
+// Brillo 0-100 como "75 %" sin printf. Devuelve el largo
+inline uint8_t formatearPorcentaje(char *texto, uint8_t valor) {
+    uint8_t largo = 0;
+    if (valor >= 100) texto[largo++] = '0' + valor / 100;
+    if (valor >= 10) texto[largo++] = '0' + valor / 10 % 10;
+    texto[largo++] = '0' + valor % 10;
+    texto[largo++] = ' ';
+    texto[largo++] = '%';
+    texto[largo] = '\0';
+    return largo;
+}
+
+class LayoutOled {
+public:
+    // Una vez, después de u8g2.begin(): mide los caracteres de los valores
+    // y centra el logo (fuentes de u8g2, u8g2_font_...)
+    template <typename Display>
+    void iniciar(Display &d, const uint8_t *fuenteValores, const uint8_t *fuenteLogo) {
+        d.setFont(fuenteValores);
+        _anchos.medir(d, OLED_CARACTERES_VALORES);
+        d.setFont(fuenteLogo);
+        _xLogo = (oled_layout::ANCHO - d.getStrWidth(oled_layout::LOGO)) / 2;
+        _fuenteValores = fuenteValores;
+        _fuenteLogo = fuenteLogo;
+    }
+
+    // Pantalla completa en el buffer de d (no la envía). temp ya
+    // formateada ("25.3 C"); sin getStrWidth() ni memoria dinámica
+    template <typename Display>
+    void dibujar(Display &d, const char *temp, uint8_t brillo, bool encendido) const {
+        using namespace oled_layout;
+        char brilloStr[6];  // "100 %"
+        formatearPorcentaje(brilloStr, brillo);
+        const char *estado = encendido ? "ON" : "OFF";
+
+        d.clearBuffer();
+        d.setFont(_fuenteValores);
+        d.drawStr(X_ETIQUETA, Y_TEMP, "Temp:");
+        d.drawStr(ANCHO - _anchos.ancho(temp), Y_TEMP, temp);
+        d.drawStr(X_ETIQUETA, Y_BRILLO, "Brillo LED:");
+        d.drawStr(ANCHO - _anchos.ancho(brilloStr), Y_BRILLO, brilloStr);
+        d.drawStr(X_ETIQUETA, Y_ESTADO, "Estado:");
+        d.drawStr(ANCHO - _anchos.ancho(estado), Y_ESTADO, estado);
+
+        d.setFont(_fuenteLogo);
+        d.drawStr(_xLogo, Y_LOGO, LOGO);
+    }
+
+private:
+    AnchosFuente _anchos;
+    int16_t _xLogo = 0;
+    const uint8_t *_fuenteValores = nullptr;
+    const uint8_t *_fuenteLogo = nullptr;
+};
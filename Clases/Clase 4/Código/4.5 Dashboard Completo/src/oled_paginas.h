@@ -0,0 +1,77 @@
+/*
+    Envío al OLED solo de las páginas que cambiaron.
+
+    El SSD1306 guarda la imagen en 8 páginas de 128 bytes (cada byte son
+    8 píxeles verticales). sendBuffer() manda las 8 páginas en cada
+    llamada, ~1.2 KB por I2C aunque solo haya cambiado un dígito.
+
+    OledPaginas guarda una copia de lo último enviado y compara el buffer
+    nuevo de u8g2 en bloques de 8x8 (tiles): por cada página con cambios
+    envía solo el tramo entre el primer y el último tile distinto; si no
+    cambió nada no envía nada.
+
+        OledPaginas oledPaginas;
+
+        // Después de dibujar en el buffer (en lugar de u8g2.sendBuffer()):
+        oledPaginas.enviarCambios(u8g2.getBufferPtr(),
+            [](uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+                u8g2.updateDisplayArea(tx, ty, tw, th);
+            });
+
+        // Si se escribió al display por otro camino (sendBuffer(), begin()):
+        oledPaginas.invalidar();   // El próximo envío es completo
+
+    El dashboard la usa desde la tarea de oled_tarea.h, que envía con
+    u8x8_DrawTile() desde su propia copia del buffer.
+
+    No depende de Arduino.h: tools/sim_oled_i2c.cpp lo compila en la PC
+    y cuenta los bytes de I2C por minuto antes y después.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define OLED_ANCHO    128
+#define OLED_PAGINAS  8                   // 64 filas / 8 filas por página
+#define OLED_TILES    (OLED_ANCHO / 8)    // Tiles de 8x8 por página
+
+class OledPaginas {
+public:
+    // Olvida lo enviado: el próximo enviarCambios() manda todo
+    void invalidar() { _valida = false; }
+
+    // Compara frame (buffer de u8g2, páginas de 128 bytes seguidas) con lo
+    // último enviado y llama a enviar(tx, ty, tw, th) una vez por página
+    // con cambios, en unidades de tile. Devuelve los bytes de imagen
+    // enviados (0 = la pantalla ya mostraba lo mismo)
+    template <typename Enviar>
+    uint16_t enviarCambios(const uint8_t *frame, Enviar enviar) {
+        uint16_t bytes = 0;
+        for (uint8_t pagina = 0; pagina < OLED_PAGINAS; pagina++) {
+            const uint8_t *nueva = frame + pagina * OLED_ANCHO;
+            uint8_t *anterior = _enviado + pagina * OLED_ANCHO;
+
+            int8_t primero = -1, ultimo = -1;
+            for (uint8_t t = 0; t < OLED_TILES; t++) {
+                if (!_valida || memcmp(nueva + t * 8, anterior + t * 8, 8) != 0) {
+                    if (primero < 0) primero = t;
+                    ultimo = t;
+                }
+            }
+            if (primero < 0) continue;
+
+            uint8_t tiles = ultimo - primero + 1;
+            enviar(primero, pagina, tiles, 1);
+            memcpy(anterior + primero * 8, nueva + primero * 8, tiles * 8);
+            bytes += tiles * 8;
+        }
+        _valida = true;
+        return bytes;
+    }
+
+private:
+    uint8_t _enviado[OLED_ANCHO * OLED_PAGINAS];  // Copia de la GDDRAM del SSD1306
+    bool _valida = false;
+};
@@ -0,0 +1,117 @@
+/*
+    Envío del OLED en segundo plano: una tarea de FreeRTOS hace el I2C.
+
+    Un sendBuffer() completo son ~1.2 KB a 400 kHz, ~26 ms en los que
+    loop() no hace nada más (tick de PWM, SSE). Con doble buffer:
+
+      - El buffer de u8g2: loop() dibuja ahí como siempre.
+      - Pendiente: publicar() copia ahí el cuadro nuevo.
+      - Enviando: el que la tarea manda por I2C. Al despertar, la tarea
+        intercambia los punteros pendiente/enviando, compara con lo
+        enviado (OledPaginas) y manda las páginas que cambiaron con
+        u8x8_DrawTile(), directo desde su buffer.
+
+    El mutex solo cubre la copia de publicar() y el intercambio de
+    punteros (microsegundos); el I2C va fuera. Si llega un cuadro
+    mientras la tarea envía, queda pendiente, y uno más nuevo lo
+    reemplaza: publicar() no falla ni espera al I2C. Mientras Wire espera
+    el fin de cada transferencia la tarea queda bloqueada y loop() sigue
+    corriendo, también en el ESP32-C3 (un núcleo).
+
+        OledEnSegundoPlano oledFondo;
+
+        // En setup(), después de lo que se envíe con sendBuffer():
+        oledFondo.begin(u8g2.getU8x8(), ARDUINO_RUNNING_CORE);
+
+        // En loop(): dibujar en el buffer de u8g2 y publicar
+        oledFondo.publicar(u8g2.getBufferPtr());
+
+    La tarea se llama "oled_i2c" (la periódica que dibuja es "oled") y
+    tarea() devuelve su handle para mostrar la pila libre.
+
+    Desde begin() el bus I2C es de la tarea: no llamar a sendBuffer() ni
+    a otras funciones de u8g2 que escriban al display.
+
+    Modelo de tiempos en la PC: tools/modelo_oled_tarea.cpp
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+#include "oled_paginas.h"
+
+#define OLED_TAREA_NOMBRE     "oled_i2c"
+#define OLED_TAREA_PILA       3072
+#define OLED_TAREA_PRIORIDAD  1  // Igual que loop(): se alternan mientras espera el I2C
+#define OLED_BYTES            (OLED_ANCHO * OLED_PAGINAS)
+
+class OledEnSegundoPlano {
+public:
+    // Crea la tarea fijada al núcleo indicado. false si no hubo memoria
+    bool begin(u8x8_t *u8x8, BaseType_t nucleo) {
+        _u8x8 = u8x8;
+        _mutex = xSemaphoreCreateMutex();
+        if (!_mutex) return false;
+        return xTaskCreatePinnedToCore(correr, OLED_TAREA_NOMBRE, OLED_TAREA_PILA, this, OLED_TAREA_PRIORIDAD,
+                                       &_tarea, nucleo) == pdPASS;
+    }
+
+    // Copia el buffer de u8g2 al pendiente y despierta a la tarea. Si la
+    // tarea está enviando, el cuadro espera (reemplaza a otro pendiente).
+    // false solo si la tarea no existe
+    bool publicar(const uint8_t *buffer) {
+        if (!_tarea) return false;
+        xSemaphoreTake(_mutex, portMAX_DELAY);  // Como mucho, un intercambio de punteros
+        memcpy(_pendiente, buffer, OLED_BYTES);
+        _hayPendiente = true;
+        xSemaphoreGive(_mutex);
+        xTaskNotifyGive(_tarea);
+        return true;
+    }
+
+    // Estadísticas del último envío (lectura de una palabra, cualquier tarea)
+    uint32_t ultimoEnvioUs() const { return _ultimoEnvioUs; }
+    uint16_t ultimosBytes() const { return _ultimosBytes; }
+    TaskHandle_t tarea() const { return _tarea; }
+
+private:
+    static void correr(void *arg) {
+        OledEnSegundoPlano *self = (OledEnSegundoPlano *)arg;
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+            xSemaphoreTake(self->_mutex, portMAX_DELAY);
+            bool hay = self->_hayPendiente;
+            if (hay) {
+                uint8_t *cuadro = self->_pendiente;
+                self->_pendiente = self->_enviando;
+                self->_enviando = cuadro;
+                self->_hayPendiente = false;
+            }
+            xSemaphoreGive(self->_mutex);
+            if (!hay) continue;
+
+            // I2C fuera del mutex: publicar() puede dejar el próximo cuadro
+            const uint8_t *cuadro = self->_enviando;
+            uint32_t inicio = micros();
+            self->_ultimosBytes = self->_paginas.enviarCambios(cuadro,
+                [self, cuadro](uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+                    u8x8_DrawTile(self->_u8x8, tx, ty, tw, (uint8_t *)cuadro + ty * OLED_ANCHO + tx * 8);
+                });
+            self->_ultimoEnvioUs = micros() - inicio;
+        }
+    }
+
+    uint8_t _buffers[2][OLED_BYTES];
+    uint8_t *_pendiente = _buffers[0];  // publicar() y el intercambio, con el mutex
+    uint8_t *_enviando = _buffers[1];   // Solo la tarea, sin el mutex
+    bool _hayPendiente = false;         // Con el mutex
+    OledPaginas _paginas;               // Solo la usa la tarea
+    u8x8_t *_u8x8 = nullptr;
+    SemaphoreHandle_t _mutex = nullptr;
+    TaskHandle_t _tarea = nullptr;
+    volatile uint32_t _ultimoEnvioUs = 0;
+    volatile uint16_t _ultimosBytes = 0;
+};
@@ -0,0 +1,44 @@
+/*
+    Marcas de tiempo del arranque.
+
+    Cada fase guarda una sola vez el instante en que terminó, en us
+    (micros(): cuenta desde que arranca la aplicación, el bootloader y la
+    carga de la flash no se incluyen). Las fases las define el sketch con
+    un enum; las de setup() se marcan en orden y las que dependen de
+    otras tareas (IP obtenida, primera respuesta de la API) cuando pasan.
+
+        PerfilArranque<ARRANQUE_FASES> perfil;
+
+        perfil.marcar(ARRANQUE_OLED, micros());        // setup()
+        if (perfil.marcar(ARRANQUE_IP, micros())) {    // Tarea "wifi"
+            // Primera vez
+        }
+        perfil.marca(ARRANQUE_OLED)                    // 0 = todavía no pasó
+
+    Se puede marcar desde cualquier tarea: cada marca es atómica y solo
+    la primera escritura queda (compare_exchange), así una reconexión no
+    pisa la IP del arranque.
+
+    No depende de Arduino.h: el instante lo pasa quien marca.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+template <uint8_t N>
+class PerfilArranque {
+public:
+    // true si es la primera vez que se marca la fase
+    bool marcar(uint8_t fase, uint32_t us) {
+        if (fase >= N) return false;
+        uint32_t vacia = 0;
+        return _marcas[fase].compare_exchange_strong(vacia, us ? us : 1);  // 0 = sin marcar
+    }
+
+    uint32_t marca(uint8_t fase) const { return fase < N ? _marcas[fase].load() : 0; }
+
+private:
+    std::atomic<uint32_t> _marcas[N] = {};
+};
@@ -0,0 +1,205 @@
+/*
+    Planificador cooperativo de tareas periódicas para loop().
+
+    Reemplaza los bloques
+
+        if (millis() - lastX > intervalX) { lastX = millis(); hacerX(); }
+        ...
+        delay(10);
+
+    por una lista de tareas con su próximo deadline, ordenada en un
+    montículo (min-heap): la raíz es siempre la tarea que vence primero.
+    ejecutar() corre las vencidas y devuelve cuánto falta para la
+    siguiente, así loop() duerme exactamente ese tiempo en lugar de
+    despertar cada 10 ms. Un evento (comando por WebSocket, interrupción
+    de un pin) puede pedir una tarea con solicitar() y despertar a loop()
+    antes de tiempo.
+
+        Planificador<RelojArduino> planificador;
+
+        // En setup():
+        planificador.agregar("sensores", readSensors, 2000000);
+        planificador.alDespertar(despertarLoop);   // xTaskNotifyGive()
+
+        // En loop():
+        uint32_t esperaUs = planificador.ejecutar();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS((esperaUs + 999) / 1000));
+
+    Los deadlines avanzan de a un período desde el anterior (sin deriva
+    aunque la tarea se atrase). Por tarea se guarda el jitter (atraso del
+    inicio respecto del deadline) y los desbordes (períodos perdidos
+    porque la tarea anterior tardó demasiado).
+
+    El reloj es un parámetro: en el ESP32 es micros(); en la PC,
+    tools/sim_planificador.cpp usa un reloj virtual para probar los
+    tiempos sin esperar.
+
+    Final/src/planificador.h es una copia exacta del de 4.5 Dashboard
+    Completo (cada uno es un proyecto de PlatformIO aparte); el
+    simulador está solo en 4.5/tools. Los cambios se hacen en ambos y
+    python3 Clases/verificar_copias.py controla que sigan iguales.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+struct RelojArduino {
+    uint32_t ahoraUs() const { return micros(); }
+};
+#endif
+
+#ifndef PLANIFICADOR_MAX
+#define PLANIFICADOR_MAX 8
+#endif
+
+#define PLANIFICADOR_ESPERA_MAX_US 1000000  // Sin tareas: volver a mirar cada 1 s
+
+struct EstadisticasTarea {
+    uint32_t ejecuciones;
+    uint32_t solicitadas;   // Ejecuciones pedidas con solicitar()
+    uint32_t jitterMaxUs;   // Mayor atraso del inicio respecto del deadline
+    uint64_t jitterSumaUs;  // Para el promedio (solo ejecuciones por deadline)
+    uint32_t duracionMaxUs;
+    uint32_t desbordes;     // Períodos salteados por atraso
+};
+
+template <typename Reloj>
+class Planificador {
+public:
+    typedef void (*Funcion)();
+
+    // Tarea cada periodoUs; la primera vez a faseUs de ahora. Devuelve su
+    // id o -1 si no hay lugar. Solo desde setup()
+    int8_t agregar(const char *nombre, Funcion funcion, uint32_t periodoUs, uint32_t faseUs = 0) {
+        if (_cantidad >= PLANIFICADOR_MAX || periodoUs == 0) return -1;
+        int8_t id = _cantidad++;
+        _nombre[id] = nombre;
+        _funcion[id] = funcion;
+        _periodo[id] = periodoUs;
+        _deadline[id] = _reloj.ahoraUs() + faseUs;
+        _estadisticas[id] = EstadisticasTarea();
+        _heap[id] = id;
+        subir(id);
+        return id;
+    }
+
+    // Función que despierta a loop() cuando llega un evento (por ejemplo
+    // xTaskNotifyGive() a la tarea de loop)
+    void alDespertar(void (*despertar)()) { _despertar = despertar; }
+
+    // Corre la tarea en la próxima pasada sin esperar su deadline; el
+    // período siguiente se cuenta desde esa ejecución. Se puede llamar
+    // desde otras tareas (handlers de AsyncTCP)
+    void solicitar(int8_t id) {
+        if (id < 0 || id >= _cantidad) return;
+        _solicitadas.fetch_or(1u << id);
+        if (_despertar) _despertar();
+    }
+
+    // Corre las tareas solicitadas y las vencidas (en orden de deadline).
+    // Devuelve los µs hasta el próximo deadline
+    uint32_t ejecutar() {
+        uint32_t solicitadas = _solicitadas.exchange(0);
+        for (int8_t id = 0; solicitadas; id++, solicitadas >>= 1) {
+            if (!(solicitadas & 1)) continue;
+            _estadisticas[id].solicitadas++;
+            uint32_t fin = correr(id);
+            _deadline[id] = fin + _periodo[id];
+            reordenar();
+        }
+
+        if (_cantidad == 0) return PLANIFICADOR_ESPERA_MAX_US;
+        for (;;) {
+            int8_t id = _heap[0];
+            int32_t falta = (int32_t)(_deadline[id] - _reloj.ahoraUs());
+            if (falta > 0) return (uint32_t)falta;
+
+            EstadisticasTarea &e = _estadisticas[id];
+            uint32_t jitter = (uint32_t)-falta;
+            if (jitter > e.jitterMaxUs) e.jitterMaxUs = jitter;
+            e.jitterSumaUs += jitter;
+            uint32_t fin = correr(id);
+
+            // Próximo deadline sin deriva; si ya pasó, se saltean períodos
+            uint32_t siguiente = _deadline[id] + _periodo[id];
+            while ((int32_t)(siguiente - fin) <= 0) {
+                siguiente += _periodo[id];
+                e.desbordes++;
+            }
+            _deadline[id] = siguiente;
+            bajar(0);
+        }
+    }
+
+    uint8_t cantidad() const { return _cantidad; }
+    const char *nombre(int8_t id) const { return _nombre[id]; }
+    uint32_t periodoUs(int8_t id) const { return _periodo[id]; }
+    const EstadisticasTarea &estadisticas(int8_t id) const { return _estadisticas[id]; }
+    void reiniciarEstadisticas() {
+        for (uint8_t id = 0; id < _cantidad; id++) _estadisticas[id] = EstadisticasTarea();
+    }
+
+private:
+    static_assert(PLANIFICADOR_MAX <= 32, "solicitar() usa una máscara de 32 bits");
+
+    // Corre la tarea y actualiza ejecuciones y duración. Devuelve el
+    // instante en que terminó
+    uint32_t correr(int8_t id) {
+        uint32_t inicio = _reloj.ahoraUs();
+        _funcion[id]();
+        uint32_t fin = _reloj.ahoraUs();
+        EstadisticasTarea &e = _estadisticas[id];
+        e.ejecuciones++;
+        if (fin - inicio > e.duracionMaxUs) e.duracionMaxUs = fin - inicio;
+        return fin;
+    }
+
+    // Comparación de deadlines que sobrevive al desborde de micros()
+    // (cada ~71 minutos) mientras los períodos sean menores a ~35 minutos
+    bool antes(int8_t a, int8_t b) const { return (int32_t)(_deadline[a] - _deadline[b]) < 0; }
+
+    void intercambiar(uint8_t i, uint8_t j) {
+        int8_t t = _heap[i];
+        _heap[i] = _heap[j];
+        _heap[j] = t;
+    }
+
+    void subir(uint8_t i) {
+        while (i > 0 && antes(_heap[i], _heap[(i - 1) / 2])) {
+            intercambiar(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void bajar(uint8_t i) {
+        for (;;) {
+            uint8_t menor = i, izq = 2 * i + 1, der = 2 * i + 2;
+            if (izq < _cantidad && antes(_heap[izq], _heap[menor])) menor = izq;
+            if (der < _cantidad && antes(_heap[der], _heap[menor])) menor = der;
+            if (menor == i) return;
+            intercambiar(i, menor);
+            i = menor;
+        }
+    }
+
+    // Después de cambiar un deadline cualquiera (pocas tareas: rehacer)
+    void reordenar() {
+        for (int i = _cantidad / 2 - 1; i >= 0; i--) bajar(i);
+    }
+
+    Reloj _reloj;
+    const char *_nombre[PLANIFICADOR_MAX];
+    Funcion _funcion[PLANIFICADOR_MAX];
+    uint32_t _periodo[PLANIFICADOR_MAX];
+    uint32_t _deadline[PLANIFICADOR_MAX];
+    EstadisticasTarea _estadisticas[PLANIFICADOR_MAX];
+    int8_t _heap[PLANIFICADOR_MAX];  // Ids ordenados por deadline (raíz = el más próximo)
+    uint8_t _cantidad = 0;
+    std::atomic<uint32_t> _solicitadas{0};
+    void (*_despertar)() = nullptr;
+};
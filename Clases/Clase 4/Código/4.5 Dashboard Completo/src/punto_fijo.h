@@ -0,0 +1,182 @@
+/*
+    Aritmética en punto fijo (formato Q) para placas sin FPU.
+
+    El ESP32-C3 (RISC-V) no tiene unidad de punto flotante: cada suma,
+    multiplicación o log() en float se emula con decenas o cientos de
+    instrucciones enteras. Fijo<F> guarda un número real en un int32_t
+    con F bits de decimales (Q16: 16 bits enteros + 16 de decimales).
+
+        Q16 a = Q16::desdeFraccion(1, 5);        // 0.2
+        Q16 b = Q16::desdeEntero(25) * a;        // 5.0 (solo enteros)
+
+        char texto[12];
+        b.formatear(texto, sizeof(texto), 1);     // "5.0" sin printf("%f")
+
+    Con -D PUNTO_FIJO (build_flags del entorno esp32c3) los sketches usan
+    este camino: en 3.6 Temperaturas en OLED la conversión del NTC, el
+    filtro EMA y el formateo de los valores para la pantalla; en 4.5
+    Dashboard Completo el formateo de la temperatura del OLED (la gamma
+    del LED sale de gamma_lut.h, sin cuentas).
+
+    No depende de Arduino.h: 3.6 Temperaturas en OLED/tools/
+    bench_punto_fijo.cpp lo compila en la PC para comparar instrucciones
+    y error contra el camino en float.
+
+    Está copiado sin cambios en 3.6 Temperaturas en OLED y 4.5 Dashboard
+    Completo, porque cada sketch se compila solo. Al corregirlo hay que
+    actualizar las dos copias (python3 Clases/verificar_copias.py las
+    compara).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+template <uint8_t F>
+class Fijo {
+public:
+    static const int32_t UNO = (int32_t)1 << F;
+
+    int32_t raw = 0;  // Valor × 2^F
+
+    static Fijo desdeRaw(int32_t r) {
+        Fijo x;
+        x.raw = r;
+        return x;
+    }
+    static Fijo desdeEntero(int32_t n) { return desdeRaw(n * UNO); }
+    static Fijo desdeFraccion(int32_t num, int32_t den) {
+        return desdeRaw((int32_t)(((int64_t)num << F) / den));
+    }
+    // Solo para constantes o sensores que ya entregan float (una vez por lectura)
+    static Fijo desdeFloat(float f) { return desdeRaw((int32_t)(f * UNO + (f < 0 ? -0.5f : 0.5f))); }
+
+    Fijo operator+(Fijo o) const { return desdeRaw(raw + o.raw); }
+    Fijo operator-(Fijo o) const { return desdeRaw(raw - o.raw); }
+    Fijo operator*(Fijo o) const { return desdeRaw((int32_t)(((int64_t)raw * o.raw) >> F)); }
+    Fijo operator/(Fijo o) const { return desdeRaw((int32_t)(((int64_t)raw << F) / o.raw)); }
+    Fijo operator*(int32_t n) const { return desdeRaw(raw * n); }
+    Fijo &operator+=(Fijo o) { raw += o.raw; return *this; }
+    Fijo &operator-=(Fijo o) { raw -= o.raw; return *this; }
+
+    bool operator<(Fijo o) const { return raw < o.raw; }
+    bool operator>(Fijo o) const { return raw > o.raw; }
+    bool operator<=(Fijo o) const { return raw <= o.raw; }
+    bool operator>=(Fijo o) const { return raw >= o.raw; }
+    bool operator==(Fijo o) const { return raw == o.raw; }
+    bool operator!=(Fijo o) const { return raw != o.raw; }
+
+    // Valor × 10^decimales redondeado (ej: 23.456 con 1 decimal → 235)
+    int32_t escalado(uint8_t decimales) const {
+        int64_t escala = 1;
+        while (decimales--) escala *= 10;
+        int64_t v = (int64_t)raw * escala;
+        v += v < 0 ? -(UNO / 2) : UNO / 2;
+        return (int32_t)(v / UNO);
+    }
+
+    int32_t redondear() const { return escalado(0); }
+
+    // Texto con la cantidad de decimales pedida, sin float ni printf.
+    // Devuelve el largo escrito (0 si no entra en el buffer)
+    size_t formatear(char *buf, size_t size, uint8_t decimales) const {
+        int32_t v = escalado(decimales);
+        char digitos[12];
+        int n = 0;
+        uint32_t u = v < 0 ? (uint32_t)0 - (uint32_t)v : (uint32_t)v;
+        do {
+            digitos[n++] = '0' + u % 10;
+            u /= 10;
+        } while (u || n <= decimales);  // Al menos un dígito entero ("0.5")
+
+        size_t largo = n + (v < 0) + (decimales > 0);
+        if (largo + 1 > size) return 0;
+        size_t i = 0;
+        if (v < 0) buf[i++] = '-';
+        while (n) {
+            if (n == decimales) buf[i++] = '.';
+            buf[i++] = digitos[--n];
+        }
+        buf[i] = '\0';
+        return i;
+    }
+};
+
+typedef Fijo<16> Q16;  // Rango ±32767, resolución 0.000015
+
+// log2(v / 2^frac) en Q16, para v > 0. Parte entera por la posición del
+// bit más alto; decimales bit a bit elevando al cuadrado la mantisa
+inline Q16 log2Raw(uint32_t v, int32_t frac) {
+    if (v == 0) return Q16::desdeRaw(INT32_MIN);
+
+    // Normalizar a [1, 2): cada desplazamiento suma o resta 1 al log2
+    int32_t entero = 16 - frac;
+    while (v >= 2u << 16) { v >>= 1; entero++; }
+    while (v < 1u << 16) { v <<= 1; entero--; }
+
+    // Mantisa en [1, 2) con 30 bits de decimales
+    uint64_t m = (uint64_t)v << 14;
+    int32_t resultado = entero * Q16::UNO;
+    for (int32_t bit = Q16::UNO >> 1; bit; bit >>= 1) {
+        m = (m * m) >> 30;
+        if (m >= (2ull << 30)) {
+            m >>= 1;
+            resultado += bit;
+        }
+    }
+    return Q16::desdeRaw(resultado);
+}
+
+inline Q16 log2Fijo(Q16 x) {
+    if (x.raw <= 0) return Q16::desdeRaw(INT32_MIN);
+    return log2Raw((uint32_t)x.raw, 16);
+}
+
+// 2^x en Q16: 2^entero es un desplazamiento y 2^fracción se aproxima con
+// un polinomio de grado 3 (error < 0.03%)
+inline Q16 exp2Fijo(Q16 x) {
+    int32_t entero = x.raw >> 16;             // Redondea hacia -∞
+    int64_t f = x.raw & 0xFFFF;               // Fracción en [0, 1), Q16
+    // 2^f ≈ 1 + f·(0.6951 + f·(0.2262 + f·0.0782)), coeficientes en Q16
+    int64_t p = 5125;                          // 0.0782
+    p = 14824 + ((p * f) >> 16);               // 0.2262
+    p = 45555 + ((p * f) >> 16);               // 0.6951
+    p = 65536 + ((p * f) >> 16);               // 1
+    if (entero >= 15) return Q16::desdeRaw(INT32_MAX);
+    if (entero < -16) return Q16::desdeRaw(0);
+    return Q16::desdeRaw((int32_t)(entero >= 0 ? p << entero : p >> -entero));
+}
+
+// x^y = 2^(y · log2(x)), para x > 0
+inline Q16 powFijo(Q16 x, Q16 y) {
+    if (x.raw <= 0) return Q16::desdeRaw(0);
+    return exp2Fijo(y * log2Fijo(x));
+}
+
+// NTC con ecuación Beta sin float. mv: tensión calibrada (eFuse) en mV.
+// Devuelve °C en Q16; false si la lectura está fuera de rango (mismos
+// límites que el cálculo en float: 0.1 V, 100 Ω - 1 MΩ, -50 a 150 °C)
+inline bool ntcCelsiusFijo(uint32_t mv, uint32_t vrefMv, uint32_t rFixed, uint32_t r0,
+                           uint32_t beta, Q16 &celsius) {
+    if (mv < 100 || mv > vrefMv - 100) return false;
+
+    // R con 8 bits de decimales: con el NTC caliente R es chica (~300 Ω)
+    // y truncar a Ω enteros movería el resultado ~0.1 °C
+    uint32_t R8 = (uint32_t)(((uint64_t)rFixed * mv << 8) / (vrefMv - mv));
+    if (R8 < (100u << 8) || R8 > (1000000u << 8)) return false;
+
+    // ln(R/R0) = (log2(R) - log2(R0))·ln(2)
+    const Q16 LN2 = Q16::desdeRaw(45426);
+    Q16 lnRelacion = (log2Raw(R8, 8) - log2Raw(r0, 0)) * LN2;
+
+    // 1/T = 1/T0 + ln(R/R0)/β, en Q30 para no perder precisión (1/T ≈ 0.0034)
+    int64_t invT0 = ((int64_t)1 << 30) * 100 / 29815;                // 1/298.15 K
+    int64_t invT = invT0 + ((int64_t)lnRelacion.raw << 14) / (int32_t)beta;
+    if (invT <= 0) return false;
+
+    // T = 1/(1/T) en Q16, a Celsius restando 273.15
+    Q16 kelvin = Q16::desdeRaw((int32_t)(((int64_t)1 << 46) / invT));
+    celsius = kelvin - Q16::desdeFraccion(27315, 100);
+    return celsius >= Q16::desdeEntero(-50) && celsius <= Q16::desdeEntero(150);
+}
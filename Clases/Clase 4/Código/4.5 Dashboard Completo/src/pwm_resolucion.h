@@ -0,0 +1,85 @@
+/*
+    Resolución del PWM según la frecuencia y tabla gamma para cada una.
+
+    El LEDC cuenta con el reloj APB (80 MHz): un período de PWM a la
+    frecuencia f tiene 80 MHz / f cuentas, así que la resolución máxima
+    es la mayor cantidad de bits con f · 2^bits ≤ 80 MHz.
+
+        Frecuencia │ Bits │ Duty máximo
+        ───────────┼──────┼────────────
+          1 kHz    │  14  │ 16383   (tope de las tablas y del ESP32-C3)
+          5 kHz    │  13  │ 8191
+         19.5 kHz  │  12  │ 4095
+         78 kHz    │  10  │ 1023
+        312 kHz    │   8  │ 255
+
+    El divisor del timer tiene 10 bits enteros (y 8 fraccionarios): no
+    puede dividir por 1024 o más, así que cada resolución tiene también
+    una frecuencia mínima, 80 MHz / (1024 · 2^bits). Con 14 bits son
+    5 Hz; por debajo ledcSetup() devuelve 0 y el canal no se configura.
+
+    Con 8 bits fijos, la gamma aplasta el extremo bajo del slider: 1-8 %
+    dan duty 0 y varios niveles seguidos comparten el mismo duty (88
+    distintos de 101). Con 13 bits (5 kHz) son 100: solo 0 y 1 % apagan.
+
+        uint8_t bits = bitsParaFrecuencia(5000);          // 13
+        const uint16_t *gamma = tablaGammaPorcentaje(bits);
+        ledcSetup(CANAL, 5000, bits);
+        ledcWrite(CANAL, gamma[brillo]);                  // brillo 0-100
+
+    No depende de Arduino.h: tools/sim_pwm_niveles.cpp lo compila en la
+    PC y cuenta cuántos duty distintos produce el slider en cada caso.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "gamma_lut.h"
+
+#define PWM_RELOJ_HZ  80000000UL  // APB, fuente de reloj del LEDC
+#define PWM_BITS_MIN  8           // Por debajo se pierden niveles del slider
+#define PWM_BITS_MAX  14          // Límite del ESP32-C3 y de TablaGamma
+#define PWM_DIVISOR_MAX 0x3FFFFUL // Divisor del timer en punto fijo 10.8 (< 1024)
+
+// Menor frecuencia con la que reloj / (frecuencia · 2^bits) entra en el
+// divisor del timer (redondeada hacia arriba)
+inline uint32_t frecuenciaMinima(uint8_t bits) {
+    uint64_t divisor = (uint64_t)PWM_DIVISOR_MAX << bits;
+    return (uint32_t)(((uint64_t)PWM_RELOJ_HZ * 256 + divisor - 1) / divisor);
+}
+
+// Mayor resolución que admite la frecuencia (0 si pide menos de 8 bits
+// o si es tan baja que el divisor no alcanza ni con 14)
+inline uint8_t bitsParaFrecuencia(uint32_t frecuencia) {
+    if (frecuencia == 0) return 0;
+    uint8_t bits = 0;
+    while (bits < PWM_BITS_MAX && ((uint64_t)frecuencia << (bits + 1)) <= PWM_RELOJ_HZ) bits++;
+    if (frecuencia < frecuenciaMinima(bits)) return 0;
+    return bits >= PWM_BITS_MIN ? bits : 0;
+}
+
+// Tabla gamma de 101 entradas (brillo 0-100 %) para la resolución dada.
+// Todas quedan en flash (7 × 202 B); devuelve nullptr fuera de 8-14 bits
+inline const uint16_t *tablaGammaPorcentaje(uint8_t bits) {
+    switch (bits) {
+        case 8:  return TablaGamma<101, 8>::valores;
+        case 9:  return TablaGamma<101, 9>::valores;
+        case 10: return TablaGamma<101, 10>::valores;
+        case 11: return TablaGamma<101, 11>::valores;
+        case 12: return TablaGamma<101, 12>::valores;
+        case 13: return TablaGamma<101, 13>::valores;
+        case 14: return TablaGamma<101, 14>::valores;
+        default: return nullptr;
+    }
+}
+
+// Cantidad de duty distintos entre los 101 niveles del slider
+// (la tabla es creciente: basta comparar cada uno con el anterior)
+inline uint8_t nivelesDistintos(const uint16_t *tabla) {
+    uint8_t distintos = 1;
+    for (uint8_t i = 1; i <= 100; i++) {
+        if (tabla[i] != tabla[i - 1]) distintos++;
+    }
+    return distintos;
+}
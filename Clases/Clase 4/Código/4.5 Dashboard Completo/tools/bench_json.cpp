@@ -0,0 +1,503 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    JsonWriter (src/json_writer.h) contra el camino anterior con
+    ArduinoJson, en la PC (no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o bench_json tools/bench_json.cpp
+        ./bench_json
+
+    Camino anterior (handleApiSensors() antes de json_writer.h):
+
+        StaticJsonDocument<200> doc;         // En el stack
+        doc["temperature"] = temperature;    // ...
+        String response;
+        serializeJson(doc, response);        // Crece de a 32 bytes (realloc)
+        request->send(200, "application/json", response);  // Otra copia
+
+    Con ArduinoJson en el include path se usa la librería real, por
+    ejemplo la que baja PlatformIO al compilar el proyecto Final:
+
+        g++ -O2 -std=c++11 -I"../../Final/.pio/libdeps/esp32/ArduinoJson/src" \
+            -o bench_json tools/bench_json.cpp
+
+    Sin ella se usa un modelo del mismo recorrido: documento de slots
+    fijos con búsqueda lineal de la clave, números formateados como
+    TextFormatter (9 decimales) y el String de Arduino, que reserva el
+    tamaño justo en cada concat(). La latencia del modelo es orientativa;
+    el heap es el mismo en los dos casos porque lo pone String.
+
+    Mide por respuesta (/api/sensors y /api/actuators con 6 canales) el
+    tiempo, las reservas de heap y el pico de heap. Verifica que las dos
+    salidas tengan las mismas claves y valores y que JsonWriter no use el
+    heap; devuelve 1 si no.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "../src/json_writer.h"
+
+#define VUELTAS     200000
+#define ACTUADORES  6
+
+static int fallas = 0;
+
+// --- Heap contado (lo usa String) ---
+
+static size_t heapActual = 0, heapPico = 0, reservas = 0;
+
+static void *heapRealloc(void *p, size_t viejo, size_t nuevo) {
+    reservas++;
+    heapActual += nuevo - viejo;
+    if (heapActual > heapPico) heapPico = heapActual;
+    return realloc(p, nuevo);
+}
+
+static void heapLiberar(void *p, size_t tam) {
+    heapActual -= tam;
+    free(p);
+}
+
+// String de Arduino: concat() llama a reserve(largo nuevo), que hace
+// realloc al tamaño justo (+1 del '\0')
+class StringArduino {
+public:
+    StringArduino() {}
+    StringArduino(const StringArduino &otro) { concat(otro._buf, otro._len); }  // send() copia
+    ~StringArduino() { if (_buf) heapLiberar(_buf, _cap + 1); }
+    void concat(const char *s, size_t n) {
+        if (_len + n > _cap) {
+            _buf = (char *)heapRealloc(_buf, _buf ? _cap + 1 : 0, _len + n + 1);
+            _cap = _len + n;
+        }
+        memcpy(_buf + _len, s, n);
+        _len += n;
+        _buf[_len] = '\0';
+    }
+    const char *c_str() const { return _buf ? _buf : ""; }
+    size_t length() const { return _len; }
+
+private:
+    char *_buf = nullptr;
+    size_t _len = 0, _cap = 0;
+};
+
+// Como Writer<::String> de ArduinoJson: junta 32 bytes y hace concat()
+class EscritorString {
+public:
+    explicit EscritorString(StringArduino &destino) : _destino(destino) {}
+    ~EscritorString() { flush(); }
+    size_t write(uint8_t c) {
+        if (_n == sizeof(_buf)) flush();
+        _buf[_n++] = (char)c;
+        return 1;
+    }
+    size_t write(const uint8_t *s, size_t n) {
+        for (size_t i = 0; i < n; i++) write(s[i]);
+        return n;
+    }
+    void flush() {
+        if (_n) _destino.concat(_buf, _n);
+        _n = 0;
+    }
+
+private:
+    StringArduino &_destino;
+    char _buf[32];
+    size_t _n = 0;
+};
+
+// --- Datos de las respuestas ---
+
+struct Datos {
+    float temperatura;
+    uint32_t ms, heapLibre, frecuencia;
+    int32_t rssi;
+    uint8_t bits, pin[ACTUADORES], brillo[ACTUADORES];
+    bool encendido[ACTUADORES], gamma[ACTUADORES], activoBajo[ACTUADORES];
+};
+
+static Datos datos(uint32_t n) {
+    Datos d;
+    d.temperatura = 21.5f + (n % 700) * 0.01f;
+    d.ms = 123456 + n * 2000;
+    d.heapLibre = 210000 - n % 5000;
+    d.rssi = -40 - (int32_t)(n % 40);
+    d.frecuencia = 5000;
+    d.bits = 13;
+    for (uint8_t id = 0; id < ACTUADORES; id++) {
+        d.pin[id] = 2 + id * 2;
+        d.brillo[id] = (n + id * 17) % 101;
+        d.encendido[id] = d.brillo[id] > 0;
+        d.gamma[id] = id != 3;
+        d.activoBajo[id] = id == 0;
+    }
+    return d;
+}
+
+// Mismos esquemas que main.cpp (con variables de la PC)
+#define SENSORS_JSON(FIELD)                             \
+    FIELD(Fixed2, "temperature", d.temperatura)         \
+    FIELD(U32,    "timestamp",   d.ms)                  \
+    FIELD(U32,    "uptime",      d.ms / 1000)           \
+    FIELD(U32,    "free_heap",   d.heapLibre)           \
+    FIELD(I32,    "wifi_rssi",   d.rssi)
+
+#define ACTUATORS_JSON(FIELD)                           \
+    FIELD(U32,    "pwm_freq",    d.frecuencia)          \
+    FIELD(U32,    "pwm_bits",    (uint32_t)d.bits)
+
+#define ACTUATOR_JSON(FIELD)                            \
+    FIELD(U32,    "id",          (uint32_t)id)          \
+    FIELD(U32,    "pin",         (uint32_t)d.pin[id])   \
+    FIELD(Bool,   "state",       d.encendido[id])       \
+    FIELD(U32,    "brightness",  (uint32_t)d.brillo[id]) \
+    FIELD(Bool,   "gamma",       d.gamma[id])           \
+    FIELD(Bool,   "active_low",  d.activoBajo[id])
+
+// --- JsonWriter (lo que hace main.cpp) ---
+
+static size_t sensoresWriter(const Datos &d, char *salida, size_t tam) {
+    char body[JSON_MAX_LEN(SENSORS_JSON)];
+    JsonWriter json(body, sizeof(body));
+    SENSORS_JSON(JSON_WRITE_FIELD)
+    size_t len = json.finish();
+    memcpy(salida, body, len + 1 < tam ? len + 1 : tam);  // send_P() copia al buffer TCP
+    return len;
+}
+
+static size_t actuadoresWriter(const Datos &d, char *salida, size_t tam) {
+    char body[JSON_MAX_LEN(ACTUATORS_JSON) + JSON_MAX_ARRAY("actuators", ACTUATOR_JSON, ACTUADORES)];
+    JsonWriter json(body, sizeof(body));
+    ACTUATORS_JSON(JSON_WRITE_FIELD)
+    json.beginArray("actuators");
+    for (uint8_t id = 0; id < ACTUADORES; id++) {
+        json.beginObject();
+        ACTUATOR_JSON(JSON_WRITE_FIELD)
+        json.endObject();
+    }
+    json.endArray();
+    size_t len = json.finish();
+    memcpy(salida, body, len + 1 < tam ? len + 1 : tam);
+    return len;
+}
+
+// --- Camino anterior ---
+
+#if defined(__has_include) && __has_include(<ArduinoJson.h>)
+#include <ArduinoJson.h>
+#define NOMBRE_ANTERIOR "ArduinoJson " ARDUINOJSON_VERSION
+
+typedef StaticJsonDocument<200> DocSensores;
+typedef StaticJsonDocument<768> DocActuadores;
+#define STACK_SENSORES   sizeof(DocSensores)
+#define STACK_ACTUADORES sizeof(DocActuadores)
+
+static void armarSensores(DocSensores &doc, const Datos &d) {
+    doc["temperature"] = d.temperatura;
+    doc["timestamp"] = d.ms;
+    doc["uptime"] = d.ms / 1000;
+    doc["free_heap"] = d.heapLibre;
+    doc["wifi_rssi"] = d.rssi;
+}
+
+static void armarActuadores(DocActuadores &doc, const Datos &d) {
+    doc["pwm_freq"] = d.frecuencia;
+    doc["pwm_bits"] = d.bits;
+    JsonArray lista = doc.createNestedArray("actuators");
+    for (uint8_t id = 0; id < ACTUADORES; id++) {
+        JsonObject a = lista.createNestedObject();
+        a["id"] = id;
+        a["pin"] = d.pin[id];
+        a["state"] = d.encendido[id];
+        a["brightness"] = d.brillo[id];
+        a["gamma"] = d.gamma[id];
+        a["active_low"] = d.activoBajo[id];
+    }
+}
+
+template <typename Doc>
+static void serializar(Doc &doc, StringArduino &response) {
+    EscritorString escritor(response);
+    serializeJson(doc, escritor);
+}
+#else
+#define NOMBRE_ANTERIOR "ArduinoJson (modelo)"
+
+// Slots fijos como los de StaticJsonDocument: clave (puntero a la
+// constante), tipo y valor. operator[] busca la clave antes de agregarla
+class DocModelo {
+public:
+    enum Tipo : uint8_t { NULO, BOOL, ENTERO, NEGATIVO, REAL, ARREGLO, OBJETO, FIN };
+
+    struct Slot {
+        const char *clave;
+        Tipo tipo;
+        union {
+            bool b;
+            uint32_t u;
+            double r;
+        };
+    };
+
+    Slot *buscarOAgregar(const char *clave) {
+        for (uint16_t i = _inicio; i < _n; i++) {
+            if (_slots[i].clave && strcmp(_slots[i].clave, clave) == 0) return &_slots[i];
+        }
+        Slot &s = _slots[_n++];
+        s.clave = clave;
+        s.tipo = NULO;
+        return &s;
+    }
+    void fijar(const char *clave, bool v) { Slot *s = buscarOAgregar(clave); s->tipo = BOOL; s->b = v; }
+    void fijar(const char *clave, uint32_t v) { Slot *s = buscarOAgregar(clave); s->tipo = ENTERO; s->u = v; }
+    void fijar(const char *clave, int32_t v) {
+        Slot *s = buscarOAgregar(clave);
+        s->tipo = v < 0 ? NEGATIVO : ENTERO;
+        s->u = v < 0 ? 0u - (uint32_t)v : (uint32_t)v;
+    }
+    void fijar(const char *clave, float v) { Slot *s = buscarOAgregar(clave); s->tipo = REAL; s->r = v; }
+    void abrir(const char *clave, Tipo tipo) {  // Arreglo u objeto anidado
+        Slot &s = _slots[_n++];
+        s.clave = clave;
+        s.tipo = tipo;
+        _inicio = _n;
+    }
+    void cerrar() {
+        _slots[_n].clave = nullptr;
+        _slots[_n++].tipo = FIN;
+        _inicio = _n;
+    }
+
+    template <typename Escritor>
+    void serializar(Escritor &out) const {
+        char cierres[4];  // Contenedores abiertos
+        int nivel = 0;
+        bool primero = true;
+        out.write('{');
+        for (uint16_t i = 0; i < _n; i++) {
+            const Slot &s = _slots[i];
+            if (s.tipo == FIN) {
+                out.write(cierres[--nivel]);
+                primero = false;
+                continue;
+            }
+            if (!primero) out.write(',');
+            primero = false;
+            if (s.clave) {
+                out.write('"');
+                out.write((const uint8_t *)s.clave, strlen(s.clave));
+                out.write((const uint8_t *)"\":", 2);
+            }
+            switch (s.tipo) {
+                case NULO: out.write((const uint8_t *)"null", 4); break;
+                case BOOL: s.b ? out.write((const uint8_t *)"true", 4) : out.write((const uint8_t *)"false", 5); break;
+                case NEGATIVO: out.write('-'); escribirEntero(out, s.u); break;
+                case ENTERO: escribirEntero(out, s.u); break;
+                case REAL: escribirReal(out, s.r); break;
+                case ARREGLO: out.write('['); cierres[nivel++] = ']'; primero = true; break;
+                case OBJETO: out.write('{'); cierres[nivel++] = '}'; primero = true; break;
+                case FIN: break;
+            }
+        }
+        out.write('}');
+    }
+
+private:
+    Slot _slots[64];
+    uint16_t _n = 0, _inicio = 0;
+
+    template <typename Escritor>
+    static void escribirEntero(Escritor &out, uint32_t v) {
+        char d[10];
+        int n = 0;
+        do {
+            d[n++] = '0' + v % 10;
+            v /= 10;
+        } while (v);
+        while (n) out.write(d[--n]);
+    }
+
+    // Como TextFormatter::writeFloat: parte entera + 9 decimales, sin
+    // los ceros finales
+    template <typename Escritor>
+    static void escribirReal(Escritor &out, double v) {
+        if (v != v) { out.write((const uint8_t *)"NaN", 3); return; }
+        if (v < 0) { out.write('-'); v = -v; }
+        uint32_t entera = (uint32_t)v;
+        uint32_t decimales = (uint32_t)((v - entera) * 1e9 + 0.5);
+        if (decimales >= 1000000000u) { entera++; decimales -= 1000000000u; }
+        escribirEntero(out, entera);
+        if (!decimales) return;
+        int cifras = 9;
+        while (decimales % 10 == 0) { decimales /= 10; cifras--; }
+        char d[9];
+        for (int i = cifras - 1; i >= 0; i--) { d[i] = '0' + decimales % 10; decimales /= 10; }
+        out.write('.');
+        out.write((const uint8_t *)d, cifras);
+    }
+};
+
+typedef DocModelo DocSensores;
+typedef DocModelo DocActuadores;
+#define STACK_SENSORES   200  // StaticJsonDocument<200> en el ESP32
+#define STACK_ACTUADORES 768
+
+static void armarSensores(DocSensores &doc, const Datos &d) {
+    doc.fijar("temperature", d.temperatura);
+    doc.fijar("timestamp", d.ms);
+    doc.fijar("uptime", d.ms / 1000);
+    doc.fijar("free_heap", d.heapLibre);
+    doc.fijar("wifi_rssi", d.rssi);
+}
+
+static void armarActuadores(DocActuadores &doc, const Datos &d) {
+    doc.fijar("pwm_freq", d.frecuencia);
+    doc.fijar("pwm_bits", (uint32_t)d.bits);
+    doc.abrir("actuators", DocModelo::ARREGLO);
+    for (uint8_t id = 0; id < ACTUADORES; id++) {
+        doc.abrir(nullptr, DocModelo::OBJETO);
+        doc.fijar("id", (uint32_t)id);
+        doc.fijar("pin", (uint32_t)d.pin[id]);
+        doc.fijar("state", d.encendido[id]);
+        doc.fijar("brightness", (uint32_t)d.brillo[id]);
+        doc.fijar("gamma", d.gamma[id]);
+        doc.fijar("active_low", d.activoBajo[id]);
+        doc.cerrar();
+    }
+    doc.cerrar();
+}
+
+static void serializar(const DocModelo &doc, StringArduino &response) {
+    EscritorString escritor(response);
+    doc.serializar(escritor);
+}
+#endif
+
+// Una respuesta completa: documento, String y la copia de send()
+template <typename Doc, void (*armar)(Doc &, const Datos &)>
+static size_t anterior(const Datos &d, char *salida, size_t tam) {
+    Doc doc;
+    armar(doc, d);
+    StringArduino response;
+    serializar(doc, response);
+    StringArduino enviada(response);  // AsyncBasicResponse guarda su copia
+    size_t len = enviada.length();
+    memcpy(salida, enviada.c_str(), len + 1 < tam ? len + 1 : tam);
+    return len;
+}
+
+// --- Comparación de salidas ---
+
+// Valor numérico (o true/false como 1/0) de "clave": en la posición n-ésima
+static bool valor(const char *json, const char *clave, int n, double &v) {
+    char buscado[32];
+    snprintf(buscado, sizeof(buscado), "\"%s\":", clave);
+    const char *p = json;
+    for (int i = 0; i <= n; i++) {
+        p = strstr(p, buscado);
+        if (!p) return false;
+        p += strlen(buscado);
+    }
+    if (strncmp(p, "true", 4) == 0) v = 1;
+    else if (strncmp(p, "false", 5) == 0) v = 0;
+    else v = strtod(p, nullptr);
+    return true;
+}
+
+static void comparar(const char *nombre, const char *a, const char *b, const char *const *claves, int nClaves, int veces) {
+    for (int k = 0; k < nClaves; k++) {
+        for (int n = 0; n < veces; n++) {
+            double va, vb;
+            if (!valor(a, claves[k], n, va) || !valor(b, claves[k], n, vb) || va - vb > 0.006 || vb - va > 0.006) {
+                printf("  FALLA: %s, \"%s\" distinto:\n    %s\n    %s\n", nombre, claves[k], a, b);
+                fallas++;
+                return;
+            }
+        }
+    }
+}
+
+struct Medida {
+    double ns;
+    double reservasPorRespuesta;
+    size_t pico;
+    size_t largo;
+};
+
+template <size_t (*generar)(const Datos &, char *, size_t)>
+static Medida medir() {
+    static Datos lista[64];
+    for (uint32_t i = 0; i < 64; i++) lista[i] = datos(i);
+    char salida[1024];
+    size_t control = 0;
+    heapActual = heapPico = reservas = 0;
+
+    typedef std::chrono::steady_clock Reloj;
+    Reloj::time_point t0 = Reloj::now();
+    for (uint32_t v = 0; v < VUELTAS; v++) control += generar(lista[v % 64], salida, sizeof(salida)) + salida[v % 16];
+    double seg = std::chrono::duration<double>(Reloj::now() - t0).count();
+
+    Medida m = {seg * 1e9 / VUELTAS, (double)reservas / VUELTAS, heapPico, control / VUELTAS};
+    if (heapActual != 0) {
+        printf("  FALLA: quedaron %zu bytes sin liberar\n", heapActual);
+        fallas++;
+    }
+    return m;
+}
+
+static void fila(const char *nombre, const char *variante, const Medida &m, size_t stack) {
+    printf("  %-15s │ %-26s │ %7.0f │ %8.1f │ %7zu │ %5zu\n", nombre, variante, m.ns, m.reservasPorRespuesta, m.pico, stack);
+}
+
+int main() {
+    // Mismas claves y valores en las dos salidas
+    char a[1024], b[1024];
+    for (uint32_t n = 0; n < 50; n++) {
+        Datos d = datos(n * 37);
+        static const char *const clavesSensores[] = {"temperature", "timestamp", "uptime", "free_heap", "wifi_rssi"};
+        static const char *const clavesActuadores[] = {"id", "pin", "state", "brightness", "gamma", "active_low"};
+        sensoresWriter(d, a, sizeof(a));
+        anterior<DocSensores, armarSensores>(d, b, sizeof(b));
+        comparar("/api/sensors", a, b, clavesSensores, 5, 1);
+        actuadoresWriter(d, a, sizeof(a));
+        anterior<DocActuadores, armarActuadores>(d, b, sizeof(b));
+        comparar("/api/actuators", a, b, clavesActuadores, 6, ACTUADORES);
+    }
+
+    Medida sensoresW = medir<sensoresWriter>();
+    Medida sensoresA = medir<anterior<DocSensores, armarSensores> >();
+    Medida actuadoresW = medir<actuadoresWriter>();
+    Medida actuadoresA = medir<anterior<DocActuadores, armarActuadores> >();
+
+    if (sensoresW.pico || actuadoresW.pico) {
+        printf("  FALLA: JsonWriter usó el heap\n");
+        fallas++;
+    }
+
+    printf("%d respuestas de cada tipo:\n\n", VUELTAS);
+    printf("  Endpoint        │ Formateo                   │ ns/resp │ Reservas │ Pico B  │ Stack\n");
+    printf("  ────────────────┼────────────────────────────┼─────────┼──────────┼─────────┼──────\n");
+    fila("/api/sensors", NOMBRE_ANTERIOR, sensoresA, STACK_SENSORES);
+    fila("", "JsonWriter", sensoresW, (size_t)JSON_MAX_LEN(SENSORS_JSON));
+    fila("/api/actuators", NOMBRE_ANTERIOR, actuadoresA, STACK_ACTUADORES);
+    fila("", "JsonWriter", actuadoresW,
+         (size_t)(JSON_MAX_LEN(ACTUATORS_JSON) + JSON_MAX_ARRAY("actuators", ACTUATOR_JSON, ACTUADORES)));
+    printf("\n  Largo medio: sensors %zu / %zu bytes, actuators %zu / %zu bytes (anterior / JsonWriter)\n",
+           sensoresA.largo, sensoresW.largo, actuadoresA.largo, actuadoresW.largo);
+    printf("  Pico B: heap usado a la vez por una respuesta (String + copia de send())\n");
+    printf("  Stack: StaticJsonDocument o buffer de JsonWriter, en bytes\n");
+
+    printf("\n%s\n", fallas ? "FALLA: ver arriba" : "OK: mismas claves y valores, JsonWriter sin heap");
+    return fallas ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Búsqueda de rutas en la PC: tabla con hash perfecto contra el camino
+    anterior (no se compila con PlatformIO)
+
+        python3 tools/gzip_data.py && python3 tools/gen_route_table.py
+        g++ -O2 -std=c++11 -o bench_rutas tools/bench_rutas.cpp
+        ./bench_rutas
+
+    El camino anterior se reproduce con std::string en lugar de String
+    (mismas copias por valor): WebServer recorre los handlers de
+    server.on() comparando URI y método, si ninguno sirve llama a
+    handleNotFound(), que completa "/" con index.html, busca el archivo
+    en la lista armada al montar LittleFS y arma el tipo MIME con la
+    cadena de endsWith() de getContentType().
+
+    La mezcla de URIs es la de una carga de página (/, CSS, JS), el
+    polling de la API y algún 404 (favicon). Verifica además que cada
+    ruta de la tabla se encuentre a sí misma, que "/" abra /index.html y
+    que una URI desconocida no se encuentre; devuelve 1 si algo falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../src/route_table.h"
+
+#define VUELTAS 2000000
+
+static int fallas = 0;
+
+// --- Camino anterior (server.on() + handleNotFound) ---
+
+enum Metodo { GET, POST };
+
+struct HandlerViejo {
+    std::string uri;
+    int metodo;  // -1 = cualquiera (server.on("/", handleRoot))
+};
+
+// Mismo orden en que se registraban en setup()
+static const HandlerViejo handlersViejos[] = {
+    {"/", -1},
+    {"/api/sensors", GET},
+    {"/api/led", GET},
+    {"/api/led", POST},
+};
+
+// Lista de archivos que armaba buildAssetTable() al montar LittleFS
+static std::vector<std::string> assetsViejos;
+
+static std::string getContentType(std::string filename) {
+    if (filename.size() >= 5 && filename.compare(filename.size() - 5, 5, ".html") == 0) return "text/html";
+    else if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".css") == 0) return "text/css";
+    else if (filename.size() >= 3 && filename.compare(filename.size() - 3, 3, ".js") == 0) return "application/javascript";
+    else if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".png") == 0) return "image/png";
+    else if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".jpg") == 0) return "image/jpeg";
+    else if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".gif") == 0) return "image/gif";
+    else if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".ico") == 0) return "image/x-icon";
+    return "text/plain";
+}
+
+static const std::string *findAsset(const std::string &path) {
+    for (const std::string &asset : assetsViejos) {
+        if (asset == path) return &asset;
+    }
+    return nullptr;
+}
+
+// Devuelve algo que depende del resultado para que no se optimice
+static size_t buscarViejo(const std::string &uri, int metodo) {
+    for (size_t i = 0; i < sizeof(handlersViejos) / sizeof(handlersViejos[0]); i++) {
+        const HandlerViejo &h = handlersViejos[i];
+        if ((h.metodo < 0 || h.metodo == metodo) && h.uri == uri) return i + 1;
+    }
+    std::string path = uri;  // handleFileRead(server.uri()) recibía una copia
+    if (path[path.size() - 1] == '/') path += "index.html";
+    const std::string *asset = findAsset(path);
+    if (!asset) return 0;
+    return getContentType(path).size();
+}
+
+// --- Tabla con hash perfecto ---
+
+static size_t buscarNuevo(const char *uri) {
+    const Route *route = findRoute(uri);
+    if (!route) return 0;
+    return route->api >= 0 ? (size_t)route->api + 1 : strlen(route->mime);
+}
+
+static void verificarTabla() {
+    int rutas = 0;
+    for (uint32_t i = 0; i < ROUTE_SIZE; i++) {
+        const Route &route = ROUTES[i];
+        if (!route.path) continue;
+        rutas++;
+        if (findRoute(route.path) != &route) {
+            printf("  FALLA: %s no se encuentra a sí misma\n", route.path);
+            fallas++;
+        }
+        if (route.api < 0 && !route.file) {
+            printf("  FALLA: %s no tiene archivo\n", route.path);
+            fallas++;
+        }
+    }
+    const Route *raiz = findRoute("/");
+    if (!raiz || !raiz->file || strcmp(raiz->file, "/index.html") != 0) {
+        printf("  FALLA: \"/\" no abre /index.html\n");
+        fallas++;
+    }
+    if (findRoute("/favicon.ico") || findRoute("/api/sensor") || findRoute("")) {
+        printf("  FALLA: se encontró una URI que no está en la tabla\n");
+        fallas++;
+    }
+    printf("Tabla: %d rutas en %u casilleros (semilla %u)\n\n", rutas, (unsigned)ROUTE_SIZE, (unsigned)ROUTE_SEED);
+}
+
+int main() {
+    verificarTabla();
+
+    for (uint32_t i = 0; i < ROUTE_SIZE; i++) {
+        if (ROUTES[i].path && ROUTES[i].api < 0 && strcmp(ROUTES[i].path, "/") != 0) {
+            assetsViejos.push_back(ROUTES[i].file);
+        }
+    }
+
+    // Una carga de página, 6 consultas de la API y un favicon que no existe
+    struct Peticion {
+        const char *uri;
+        int metodo;
+    };
+    static const Peticion mezcla[] = {
+        {"/", GET}, {"/style.css", GET}, {"/script.js", GET}, {"/favicon.ico", GET},
+        {"/api/sensors", GET}, {"/api/led", GET}, {"/api/sensors", GET},
+        {"/api/led", POST}, {"/api/sensors", GET}, {"/api/actuators", GET},
+    };
+    const int n = sizeof(mezcla) / sizeof(mezcla[0]);
+    std::vector<std::string> uris;
+    for (int i = 0; i < n; i++) uris.push_back(mezcla[i].uri);
+
+    typedef std::chrono::steady_clock Reloj;
+    size_t control = 0;
+
+    Reloj::time_point t0 = Reloj::now();
+    for (int v = 0; v < VUELTAS; v++) {
+        int i = v % n;
+        control += buscarViejo(uris[i], mezcla[i].metodo);
+    }
+    double segViejo = std::chrono::duration<double>(Reloj::now() - t0).count();
+
+    t0 = Reloj::now();
+    for (int v = 0; v < VUELTAS; v++) {
+        control += buscarNuevo(uris[v % n].c_str());  // request->url().c_str()
+    }
+    double segNuevo = std::chrono::duration<double>(Reloj::now() - t0).count();
+
+    printf("%d búsquedas (mezcla de %d URIs):\n\n", VUELTAS, n);
+    printf("                                  │ Búsquedas/s │ ns por búsqueda\n");
+    printf("  ────────────────────────────────┼─────────────┼────────────────\n");
+    printf("  server.on() + handleNotFound()  │ %11.0f │ %8.1f\n", VUELTAS / segViejo, segViejo * 1e9 / VUELTAS);
+    printf("  findRoute() (hash perfecto)     │ %11.0f │ %8.1f\n", VUELTAS / segNuevo, segNuevo * 1e9 / VUELTAS);
+    printf("\n  %.1f veces más rápido (control %zu)\n", segViejo / segNuevo, control);
+
+    printf("\n%s\n", fallas ? "FALLA: la tabla de rutas no es correcta" : "OK: todas las rutas se encuentran");
+    return fallas ? 1 : 0;
+}
@@ -0,0 +1,623 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Generador de carga HTTP contra un servidor de sockets en la PC que
+    imita a AsyncTCP (no se compila con PlatformIO)
+
+        python3 tools/gzip_data.py && python3 tools/gen_route_table.py
+        g++ -O2 -std=c++11 -pthread -o carga_http tools/carga_http.cpp
+        ./carga_http
+
+    El servidor escucha en 127.0.0.1 y despacha con el mismo código que
+    el firmware: findRoute() (route_table.h), ArchivosEstaticos para los
+    archivos de data/ y JsonWriter para /api/sensors y /api/led. Tres
+    modos:
+
+      síncrono     El de antes: WebServer dentro de loop(). Una conexión
+                   por vuelta, updateOLED() bloquea 26 ms cada 500 ms y
+                   delay(10) al final de cada vuelta
+      async        Como ESPAsyncWebServer en el firmware: una tarea con
+                   poll(), pool de 16 conexiones (CONFIG_LWIP_MAX_ACTIVE_TCP),
+                   una máquina de estados por conexión (línea, cabeceras,
+                   cuerpo) y "Connection: close" después de cada respuesta
+      pipelining   El mismo servidor con keep-alive: la máquina de estados
+                   sigue leyendo pedidos del mismo buffer y responde en
+                   orden (la página pide /, CSS y JS juntos)
+
+    Cada cliente (hilo) repite: carga de página (3 archivos con gzip) y
+    dos consultas de la API (GET /api/sensors y POST /api/led con cuerpo).
+    Informa p50/p99 de la latencia por pedido con 1 a 32 clientes
+    concurrentes. Verifica cada respuesta (código, Content-Length, tipo y
+    orden con pipelining); devuelve 1 si alguna no coincide.
+
+    ESPAsyncWebServer 1.2.3 cierra la conexión después de cada respuesta
+    y descarta lo que llegó detrás del primer pedido: un cliente que
+    envía pedidos en pipeline tiene que reintentar los que quedaron sin
+    respuesta (RFC 7230 §6.3.2). Los navegadores no usan pipelining,
+    abren hasta 6 conexiones en paralelo; el modo "pipelining" mide
+    cuánto se ganaría con keep-alive en la misma conexión.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/archivos_estaticos.h"
+#include "../src/json_writer.h"
+
+#define POOL_CONEXIONES  16    // CONFIG_LWIP_MAX_ACTIVE_TCP
+#define ITERACIONES      3     // Cargas de página por cliente
+#define OLED_MS          26    // sendBuffer() completo a 400 kHz
+#define OLED_CADA_MS     500
+#define DELAY_LOOP_MS    10
+
+enum Modo { SINCRONO, ASYNC, PIPELINING };
+static const char *NOMBRE_MODO[] = {"síncrono", "async", "pipelining"};
+
+static std::atomic<int> fallas(0);
+
+typedef std::chrono::steady_clock Reloj;
+
+static uint32_t msDesde(Reloj::time_point t0) {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(Reloj::now() - t0).count();
+}
+
+// --- LittleFS simulado con los archivos de data/ ---
+
+class ArchivoSim {
+public:
+    ArchivoSim(const std::string *datos = nullptr) : _datos(datos) {}
+    explicit operator bool() const { return _datos != nullptr; }
+    size_t size() const { return _datos ? _datos->size() : 0; }
+    size_t read(uint8_t *buf, size_t n) {
+        if (!_datos) return 0;
+        n = std::min(n, _datos->size() - _pos);
+        memcpy(buf, _datos->data() + _pos, n);
+        _pos += n;
+        return n;
+    }
+    void close() { _datos = nullptr; }
+    const std::string *datos() const { return _datos; }
+
+private:
+    const std::string *_datos;
+    size_t _pos = 0;
+};
+
+class FsSim {
+public:
+    ArchivoSim open(const char *ruta, const char *) {
+        auto it = _archivos.find(ruta);
+        return ArchivoSim(it == _archivos.end() ? nullptr : &it->second);
+    }
+    bool cargar(const char *ruta) {
+        FILE *f = fopen((std::string("data") + ruta).c_str(), "rb");
+        if (!f) return false;
+        std::string datos;
+        char buf[512];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0) datos.append(buf, n);
+        fclose(f);
+        _archivos[ruta] = datos;
+        return true;
+    }
+
+private:
+    std::map<std::string, std::string> _archivos;
+};
+
+static FsSim fs;
+static ArchivosEstaticos archivos;
+
+// --- Despacho (mismo camino que handleRequest()) ---
+
+struct Peticion {
+    std::string metodo, url, aceptaEncoding, ifNoneMatch, cuerpo;
+    size_t largoCuerpo = 0;
+    bool keepAlive = false;
+};
+
+static bool ledEncendido = false;
+static uint32_t ledBrillo = 50;
+
+#define SENSORS_JSON(FIELD)                         \
+    FIELD(Fixed2, "temperature", 41.3f)             \
+    FIELD(U32,    "timestamp",   ms)                \
+    FIELD(U32,    "uptime",      ms / 1000)         \
+    FIELD(U32,    "free_heap",   200000u)           \
+    FIELD(I32,    "wifi_rssi",   -57)
+
+#define LED_JSON(FIELD)                             \
+    FIELD(Bool,   "state",       ledEncendido)      \
+    FIELD(U32,    "brightness",  ledBrillo)
+
+static std::string respuesta(int codigo, const char *tipo, const std::string &cuerpo, const char *extra, bool keepAlive) {
+    char cab[512];
+    snprintf(cab, sizeof(cab), "HTTP/1.1 %d %s\r\nContent-Length: %u\r\nContent-Type: %s\r\n%sConnection: %s\r\n\r\n",
+             codigo, codigo == 200 ? "OK" : codigo == 304 ? "Not Modified" : "Not Found", (unsigned)cuerpo.size(),
+             tipo, extra, keepAlive ? "keep-alive" : "close");
+    return cab + cuerpo;
+}
+
+static std::string despachar(const Peticion &p, uint32_t ms) {
+    const Route *route = findRoute(p.url.c_str());
+    if (route && route->api == API_SENSORS) {
+        char body[JSON_MAX_LEN(SENSORS_JSON)];
+        JsonWriter json(body, sizeof(body));
+        SENSORS_JSON(JSON_WRITE_FIELD)
+        size_t len = json.finish();
+        return respuesta(200, "application/json", std::string(body, len), "", p.keepAlive);
+    }
+    if (route && route->api == API_LED) {
+        if (p.metodo == "POST" && p.cuerpo.find("action=toggle") != std::string::npos) ledEncendido = !ledEncendido;
+        char body[JSON_MAX_LEN(LED_JSON)];
+        JsonWriter json(body, sizeof(body));
+        LED_JSON(JSON_WRITE_FIELD)
+        size_t len = json.finish();
+        return respuesta(200, "application/json", std::string(body, len), "", p.keepAlive);
+    }
+    if (route && route->file) {
+        RespuestaArchivo r = archivos.elegir(*route, p.aceptaEncoding.find("gzip") != std::string::npos,
+                                             p.ifNoneMatch.empty() ? nullptr : p.ifNoneMatch.c_str());
+        if (r.codigo != 404) {
+            std::string extra = std::string("ETag: ") + r.etag + "\r\nCache-Control: no-cache\r\nVary: Accept-Encoding\r\n";
+            if (r.codigo == 304) return respuesta(304, route->mime, "", extra.c_str(), p.keepAlive);
+            if (r.gzip) extra += "Content-Encoding: gzip\r\n";
+            ArchivoSim file = fs.open(r.archivo, "r");
+            return respuesta(200, route->mime, file ? *file.datos() : "", extra.c_str(), p.keepAlive);
+        }
+    }
+    return respuesta(404, "text/plain", "Archivo no encontrado", "", p.keepAlive);
+}
+
+// --- Máquina de estados de una conexión ---
+
+class ConexionHttp {
+public:
+    enum Estado { LINEA, CABECERAS, CUERPO };
+
+    // Procesa todo lo recibido. Devuelve las respuestas listas, en orden.
+    // Sin keep-alive se queda con el primer pedido y descarta el resto
+    std::string recibir(const char *datos, size_t n, uint32_t ms, bool pipelining) {
+        std::string salida;
+        _entrada.append(datos, n);
+        while (!_terminada) {
+            if (_estado == CUERPO) {
+                if (_entrada.size() < _pedido.largoCuerpo) break;
+                _pedido.cuerpo = _entrada.substr(0, _pedido.largoCuerpo);
+                _entrada.erase(0, _pedido.largoCuerpo);
+                salida += completar(ms, pipelining);
+                continue;
+            }
+            size_t fin = _entrada.find("\r\n");
+            if (fin == std::string::npos) break;
+            std::string linea = _entrada.substr(0, fin);
+            _entrada.erase(0, fin + 2);
+            if (_estado == LINEA) {
+                _pedido = Peticion();
+                size_t a = linea.find(' '), b = linea.rfind(' ');
+                _pedido.metodo = linea.substr(0, a);
+                _pedido.url = linea.substr(a + 1, b - a - 1);
+                _estado = CABECERAS;
+            } else if (!linea.empty()) {
+                size_t dp = linea.find(':');
+                std::string nombre = linea.substr(0, dp), valor = linea.substr(dp + 2);
+                if (nombre == "Accept-Encoding") _pedido.aceptaEncoding = valor;
+                else if (nombre == "If-None-Match") _pedido.ifNoneMatch = valor;
+                else if (nombre == "Content-Length") _pedido.largoCuerpo = strtoul(valor.c_str(), nullptr, 10);
+                else if (nombre == "Connection") _pedido.keepAlive = valor == "keep-alive";
+            } else if (_pedido.largoCuerpo) {
+                _estado = CUERPO;
+            } else {
+                salida += completar(ms, pipelining);
+            }
+        }
+        return salida;
+    }
+
+    bool terminada() const { return _terminada; }
+
+private:
+    Estado _estado = LINEA;
+    std::string _entrada;
+    Peticion _pedido;
+    bool _terminada = false;
+
+    std::string completar(uint32_t ms, bool pipelining) {
+        _pedido.keepAlive = pipelining && _pedido.keepAlive;
+        _estado = LINEA;
+        if (!_pedido.keepAlive) {
+            _terminada = true;  // Responder y cerrar, lo demás se descarta
+            _entrada.clear();
+        }
+        return despachar(_pedido, ms);
+    }
+};
+
+// --- Servidores ---
+
+static int escuchar(uint16_t &puerto) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int uno = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno));
+    sockaddr_in dir = {};
+    dir.sin_family = AF_INET;
+    dir.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(fd, (sockaddr *)&dir, sizeof(dir));
+    listen(fd, 64);
+    socklen_t largo = sizeof(dir);
+    getsockname(fd, (sockaddr *)&dir, &largo);
+    puerto = ntohs(dir.sin_port);
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    return fd;
+}
+
+static void enviarTodo(int fd, const std::string &datos) {
+    size_t enviado = 0;
+    while (enviado < datos.size()) {
+        ssize_t n = send(fd, datos.data() + enviado, datos.size() - enviado, MSG_NOSIGNAL);
+        if (n > 0) {
+            enviado += n;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd p = {fd, POLLOUT, 0};
+            poll(&p, 1, 100);
+        } else {
+            return;  // El cliente cerró
+        }
+    }
+}
+
+// loop() de antes: handleClient() atiende una conexión, después OLED y delay(10)
+static void servidorSincrono(int escucha, std::atomic<bool> &seguir) {
+    Reloj::time_point inicio = Reloj::now();
+    uint32_t ultimoOled = 0;
+    while (seguir) {
+        int fd = accept(escucha, nullptr, nullptr);
+        if (fd >= 0) {
+            timeval espera = {1, 0};
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &espera, sizeof(espera));
+            ConexionHttp conexion;
+            char buf[1460];
+            while (!conexion.terminada()) {
+                ssize_t n = recv(fd, buf, sizeof(buf), 0);
+                if (n <= 0) break;
+                enviarTodo(fd, conexion.recibir(buf, n, msDesde(inicio), false));
+            }
+            close(fd);
+        }
+        if (msDesde(inicio) - ultimoOled > OLED_CADA_MS) {
+            ultimoOled = msDesde(inicio);
+            std::this_thread::sleep_for(std::chrono::milliseconds(OLED_MS));  // updateOLED()
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(DELAY_LOOP_MS));
+    }
+}
+
+// Tarea de AsyncTCP: poll() sobre el socket de escucha y el pool
+static void servidorAsync(int escucha, std::atomic<bool> &seguir, bool pipelining) {
+    struct Slot {
+        int fd = -1;
+        ConexionHttp conexion;
+        std::string salida;
+    };
+    std::vector<Slot> pool(POOL_CONEXIONES);
+    Reloj::time_point inicio = Reloj::now();
+    while (seguir) {
+        std::vector<pollfd> fds;
+        std::vector<int> indices;
+        int libres = 0;
+        for (int i = 0; i < POOL_CONEXIONES; i++) {
+            if (pool[i].fd < 0) {
+                libres++;
+                continue;
+            }
+            fds.push_back({pool[i].fd, (short)(POLLIN | (pool[i].salida.empty() ? 0 : POLLOUT)), 0});
+            indices.push_back(i);
+        }
+        if (libres) {  // Pool lleno: la conexión espera en el backlog
+            fds.push_back({escucha, POLLIN, 0});
+            indices.push_back(-1);
+        }
+        if (poll(fds.data(), fds.size(), 20) <= 0) continue;
+
+        for (size_t k = 0; k < fds.size(); k++) {
+            if (!fds[k].revents) continue;
+            if (indices[k] < 0) {
+                int fd = accept(escucha, nullptr, nullptr);
+                if (fd < 0) continue;
+                fcntl(fd, F_SETFL, O_NONBLOCK);
+                int uno = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+                for (Slot &s : pool) {
+                    if (s.fd < 0) {
+                        s.fd = fd;
+                        s.conexion = ConexionHttp();
+                        s.salida.clear();
+                        break;
+                    }
+                }
+                continue;
+            }
+            Slot &s = pool[indices[k]];
+            if (fds[k].revents & POLLIN) {  // onData
+                char buf[1460];
+                ssize_t n = recv(s.fd, buf, sizeof(buf), 0);
+                if (n <= 0) {
+                    close(s.fd);
+                    s.fd = -1;
+                    continue;
+                }
+                if (!s.conexion.terminada()) s.salida += s.conexion.recibir(buf, n, msDesde(inicio), pipelining);
+            }
+            if (!s.salida.empty()) {  // onAck: enviar lo que entre
+                ssize_t n = send(s.fd, s.salida.data(), s.salida.size(), MSG_NOSIGNAL);
+                if (n > 0) s.salida.erase(0, n);
+            }
+            if (s.salida.empty() && s.conexion.terminada()) {
+                close(s.fd);
+                s.fd = -1;
+            }
+        }
+    }
+    for (Slot &s : pool) {
+        if (s.fd >= 0) close(s.fd);
+    }
+}
+
+// --- Clientes ---
+
+struct Pedido {
+    const char *metodo, *url, *cuerpo;
+};
+
+// Carga de página + API, como el dashboard
+static const Pedido PAGINA[] = {
+    {"GET", "/", nullptr}, {"GET", "/style.css", nullptr}, {"GET", "/script.js", nullptr},
+};
+static const Pedido API[] = {
+    {"GET", "/api/sensors", nullptr}, {"POST", "/api/led", "action=toggle"},
+};
+
+static std::string textoPedido(const Pedido &p, bool keepAlive) {
+    std::string t = std::string(p.metodo) + " " + p.url + " HTTP/1.1\r\nHost: 127.0.0.1\r\n" +
+                    "Accept-Encoding: gzip, deflate\r\nConnection: " + (keepAlive ? "keep-alive" : "close") + "\r\n";
+    if (p.cuerpo) {
+        char largo[96];
+        snprintf(largo, sizeof(largo), "Content-Type: application/x-www-form-urlencoded\r\nContent-Length: %u\r\n",
+                 (unsigned)strlen(p.cuerpo));
+        t += largo;
+    }
+    return t + "\r\n" + (p.cuerpo ? p.cuerpo : "");
+}
+
+static int conectar(uint16_t puerto) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in dir = {};
+    dir.sin_family = AF_INET;
+    dir.sin_port = htons(puerto);
+    dir.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int uno = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+    timeval espera = {10, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &espera, sizeof(espera));
+    if (connect(fd, (sockaddr *)&dir, sizeof(dir)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Lee una respuesta completa (cabeceras + Content-Length bytes) de buffer/fd
+static bool leerRespuesta(int fd, std::string &buffer, int &codigo, std::string &tipo, size_t &largo) {
+    size_t finCab;
+    while ((finCab = buffer.find("\r\n\r\n")) == std::string::npos) {
+        char buf[2048];
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) return false;
+        buffer.append(buf, n);
+    }
+    std::string cab = buffer.substr(0, finCab);
+    codigo = atoi(cab.c_str() + 9);
+    size_t p = cab.find("Content-Length: ");
+    largo = p == std::string::npos ? 0 : strtoul(cab.c_str() + p + 16, nullptr, 10);
+    p = cab.find("Content-Type: ");
+    tipo = p == std::string::npos ? "" : cab.substr(p + 14, cab.find("\r\n", p) - p - 14);
+    while (buffer.size() < finCab + 4 + largo) {
+        char buf[2048];
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) return false;
+        buffer.append(buf, n);
+    }
+    buffer.erase(0, finCab + 4 + largo);
+    return true;
+}
+
+static void verificar(const Pedido &p, bool leida, int codigo, const std::string &tipo) {
+    const Route *route = findRoute(p.url);
+    const char *esperado = route && route->api >= 0 ? "application/json" : route ? route->mime : "";
+    if (!leida || codigo != 200 || tipo != esperado) {
+        if (fallas++ < 5) {
+            printf("  FALLA: %s %s -> %s, código %d, tipo \"%s\"\n", p.metodo, p.url, leida ? "leída" : "sin respuesta",
+                   codigo, tipo.c_str());
+        }
+    }
+}
+
+// Un pedido por conexión (síncrono y async)
+static void clienteCierre(uint16_t puerto, std::vector<double> &latencias) {
+    for (int it = 0; it < ITERACIONES; it++) {
+        for (int grupo = 0; grupo < 2; grupo++) {
+            const Pedido *lista = grupo ? API : PAGINA;
+            int n = grupo ? 2 : 3;
+            for (int i = 0; i < n; i++) {
+                Reloj::time_point t0 = Reloj::now();
+                int fd = conectar(puerto);
+                std::string buffer;
+                int codigo = 0;
+                std::string tipo;
+                size_t largo;
+                bool leida = fd >= 0;
+                if (leida) {
+                    enviarTodo(fd, textoPedido(lista[i], false));
+                    leida = leerRespuesta(fd, buffer, codigo, tipo, largo);
+                    close(fd);
+                }
+                latencias.push_back(std::chrono::duration<double, std::milli>(Reloj::now() - t0).count());
+                verificar(lista[i], leida, codigo, tipo);
+            }
+        }
+    }
+}
+
+// Una conexión keep-alive: los 3 archivos de la página en pipeline
+static void clientePipelining(uint16_t puerto, std::vector<double> &latencias) {
+    int fd = conectar(puerto);
+    std::string buffer;
+    for (int it = 0; it < ITERACIONES && fd >= 0; it++) {
+        Reloj::time_point t0 = Reloj::now();
+        std::string juntos;
+        for (const Pedido &p : PAGINA) juntos += textoPedido(p, true);
+        enviarTodo(fd, juntos);
+        for (const Pedido &p : PAGINA) {  // Las respuestas llegan en orden
+            int codigo = 0;
+            std::string tipo;
+            size_t largo;
+            bool leida = leerRespuesta(fd, buffer, codigo, tipo, largo);
+            latencias.push_back(std::chrono::duration<double, std::milli>(Reloj::now() - t0).count());
+            verificar(p, leida, codigo, tipo);
+        }
+        for (const Pedido &p : API) {
+            t0 = Reloj::now();
+            enviarTodo(fd, textoPedido(p, true));
+            int codigo = 0;
+            std::string tipo;
+            size_t largo;
+            bool leida = leerRespuesta(fd, buffer, codigo, tipo, largo);
+            latencias.push_back(std::chrono::duration<double, std::milli>(Reloj::now() - t0).count());
+            verificar(p, leida, codigo, tipo);
+        }
+    }
+    if (fd >= 0) close(fd);
+}
+
+static double percentil(std::vector<double> &v, double p) {
+    std::sort(v.begin(), v.end());
+    return v.empty() ? 0 : v[std::min(v.size() - 1, (size_t)(p * v.size()))];
+}
+
+static void medir(Modo modo, int clientes, double &p50, double &p99, double &segundos) {
+    uint16_t puerto;
+    int escucha = escuchar(puerto);
+    std::atomic<bool> seguir(true);
+    std::thread servidor([&] {
+        if (modo == SINCRONO) servidorSincrono(escucha, seguir);
+        else servidorAsync(escucha, seguir, modo == PIPELINING);
+    });
+
+    std::vector<std::vector<double> > porCliente(clientes);
+    std::vector<std::thread> hilos;
+    Reloj::time_point t0 = Reloj::now();
+    for (int c = 0; c < clientes; c++) {
+        hilos.emplace_back([&, c] {
+            if (modo == PIPELINING) clientePipelining(puerto, porCliente[c]);
+            else clienteCierre(puerto, porCliente[c]);
+        });
+    }
+    for (std::thread &h : hilos) h.join();
+    segundos = std::chrono::duration<double>(Reloj::now() - t0).count();
+    seguir = false;
+    servidor.join();
+    close(escucha);
+
+    std::vector<double> todas;
+    for (const std::vector<double> &v : porCliente) todas.insert(todas.end(), v.begin(), v.end());
+    if (todas.size() != (size_t)clientes * ITERACIONES * 5) {
+        printf("  FALLA: %s con %d clientes: %zu de %d pedidos\n", NOMBRE_MODO[modo], clientes, todas.size(),
+               clientes * ITERACIONES * 5);
+        fallas++;
+    }
+    p50 = percentil(todas, 0.50);
+    p99 = percentil(todas, 0.99);
+}
+
+// Un pipeline contra el servidor del firmware (cierre): solo responde el
+// primero, los demás se descartan y hay que reintentarlos
+static void probarPipelineConCierre() {
+    uint16_t puerto;
+    int escucha = escuchar(puerto);
+    std::atomic<bool> seguir(true);
+    std::thread servidor([&] { servidorAsync(escucha, seguir, false); });
+    int fd = conectar(puerto);
+    std::string juntos;
+    for (const Pedido &p : PAGINA) juntos += textoPedido(p, true);
+    enviarTodo(fd, juntos);
+    std::string buffer;
+    int respondidos = 0, codigo;
+    std::string tipo;
+    size_t largo;
+    while (leerRespuesta(fd, buffer, codigo, tipo, largo)) respondidos++;
+    close(fd);
+    seguir = false;
+    servidor.join();
+    close(escucha);
+    printf("  Pipeline de 3 pedidos contra el modo async (firmware): %d respuesta(s) y cierre\n", respondidos);
+    if (respondidos != 1) {
+        printf("  FALLA: se esperaba responder solo el primer pedido\n");
+        fallas++;
+    }
+}
+
+int main() {
+    const char *archivosData[] = {"/index.html", "/style.css", "/script.js",
+                                  "/index.html.gz", "/style.css.gz", "/script.js.gz"};
+    for (const char *ruta : archivosData) {
+        if (!fs.cargar(ruta)) {
+            printf("No se encontró data%s: ejecutar desde la carpeta del proyecto, después de\n"
+                   "python3 tools/gzip_data.py && python3 tools/gen_route_table.py\n", ruta);
+            return 1;
+        }
+    }
+    archivos.cargar(fs);
+
+    printf("Latencia por pedido (ms), %d cargas de página + API por cliente:\n\n", ITERACIONES);
+    printf("  Clientes │ síncrono p50 / p99  │ async p50 / p99     │ pipelining p50 / p99\n");
+    printf("  ─────────┼─────────────────────┼─────────────────────┼─────────────────────\n");
+    static const int CLIENTES[] = {1, 2, 4, 8, 16, 32};
+    for (int clientes : CLIENTES) {
+        printf("  %8d", clientes);
+        for (int modo = SINCRONO; modo <= PIPELINING; modo++) {
+            double p50, p99, seg;
+            medir((Modo)modo, clientes, p50, p99, seg);
+            printf(" │ %7.2f / %9.2f", p50, p99);
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+    printf("\n");
+    probarPipelineConCierre();
+
+    printf("\n%s\n", fallas ? "FALLA: ver arriba" : "OK: todas las respuestas correctas y en orden");
+    return fallas ? 1 : 0;
+}
@@ -0,0 +1,170 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Verificación en la PC de src/oled_layout.h (no se compila con
+    PlatformIO)
+
+        g++ -O2 -std=c++11 -o comparar_layout_oled tools/comparar_layout_oled.cpp
+        ./comparar_layout_oled
+
+    Un display falso con la misma regla de anchos que u8g2 (getStrWidth
+    suma el avance de cada carácter y el ancho dibujado del último) y
+    fuentes inventadas con anchos irregulares. Para cada pantalla posible
+    (temperaturas de -40 a 125 °C en float y en punto fijo, nan, inf,
+    brillo 0-100, ON/OFF) dibuja con la versión anterior de updateOLED()
+    (getStrWidth() en cada valor) y con LayoutOled, y compara los dos
+    buffers bit por bit. También verifica que dibujar() no llame a
+    getStrWidth(). Devuelve 1 si algo falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "../src/oled_layout.h"
+#include "../src/punto_fijo.h"
+
+// Fuente falsa: alto y, por carácter ASCII 32-126, avance, ancho
+// dibujado y desplazamiento (como las fuentes de u8g2)
+struct FuenteFalsa {
+    uint8_t alto;
+    uint8_t avance[95], ancho[95], desplazamiento[95];
+};
+
+static uint32_t hash(uint32_t a, uint32_t b) {
+    uint32_t h = (a * 2654435761u) ^ (b * 40503u);
+    return h ^ (h >> 13);
+}
+
+// Monoespaciada (como 7x13) o proporcional (como helvB08), con la caja
+// de cada carácter distinta
+static void generarFuente(FuenteFalsa &f, uint8_t alto, bool mono, uint32_t semilla) {
+    f.alto = alto;
+    for (int i = 0; i < 95; i++) {
+        uint32_t h = hash(i + 32, semilla);
+        f.avance[i] = mono ? 7 : 4 + h % 5;
+        f.ancho[i] = i == 0 ? 0 : 1 + (h >> 4) % (f.avance[i] - 1);  // Espacio: sin píxeles
+        f.desplazamiento[i] = (h >> 8) % (f.avance[i] - f.ancho[i] + 1);
+    }
+}
+
+class DisplayFalso {
+public:
+    uint8_t buffer[128 * 8];
+    uint32_t medidas = 0;  // Llamadas a getStrWidth()
+
+    void clearBuffer() { memset(buffer, 0, sizeof(buffer)); }
+    void setFont(const uint8_t *fuente) { _f = (const FuenteFalsa *)fuente; }
+
+    // Regla de u8g2_string_width(): el último carácter cuenta su ancho
+    // dibujado + desplazamiento en lugar del avance (si tiene píxeles)
+    uint8_t getStrWidth(const char *s) {
+        medidas++;
+        int w = 0, dx = 0, ancho = 0, desp = 0;
+        for (; *s; s++) {
+            int i = *s - 32;
+            dx = _f->avance[i];
+            ancho = _f->ancho[i];
+            desp = _f->desplazamiento[i];
+            w += dx;
+        }
+        if (ancho != 0) w = w - dx + ancho + desp;
+        return (uint8_t)w;
+    }
+
+    void drawStr(int x, int y, const char *s) {
+        for (; *s; s++) {
+            int i = *s - 32;
+            for (int col = 0; col < _f->ancho[i]; col++) {
+                for (int fila = 0; fila < _f->alto; fila++) {
+                    if (hash(*s * 64 + col, fila) & 1) pixel(x + _f->desplazamiento[i] + col, y - fila);
+                }
+            }
+            x += _f->avance[i];
+        }
+    }
+
+private:
+    void pixel(int x, int y) {
+        if (x < 0 || x >= 128 || y < 0 || y >= 64) return;
+        buffer[(y / 8) * 128 + x] |= 1 << (y % 8);
+    }
+
+    const FuenteFalsa *_f = nullptr;
+};
+
+static FuenteFalsa fuenteValores, fuenteLogo;
+static DisplayFalso anterior, nuevo;
+static LayoutOled layout;
+static int fallas = 0;
+static uint32_t pantallas = 0;
+
+// updateOLED() antes de oled_layout.h
+static void dibujarAnterior(DisplayFalso &d, const char *temp, uint8_t brillo, bool encendido) {
+    d.clearBuffer();
+    d.setFont((const uint8_t *)&fuenteValores);
+    d.drawStr(0, 15, "Temp:");
+    d.drawStr(128 - d.getStrWidth(temp), 15, temp);
+    char brightnessStr[8];
+    snprintf(brightnessStr, sizeof(brightnessStr), "%u %%", brillo);
+    d.drawStr(0, 30, "Brillo LED:");
+    d.drawStr(128 - d.getStrWidth(brightnessStr), 30, brightnessStr);
+    const char *stateStr = encendido ? "ON" : "OFF";
+    d.drawStr(0, 45, "Estado:");
+    d.drawStr(128 - d.getStrWidth(stateStr), 45, stateStr);
+    d.setFont((const uint8_t *)&fuenteLogo);
+    int xUnse = (128 - d.getStrWidth("UNSE IoT")) / 2;
+    d.drawStr(xUnse, 62, "UNSE IoT");
+}
+
+static void comparar(const char *temp, uint8_t brillo, bool encendido) {
+    pantallas++;
+    dibujarAnterior(anterior, temp, brillo, encendido);
+    nuevo.medidas = 0;
+    layout.dibujar(nuevo, temp, brillo, encendido);
+    bool ok = memcmp(anterior.buffer, nuevo.buffer, sizeof(nuevo.buffer)) == 0 && nuevo.medidas == 0;
+    if (!ok && fallas++ < 5) {
+        printf("  FALLA: \"%s\", %u %%, %s (%u llamadas a getStrWidth)\n", temp, brillo, encendido ? "ON" : "OFF",
+               (unsigned)nuevo.medidas);
+    }
+}
+
+int main() {
+    for (uint32_t semilla = 1; semilla <= 3; semilla++) {
+        generarFuente(fuenteValores, 13, true, semilla);
+        generarFuente(fuenteLogo, 9, false, semilla + 100);
+        layout.iniciar(nuevo, (const uint8_t *)&fuenteValores, (const uint8_t *)&fuenteLogo);
+
+        char temp[16];
+        for (int decimas = -400; decimas <= 1250; decimas++) {
+            // Camino float: snprintf("%.1f C")
+            snprintf(temp, sizeof(temp), "%.1f C", decimas / 10.0f);
+            comparar(temp, 75, true);
+
+            // Camino PUNTO_FIJO: Q16::formatear() + " C"
+            size_t largo = Q16::desdeFloat(decimas / 10.0f + 0.04f).formatear(temp, sizeof(temp) - 2, 1);
+            memcpy(temp + largo, " C", 3);
+            comparar(temp, 75, true);
+        }
+        snprintf(temp, sizeof(temp), "%.1f C", (double)NAN);
+        comparar(temp, 75, true);
+        snprintf(temp, sizeof(temp), "%.1f C", (double)INFINITY);
+        comparar(temp, 75, true);
+
+        for (int brillo = 0; brillo <= 100; brillo++) {
+            comparar("25.3 C", brillo, true);
+            comparar("25.3 C", brillo, false);
+        }
+    }
+
+    printf("%u pantallas comparadas con 3 juegos de fuentes falsas\n", (unsigned)pantallas);
+    printf("\n%s\n", fallas ? "FALLA: las pantallas no coinciden" : "OK: pantallas idénticas bit por bit, sin getStrWidth() al dibujar");
+    return fallas ? 1 : 0;
+}
@@ -0,0 +1,385 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Polling contra Server-Sent Events en la PC: bytes y llamadas de red
+    por minuto con una pestaña abierta (no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o comparar_sse tools/comparar_sse.cpp
+        ./comparar_sse
+
+    Simula un minuto con el reloj de la tarea de red (tick de 20 ms) y
+    pasa todo por sockets TCP reales en 127.0.0.1, contando cada llamada
+    y cada byte de los dos lados:
+
+      polling   Lo que hace script.js sin SSE: GET /api/sensors y
+                GET /api/led cada 3 s. Cada pedido es una conexión nueva
+                (ESPAsyncWebServer cierra después de responder)
+      SSE       Una conexión a /api/stream que queda abierta. En cada tick
+                CambiosStream (src/cambios_stream.h, el mismo código que
+                updateStream()) decide qué eventos enviar
+
+    Las cabeceras son las de Chrome y las de ESPAsyncWebServer 1.2.3; los
+    JSON se arman con JsonWriter igual que en el firmware. Las llamadas
+    del servidor equivalen en el ESP32 a los eventos de lwIP que atiende
+    AsyncTCP (aceptar, recibir, tcp_write, cerrar). Los bytes en el cable
+    se estiman con 40 B de IP + TCP por segmento: 7 segmentos por
+    conexión (SYN, SYN-ACK, ACK y los dos FIN con su ACK) y 2 por cada
+    envío (datos y ACK).
+
+    Tres escenarios: temperatura estable, temperatura subiendo 3°C en el
+    minuto y el brillo del LED cambiando 10 veces (desde otra pestaña).
+    "Ver un cambio" es el tiempo hasta que la pestaña recibe el brillo
+    nuevo (con SSE llega en el mismo tick). Verifica que la pestaña
+    termine con el estado correcto en los dos modos, que SSE entregue
+    todos los cambios y que use menos bytes y llamadas; devuelve 1 si no.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+
+#include "../src/cambios_stream.h"
+#include "../src/json_writer.h"
+
+#define DURACION_MS    60000
+#define TICK_MS        20      // streamTickInterval
+#define POLL_MS        3000    // setInterval(update, 3000) en script.js
+#define HEARTBEAT_MS   15000   // streamHeartbeatInterval
+#define BYTES_SEGMENTO 40      // Cabecera IPv4 + TCP sin opciones
+
+static int fallas = 0;
+
+// --- Estado del "ESP32" ---
+
+struct Estado {
+    float temperatura;
+    bool encendido;
+    uint8_t brillo;
+};
+
+#define SENSORS_JSON(FIELD)                         \
+    FIELD(Fixed2, "temperature", e.temperatura)     \
+    FIELD(U32,    "timestamp",   ms)                \
+    FIELD(U32,    "uptime",      ms / 1000)         \
+    FIELD(U32,    "free_heap",   201344u)           \
+    FIELD(I32,    "wifi_rssi",   -57)
+
+#define LED_JSON(FIELD)                             \
+    FIELD(Bool,   "state",       e.encendido)       \
+    FIELD(U32,    "brightness",  e.brillo)          \
+    FIELD(U32,    "pwm_freq",    5000u)             \
+    FIELD(U32,    "pwm_bits",    8u)                \
+    FIELD(U32,    "pwm_levels",  256u)
+
+static std::string jsonSensores(const Estado &e, uint32_t ms) {
+    char body[JSON_MAX_LEN(SENSORS_JSON)];
+    JsonWriter json(body, sizeof(body));
+    SENSORS_JSON(JSON_WRITE_FIELD)
+    return std::string(body, json.finish());
+}
+
+static std::string jsonLed(const Estado &e, uint32_t ms) {
+    (void)ms;
+    char body[JSON_MAX_LEN(LED_JSON)];
+    JsonWriter json(body, sizeof(body));
+    LED_JSON(JSON_WRITE_FIELD)
+    return std::string(body, json.finish());
+}
+
+// Escenario: estado del ESP32 en cada instante
+typedef Estado (*Escenario)(uint32_t ms);
+
+static float ruido(uint32_t ms) {
+    return 0.03f * (float)((ms * 2654435761u) >> 16 & 0xFF) / 255.0f;
+}
+
+static Estado estable(uint32_t ms) {
+    return {24.0f + ruido(ms), true, 50};
+}
+
+static Estado subiendo(uint32_t ms) {
+    return {24.0f + 3.0f * ms / DURACION_MS + ruido(ms), true, 50};
+}
+
+// 10 cambios de brillo entre los 5 y los 50 s
+static Estado slider(uint32_t ms) {
+    uint32_t cambios = ms < 5000 ? 0 : std::min<uint32_t>(10, (ms - 5000) / 5000 + 1);
+    return {24.0f + ruido(ms), true, (uint8_t)(50 + 15 * cambios)};
+}
+
+// --- Sockets con contadores ---
+
+struct Contador {
+    uint32_t llamadas = 0;
+    uint32_t bytes = 0;      // Datos de aplicación, los dos sentidos
+    uint32_t conexiones = 0;
+    uint32_t envios = 0;     // send() con datos: un segmento + su ACK
+};
+
+static int escucha;
+static sockaddr_in direccion;
+
+static void abrirEscucha() {
+    escucha = socket(AF_INET, SOCK_STREAM, 0);
+    direccion = sockaddr_in();
+    direccion.sin_family = AF_INET;
+    direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(escucha, (sockaddr *)&direccion, sizeof(direccion));
+    listen(escucha, 4);
+    socklen_t largo = sizeof(direccion);
+    getsockname(escucha, (sockaddr *)&direccion, &largo);
+}
+
+// Navegador: socket() + connect(). Servidor: accept()
+static void conectar(int &cliente, int &servidor, Contador &nav, Contador &esp) {
+    cliente = socket(AF_INET, SOCK_STREAM, 0);
+    connect(cliente, (sockaddr *)&direccion, sizeof(direccion));
+    servidor = accept(escucha, nullptr, nullptr);
+    nav.llamadas += 2;
+    esp.llamadas += 1;
+    nav.conexiones++;
+}
+
+static void enviar(int fd, const std::string &datos, Contador &c) {
+    send(fd, datos.data(), datos.size(), MSG_NOSIGNAL);
+    c.llamadas++;
+    c.envios++;
+    c.bytes += datos.size();
+}
+
+// Lee lo que haya llegado. Con hastaCerrar sigue hasta el recv() que
+// devuelve 0 (el servidor cerró), como hace el navegador
+static std::string recibir(int fd, Contador &c, bool hastaCerrar) {
+    std::string datos;
+    char buf[4096];
+    for (;;) {
+        ssize_t n = recv(fd, buf, sizeof(buf), hastaCerrar ? 0 : MSG_DONTWAIT);
+        if (n < 0) break;
+        c.llamadas++;
+        if (n == 0) break;
+        datos.append(buf, n);
+        c.bytes += n;
+    }
+    return datos;
+}
+
+static void cerrar(int fd, Contador &c) {
+    close(fd);
+    c.llamadas++;
+}
+
+static const char *CABECERAS_CHROME =
+    " HTTP/1.1\r\n"
+    "Host: 192.168.1.50\r\n"
+    "Connection: keep-alive\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36\r\n"
+    "Accept: */*\r\n"
+    "Referer: http://192.168.1.50/\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Accept-Language: es-AR,es;q=0.9,en;q=0.8\r\n"
+    "\r\n";
+
+// Lo que la pestaña sabe del estado
+struct Pestania {
+    float temperatura = NAN;
+    int brillo = -1;
+    uint32_t retrasoTotal = 0, retrasoMaximo = 0, cambiosVistos = 0;
+    int brilloEsperado = -1;
+    uint32_t cambioDesde = 0;
+
+    void leer(const std::string &json, uint32_t ms) {
+        size_t p = json.find("\"temperature\":");
+        if (p != std::string::npos) temperatura = strtof(json.c_str() + p + 14, nullptr);
+        p = json.find("\"brightness\":");
+        if (p != std::string::npos) brillo = atoi(json.c_str() + p + 13);
+        if (brilloEsperado >= 0 && brillo == brilloEsperado) {  // Vio el cambio
+            uint32_t retraso = ms - cambioDesde;
+            retrasoTotal += retraso;
+            if (retraso > retrasoMaximo) retrasoMaximo = retraso;
+            cambiosVistos++;
+            brilloEsperado = -1;
+        }
+    }
+};
+
+struct Resultado {
+    Contador nav, esp;
+    Pestania pestania;
+    uint32_t cambios = 0;
+};
+
+// El brillo cambió en el ESP32: medir cuánto tarda en verlo la pestaña
+static void anotarCambio(Resultado &r, const Estado &antes, const Estado &ahora, uint32_t ms) {
+    if (ahora.brillo != antes.brillo) {
+        r.pestania.brilloEsperado = ahora.brillo;
+        r.pestania.cambioDesde = ms;
+        r.cambios++;
+    }
+}
+
+static void pedirPorHttp(const char *url, const std::string &json, Resultado &r, uint32_t ms) {
+    int cliente, servidor;
+    conectar(cliente, servidor, r.nav, r.esp);
+    enviar(cliente, std::string("GET ") + url + CABECERAS_CHROME, r.nav);
+    recibir(servidor, r.esp, false);  // onData: llegó el pedido
+
+    char cabeceras[160];
+    snprintf(cabeceras, sizeof(cabeceras),
+             "HTTP/1.1 200 OK\r\nContent-Length: %u\r\nContent-Type: application/json\r\n"
+             "Connection: close\r\nAccept-Ranges: none\r\n\r\n", (unsigned)json.size());
+    enviar(servidor, cabeceras + json, r.esp);
+    cerrar(servidor, r.esp);
+
+    std::string respuesta = recibir(cliente, r.nav, true);
+    cerrar(cliente, r.nav);
+    size_t cuerpo = respuesta.find("\r\n\r\n");
+    if (cuerpo != std::string::npos) r.pestania.leer(respuesta.substr(cuerpo + 4), ms);
+}
+
+static Resultado medirPolling(Escenario escenario) {
+    Resultado r;
+    Estado anterior = escenario(0);
+    for (uint32_t ms = 0; ms < DURACION_MS; ms += TICK_MS) {
+        Estado e = escenario(ms);
+        anotarCambio(r, anterior, e, ms);
+        anterior = e;
+        if (ms % POLL_MS == 0) {  // update(): dos fetch()
+            pedirPorHttp("/api/sensors", jsonSensores(e, ms), r, ms);
+            pedirPorHttp("/api/led", jsonLed(e, ms), r, ms);
+        }
+    }
+    return r;
+}
+
+// Formato de AsyncEventSource: id, event, data y una línea vacía
+static std::string eventoSse(const char *evento, const std::string &datos, uint32_t id) {
+    char linea[64];
+    snprintf(linea, sizeof(linea), "id: %u\r\nevent: %s\r\n", (unsigned)id, evento);
+    return linea + std::string("data: ") + datos + "\r\n\r\n";
+}
+
+static Resultado medirSse(Escenario escenario) {
+    Resultado r;
+    int cliente, servidor;
+    conectar(cliente, servidor, r.nav, r.esp);
+    enviar(cliente, std::string("GET /api/stream") + CABECERAS_CHROME, r.nav);
+    recibir(servidor, r.esp, false);
+
+    // handleStreamConnect(): cabeceras, "hola" con retry y el estado completo
+    Estado e = escenario(0);
+    enviar(servidor, "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n"
+                     "Connection: keep-alive\r\nAccept-Ranges: none\r\n\r\n", r.esp);
+    enviar(servidor, "retry: 3000\r\nid: 0\r\ndata: hola\r\n\r\n", r.esp);
+    enviar(servidor, eventoSse("sensors", jsonSensores(e, 0), 0), r.esp);
+    enviar(servidor, eventoSse("led", jsonLed(e, 0), 0), r.esp);
+
+    CambiosStream cambios(HEARTBEAT_MS);
+    std::string pendiente;
+    Estado anterior = e;
+    for (uint32_t ms = 0; ms < DURACION_MS; ms += TICK_MS) {
+        e = escenario(ms);
+        anotarCambio(r, anterior, e, ms);
+        anterior = e;
+
+        uint8_t enviarAhora = cambios.revisar(e.temperatura, e.encendido, e.brillo, ms);
+        if (enviarAhora & EVENTO_SENSORES) enviar(servidor, eventoSse("sensors", jsonSensores(e, ms), ms), r.esp);
+        if (enviarAhora & EVENTO_LED) enviar(servidor, eventoSse("led", jsonLed(e, ms), ms), r.esp);
+        if (ms && !enviarAhora) continue;
+
+        // El navegador se despierta solo cuando llegan datos
+        pendiente += recibir(cliente, r.nav, false);
+        size_t fin;
+        while ((fin = pendiente.find("\r\n\r\n")) != std::string::npos) {
+            std::string mensaje = pendiente.substr(0, fin);
+            pendiente.erase(0, fin + 4);
+            size_t datos = mensaje.find("data: {");
+            if (datos != std::string::npos) r.pestania.leer(mensaje.substr(datos + 6), ms);
+        }
+    }
+    cerrar(servidor, r.esp);
+    recibir(cliente, r.nav, true);
+    cerrar(cliente, r.nav);
+    return r;
+}
+
+static uint32_t bytesEnCable(const Resultado &r) {
+    uint32_t segmentos = 7 * r.nav.conexiones + 2 * (r.nav.envios + r.esp.envios);
+    return r.nav.bytes + r.esp.bytes + segmentos * BYTES_SEGMENTO;
+}
+
+static void imprimir(const char *modo, const Resultado &r) {
+    printf("  %-10s │ %5u │ %6u │ %7u │ %6u │ %9u │ ",
+           modo, r.nav.conexiones, r.nav.bytes + r.esp.bytes, bytesEnCable(r), r.esp.llamadas, r.nav.llamadas);
+    if (r.pestania.cambiosVistos) {
+        printf("%4u / %4u ms\n", r.pestania.retrasoTotal / r.pestania.cambiosVistos, r.pestania.retrasoMaximo);
+    } else {
+        printf("      -\n");
+    }
+}
+
+static void verificar(const char *nombre, Escenario escenario, const Resultado &polling, const Resultado &sse) {
+    const Resultado *modos[] = {&polling, &sse};
+    for (const Resultado *r : modos) {
+        const char *modo = r == &polling ? "polling" : "SSE";
+        // El polling ve el estado de la última consulta, SSE el del último tick
+        Estado final = escenario(r == &polling ? (DURACION_MS - 1) / POLL_MS * POLL_MS : DURACION_MS - TICK_MS);
+        if (r->pestania.brillo != final.brillo || fabsf(r->pestania.temperatura - final.temperatura) > 0.11f) {
+            printf("  FALLA: %s, %s: la pestaña terminó con %.2f°C / %d (real %.2f°C / %u)\n", nombre, modo,
+                   r->pestania.temperatura, r->pestania.brillo, final.temperatura, final.brillo);
+            fallas++;
+        }
+    }
+    if (sse.pestania.cambiosVistos != sse.cambios) {
+        printf("  FALLA: %s: SSE entregó %u de %u cambios de brillo\n", nombre, sse.pestania.cambiosVistos, sse.cambios);
+        fallas++;
+    }
+    if (bytesEnCable(sse) >= bytesEnCable(polling) || sse.esp.llamadas >= polling.esp.llamadas) {
+        printf("  FALLA: %s: SSE no usa menos bytes y llamadas que el polling\n", nombre);
+        fallas++;
+    }
+}
+
+int main() {
+    abrirEscucha();
+
+    struct {
+        const char *nombre;
+        Escenario escenario;
+    } escenarios[] = {
+        {"Temperatura estable", estable},
+        {"Temperatura subiendo 3°C", subiendo},
+        {"Brillo cambiando 10 veces", slider},
+    };
+
+    printf("Un minuto con una pestaña abierta (tick de red %d ms, polling cada %d s):\n", TICK_MS, POLL_MS / 1000);
+    for (auto &esc : escenarios) {
+        Resultado polling = medirPolling(esc.escenario);
+        Resultado sse = medirSse(esc.escenario);
+        printf("\n%s\n", esc.nombre);
+        printf("  Modo       │ Conex │ Bytes  │ B cable │ Llam.  │ Llam. PC  │ Ver un cambio\n");
+        printf("             │       │ datos  │ (est.)  │ ESP32  │ navegador │ (medio / máx)\n");
+        printf("  ───────────┼───────┼────────┼─────────┼────────┼───────────┼──────────────\n");
+        imprimir("polling", polling);
+        imprimir("SSE", sse);
+        printf("  SSE usa el %.0f%% de los bytes y el %.0f%% de las llamadas del ESP32\n",
+               100.0 * bytesEnCable(sse) / bytesEnCable(polling), 100.0 * sse.esp.llamadas / polling.esp.llamadas);
+        verificar(esc.nombre, esc.escenario, polling, sse);
+    }
+    close(escucha);
+
+    printf("\n%s\n", fallas ? "FALLA: ver arriba" : "OK: la pestaña ve el mismo estado con menos tráfico");
+    return fallas ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Prueba de estrés en la PC de src/cola_spsc.h y src/instantanea.h con
+    hilos de std::thread (no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -pthread -o estres_concurrencia tools/estres_concurrencia.cpp
+        ./estres_concurrencia
+
+    Con ThreadSanitizer (informa cualquier acceso concurrente sin
+    sincronizar y termina con código 66):
+
+        g++ -O1 -g -std=c++11 -fsanitize=thread -pthread -o estres_tsan tools/estres_concurrencia.cpp
+        ./estres_tsan
+
+    Mismo reparto que el dashboard con MULTITAREA:
+      - "sensores" envía lecturas numeradas por una cola SPSC
+      - "http" envía pedidos numerados por otra cola SPSC
+      - "control" es el único consumidor de las dos y el único escritor
+        de la instantánea
+      - "oled", "red" y "api" leen la instantánea sin parar
+
+    Cada estado publicado cumple relaciones entre sus campos (todos los
+    brillos iguales, temperatura y suma de control derivadas de los
+    contadores); una lectura mezclada de dos versiones las rompe. Se
+    verifica además que las colas no pierdan ni reordenen elementos y
+    que los lectores nunca vean el estado retroceder. Devuelve 1 si
+    alguna comprobación falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+
+#include "../src/cola_spsc.h"
+#include "../src/instantanea.h"
+
+#define LECTURAS  50000
+#define PEDIDOS   50000
+#define LECTORES  3
+
+struct Lectura {
+    uint32_t numero;
+    float temperatura;
+};
+
+struct Pedido {
+    uint32_t numero;
+    uint8_t brillo;
+};
+
+// Parecido a EstadoDashboard: varias palabras que tienen que cambiar juntas
+struct Estado {
+    uint32_t lecturas;
+    float temperatura;  // lecturas * 0.25 (exacto en float)
+    uint32_t pedidos;
+    uint8_t brillo[8];  // Todos = pedidos % 101
+    uint32_t control;   // Suma de control de lo anterior
+};
+
+static float temperaturaDe(uint32_t n) { return (n % 4096) * 0.25f; }
+
+static uint32_t sumaDe(const Estado &e) { return e.lecturas * 2654435761u ^ e.pedidos * 40503u ^ e.brillo[7]; }
+
+static ColaSpsc<Lectura, 4> colaLecturas;
+static ColaSpsc<Pedido, 16> colaPedidos;
+static Instantanea<Estado> estado;
+static std::atomic<bool> terminado(false);
+
+static std::atomic<uint32_t> fallas(0);
+static std::atomic<uint32_t> llenas(0);  // Envíos que encontraron la cola llena
+
+static void falla(const char *que) {
+    if (fallas.fetch_add(1) < 5) printf("  FALLA: %s\n", que);
+}
+
+static void sensores() {
+    for (uint32_t n = 1; n <= LECTURAS; n++) {
+        Lectura l = {n, temperaturaDe(n)};
+        // El firmware descarta si está llena; acá se reintenta para poder
+        // verificar que no se pierde nada de lo que entra
+        while (!colaLecturas.enviar(l)) {
+            llenas.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    }
+}
+
+static void http() {
+    for (uint32_t n = 1; n <= PEDIDOS; n++) {
+        Pedido p = {n, (uint8_t)(n % 101)};
+        while (!colaPedidos.enviar(p)) {
+            llenas.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    }
+}
+
+static void control() {
+    Estado e = {};
+    e.control = sumaDe(e);
+    estado.publicar(e);
+    while (e.lecturas < LECTURAS || e.pedidos < PEDIDOS) {
+        bool cambio = false;
+        Lectura l;
+        while (colaLecturas.recibir(l)) {
+            if (l.numero != e.lecturas + 1 || l.temperatura != temperaturaDe(l.numero)) falla("lectura perdida o alterada");
+            e.lecturas = l.numero;
+            e.temperatura = l.temperatura;
+            cambio = true;
+        }
+        Pedido p;
+        while (colaPedidos.recibir(p)) {
+            if (p.numero != e.pedidos + 1) falla("pedido perdido o fuera de orden");
+            e.pedidos = p.numero;
+            for (uint8_t &b : e.brillo) b = p.brillo;
+            cambio = true;
+        }
+        if (cambio) {
+            e.control = sumaDe(e);
+            estado.publicar(e);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    terminado = true;
+}
+
+struct Resultado {
+    uint64_t lecturas = 0;
+    uint64_t versiones = 0;  // Versiones distintas vistas
+};
+
+static void lector(Resultado *r) {
+    Estado anterior = {};
+    uint32_t versionAnterior = 0;
+    while (!terminado.load()) {
+        Estado e;
+        uint32_t version = estado.leer(e);
+        r->lecturas++;
+        if (version != versionAnterior) r->versiones++;
+
+        bool coherente = e.control == sumaDe(e) && e.temperatura == temperaturaDe(e.lecturas);
+        for (uint8_t b : e.brillo) coherente &= b == e.pedidos % 101;
+        if (!coherente) falla("instantánea mezclada de dos versiones");
+        if (version < versionAnterior || e.lecturas < anterior.lecturas || e.pedidos < anterior.pedidos) {
+            falla("el estado retrocedió");
+        }
+        anterior = e;
+        versionAnterior = version;
+        std::this_thread::yield();  // Como en el firmware, los lectores no acaparan el procesador
+    }
+}
+
+int main() {
+    Resultado resultados[LECTORES];
+    std::thread lectores[LECTORES];
+    for (int i = 0; i < LECTORES; i++) lectores[i] = std::thread(lector, &resultados[i]);
+    std::thread tControl(control), tSensores(sensores), tHttp(http);
+
+    tSensores.join();
+    tHttp.join();
+    tControl.join();
+    for (std::thread &t : lectores) t.join();
+
+    Estado final;
+    uint32_t versiones = estado.leer(final);
+    printf("%u lecturas y %u pedidos por colas SPSC (%u envíos con la cola llena, reintentados)\n",
+           final.lecturas, final.pedidos, llenas.load());
+    printf("%u versiones publicadas en la instantánea\n", versiones);
+    const char *nombres[LECTORES] = {"oled", "red", "api"};
+    for (int i = 0; i < LECTORES; i++) {
+        printf("  Lector %-4s: %8llu lecturas, %7llu versiones distintas vistas\n", nombres[i],
+               (unsigned long long)resultados[i].lecturas, (unsigned long long)resultados[i].versiones);
+    }
+
+    if (final.lecturas != LECTURAS || final.pedidos != PEDIDOS) falla("no llegaron todos los elementos");
+    printf("\n%s\n", fallas ? "FALLA: revisar los mensajes anteriores"
+                            : "OK: sin pérdidas, sin reordenamientos y sin instantáneas mezcladas");
+    return fallas ? 1 : 0;
+}
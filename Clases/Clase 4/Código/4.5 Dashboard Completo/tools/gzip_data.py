@@ -0,0 +1,63 @@
+"""
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Script de PlatformIO (extra_scripts = pre:tools/gzip_data.py)
+
+    Antes de compilar o de generar la imagen LittleFS (uploadfs) crea una
+    copia comprimida <archivo>.gz de cada archivo web de data/. El firmware
+    sirve la variante .gz a los navegadores que envían
+    "Accept-Encoding: gzip" y el original al resto.
+
+    La compresión es determinística (mtime=0): el mismo archivo fuente
+    produce siempre el mismo .gz, así la imagen LittleFS no cambia si no
+    se editó el contenido web.
+
+    Fuera de PlatformIO (herramientas de tools/ en la PC):
+        python3 tools/gzip_data.py
+
+    Copia idéntica en 4.5 Dashboard Completo y en Final: cada carpeta es
+    un proyecto de PlatformIO independiente. Un cambio va en las dos;
+    python3 Clases/verificar_copias.py avisa si quedaron distintas.
+
+    ─────────────────────────────────────────────────────────────────────
+"""
+
+import gzip
+import os
+
+# Extensiones que vale la pena comprimir (las imágenes ya vienen comprimidas)
+COMPRIMIBLES = (".html", ".css", ".js", ".json", ".svg", ".txt", ".ico")
+
+try:
+    Import("env")  # noqa: F821 (lo inyecta PlatformIO/SCons)
+    data_dir = env.subst("$PROJECT_DATA_DIR")  # noqa: F821
+except NameError:  # Ejecutado con python3 desde la carpeta del proyecto
+    data_dir = os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "data")
+
+for nombre in sorted(os.listdir(data_dir)):
+    origen = os.path.join(data_dir, nombre)
+    if not os.path.isfile(origen) or not nombre.endswith(COMPRIMIBLES):
+        continue
+
+    destino = origen + ".gz"
+    if os.path.exists(destino) and os.path.getmtime(destino) >= os.path.getmtime(origen):
+        continue  # Ya está actualizado
+
+    with open(origen, "rb") as f:
+        crudo = f.read()
+    comprimido = gzip.compress(crudo, compresslevel=9, mtime=0)
+
+    # Si no se gana nada no se genera la variante .gz
+    if len(comprimido) >= len(crudo):
+        if os.path.exists(destino):
+            os.remove(destino)
+        continue
+
+    with open(destino, "wb") as f:
+        f.write(comprimido)
+    print("gzip: %s %d -> %d bytes" % (nombre, len(crudo), len(comprimido)))
@@ -0,0 +1,595 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Latencia de ida y vuelta del canal WebSocket del LED en la PC, con
+    hilos y sockets reales (no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -pthread -o latencia_ws tools/latencia_ws.cpp
+        ./latencia_ws
+
+    Mismo camino que en el ESP32 con MULTITAREA, cada parte en su hilo:
+
+      navegador   Envía tramas binarias [0x02, brillo] enmascaradas
+                  (RFC 6455) como script.js al mover el slider, y lee el
+                  evento SSE "led" en otra conexión
+      async_tcp   Arma las tramas y hace lo mismo que handleWsEvent():
+                  valida, comandoDeTrama() (src/actuadores.h), deja el
+                  brillo en el buzón UltimoValor (el toggle va por la
+                  ColaSpsc) y despierta al control
+      control     Lo de controlar(): vacía la cola, toma el buzón,
+                  aplicar() (ledcWrite) y publica la Instantanea
+      red         Tick de 20 ms con CambiosStream (updateStream())
+
+    Un arrastre del slider son 100 movimientos (brillo 1 a 100) a 10, 60
+    y 200 por segundo y sin pausa (ráfaga). Para cada valor mide trama -> ledcWrite
+    y trama -> evento SSE en la pestaña (p50/p99); los valores que el
+    control combinó con uno posterior no llegan a escribirse y se cuentan
+    aparte. La conexión WebSocket ya está abierta (el handshake queda
+    fuera de la medición). Los tiempos son de la PC: muestran la forma
+    del camino (despertar al control enseguida, SSE en el tick de 20 ms),
+    no los microsegundos del ESP32.
+
+    Verifica que el PWM y la pestaña terminen en el último brillo
+    enviado (también en ráfaga, más rápida que el control), y sin hilos
+    que 10 brillos y dos toggles recibidos antes de que corra el control
+    salgan al LEDC en una sola escritura con el último valor, y que un
+    toggle después de un brillo se aplique en ese orden. Si ledcSetup()
+    rechaza una frecuencia, aplicar() no escribe y vuelve a la anterior.
+    Con tramas y
+    POST al azar verifica además que el estado previsto (con el que
+    responden los POST sin esperar a controlar()) sea el que se aplica:
+    primero sin hilos y después con AsyncTCP encolando en su propio hilo
+    mientras controlar() corre en otro, desalojado a propósito entre la
+    cola y el buzón (pausaUs), que es donde un brillo puede adelantarse
+    a un toggle encolado antes. Devuelve 1 si algo falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/actuadores.h"
+#include "../src/cambios_stream.h"
+#include "../src/cola_spsc.h"
+#include "../src/instantanea.h"
+
+#define MOVIMIENTOS 100
+#define RED_TICK_MS 20   // streamTickInterval
+#define WS_BINARY   0x02
+
+static int fallas = 0;
+
+typedef std::chrono::steady_clock Reloj;
+static Reloj::time_point inicio = Reloj::now();
+
+static double msAhora() {
+    return std::chrono::duration<double, std::milli>(Reloj::now() - inicio).count();
+}
+
+// --- LEDC de la PC ---
+
+static std::atomic<uint32_t> escriturasLedc(0);
+static std::atomic<uint32_t> ultimoDuty(0);
+
+static bool ledcRechaza = false;  // ledcSetup() devuelve 0, como con el divisor fuera de rango
+
+double ledcSetup(uint8_t, double frecuencia, uint8_t) { return ledcRechaza ? 0 : frecuencia; }
+void ledcAttachPin(uint8_t, uint8_t) {}
+void ledcWrite(uint8_t, uint32_t duty) {
+    escriturasLedc++;
+    ultimoDuty = duty;
+}
+
+// --- Lo que comparten las tareas (igual que en main.cpp) ---
+
+struct PedidoControl {
+    uint32_t frecuencia;
+    uint8_t cantidad;
+    ComandoActuador comandos[ACTUADORES_MAX * 4];
+};
+
+struct EstadoDashboard {
+    float temperatura;
+    uint32_t frecuencia;
+    uint32_t encendidos;
+    uint8_t brillo[ACTUADORES_MAX];
+    uint8_t bits;
+    uint8_t niveles;
+};
+
+// xTaskNotifyGive() / ulTaskNotifyTake(pdTRUE, ...)
+class Notificacion {
+public:
+    void dar() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cuenta++;
+        _cv.notify_one();
+    }
+    bool tomar(uint32_t esperaMs) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait_for(lock, std::chrono::milliseconds(esperaMs), [this] { return _cuenta > 0; });
+        bool habia = _cuenta > 0;
+        _cuenta = 0;
+        return habia;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    uint32_t _cuenta = 0;
+};
+
+struct Dashboard {
+    Actuadores actuadores;
+    uint8_t ledPrincipal = 0;
+    ColaSpsc<PedidoControl, 16> colaPedidos;
+    UltimoValor brilloSlider;
+    Instantanea<EstadoDashboard> estado;
+    Notificacion control;
+    EstadoDashboard previsto;
+    uint32_t pedidosAplicados = 0;  // Solo para las verificaciones
+    std::atomic<uint32_t> corridasControl{0};
+    uint32_t pausaUs = 0;  // Desalojo del control después de mirar la cola
+
+    // Brillo escrito al LEDC -> instante (para la latencia)
+    double aplicado[MOVIMIENTOS + 1];
+
+    Dashboard() {
+        actuadores.configurarPwm(5000);
+        ledPrincipal = actuadores.agregar(2, false, CURVA_GAMMA);
+        actuadores.aplicar();
+        std::fill(aplicado, aplicado + MOVIMIENTOS + 1, -1.0);
+        publicarEstado();
+        estado.leer(previsto);
+    }
+
+    void publicarEstado() {
+        EstadoDashboard e;
+        memset(&e, 0, sizeof(e));
+        e.frecuencia = actuadores.frecuencia();
+        e.bits = actuadores.bits();
+        e.niveles = actuadores.niveles();
+        for (uint8_t id = 0; id < actuadores.cantidad(); id++) {
+            e.brillo[id] = actuadores.brillo(id);
+            if (actuadores.encendido(id)) e.encendidos |= 1u << id;
+        }
+        estado.publicar(e);
+    }
+
+    // prever() y enviarPedido()
+    void prever(const PedidoControl &pedido) {
+        if (pedido.frecuencia) {
+            previsto.frecuencia = pedido.frecuencia;
+            previsto.bits = bitsParaFrecuencia(pedido.frecuencia);
+            previsto.niveles = nivelesDistintos(tablaGammaPorcentaje(previsto.bits));
+        }
+        for (uint8_t i = 0; i < pedido.cantidad; i++) {
+            aplicarAEstado(pedido.comandos[i], previsto.brillo, previsto.encendidos);
+        }
+    }
+
+    bool enviarPedido(const PedidoControl &pedido) {
+        if (!colaPedidos.enviar(pedido)) return false;
+        prever(pedido);
+        control.dar();
+        return true;
+    }
+
+    // handleWsEvent() con WS_EVT_DATA
+    void alRecibirTrama(bool final, uint64_t index, uint64_t largoTrama, uint8_t opcode, uint8_t *data, size_t len) {
+        if (!final || index != 0 || largoTrama != 2 || opcode != WS_BINARY) return;
+        ComandoActuador comando;
+        if (!comandoDeTrama(data, len, ledPrincipal, comando)) return;
+        if (comando.op == OP_BRILLO) {
+            brilloSlider.dejar(comando.valor, colaPedidos.escritos());
+            aplicarAEstado(comando, previsto.brillo, previsto.encendidos);
+            control.dar();
+            return;
+        }
+        PedidoControl pedido;
+        memset(&pedido, 0, sizeof(pedido));
+        pedido.comandos[pedido.cantidad++] = comando;
+        enviarPedido(pedido);
+    }
+
+    // controlar()
+    void controlar() {
+        corridasControl++;
+        bool cambio = false;
+        PedidoControl pedido;
+        uint8_t brillo;
+        for (;;) {
+            uint32_t indice = colaPedidos.leidos();
+            bool hayPedido = colaPedidos.recibir(pedido);
+            if (pausaUs) std::this_thread::sleep_for(std::chrono::microseconds(pausaUs));
+            if (brilloSlider.tomarHasta(indice, brillo)) {
+                actuadores.fijarBrillo(ledPrincipal, brillo);
+                cambio = true;
+            }
+            if (!hayPedido) break;
+            if (pedido.frecuencia) actuadores.configurarPwm(pedido.frecuencia);
+            actuadores.ejecutarLote(pedido.comandos, pedido.cantidad);
+            pedidosAplicados++;
+            cambio = true;
+        }
+        if (actuadores.aplicar() & (1u << ledPrincipal)) {
+            uint8_t escrito = actuadores.brillo(ledPrincipal);
+            if (escrito <= MOVIMIENTOS && aplicado[escrito] < 0) aplicado[escrito] = msAhora();
+        }
+        if (cambio) publicarEstado();
+    }
+};
+
+// --- Sockets ---
+
+static void parDeSockets(int &cliente, int &servidor) {
+    int escucha = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in dir = {};
+    dir.sin_family = AF_INET;
+    dir.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(escucha, (sockaddr *)&dir, sizeof(dir));
+    listen(escucha, 1);
+    socklen_t largo = sizeof(dir);
+    getsockname(escucha, (sockaddr *)&dir, &largo);
+    cliente = socket(AF_INET, SOCK_STREAM, 0);
+    int uno = 1;
+    setsockopt(cliente, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+    connect(cliente, (sockaddr *)&dir, sizeof(dir));
+    servidor = accept(escucha, nullptr, nullptr);
+    setsockopt(servidor, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+    close(escucha);
+}
+
+static bool leerExacto(int fd, uint8_t *buf, size_t n) {
+    while (n) {
+        ssize_t r = recv(fd, buf, n, 0);
+        if (r <= 0) return false;
+        buf += r;
+        n -= r;
+    }
+    return true;
+}
+
+// Trama del navegador: FIN + binaria, con máscara (cliente -> servidor)
+static void enviarTrama(int fd, uint8_t op, uint8_t valor) {
+    uint8_t mascara[4] = {(uint8_t)rand(), (uint8_t)rand(), (uint8_t)rand(), (uint8_t)rand()};
+    uint8_t trama[8] = {0x80 | WS_BINARY, 0x80 | 2, mascara[0], mascara[1], mascara[2], mascara[3],
+                        (uint8_t)(op ^ mascara[0]), (uint8_t)(valor ^ mascara[1])};
+    send(fd, trama, sizeof(trama), MSG_NOSIGNAL);
+}
+
+// Tarea de AsyncTCP: arma cada trama y llama al handler
+static void tareaAsyncTcp(Dashboard &d, int fd) {
+    uint8_t cabecera[2];
+    while (leerExacto(fd, cabecera, 2)) {
+        bool final = cabecera[0] & 0x80;
+        uint8_t opcode = cabecera[0] & 0x0F;
+        uint8_t largo = cabecera[1] & 0x7F;  // El slider nunca pasa de 125 bytes
+        uint8_t mascara[4] = {0, 0, 0, 0};
+        if (cabecera[1] & 0x80 && !leerExacto(fd, mascara, 4)) return;
+        uint8_t datos[125];
+        if (!leerExacto(fd, datos, largo)) return;
+        for (uint8_t i = 0; i < largo; i++) datos[i] ^= mascara[i % 4];
+        d.alRecibirTrama(final, 0, largo, opcode, datos, largo);
+    }
+}
+
+static void tareaControl(Dashboard &d, std::atomic<bool> &seguir) {
+    while (seguir) {
+        d.control.tomar(1000);  // controlInterval: respaldo si nadie despierta
+        d.controlar();
+    }
+}
+
+static void tareaRed(Dashboard &d, int fd, std::atomic<bool> &seguir) {
+    CambiosStream cambios(15000);
+    while (seguir) {
+        EstadoDashboard e;
+        d.estado.leer(e);
+        uint8_t brillo = e.brillo[d.ledPrincipal];
+        if (cambios.revisar(25.0f, e.encendidos & 1, brillo, (uint32_t)msAhora()) & EVENTO_LED) {
+            char evento[96];
+            int n = snprintf(evento, sizeof(evento), "event: led\r\ndata: {\"state\":%s,\"brightness\":%u}\r\n\r\n",
+                             e.encendidos & 1 ? "true" : "false", brillo);
+            send(fd, evento, n, MSG_NOSIGNAL);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(RED_TICK_MS));
+    }
+}
+
+// Pestaña: instante en que el evento SSE trae cada brillo
+static void lectorSse(int fd, double *confirmado, std::atomic<int> &ultimo) {
+    std::string pendiente;
+    char buf[1024];
+    ssize_t n;
+    while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+        pendiente.append(buf, n);
+        size_t fin;
+        while ((fin = pendiente.find("\r\n\r\n")) != std::string::npos) {
+            size_t p = pendiente.find("\"brightness\":");
+            if (p < fin) {
+                int brillo = atoi(pendiente.c_str() + p + 13);
+                if (brillo <= MOVIMIENTOS && confirmado[brillo] < 0) confirmado[brillo] = msAhora();
+                ultimo = brillo;
+            }
+            pendiente.erase(0, fin + 4);
+        }
+    }
+}
+
+static double percentil(std::vector<double> v, double p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, (size_t)(p * v.size()))];
+}
+
+// Un arrastre del slider a "porSegundo" movimientos (0 = ráfaga)
+static void arrastre(const char *nombre, uint32_t porSegundo) {
+    Dashboard d;
+    int wsCliente, wsServidor, sseCliente, sseServidor;
+    parDeSockets(wsCliente, wsServidor);
+    parDeSockets(sseCliente, sseServidor);
+
+    std::atomic<bool> seguir(true);
+    double enviado[MOVIMIENTOS + 1], confirmado[MOVIMIENTOS + 1];
+    std::fill(confirmado, confirmado + MOVIMIENTOS + 1, -1.0);
+    std::atomic<int> ultimoSse(-1);
+    uint32_t escriturasAntes = escriturasLedc;
+
+    std::thread asyncTcp(tareaAsyncTcp, std::ref(d), wsServidor);
+    std::thread control(tareaControl, std::ref(d), std::ref(seguir));
+    std::thread red(tareaRed, std::ref(d), sseServidor, std::ref(seguir));
+    std::thread pestania(lectorSse, sseCliente, confirmado, std::ref(ultimoSse));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  // Estado inicial por SSE
+
+    for (int brillo = 1; brillo <= MOVIMIENTOS; brillo++) {
+        enviado[brillo] = msAhora();
+        enviarTrama(wsCliente, OP_BRILLO, brillo);
+        if (porSegundo) std::this_thread::sleep_for(std::chrono::microseconds(1000000 / porSegundo));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(3 * RED_TICK_MS));
+
+    seguir = false;
+    shutdown(wsCliente, SHUT_RDWR);
+    shutdown(sseServidor, SHUT_RDWR);
+    asyncTcp.join();
+    control.join();
+    red.join();
+    pestania.join();
+    close(wsCliente);
+    close(wsServidor);
+    close(sseCliente);
+    close(sseServidor);
+
+    std::vector<double> aPwm, aPestania;
+    int combinados = 0;
+    for (int brillo = 1; brillo <= MOVIMIENTOS; brillo++) {
+        if (d.aplicado[brillo] >= 0) aPwm.push_back(d.aplicado[brillo] - enviado[brillo]);
+        else combinados++;
+        if (confirmado[brillo] >= 0) aPestania.push_back(confirmado[brillo] - enviado[brillo]);
+    }
+    printf("  %-9s │ %6u │ %5u │ %6d │ %6.3f / %6.3f │ %5.1f / %5.1f\n", nombre, d.corridasControl.load(),
+           escriturasLedc - escriturasAntes, combinados, percentil(aPwm, 0.5), percentil(aPwm, 0.99),
+           percentil(aPestania, 0.5), percentil(aPestania, 0.99));
+
+    EstadoDashboard e;
+    d.estado.leer(e);
+    if (e.brillo[d.ledPrincipal] != MOVIMIENTOS || ultimoSse != MOVIMIENTOS) {
+        printf("  FALLA: %s: PWM en %u, pestaña en %d (se esperaba %d)\n", nombre, e.brillo[d.ledPrincipal],
+               ultimoSse.load(), MOVIMIENTOS);
+        fallas++;
+    }
+}
+
+// Sin hilos: 10 tramas antes de que corra el control
+static void probarCombinacion() {
+    Dashboard d;
+    uint32_t antes = escriturasLedc;
+    for (uint8_t brillo = 10; brillo <= 100; brillo += 10) {
+        uint8_t trama[2] = {OP_BRILLO, brillo};
+        d.alRecibirTrama(true, 0, 2, WS_BINARY, trama, 2);
+    }
+    uint8_t alternar[2] = {OP_ALTERNAR, 0};
+    d.alRecibirTrama(true, 0, 2, WS_BINARY, alternar, 2);
+    d.alRecibirTrama(true, 0, 2, WS_BINARY, alternar, 2);  // Dos toggles se anulan
+    uint8_t invalida[3] = {OP_BRILLO, 50, 0};
+    d.alRecibirTrama(true, 0, 3, WS_BINARY, invalida, 3);  // Se ignora
+    uint8_t texto[2] = {OP_BRILLO, 20};
+    d.alRecibirTrama(true, 0, 2, 0x01, texto, 2);  // Trama de texto: se ignora
+    d.controlar();
+
+    uint32_t escrituras = escriturasLedc - antes;
+    const uint16_t *gamma = tablaGammaPorcentaje(d.actuadores.bits());
+    printf("\n  10 brillos y 2 toggles antes del tick: %u pedidos en cola, %u ledcWrite, brillo %u\n",
+           d.pedidosAplicados, escrituras, d.actuadores.brillo(d.ledPrincipal));
+    if (d.pedidosAplicados != 2 || escrituras != 1 || d.actuadores.brillo(d.ledPrincipal) != 100 ||
+        !d.actuadores.encendido(d.ledPrincipal) || ultimoDuty != gamma[100]) {
+        printf("  FALLA: se esperaba una sola escritura con el último brillo (100) y el LED encendido\n");
+        fallas++;
+    }
+
+    // Brillo y después toggle: tiene que quedar apagado con ese brillo
+    uint8_t brillo40[2] = {OP_BRILLO, 40};
+    d.alRecibirTrama(true, 0, 2, WS_BINARY, brillo40, 2);
+    d.alRecibirTrama(true, 0, 2, WS_BINARY, alternar, 2);
+    d.controlar();
+    printf("  Brillo 40 y toggle: brillo %u, %s\n", d.actuadores.brillo(d.ledPrincipal),
+           d.actuadores.encendido(d.ledPrincipal) ? "encendido" : "apagado");
+    if (d.actuadores.brillo(d.ledPrincipal) != 40 || d.actuadores.encendido(d.ledPrincipal)) {
+        printf("  FALLA: el toggle se aplicó antes que el brillo\n");
+        fallas++;
+    }
+}
+
+// ledcSetup() que falla: aplicar() no escribe y vuelve a la frecuencia anterior
+static void probarLedcRechazado() {
+    Actuadores a;
+    a.configurarPwm(5000);
+    uint8_t led = a.agregar(2, false, CURVA_GAMMA);
+    a.aplicar();
+    a.configurarPwm(19500);
+    ledcRechaza = true;
+    uint32_t escritos = a.aplicar();
+    ledcRechaza = false;
+    bool restaurado = escritos == 0 && a.fallasPwm() == 1 && a.frecuencia() == 5000 && a.bits() == 13;
+    escritos = a.aplicar();
+    printf("\n  ledcSetup() rechaza 19500 Hz: queda en %u Hz / %u bits, el tick siguiente escribe 0x%x\n",
+           (unsigned)a.frecuencia(), a.bits(), (unsigned)escritos);
+    if (!restaurado || escritos != (1u << led) || bitsParaFrecuencia(4) != 0 || bitsParaFrecuencia(5) != 14) {
+        printf("  FALLA: se esperaba volver a 5000 Hz sin escribir duty en la escala rechazada\n");
+        fallas++;
+    }
+}
+
+// Tres actuadores (el LED y dos más) con el estado previsto al día
+static void prepararPrevisto(Dashboard &d) {
+    for (uint8_t i = 0; i < 2; i++) d.actuadores.agregar(3 + i, false, CURVA_LINEAL);
+    d.actuadores.aplicar();
+    d.publicarEstado();
+    d.estado.leer(d.previsto);
+}
+
+// Lo que hace la tarea de AsyncTCP: una trama del slider (brillo o
+// toggle) o un POST /api/actuators o /api/led, al azar. false si el
+// pedido se descartó por cola llena
+static bool pedidoAlAzar(Dashboard &d, int r) {
+    if (r < 4) {
+        uint8_t trama[2] = {OP_BRILLO, (uint8_t)(rand() % 101)};
+        d.alRecibirTrama(true, 0, 2, WS_BINARY, trama, 2);
+    } else if (r < 5) {
+        uint8_t trama[2] = {OP_ALTERNAR, 0};
+        d.alRecibirTrama(true, 0, 2, WS_BINARY, trama, 2);
+    } else {
+        PedidoControl pedido;
+        memset(&pedido, 0, sizeof(pedido));
+        pedido.cantidad = 1 + rand() % 3;
+        for (uint8_t c = 0; c < pedido.cantidad; c++) {
+            OpActuador op = (OpActuador)(OP_ALTERNAR + rand() % 3);
+            uint8_t valor = op == OP_BRILLO ? rand() % 101 : op == OP_ESTADO ? rand() % 2 : 0;
+            pedido.comandos[c] = {(uint8_t)(rand() % d.actuadores.cantidad()), op, valor};
+        }
+        if (rand() % 8 == 0) pedido.frecuencia = rand() % 2 ? 5000 : 1000;
+        return d.enviarPedido(pedido);
+    }
+    return true;
+}
+
+static bool coincidePrevisto(Dashboard &d) {
+    EstadoDashboard e;
+    d.estado.leer(e);
+    return e.encendidos == d.previsto.encendidos && !memcmp(e.brillo, d.previsto.brillo, sizeof(e.brillo)) &&
+           e.frecuencia == d.previsto.frecuencia && e.bits == d.previsto.bits && e.niveles == d.previsto.niveles;
+}
+
+// Sin hilos: tramas del WebSocket y POST al azar, con controlar() en
+// momentos al azar (a veces con la cola llena). Lo que responde un POST
+// (previsto) tiene que ser lo que controlar() termina aplicando
+static void probarPrevisto() {
+    Dashboard d;
+    prepararPrevisto(d);
+
+    srand(1);
+    int descartados = 0, diferencias = 0;
+    for (int paso = 0; paso < 20000; paso++) {
+        int r = rand() % 10;
+        if (r < 7) {
+            if (!pedidoAlAzar(d, r)) descartados++;
+        } else if (r < 8) {
+            d.controlar();
+        }
+        if (paso % 1000 == 999) {  // Sin nada en vuelo: tienen que coincidir
+            d.controlar();
+            if (!coincidePrevisto(d)) diferencias++;
+        }
+    }
+    printf("  20000 tramas y POST al azar (%d descartados por cola llena): previsto %s el estado aplicado\n",
+           descartados, diferencias ? "NO coincide con" : "coincide con");
+    if (diferencias) {
+        printf("  FALLA: %d de 20 comparaciones distintas\n", diferencias);
+        fallas++;
+    }
+}
+
+// Con hilos, como con MULTITAREA: AsyncTCP encola en un hilo mientras
+// controlar() corre en otro, sin pausas entre uno y otro. Cada tanto
+// AsyncTCP deja de enviar, espera dos corridas completas del control y
+// compara lo aplicado con lo previsto. Un brillo aplicado fuera de orden
+// respecto de un toggle o un POST deja el LED en otro estado
+static void probarPrevistoConHilos() {
+    Dashboard d;
+    prepararPrevisto(d);
+
+    std::atomic<bool> seguir(true);
+    std::atomic<uint32_t> completas(0);  // Corridas de controlar() terminadas
+    d.pausaUs = 50;
+    std::thread control([&] {
+        while (seguir) {
+            d.controlar();
+            completas++;
+            std::this_thread::yield();
+        }
+    });
+
+    srand(2);
+    int descartados = 0, diferencias = 0, comparaciones = 0;
+    for (int paso = 0; paso < 20000; paso++) {
+        if (!pedidoAlAzar(d, rand() % 7)) descartados++;
+        if (rand() % 16 == 0) {  // Sin nada en vuelo: tienen que coincidir
+            uint32_t corridas = completas;
+            while (completas < corridas + 2) std::this_thread::yield();  // La segunda empezó después
+            comparaciones++;
+            if (!coincidePrevisto(d)) {
+                diferencias++;
+                d.estado.leer(d.previsto);  // Seguir desde lo aplicado
+            }
+        }
+    }
+    seguir = false;
+    control.join();
+
+    printf("  20000 tramas y POST desde otro hilo (%d descartados por cola llena): previsto %s el estado aplicado\n",
+           descartados, diferencias ? "NO coincide con" : "coincide con");
+    if (diferencias) {
+        printf("  FALLA: %d de %d comparaciones distintas (brillo aplicado fuera de orden)\n", diferencias,
+               comparaciones);
+        fallas++;
+    }
+}
+
+int main() {
+    printf("Arrastre del slider: %d tramas [0x02, brillo] por WebSocket\n\n", MOVIMIENTOS);
+    printf("  Ritmo     │ Control│ ledc  │ Combi- │ Trama->PWM ms   │ Trama->SSE ms\n");
+    printf("            │ corrió │ Write │ nados  │  p50  /  p99    │  p50  /  p99\n");
+    printf("  ──────────┼────────┼───────┼────────┼─────────────────┼──────────────\n");
+    arrastre("10/s", 10);
+    arrastre("60/s", 60);
+    arrastre("200/s", 200);
+    arrastre("sin pausa", 0);
+    probarCombinacion();
+    probarLedcRechazado();
+    probarPrevisto();
+    probarPrevistoConHilos();
+
+    printf("\n%s\n", fallas ? "FALLA: ver arriba" : "OK: el PWM y la pestaña terminan en el último brillo");
+    return fallas ? 1 : 0;
+}
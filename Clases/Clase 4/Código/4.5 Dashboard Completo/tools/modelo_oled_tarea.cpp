@@ -0,0 +1,231 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Modelo de tiempos en la PC del envío del OLED (src/oled_tarea.h,
+    no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o modelo_oled_tarea tools/modelo_oled_tarea.cpp
+        ./modelo_oled_tarea
+
+    Un minuto de loop(): refresco del OLED cada 500 ms y tick de PWM
+    cada 20 ms (aplica los comandos del WebSocket y de la API). Los
+    cuadros se generan cambiando la zona de la temperatura cada 2 s y la
+    del brillo mientras se arrastra el slider; OledPaginas decide qué se
+    envía y el tiempo de I2C sale de los bytes a 400 kHz más una
+    sobrecarga estimada por transacción de Wire.
+
+    Compara tres formas de enviar:
+      1. sendBuffer() en loop()         (antes de oled_paginas.h)
+      2. Solo páginas cambiadas en loop()
+      3. Tarea en segundo plano         (loop() solo copia 1 KB)
+    y cuánto se atrasa el tick de PWM cuando cae durante un envío.
+
+    La tarea se modela como en oled_tarea.h: un cuadro publicado durante
+    un envío queda pendiente y uno más nuevo lo reemplaza. Además del
+    minuto normal hay una ráfaga (un cuadro completo distinto cada 10 ms,
+    más rápido que el I2C). Verifica que la pantalla siempre termine con
+    el último cuadro publicado y que ningún cuadro espere más de un envío;
+    devuelve 1 si falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/oled_paginas.h"
+
+#define I2C_HZ              400000
+#define I2C_BLOQUE          24     // Bytes de datos por transacción en u8x8
+#define I2C_SOBRECARGA_US   40     // Estimación: driver de Wire por transacción
+#define COPIA_US            10     // memcpy de 1 KB en publicar() (estimación)
+#define DURACION_US         60000000u
+#define OLED_PERIODO_US     500000u
+#define PWM_PERIODO_US      20000u
+#define RAFAGA_PERIODO_US   10000u
+#define RAFAGA_CUADROS      100
+
+struct Envio {
+    uint32_t bytes;
+    uint32_t transacciones;
+};
+
+// Mismo modelo que tools/sim_oled_i2c.cpp: posición (dirección + 0x00 +
+// 3 comandos) y datos en bloques de 24 (dirección + 0x40 + datos)
+static void sumarTramo(Envio &e, uint8_t tiles) {
+    uint32_t datos = tiles * 8;
+    uint32_t bloques = (datos + I2C_BLOQUE - 1) / I2C_BLOQUE;
+    e.bytes += 2 + 3 + datos + 2 * bloques;
+    e.transacciones += 1 + bloques;
+}
+
+static uint32_t duracionUs(const Envio &e) {
+    return (uint32_t)((uint64_t)e.bytes * 9 * 1000000 / I2C_HZ) + e.transacciones * I2C_SOBRECARGA_US;
+}
+
+// Cuadro n: la temperatura (páginas 0-1, a la derecha) cambia cada 2 s;
+// el brillo (páginas 2-3) cambia en cada refresco entre los 20 y 23 s
+static void generarCuadro(uint8_t *frame, int n) {
+    for (int i = 0; i < OLED_ANCHO * OLED_PAGINAS; i++) frame[i] = (uint8_t)(i * 37);  // Etiquetas y logo
+    uint8_t temp = n / 4, brillo = n < 40 ? 0 : n < 46 ? n - 39 : 7;
+    for (int pagina = 0; pagina < 2; pagina++) {
+        for (int x = 96; x < 128; x++) frame[pagina * OLED_ANCHO + x] = temp * 13 + x;
+    }
+    for (int pagina = 2; pagina < 4; pagina++) {
+        for (int x = 100; x < 128; x++) frame[pagina * OLED_ANCHO + x] = brillo * 29 + x;
+    }
+}
+
+// Cuadro de la ráfaga: todas las páginas cambian (peor caso de I2C)
+static void generarCuadroCompleto(uint8_t *frame, int n) {
+    for (int i = 0; i < OLED_ANCHO * OLED_PAGINAS; i++) frame[i] = (uint8_t)(i * 37 + n * 11 + 1);
+}
+
+// La tarea de oled_tarea.h en tiempo simulado: buffer pendiente que
+// publicar() pisa, y la tarea lo toma al terminar cada envío
+struct ModeloTarea {
+    OledPaginas paginas;
+    uint8_t pendiente[OLED_ANCHO * OLED_PAGINAS];
+    bool hayPendiente = false;
+    int cuadroPendiente = -1, ultimoEnviado = -1;
+    uint32_t publicadoEn = 0, libreEn = 0;  // Fin del envío en curso
+    uint32_t duranteEnvio = 0;    // Publicados con la tarea enviando
+    uint32_t reemplazados = 0;   // Pendientes pisados por uno más nuevo
+    uint32_t peorEnvioUs = 0, peorEsperaUs = 0;
+
+    // Envíos que la tarea empieza hasta el instante t
+    void avanzar(uint32_t t) {
+        while (hayPendiente && libreEn <= t) {
+            hayPendiente = false;  // Intercambio de punteros con el mutex
+            uint32_t espera = libreEn - publicadoEn;
+            if (espera > peorEsperaUs) peorEsperaUs = espera;
+            Envio e = {0, 0};
+            paginas.enviarCambios(pendiente, [&](uint8_t, uint8_t, uint8_t tw, uint8_t) { sumarTramo(e, tw); });
+            libreEn += duracionUs(e);
+            if (duracionUs(e) > peorEnvioUs) peorEnvioUs = duracionUs(e);
+            ultimoEnviado = cuadroPendiente;
+        }
+    }
+
+    void publicar(const uint8_t *frame, int n, uint32_t t) {
+        avanzar(t);
+        if (t < libreEn) duranteEnvio++;
+        if (hayPendiente) reemplazados++;
+        memcpy(pendiente, frame, sizeof(pendiente));
+        hayPendiente = true;
+        cuadroPendiente = n;
+        publicadoEn = t + COPIA_US;
+        if (libreEn < publicadoEn) libreEn = publicadoEn;  // Tarea libre: arranca al despertar
+        avanzar(publicadoEn);
+    }
+};
+
+struct Resultado {
+    const char *nombre;
+    uint64_t bloqueadoUs = 0;   // loop() detenido en el OLED
+    uint32_t peorBloqueoUs = 0;
+    uint32_t peorAtrasoPwmUs = 0;
+    uint32_t ticksAtrasados = 0;  // Más de 1 ms tarde
+};
+
+// Atraso de los ticks de PWM que caen dentro de [inicio, inicio + bloqueo)
+static void atrasarTicks(Resultado &r, uint32_t inicio, uint32_t bloqueo) {
+    r.bloqueadoUs += bloqueo;
+    if (bloqueo > r.peorBloqueoUs) r.peorBloqueoUs = bloqueo;
+    uint32_t tick = (inicio / PWM_PERIODO_US + 1) * PWM_PERIODO_US;
+    for (; tick < inicio + bloqueo; tick += PWM_PERIODO_US) {
+        uint32_t atraso = inicio + bloqueo - tick;
+        if (atraso > r.peorAtrasoPwmUs) r.peorAtrasoPwmUs = atraso;
+        if (atraso > 1000) r.ticksAtrasados++;
+    }
+}
+
+int main() {
+    static uint8_t frame[OLED_ANCHO * OLED_PAGINAS];
+    Resultado completo, paginas, tarea;
+    completo.nombre = "sendBuffer() en loop()";
+    paginas.nombre = "Páginas cambiadas en loop()";
+    tarea.nombre = "Tarea en segundo plano";
+
+    OledPaginas oled;
+    ModeloTarea modelo;
+
+    Envio envioCompleto = {0, 0};
+    for (int p = 0; p < OLED_PAGINAS; p++) sumarTramo(envioCompleto, OLED_TILES);
+
+    int n = 0;
+    for (uint32_t t = 0; t < DURACION_US; t += OLED_PERIODO_US, n++) {
+        generarCuadro(frame, n);
+        Envio e = {0, 0};
+        oled.enviarCambios(frame, [&](uint8_t, uint8_t, uint8_t tw, uint8_t) { sumarTramo(e, tw); });
+
+        atrasarTicks(completo, t, duracionUs(envioCompleto));
+        if (e.bytes) atrasarTicks(paginas, t, duracionUs(e));
+
+        // Con la tarea, loop() solo copia; el I2C corre en paralelo
+        if (e.bytes) {
+            atrasarTicks(tarea, t, COPIA_US);
+            modelo.publicar(frame, n, t);
+        }
+    }
+    modelo.avanzar(UINT32_MAX);
+
+    printf("Un minuto de loop(): OLED cada 500 ms, tick de PWM cada 20 ms, I2C a %d kHz\n", I2C_HZ / 1000);
+    printf("(sobrecarga estimada de %d us por transacción de Wire)\n\n", I2C_SOBRECARGA_US);
+    printf("                               │ loop() detenido │ Peor bloqueo │ Peor atraso PWM │ Ticks > 1 ms tarde\n");
+    printf("  ─────────────────────────────┼─────────────────┼──────────────┼─────────────────┼───────────────────\n");
+    Resultado *filas[] = {&completo, &paginas, &tarea};
+    for (Resultado *r : filas) {
+        // %-29s cuenta bytes: compensar los caracteres UTF-8 de 2 bytes
+        int extra = 0;
+        for (const char *c = r->nombre; *c; c++) extra += ((*c & 0xC0) == 0x80);
+        printf("  %-*s │ %11.1f ms  │ %8.2f ms  │ %11.2f ms  │ %u\n", 29 + extra, r->nombre, r->bloqueadoUs / 1000.0,
+               r->peorBloqueoUs / 1000.0, r->peorAtrasoPwmUs / 1000.0, (unsigned)r->ticksAtrasados);
+    }
+    printf("\n  Envío más largo de la tarea: %.2f ms (de %u ms entre refrescos)\n", modelo.peorEnvioUs / 1000.0,
+           (unsigned)(OLED_PERIODO_US / 1000));
+    printf("  Publicados durante un envío: %u, reemplazados antes de salir: %u\n", (unsigned)modelo.duranteEnvio,
+           (unsigned)modelo.reemplazados);
+    printf("  Bloqueo de loop() eliminado: %.1f %% contra sendBuffer(), %.1f %% contra páginas en loop()\n",
+           100.0 * (completo.bloqueadoUs - tarea.bloqueadoUs) / completo.bloqueadoUs,
+           100.0 * (paginas.bloqueadoUs - tarea.bloqueadoUs) / paginas.bloqueadoUs);
+
+    int fallas = 0;
+    if (modelo.ultimoEnviado != modelo.cuadroPendiente) {
+        printf("FALLA: la pantalla quedó en el cuadro %d, el último publicado es %d\n", modelo.ultimoEnviado,
+               modelo.cuadroPendiente);
+        fallas++;
+    }
+
+    // Ráfaga: cuadros completos más rápido de lo que el I2C los envía
+    ModeloTarea rafaga;
+    for (int i = 0; i < RAFAGA_CUADROS; i++) {
+        generarCuadroCompleto(frame, i);
+        rafaga.publicar(frame, i, i * RAFAGA_PERIODO_US);
+    }
+    rafaga.avanzar(UINT32_MAX);
+    printf("\n  Ráfaga de %d cuadros completos cada %u ms: envío de %.2f ms, %u publicados durante un envío,\n",
+           RAFAGA_CUADROS, (unsigned)(RAFAGA_PERIODO_US / 1000), rafaga.peorEnvioUs / 1000.0,
+           (unsigned)rafaga.duranteEnvio);
+    printf("  %u reemplazados antes de salir, espera máxima de un cuadro %.2f ms\n", (unsigned)rafaga.reemplazados,
+           rafaga.peorEsperaUs / 1000.0);
+    if (rafaga.ultimoEnviado != RAFAGA_CUADROS - 1) {
+        printf("FALLA: tras la ráfaga la pantalla quedó en el cuadro %d, no en el %d\n", rafaga.ultimoEnviado,
+               RAFAGA_CUADROS - 1);
+        fallas++;
+    }
+    // Un cuadro espera como mucho el envío en curso
+    if (rafaga.peorEsperaUs > rafaga.peorEnvioUs || modelo.peorEsperaUs > modelo.peorEnvioUs) {
+        printf("FALLA: un cuadro esperó más que un envío completo\n");
+        fallas++;
+    }
+
+    printf("\n%s\n", fallas ? "FALLA" : "OK: publicar() nunca falla y la pantalla termina con el último cuadro");
+    return fallas ? 1 : 0;
+}
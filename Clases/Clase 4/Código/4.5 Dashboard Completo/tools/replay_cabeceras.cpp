@@ -0,0 +1,301 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Repetición en la PC de cabeceras HTTP capturadas de un navegador
+    contra src/archivos_estaticos.h (no se compila con PlatformIO)
+
+        python3 tools/gzip_data.py && python3 tools/gen_route_table.py
+        g++ -O2 -std=c++11 -o replay_cabeceras tools/replay_cabeceras.cpp
+        ./replay_cabeceras
+
+    LittleFS se simula con los archivos reales de data/ (y sus .gz),
+    contando cuántas veces se abre un archivo y cuántos bytes se leen de
+    la flash. Cada carga de página pide /, /style.css y /script.js con
+    las cabeceras que envía Chrome (primera visita y recarga con
+    If-None-Match) y curl (sin gzip).
+
+    Compara bytes enviados y lecturas de flash por carga contra el
+    servidor original (exists() + streamFile() del archivo sin comprimir,
+    sin ETag). Verifica que la recarga responda 304 sin tocar la flash,
+    que subir un style.css distinto sin recompilar cambie su ETag, que
+    "/" sirva index.html y que con LittleFS vacío (formateado por
+    begin(true) sin uploadfs) "/" e "/index.html" caigan en la página
+    básica y el resto en 404; devuelve 1 si algo falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <string>
+
+#include "../src/archivos_estaticos.h"
+
+static int fallas = 0;
+
+// --- LittleFS simulado ---
+
+struct Contadores {
+    uint32_t aperturas;   // open() y exists()
+    uint32_t bytesFlash;  // Leídos con read()
+};
+static Contadores flash;
+
+class ArchivoSim {
+public:
+    ArchivoSim(const std::string *datos = nullptr) : _datos(datos) {}
+    explicit operator bool() const { return _datos != nullptr; }
+    size_t size() const { return _datos ? _datos->size() : 0; }
+    size_t read(uint8_t *buf, size_t n) {
+        if (!_datos) return 0;
+        if (n > _datos->size() - _pos) n = _datos->size() - _pos;
+        memcpy(buf, _datos->data() + _pos, n);
+        _pos += n;
+        flash.bytesFlash += n;
+        return n;
+    }
+    void close() { _datos = nullptr; }
+
+private:
+    const std::string *_datos;
+    size_t _pos = 0;
+};
+
+class FsSim {
+public:
+    ArchivoSim open(const char *ruta, const char *) {
+        flash.aperturas++;
+        auto it = _archivos.find(ruta);
+        return ArchivoSim(it == _archivos.end() ? nullptr : &it->second);
+    }
+    bool exists(const char *ruta) {
+        flash.aperturas++;
+        return _archivos.count(ruta) > 0;
+    }
+    bool cargar(const char *ruta) {  // Desde data/ en la PC
+        FILE *f = fopen((std::string("data") + ruta).c_str(), "rb");
+        if (!f) return false;
+        std::string datos;
+        char buf[512];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0) datos.append(buf, n);
+        fclose(f);
+        _archivos[ruta] = datos;
+        return true;
+    }
+    void escribir(const char *ruta, const std::string &datos) { _archivos[ruta] = datos; }
+
+private:
+    std::map<std::string, std::string> _archivos;
+};
+
+// --- Cabeceras capturadas (como llegan, una por línea) ---
+
+static const char *CHROME =
+    "Host: 192.168.1.50\r\n"
+    "Connection: keep-alive\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Accept-Language: es-AR,es;q=0.9,en;q=0.8\r\n";
+
+static const char *CURL =
+    "Host: 192.168.1.50\r\n"
+    "User-Agent: curl/8.5.0\r\n"
+    "Accept: */*\r\n";
+
+// Valor de una cabecera (sin distinguir mayúsculas), "" si no está
+static std::string cabecera(const std::string &texto, const char *nombre) {
+    size_t largo = strlen(nombre), inicio = 0;
+    while (inicio < texto.size()) {
+        size_t fin = texto.find("\r\n", inicio);
+        if (fin == std::string::npos) fin = texto.size();
+        if (fin - inicio > largo && strncasecmp(texto.c_str() + inicio, nombre, largo) == 0 && texto[inicio + largo] == ':') {
+            size_t v = inicio + largo + 1;
+            while (v < fin && texto[v] == ' ') v++;
+            return texto.substr(v, fin - v);
+        }
+        inicio = fin + 2;
+    }
+    return "";
+}
+
+// Largo aproximado de la respuesta de ESPAsyncWebServer
+static uint32_t largoCabecerasRespuesta(const RespuestaArchivo &r, const Route &route) {
+    char texto[512];
+    int n = r.codigo == 304 ? snprintf(texto, sizeof(texto), "HTTP/1.1 304 Not Modified\r\n")
+                            : snprintf(texto, sizeof(texto),
+                                       "HTTP/1.1 200 OK\r\nContent-Length: %u\r\nContent-Type: %s\r\n%s",
+                                       (unsigned)r.bytes, route.mime, r.gzip ? "Content-Encoding: gzip\r\n" : "");
+    n += snprintf(texto + n, sizeof(texto) - n,
+                  "ETag: %s\r\nCache-Control: no-cache\r\nVary: Accept-Encoding\r\nConnection: close\r\n"
+                  "Accept-Ranges: none\r\n\r\n", r.etag);
+    return n;
+}
+
+static const char *PAGINA[] = {"/", "/style.css", "/script.js"};
+static const int PAGINA_N = 3;
+
+struct Carga {
+    uint32_t bytes, aperturas, bytesFlash, respuestas304;
+};
+
+// Una carga de página con el servidor actual. etags guarda los recibidos
+// (el navegador los manda en If-None-Match la próxima vez)
+static Carga cargarPagina(FsSim &fs, ArchivosEstaticos &archivos, const char *cabecerasBase,
+                          std::map<std::string, std::string> *etags) {
+    Carga c = {};
+    Contadores antes = flash;
+    for (int i = 0; i < PAGINA_N; i++) {
+        const Route *route = findRoute(PAGINA[i]);
+        if (!route) {
+            printf("  FALLA: %s no está en la tabla\n", PAGINA[i]);
+            fallas++;
+            continue;
+        }
+        std::string pedido = cabecerasBase;
+        if (etags && etags->count(PAGINA[i])) pedido += "If-None-Match: " + (*etags)[PAGINA[i]] + "\r\n";
+        std::string ifNoneMatch = cabecera(pedido, "If-None-Match");
+        bool gzip = cabecera(pedido, "Accept-Encoding").find("gzip") != std::string::npos;
+
+        RespuestaArchivo r = archivos.elegir(*route, gzip, ifNoneMatch.empty() ? nullptr : ifNoneMatch.c_str());
+        if (r.codigo == 404) {
+            printf("  FALLA: %s respondió 404\n", PAGINA[i]);
+            fallas++;
+            continue;
+        }
+        c.bytes += largoCabecerasRespuesta(r, *route);
+        if (r.codigo == 304) {
+            c.respuestas304++;
+        } else {
+            ArchivoSim file = fs.open(r.archivo, "r");  // handleFileRead()
+            if (!file || file.size() != r.bytes) {
+                printf("  FALLA: %s -> %s no coincide con lo medido al montar\n", PAGINA[i], r.archivo);
+                fallas++;
+            }
+            uint8_t buf[1460];  // Lo envía por partes (segmentos TCP)
+            size_t n;
+            while ((n = file.read(buf, sizeof(buf))) > 0) c.bytes += n;
+        }
+        if (etags) (*etags)[PAGINA[i]] = r.etag;
+    }
+    c.aperturas = flash.aperturas - antes.aperturas;
+    c.bytesFlash = flash.bytesFlash - antes.bytesFlash;
+    return c;
+}
+
+// Servidor original: exists() + open() + streamFile() sin comprimir
+static Carga cargarPaginaOriginal(FsSim &fs) {
+    Carga c = {};
+    Contadores antes = flash;
+    for (int i = 0; i < PAGINA_N; i++) {
+        std::string path = PAGINA[i];
+        if (path == "/") path += "index.html";
+        if (!fs.exists(path.c_str())) continue;
+        ArchivoSim file = fs.open(path.c_str(), "r");
+        c.bytes += 90;  // "HTTP/1.1 200 OK", Content-Type, Content-Length, Connection
+        uint8_t buf[1460];
+        size_t n;
+        while ((n = file.read(buf, sizeof(buf))) > 0) c.bytes += n;
+    }
+    c.aperturas = flash.aperturas - antes.aperturas;
+    c.bytesFlash = flash.bytesFlash - antes.bytesFlash;
+    return c;
+}
+
+static void fila(const char *nombre, const Carga &c) {
+    printf("  %-34s │ %7u │ %9u │ %11u │ %u\n", nombre, (unsigned)c.bytes, (unsigned)c.aperturas,
+           (unsigned)c.bytesFlash, (unsigned)c.respuestas304);
+}
+
+static void esperar(bool condicion, const char *mensaje) {
+    if (!condicion) {
+        printf("  FALLA: %s\n", mensaje);
+        fallas++;
+    }
+}
+
+int main() {
+    FsSim fs;
+    const char *archivosData[] = {"/index.html", "/style.css", "/script.js",
+                                  "/index.html.gz", "/style.css.gz", "/script.js.gz"};
+    for (const char *ruta : archivosData) {
+        if (!fs.cargar(ruta)) {
+            printf("No se encontró data%s: ejecutar desde la carpeta del proyecto, después de\n"
+                   "python3 tools/gzip_data.py && python3 tools/gen_route_table.py\n", ruta);
+            return 1;
+        }
+    }
+
+    // Montaje: cada archivo se lee una vez
+    ArchivosEstaticos archivos;
+    Contadores antes = flash;
+    archivos.cargar(fs);
+    Contadores montaje = {flash.aperturas - antes.aperturas, flash.bytesFlash - antes.bytesFlash};
+
+    std::map<std::string, std::string> etagsChrome, etagsCurl;
+    Carga original = cargarPaginaOriginal(fs);
+    Carga primera = cargarPagina(fs, archivos, CHROME, &etagsChrome);
+    Carga recarga = cargarPagina(fs, archivos, CHROME, &etagsChrome);
+    Carga curl = cargarPagina(fs, archivos, CURL, nullptr);
+    Carga curlEtag = cargarPagina(fs, archivos, CURL, &etagsCurl);
+    Carga curlRecarga = cargarPagina(fs, archivos, CURL, &etagsCurl);
+
+    esperar(primera.respuestas304 == 0, "la primera visita recibió un 304");
+    esperar(recarga.respuestas304 == PAGINA_N, "la recarga no respondió 304 en todo");
+    esperar(recarga.aperturas == 0 && recarga.bytesFlash == 0, "la recarga leyó la flash");
+    esperar(primera.bytes < original.bytes, "gzip no redujo los bytes enviados");
+    esperar(curlEtag.respuestas304 == 0 && curlRecarga.respuestas304 == PAGINA_N, "curl con If-None-Match no recibió 304");
+    const Route *raiz = findRoute("/"), *index = findRoute("/index.html");
+    esperar(raiz && index && strcmp(raiz->file, "/index.html") == 0 &&
+                strcmp(archivos.info(*raiz).etag, archivos.info(*index).etag) == 0,
+            "\"/\" no sirve /index.html");
+
+    // Imagen LittleFS nueva sin recompilar: solo cambió style.css
+    fs.escribir("/style.css", "body{color:red}\n");
+    fs.escribir("/style.css.gz", std::string("\x1f\x8b", 2) + "style.css nuevo comprimido");
+    archivos.cargar(fs);
+    Carga nueva = cargarPagina(fs, archivos, CHROME, &etagsChrome);
+    esperar(nueva.respuestas304 == PAGINA_N - 1, "después de subir un style.css nuevo no se reenvió solo ese archivo");
+    const Route *css = findRoute("/style.css");
+    esperar(css && archivos.info(*css).size == 16, "el tamaño de style.css no es el de la imagen nueva");
+
+    // LittleFS recién formateado (nunca se corrió uploadfs): montó, pero
+    // no hay archivos. La página principal cae en handleFallbackPage()
+    FsSim vacio;
+    ArchivosEstaticos sinArchivos;
+    sinArchivos.cargar(vacio);
+    for (int i = 0; i < PAGINA_N + 1; i++) {
+        const char *ruta = i < PAGINA_N ? PAGINA[i] : "/index.html";
+        const Route *route = findRoute(ruta);
+        bool principal = strcmp(ruta, "/") == 0 || strcmp(ruta, "/index.html") == 0;
+        RespuestaArchivo r = sinArchivos.elegir(*route, true, nullptr);
+        if (r.codigo != 404 || esPaginaPrincipal(*route) != principal) {
+            printf("  FALLA: LittleFS vacío: %s debería ir a %s\n", ruta, principal ? "la página básica" : "404");
+            fallas++;
+        }
+    }
+
+    printf("Carga de página (/, /style.css, /script.js), cabeceras capturadas:\n\n");
+    printf("                                     │ Bytes   │ Aperturas │ Bytes flash │ 304\n");
+    printf("  ───────────────────────────────────┼─────────┼───────────┼─────────────┼────\n");
+    fila("Original (sin gzip ni ETag)", original);
+    fila("Chrome, primera visita", primera);
+    fila("Chrome, recarga (If-None-Match)", recarga);
+    fila("curl sin gzip ni If-None-Match", curl);
+    fila("curl con If-None-Match", curlRecarga);
+    fila("Chrome, style.css nuevo (uploadfs)", nueva);
+    printf("\n  Montaje: %u aperturas, %u bytes leídos (una vez por arranque)\n", (unsigned)montaje.aperturas,
+           (unsigned)montaje.bytesFlash);
+    printf("  Primera visita: %.0f%% de los bytes del original; recarga: %.0f%%\n",
+           100.0 * primera.bytes / original.bytes, 100.0 * recarga.bytes / original.bytes);
+
+    printf("\n%s\n", fallas ? "FALLA: ver arriba" : "OK: 304 sin tocar la flash, ETag nuevo al cambiar la imagen y página básica sin archivos");
+    return fallas ? 1 : 0;
+}
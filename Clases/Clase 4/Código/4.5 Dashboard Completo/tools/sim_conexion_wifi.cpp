@@ -0,0 +1,415 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Simulación en la PC de src/conexion_wifi.h con un AP que se cae
+    (no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o sim_conexion_wifi tools/sim_conexion_wifi.cpp
+        ./sim_conexion_wifi
+
+    Reloj virtual en ms y una radio simulada: asociarse y obtener IP
+    tarda 3 s si el AP está, y si no está el intento falla a los 2.5 s
+    (evento de desconexión). Durante una hora se cortan el AP varias
+    veces (de 5 s a 4 minutos) y loop() corre cada 10 ms.
+
+      1. Cuánto queda detenido loop() y cuánto tarda en volver la
+         conexión: checkWiFiConnection() anterior (delay(500) x 10 cada
+         10 s) contra la máquina de estados.
+      2. Que solo haya transiciones dibujadas en
+         Diagramas/wifi_conexion_estados.pu y que el backoff crezca hasta
+         el tope con el jitter dentro de [mitad, total].
+      3. 20 equipos que pierden el mismo AP: cuántos reintentan a la vez
+         con y sin jitter.
+      4. Arranque con la caché de cache_wifi.h: sin caché (escaneo y
+         DHCP), con caché (canal, BSSID e IP conocidos) y con una caché
+         vieja (el AP cambió de canal: timeout corto y escaneo completo
+         enseguida, sin backoff).
+
+    Devuelve 1 si alguna comprobación falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/conexion_wifi.h"
+
+#define TICK_MS             10       // loop()
+#define ASOCIACION_MS       3000     // Escaneo + asociación + DHCP con el AP presente
+#define RAPIDA_MS           400      // Asociación en el canal guardado, sin DHCP
+#define FALLA_MS            2500     // Escaneo sin encontrar el AP
+#define RAZON_BEACON        200      // WIFI_REASON_BEACON_TIMEOUT
+#define RAZON_SIN_AP        201      // WIFI_REASON_NO_AP_FOUND
+#define DURACION_MS         3600000u // Una hora
+
+static uint32_t ahora = 0;
+static int fallas = 0;
+
+static void comprobar(bool ok, const char *que) {
+    printf("  [%s] %s\n", ok ? " OK " : "FALLA", que);
+    if (!ok) fallas++;
+}
+
+// Cortes del AP: [inicio, fin)
+struct Corte {
+    uint32_t inicio, fin;
+};
+static const Corte cortes[] = {
+    {120000, 125000},    // 5 s
+    {600000, 660000},    // 1 minuto
+    {1200000, 1440000},  // 4 minutos
+    {2000000, 2020000},  // 20 s
+    {3000000, 3001000},  // 1 s
+};
+static const int CORTES = sizeof(cortes) / sizeof(cortes[0]);
+
+// Cortes de la prueba en curso
+static const Corte *cortesActivos = cortes;
+static int cantidadCortes = CORTES;
+
+static bool apPresente(uint32_t t) {
+    for (int i = 0; i < cantidadCortes; i++) {
+        if (t >= cortesActivos[i].inicio && t < cortesActivos[i].fin) return false;
+    }
+    return true;
+}
+
+// Radio simulada: un intento en curso termina en conexión o falla
+// (evento) después de un tiempo; el corte del AP desconecta
+class RadioSim {
+public:
+    template <typename Maquina>
+    void avanzar(Maquina &m) {
+        if (_conectada && !apPresente(ahora)) {
+            _conectada = false;
+            m.alDesconectar(RAZON_BEACON);
+        }
+        if (_intento && (int32_t)(ahora - _finIntento) >= 0) {
+            _intento = false;
+            if (_exito) {
+                _conectada = true;
+                m.alConectar();
+            } else {
+                m.alDesconectar(RAZON_SIN_AP);
+            }
+        }
+    }
+
+    // Con caché: asociación directa. Si el AP ya no está en ese canal no
+    // llega ningún evento (peor caso: vence el timeout del intento rápido)
+    bool conectar() {
+        _consultas++;
+        if (!_cache) {
+            empezar();
+            return false;
+        }
+        _conectada = false;
+        _intentos++;
+        _ultimoIntento = ahora;
+        _exito = _cacheValida && apPresente(ahora);
+        _intento = _exito;
+        _finIntento = ahora + RAPIDA_MS;
+        return true;
+    }
+    void reconectar() {  // El ASSOC_LEAVE propio lo filtra la máquina
+        _consultas++;
+        empezar();
+    }
+    void conectada() {
+        _consultas++;
+        _cache = _cacheValida = true;
+        _guardadas++;
+    }
+    bool conectado() {
+        _consultas++;
+        return _conectada;
+    }
+    uint32_t aleatorio() {
+        _consultas++;
+        return _semilla = _semilla * 1103515245u + 12345u, _sinJitter ? 0 : _semilla >> 8;
+    }
+
+    void sinJitter() { _sinJitter = true; }
+    void semilla(uint32_t s) { _semilla = s; }
+    void cache(bool valida) { _cache = true, _cacheValida = valida; }
+    uint32_t guardadas() const { return _guardadas; }
+    uint32_t intentos() const { return _intentos; }
+    uint32_t ultimoIntento() const { return _ultimoIntento; }
+    uint32_t consultas() const { return _consultas; }  // Llamadas de la máquina a la radio
+
+private:
+    void empezar() {
+        _conectada = false;
+        _intento = true;
+        _intentos++;
+        _ultimoIntento = ahora;
+        // Si el AP vuelve durante el escaneo, igual falla (simplificación)
+        _exito = apPresente(ahora) && apPresente(ahora + ASOCIACION_MS);
+        _finIntento = ahora + (_exito ? ASOCIACION_MS : FALLA_MS);
+    }
+
+    bool _conectada = false, _intento = false, _exito = false, _sinJitter = false;
+    bool _cache = false, _cacheValida = false;
+    uint32_t _finIntento = 0, _intentos = 0, _ultimoIntento = 0, _guardadas = 0, _consultas = 0;
+    uint32_t _semilla = 1;
+};
+
+// Transiciones dibujadas en el diagrama
+static bool permitida(EstadoWifi a, EstadoWifi b) {
+    switch (a) {
+        case WIFI_INICIALIZACION: return b == WIFI_CONECTANDO;
+        case WIFI_CONECTANDO: return b == WIFI_CONECTADO || b == WIFI_ERROR_CONEXION || b == WIFI_DESCONECTADO;
+        case WIFI_CONECTADO: return b == WIFI_VERIFICANDO || b == WIFI_CONEXION_PERDIDA;
+        case WIFI_VERIFICANDO: return b == WIFI_CONECTADO || b == WIFI_CONEXION_PERDIDA;
+        case WIFI_ERROR_CONEXION: return b == WIFI_REINTENTANDO || b == WIFI_CONECTADO;
+        case WIFI_REINTENTANDO: return b == WIFI_CONECTADO || b == WIFI_ERROR_CONEXION || b == WIFI_DESCONECTADO;
+        case WIFI_DESCONECTADO: return b == WIFI_REINTENTANDO || b == WIFI_CONECTADO;
+        case WIFI_CONEXION_PERDIDA: return b == WIFI_REINTENTANDO;
+    }
+    return false;
+}
+
+static int prohibidas = 0;
+static uint32_t inicioEspera = 0;
+static int esperasFuera = 0;  // Esperas fuera de [mitad, total] del backoff
+static uint32_t esperaMax = 0;
+static ConexionWifi<RadioSim> *maquina = nullptr;
+
+static void alCambiar(EstadoWifi anterior, EstadoWifi nuevo) {
+    if (!permitida(anterior, nuevo)) {
+        if (prohibidas++ < 3) printf("    Transición no dibujada: %s -> %s\n", nombreEstadoWifi(anterior), nombreEstadoWifi(nuevo));
+    }
+    if (nuevo == WIFI_ERROR_CONEXION) inicioEspera = ahora;
+    if (anterior == WIFI_ERROR_CONEXION && nuevo == WIFI_REINTENTANDO) {
+        // intentos() ya cuenta el nuevo: la espera fue para intentos() - 1
+        uint32_t esperado = WIFI_BACKOFF_BASE_MS;
+        for (uint8_t i = 1; i < maquina->intentos() - 1 && esperado < WIFI_BACKOFF_MAX_MS; i++) esperado *= 2;
+        if (esperado > WIFI_BACKOFF_MAX_MS) esperado = WIFI_BACKOFF_MAX_MS;
+        uint32_t espera = ahora - inicioEspera;
+        if (espera + TICK_MS < esperado / 2 || espera > esperado + TICK_MS) esperasFuera++;
+        if (espera > esperaMax) esperaMax = espera;
+    }
+}
+
+// Demora desde que vuelve el AP hasta estar conectado, por corte
+static void demoras(const uint32_t *conectadoEn, const char *nombre, uint32_t &peor) {
+    // %-*s cuenta bytes: compensar los caracteres UTF-8 de 2 bytes
+    int extra = 0;
+    for (const char *c = nombre; *c; c++) extra += ((*c & 0xC0) == 0x80);
+    printf("    %-*s", 26 + extra, nombre);
+    peor = 0;
+    for (int i = 0; i < CORTES; i++) {
+        uint32_t d = conectadoEn[i] - cortes[i].fin;
+        printf(" │ %9.1f s", d / 1000.0);
+        if (d > peor) peor = d;
+    }
+    printf("\n");
+}
+
+static void comparar() {
+    // Antes: cada 10 s, si no hay conexión, reconnect() y hasta 10 x delay(500)
+    uint32_t peorBloqueoAntes = 0, bloqueadoAntes = 0, intentosAntes = 0;
+    uint32_t conectadoAntes[CORTES];
+    {
+        bool conectada = true;
+        uint32_t intentoFin = 0;
+        bool intento = false, exito = false;
+        int corte = 0;
+        for (ahora = 0; ahora < DURACION_MS;) {
+            if (conectada && !apPresente(ahora)) conectada = false;
+            if (ahora % 10000 == 0 && !conectada) {
+                // WiFi.reconnect() + while (...) delay(500)
+                intentosAntes++;
+                intento = true;
+                exito = apPresente(ahora) && apPresente(ahora + ASOCIACION_MS);
+                intentoFin = ahora + (exito ? ASOCIACION_MS : FALLA_MS);
+                uint32_t bloqueo = 0;
+                for (int i = 0; i < 10 && !conectada; i++) {
+                    bloqueo += 500;
+                    if (intento && ahora + bloqueo >= intentoFin) {
+                        intento = false;
+                        conectada = exito;
+                        if (conectada) break;
+                    }
+                }
+                bloqueadoAntes += bloqueo;
+                if (bloqueo > peorBloqueoAntes) peorBloqueoAntes = bloqueo;
+                ahora += bloqueo;
+                if (conectada && corte < CORTES) conectadoAntes[corte++] = ahora;
+                ahora = (ahora / TICK_MS + 1) * TICK_MS;
+                continue;
+            }
+            ahora += TICK_MS;
+        }
+    }
+
+    // Máquina de estados
+    RadioSim radio;
+    ConexionWifi<RadioSim> wifi(radio);
+    maquina = &wifi;
+    wifi.alCambiar(alCambiar);
+    uint32_t conectadoDespues[CORTES];
+    int corte = 0;
+    bool estabaConectado = false;
+    // El reloj virtual solo avanza entre llamadas: una espera dentro de
+    // actualizar() (while (!conectado()) delay(...)) no terminaría nunca o
+    // se vería como muchas consultas a la radio en la misma llamada
+    uint32_t maxConsultas = 0;
+    ahora = 0;
+    wifi.iniciar(ahora);
+    radio.avanzar(wifi);
+    uint32_t intentosAlConectar = radio.intentos();
+    for (; ahora < DURACION_MS; ahora += TICK_MS) {
+        radio.avanzar(wifi);
+        uint32_t consultas = radio.consultas();
+        wifi.actualizar(ahora);
+        if (radio.consultas() - consultas > maxConsultas) maxConsultas = radio.consultas() - consultas;
+
+        bool conectado = wifi.conectado();
+        if (conectado && !estabaConectado && ahora > cortes[0].inicio && corte < CORTES) conectadoDespues[corte++] = ahora;
+        estabaConectado = conectado;
+    }
+    uint32_t intentosDespues = radio.intentos() - intentosAlConectar;
+
+    printf("    %-26s", "Demora al volver el AP");
+    for (const Corte &c : cortes) printf(" │ corte %3u s", (c.fin - c.inicio) / 1000);
+    printf("\n");
+    uint32_t peorAntes = 0, peorDespues = 0;
+    demoras(conectadoAntes, "checkWiFiConnection()", peorAntes);
+    demoras(conectadoDespues, "Máquina de estados", peorDespues);
+    printf("\n    checkWiFiConnection(): loop() detenido %.1f s en total, hasta %u ms seguidos; %u intentos\n",
+           bloqueadoAntes / 1000.0, peorBloqueoAntes, intentosAntes);
+    printf("    Máquina de estados:    loop() nunca espera (hasta %u consultas a la radio por llamada); %u intentos\n",
+           maxConsultas, intentosDespues);
+    printf("    Espera más larga entre intentos: %.1f s (tope %d s)\n\n", esperaMax / 1000.0, WIFI_BACKOFF_MAX_MS / 1000);
+
+    comprobar(corte == CORTES, "reconecta después de cada corte");
+    comprobar(maxConsultas <= 3, "actualizar() no espera a la radio (a lo sumo 3 consultas por llamada)");
+    char texto[96];
+    snprintf(texto, sizeof(texto), "peor demora al volver el AP %.1f s (≤ tope + timeout + asociación)",
+             peorDespues / 1000.0);
+    comprobar(peorDespues <= WIFI_BACKOFF_MAX_MS + WIFI_TIMEOUT_INTENTO_MS + ASOCIACION_MS + TICK_MS, texto);
+    comprobar(prohibidas == 0, "solo transiciones del diagrama");
+    comprobar(esperasFuera == 0, "esperas entre la mitad y el total del backoff");
+}
+
+// N equipos pierden el AP a los 10 s y vuelve a los 70 s: intentos que
+// empiezan en la misma ventana de 100 ms. El primer reintento es
+// inmediato (CONEXION_PERDIDA -> REINTENTANDO) y coincide en todos: se
+// cuentan los siguientes, los que dependen del backoff
+static uint32_t simultaneos(bool jitter) {
+    const int N = 20;
+    const uint32_t CAIDA = 10000, VUELTA = 70000, VENTANA = 100;
+    static uint16_t porVentana[(VUELTA + 60000) / 100];
+    memset(porVentana, 0, sizeof(porVentana));
+
+    const Corte corte = {CAIDA, VUELTA};
+    cortesActivos = &corte;
+    cantidadCortes = 1;
+
+    RadioSim radios[N];
+    ConexionWifi<RadioSim> *equipos[N];
+    for (int i = 0; i < N; i++) {
+        radios[i].semilla(i * 7919 + 1);
+        if (!jitter) radios[i].sinJitter();
+        equipos[i] = new ConexionWifi<RadioSim>(radios[i]);
+    }
+    // Arrancan con 0-2 s de diferencia y están conectados antes de la caída
+    uint32_t maximo = 0;
+    for (ahora = 0; ahora < VUELTA + 60000; ahora += TICK_MS) {
+        for (int i = 0; i < N; i++) {
+            if (ahora < (uint32_t)i * 100) continue;
+            if (ahora == (uint32_t)i * 100) equipos[i]->iniciar(ahora);
+            uint32_t antes = radios[i].intentos();
+            radios[i].avanzar(*equipos[i]);
+            equipos[i]->actualizar(ahora);
+            if (radios[i].intentos() != antes && ahora > CAIDA + TICK_MS) {
+                uint16_t &n = porVentana[ahora / VENTANA];
+                if (++n > maximo) maximo = n;
+            }
+        }
+    }
+    for (int i = 0; i < N; i++) delete equipos[i];
+    cortesActivos = cortes;
+    cantidadCortes = CORTES;
+    return maximo;
+}
+
+// Desde el reset hasta CONECTADO con el AP presente. En espera queda lo
+// que pasó entre ERROR_CONEXION y el reintento (0 si no hubo)
+static int prohibidasArranque = 0;
+static uint32_t errorEn = 0, esperaArranque = 0;
+
+static void alCambiarArranque(EstadoWifi anterior, EstadoWifi nuevo) {
+    if (!permitida(anterior, nuevo)) prohibidasArranque++;
+    if (nuevo == WIFI_ERROR_CONEXION) errorEn = ahora;
+    if (anterior == WIFI_ERROR_CONEXION && nuevo == WIFI_REINTENTANDO) esperaArranque = ahora - errorEn;
+}
+
+static uint32_t arrancar(RadioSim &radio, bool &rapido) {
+    ConexionWifi<RadioSim> wifi(radio);
+    wifi.alCambiar(alCambiarArranque);
+    esperaArranque = 0;
+    ahora = 0;
+    wifi.iniciar(ahora);
+    for (; ahora < 60000 && !wifi.conectado(); ahora += TICK_MS) {
+        radio.avanzar(wifi);
+        wifi.actualizar(ahora);
+    }
+    rapido = wifi.rapido();
+    return ahora - TICK_MS;
+}
+
+static void arranques() {
+    bool rapido;
+    RadioSim radio;  // Primer arranque: sin caché
+    uint32_t sinCache = arrancar(radio, rapido);
+    bool guardo = radio.guardadas() == 1;
+    bool sinCacheCompleta = !rapido;
+
+    RadioSim conCacheRadio;
+    conCacheRadio.cache(true);
+    uint32_t conCache = arrancar(conCacheRadio, rapido);
+    bool conCacheRapida = rapido;
+
+    RadioSim viejaRadio;
+    viejaRadio.cache(false);
+    uint32_t vieja = arrancar(viejaRadio, rapido);
+    bool viejaCompleta = !rapido && viejaRadio.guardadas() == 1;
+    uint32_t esperaVieja = esperaArranque;
+
+    printf("    Sin caché (escaneo + DHCP):          conectado a los %4.1f s\n", sinCache / 1000.0);
+    printf("    Con caché (canal, BSSID e IP):       conectado a los %4.1f s\n", conCache / 1000.0);
+    printf("    Caché vieja (el AP cambió de canal): conectado a los %4.1f s (timeout de %d s + escaneo)\n\n",
+           vieja / 1000.0, WIFI_TIMEOUT_RAPIDO_MS / 1000);
+
+    comprobar(sinCacheCompleta && guardo, "sin caché escanea y guarda la conexión");
+    comprobar(conCacheRapida && conCache <= RAPIDA_MS + 2 * TICK_MS, "con caché conecta sin escanear ni DHCP");
+    comprobar(viejaCompleta && vieja <= WIFI_TIMEOUT_RAPIDO_MS + ASOCIACION_MS + 2 * TICK_MS,
+              "caché vieja: vuelve al escaneo completo y guarda la nueva");
+    comprobar(esperaVieja <= TICK_MS, "el escaneo después de la caché vieja no espera el backoff");
+    comprobar(prohibidasArranque == 0, "solo transiciones del diagrama");
+}
+
+int main() {
+    printf("1. Una hora con %d cortes del AP, loop() cada %d ms:\n", CORTES, TICK_MS);
+    comparar();
+
+    printf("\n2. 20 equipos pierden el mismo AP durante 1 minuto:\n");
+    uint32_t sin = simultaneos(false), con = simultaneos(true);
+    printf("    Máximo de reintentos con backoff en la misma ventana de 100 ms: sin jitter %u, con jitter %u\n", sin, con);
+    comprobar(con < sin, "el jitter reparte los reintentos");
+
+    printf("\n3. Arranque con el AP presente:\n");
+    arranques();
+
+    printf("\n%s\n", fallas ? "FALLA: revisar las comprobaciones marcadas" : "OK: conexión WiFi sin bloqueos verificada");
+    return fallas ? 1 : 0;
+}
@@ -0,0 +1,160 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Simulación en la PC del tráfico I2C del OLED (src/oled_paginas.h,
+    no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o sim_oled_i2c tools/sim_oled_i2c.cpp
+        ./sim_oled_i2c
+
+    Un minuto de dashboard (updateOLED() cada 500 ms) con la temperatura
+    cambiando cada 2 s, el slider arrastrado durante 3 s y un toggle.
+    El texto se dibuja con una fuente inventada del mismo tamaño que la
+    real (7x13): alcanza para saber qué páginas cambian, no para verla.
+
+    Compara los bytes de I2C de sendBuffer() en cada refresco contra
+    saltear los refrescos sin cambios + enviar solo las páginas
+    modificadas. Verifica que la memoria simulada del SSD1306 termine
+    igual al buffer en cada refresco; devuelve 1 si no.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/oled_paginas.h"
+
+#define I2C_HZ        400000  // Wire a 400 kHz
+#define I2C_BLOQUE    24      // Bytes de datos por transacción en u8x8 (ssd13xx_fast_i2c)
+#define REFRESCOS     120     // 1 minuto a 500 ms
+
+static uint8_t frame[OLED_ANCHO * OLED_PAGINAS];   // Buffer de u8g2
+static uint8_t gddram[OLED_ANCHO * OLED_PAGINAS];  // Memoria del SSD1306
+static int fallas = 0;
+
+// Modelo del envío de u8x8 por cada tramo de una página: una transacción
+// con la posición (dirección + 0x00 + 3 comandos) y los datos en bloques
+// de 24 bytes (dirección + 0x40 + datos). Aproximado, pero proporcional
+static uint32_t bytesI2C(uint8_t tiles) {
+    uint32_t datos = tiles * 8;
+    return 2 + 3 + datos + 2 * ((datos + I2C_BLOQUE - 1) / I2C_BLOQUE);
+}
+
+static void pixel(int x, int y) {
+    if (x < 0 || x >= OLED_ANCHO || y < 0 || y >= 64) return;
+    frame[(y / 8) * OLED_ANCHO + x] |= 1 << (y % 8);
+}
+
+// Fuente inventada de celdas ancho x alto: cada carácter es un patrón
+// distinto de píxeles que cambia si cambia el carácter
+static void texto(int x, int base, const char *s, int ancho, int alto) {
+    for (; *s; s++, x += ancho) {
+        for (int col = 0; col < ancho - 1; col++) {
+            uint32_t bits = (uint32_t)(*s * 2654435761u) >> (col * 3);
+            for (int fila = 0; fila < alto - 2; fila++) {
+                if (bits & (1u << (fila % 13))) pixel(x + col, base - fila);
+            }
+        }
+    }
+}
+
+// Mismo layout que updateOLED() (7x13 mono: ancho = 7 · largo)
+static void dibujar(const char *temp, unsigned brillo, bool encendido) {
+    memset(frame, 0, sizeof(frame));
+    char brilloStr[8];
+    snprintf(brilloStr, sizeof(brilloStr), "%u %%", brillo);
+    const char *estado = encendido ? "ON" : "OFF";
+    texto(0, 15, "Temp:", 7, 13);
+    texto(128 - 7 * (int)strlen(temp), 15, temp, 7, 13);
+    texto(0, 30, "Brillo LED:", 7, 13);
+    texto(128 - 7 * (int)strlen(brilloStr), 30, brilloStr, 7, 13);
+    texto(0, 45, "Estado:", 7, 13);
+    texto(128 - 7 * (int)strlen(estado), 45, estado, 7, 13);
+    texto(40, 62, "UNSE IoT", 6, 9);
+}
+
+struct Escenario {
+    char temp[16];
+    unsigned brillo;
+    bool encendido;
+};
+
+// Un valor por refresco (cada 500 ms): temperatura nueva cada 2 s con
+// ruido de ±0.2 °C (a veces repite), slider de 50 a 80 % entre los 20 y
+// 23 s, toggle a los 40 s. Las dos variantes ven la misma secuencia
+static Escenario escenario[REFRESCOS];
+
+static void generarEscenario() {
+    uint32_t semilla = 12345;
+    int decimas = 453;
+    for (int n = 0; n < REFRESCOS; n++) {
+        if (n % 4 == 0) {
+            semilla = semilla * 1103515245 + 12345;
+            decimas += (int)((semilla >> 16) % 5) - 2;
+        }
+        Escenario &e = escenario[n];
+        snprintf(e.temp, sizeof(e.temp), "%d.%d C", decimas / 10, decimas % 10);
+        e.brillo = n < 40 ? 50 : n < 46 ? 50 + (n - 39) * 5 : 80;
+        e.encendido = n < 80;
+    }
+}
+
+int main() {
+    uint32_t antes = 0, despues = 0, dibujados = 0, enviosParciales = 0;
+    generarEscenario();
+
+    // Antes: clearBuffer + dibujar + sendBuffer() en cada refresco
+    for (int n = 0; n < REFRESCOS; n++) {
+        const Escenario &e = escenario[n];
+        dibujar(e.temp, e.brillo, e.encendido);
+        antes += OLED_PAGINAS * bytesI2C(OLED_TILES);
+    }
+
+    // Después: saltear si no cambió nada y enviar solo páginas distintas
+    OledPaginas oled;
+    Escenario mostrado = {};
+    bool valido = false;
+    memset(gddram, 0xA5, sizeof(gddram));  // Basura de arranque
+    for (int n = 0; n < REFRESCOS; n++) {
+        const Escenario &e = escenario[n];
+        if (valido && strcmp(e.temp, mostrado.temp) == 0 && e.brillo == mostrado.brillo && e.encendido == mostrado.encendido) {
+            continue;
+        }
+        mostrado = e;
+        valido = true;
+        dibujados++;
+        dibujar(e.temp, e.brillo, e.encendido);
+        oled.enviarCambios(frame, [&](uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+            for (uint8_t fila = ty; fila < ty + th; fila++) {
+                memcpy(gddram + fila * OLED_ANCHO + tx * 8, frame + fila * OLED_ANCHO + tx * 8, tw * 8);
+                despues += bytesI2C(tw);
+                if (tw < OLED_TILES) enviosParciales++;
+            }
+        });
+        if (memcmp(gddram, frame, sizeof(frame)) != 0) {
+            printf("  FALLA: refresco %d, el display no coincide con el buffer\n", n);
+            fallas++;
+        }
+    }
+
+    double msAntes = antes * 9.0 * 1000 / I2C_HZ;  // 8 bits + ACK por byte
+    double msDespues = despues * 9.0 * 1000 / I2C_HZ;
+    printf("Un minuto de dashboard, %d refrescos de 500 ms, I2C a %d kHz:\n\n", REFRESCOS, I2C_HZ / 1000);
+    printf("                         │ Bytes I2C │ Tiempo de bus │ Refrescos dibujados\n");
+    printf("  ───────────────────────┼───────────┼───────────────┼────────────────────\n");
+    printf("  sendBuffer() siempre   │ %9u │ %9.0f ms  │ %u\n", (unsigned)antes, msAntes, REFRESCOS);
+    printf("  Páginas con cambios    │ %9u │ %9.0f ms  │ %u (%u tramos parciales)\n", (unsigned)despues, msDespues,
+           (unsigned)dibujados, (unsigned)enviosParciales);
+    printf("\n  Frame completo: %u bytes (%.1f ms bloqueando loop())\n", OLED_PAGINAS * bytesI2C(OLED_TILES),
+           OLED_PAGINAS * bytesI2C(OLED_TILES) * 9.0 * 1000 / I2C_HZ);
+    printf("  Reducción: %.1f veces menos tráfico\n", (double)antes / despues);
+
+    printf("\n%s\n", fallas ? "FALLA: el display simulado no coincide" : "OK: el display simulado coincide en cada refresco");
+    return fallas ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Pruebas en la PC de src/planificador.h con un reloj virtual (no se
+    compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o sim_planificador tools/sim_planificador.cpp
+        ./sim_planificador
+
+    El reloj solo avanza cuando el simulador lo indica (duración de cada
+    tarea, tiempo dormido), así que los resultados son siempre iguales:
+
+    1. Las tareas del dashboard durante 10 minutos: cantidad de
+       ejecuciones exacta, jitter acotado y sin desbordes, con espera
+       exacta y con la espera redondeada a ticks de 1 ms de FreeRTOS.
+    2. Una tarea que tarda más que su período: se cuentan los desbordes
+       y las demás siguen corriendo.
+    3. El contador de micros() desbordando en medio de la prueba.
+    4. Comandos que llegan en momentos al azar: demora hasta atenderlos
+       con solicitar() contra el loop() anterior con delay(10), y
+       cuántas veces se despierta loop() por segundo.
+
+    Devuelve 1 si alguna comprobación falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/planificador.h"
+
+static uint32_t ahora = 0;  // Reloj virtual (µs)
+
+struct RelojVirtual {
+    uint32_t ahoraUs() const { return ahora; }
+};
+
+static int fallas = 0;
+
+static void comprobar(bool ok, const char *que) {
+    printf("  [%s] %s\n", ok ? " OK " : "FALLA", que);
+    if (!ok) fallas++;
+}
+
+// Tareas del dashboard: cada una "tarda" avanzando el reloj
+static void sensores() { ahora += 900; }   // temperatureRead() + Serial
+static void oled() { ahora += 1500; }      // Dibujar + publicar
+static void pwm() { ahora += 50; }         // actuadores.aplicar()
+static void wifi() { ahora += 20; }
+static void logIp() { ahora += 400; }
+static void lenta() { ahora += 50000; }    // Tarda más que su período
+
+// loop(): ejecutar y dormir lo indicado (redondeado a ticks de 1 ms si
+// tickUs > 0, como ulTaskNotifyTake)
+template <typename P>
+static uint32_t correrLoop(P &p, uint32_t duracionUs, uint32_t tickUs) {
+    uint32_t inicio = ahora, despertares = 0;
+    while (ahora - inicio < duracionUs) {
+        uint32_t espera = p.ejecutar();
+        if (tickUs) espera = (espera + tickUs - 1) / tickUs * tickUs;
+        ahora += espera;
+        despertares++;
+    }
+    return despertares;
+}
+
+static void imprimir(Planificador<RelojVirtual> &p) {
+    printf("    %-9s │ Período  │ Ejecuciones │ Jitter máx │ Jitter medio │ Duración máx │ Desbordes\n", "Tarea");
+    for (uint8_t id = 0; id < p.cantidad(); id++) {
+        const EstadisticasTarea &e = p.estadisticas(id);
+        uint32_t porDeadline = e.ejecuciones - e.solicitadas;
+        printf("    %-9s │ %5u ms │ %11u │ %7.2f ms │ %9.3f ms │ %9.2f ms │ %u\n", p.nombre(id), p.periodoUs(id) / 1000,
+               e.ejecuciones, e.jitterMaxUs / 1000.0, porDeadline ? e.jitterSumaUs / 1000.0 / porDeadline : 0.0,
+               e.duracionMaxUs / 1000.0, e.desbordes);
+    }
+}
+
+static void dashboard(uint32_t tickUs, uint32_t inicio) {
+    ahora = inicio;
+    Planificador<RelojVirtual> p;
+    int8_t s = p.agregar("sensores", sensores, 2000000);
+    int8_t o = p.agregar("oled", oled, 500000);
+    int8_t w = p.agregar("pwm", pwm, 20000);
+    int8_t f = p.agregar("wifi", wifi, 10000000);
+    int8_t l = p.agregar("ip", logIp, 30000000);
+    uint32_t despertares = correrLoop(p, 600000000, tickUs);  // 10 minutos
+    imprimir(p);
+
+    // Primera ejecución en t = 0 y después una por período
+    bool cantidades = p.estadisticas(s).ejecuciones == 300 && p.estadisticas(o).ejecuciones == 1200 &&
+                      p.estadisticas(w).ejecuciones == 30000 && p.estadisticas(f).ejecuciones == 60 &&
+                      p.estadisticas(l).ejecuciones == 20;
+    bool sinDesbordes = true;
+    uint32_t jitterMax = 0;
+    for (uint8_t id = 0; id < p.cantidad(); id++) {
+        sinDesbordes &= p.estadisticas(id).desbordes == 0;
+        if (p.estadisticas(id).jitterMaxUs > jitterMax) jitterMax = p.estadisticas(id).jitterMaxUs;
+    }
+    char texto[96];
+    comprobar(cantidades, "ejecuciones = duración / período en todas las tareas");
+    comprobar(sinDesbordes, "sin desbordes");
+    // Peor caso: todas vencen juntas (2.87 ms de trabajo) + un tick
+    snprintf(texto, sizeof(texto), "jitter máximo %.2f ms (≤ trabajo simultáneo + 1 tick)", jitterMax / 1000.0);
+    comprobar(jitterMax <= 900 + 1500 + 50 + 20 + 400 + tickUs, texto);
+    snprintf(texto, sizeof(texto), "%.1f despertares por segundo (delay(10): 100)", despertares / 600.0);
+    comprobar(despertares / 600.0 < 60, texto);
+}
+
+static void desborde() {
+    ahora = 0;
+    Planificador<RelojVirtual> p;
+    int8_t len = p.agregar("lenta", lenta, 20000);
+    int8_t s = p.agregar("sensores", sensores, 2000000);
+    correrLoop(p, 10000000, 0);
+    imprimir(p);
+    const EstadisticasTarea &e = p.estadisticas(len);
+    // 50 ms de trabajo cada 20 ms: corre una vez cada 60 ms y saltea 2 períodos
+    comprobar(e.ejecuciones > 0 && e.desbordes == 2 * e.ejecuciones, "tarea lenta: 2 desbordes por ejecución");
+    // Cooperativo: la tarea lenta no se interrumpe, sensores se atrasa
+    // hasta 50 ms pero no pierde períodos
+    const EstadisticasTarea &es = p.estadisticas(s);
+    comprobar(es.ejecuciones >= 5 && es.desbordes == 0 && es.jitterMaxUs <= 50000, "las demás tareas siguen corriendo");
+}
+
+// Comandos al azar (promedio cada 73 ms): demora desde que llega hasta
+// que corre la tarea de PWM
+static void eventos() {
+    const uint32_t DURACION = 60000000;
+    srand(7);
+    uint32_t llegadas[2000];
+    int n = 0;
+    for (uint32_t t = rand() % 146000; t < DURACION && n < 2000; t += 1 + rand() % 146000) llegadas[n++] = t;
+
+    // Antes: loop() revisa todo, delay(10), y el tick de PWM a 20 ms
+    // aplica lo pendiente. La demora es hasta el próximo tick
+    uint64_t sumaAntes = 0;
+    uint32_t maxAntes = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t tick = (llegadas[i] / 20000 + 1) * 20000;                   // Próximo tick de 20 ms
+        uint32_t iteracion = (tick + 9999) / 10000 * 10000;                  // Loop que lo ve (cada 10 ms)
+        uint32_t demora = iteracion - llegadas[i];
+        sumaAntes += demora;
+        if (demora > maxAntes) maxAntes = demora;
+    }
+
+    // Con el planificador: solicitar() despierta a loop() al llegar
+    ahora = 0;
+    Planificador<RelojVirtual> p;
+    p.agregar("sensores", sensores, 2000000);
+    p.agregar("oled", oled, 500000);
+    int8_t w = p.agregar("pwm", pwm, 20000);
+    uint64_t sumaDespues = 0;
+    uint32_t maxDespues = 0;
+    for (int i = 0; i < n; i++) {
+        // Dormir hasta el próximo deadline o hasta el evento, lo que llegue primero
+        for (;;) {
+            uint32_t espera = p.ejecutar();
+            if (ahora + espera >= llegadas[i]) break;
+            ahora += espera;
+        }
+        if (ahora < llegadas[i]) ahora = llegadas[i];
+        uint32_t llegada = llegadas[i];
+        uint32_t antes = p.estadisticas(w).ejecuciones;
+        p.solicitar(w);
+        // Si otra tarea estaba corriendo al llegar, el evento espera a que termine
+        while (p.estadisticas(w).ejecuciones == antes) p.ejecutar();
+        uint32_t demora = ahora - llegada - 50;  // Sin contar la propia tarea
+        sumaDespues += demora;
+        if (demora > maxDespues) maxDespues = demora;
+    }
+
+    printf("    %d comandos en 60 s:\n", n);
+    printf("    loop() con delay(10) + tick de 20 ms │ demora media %6.2f ms │ máxima %6.2f ms\n",
+           sumaAntes / 1000.0 / n, maxAntes / 1000.0);
+    printf("    Planificador + solicitar()           │ demora media %6.2f ms │ máxima %6.2f ms\n",
+           sumaDespues / 1000.0 / n, maxDespues / 1000.0);
+    comprobar(maxDespues < maxAntes && sumaDespues < sumaAntes, "solicitar() atiende los comandos antes que el tick fijo");
+}
+
+int main() {
+    printf("1. Tareas del dashboard, 10 minutos, espera exacta:\n");
+    dashboard(0, 0);
+    printf("\n   Espera redondeada a ticks de 1 ms (FreeRTOS):\n");
+    dashboard(1000, 0);
+
+    printf("\n2. Tarea de 50 ms con período de 20 ms:\n");
+    desborde();
+
+    printf("\n3. micros() desborda a los 5 s de empezar:\n");
+    dashboard(1000, 0xFFFFFFFFu - 5000000);
+
+    printf("\n4. Comandos del WebSocket:\n");
+    eventos();
+
+    printf("\n%s\n", fallas ? "FALLA: revisar las comprobaciones marcadas" : "OK: planificador verificado");
+    return fallas ? 1 : 0;
+}
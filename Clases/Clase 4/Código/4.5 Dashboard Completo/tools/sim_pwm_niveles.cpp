@@ -0,0 +1,138 @@
+/*
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Simulación en la PC de la cuantización del PWM (src/pwm_resolucion.h,
+    no se compila con PlatformIO)
+
+        g++ -O2 -std=c++11 -o sim_pwm_niveles tools/sim_pwm_niveles.cpp
+        ./sim_pwm_niveles            # Tabla de frecuencias típicas
+        ./sim_pwm_niveles 19500      # Detalle de una frecuencia
+
+    Para cada frecuencia: resolución elegida, cuántos duty distintos
+    produce el slider 0-100 % después de la corrección gamma, el primer
+    brillo que enciende el LED y el salto relativo más grande entre dos
+    posiciones encendidas (un salto grande se ve como escalón).
+    Verifica que la resolución respete frecuencia · 2^bits ≤ 80 MHz, que
+    el divisor del timer entre en sus 10 bits enteros (5 Hz como mínimo)
+    y que las tablas coincidan con pow(); devuelve 1 si algo falla.
+
+    ─────────────────────────────────────────────────────────────────────
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../src/pwm_resolucion.h"
+
+static int fallas = 0;
+
+struct Cuantizacion {
+    uint8_t distintos;
+    uint8_t primerEncendido;  // Primer brillo con duty > 0
+    double saltoMaximo;       // Mayor duty[i] / duty[i-1] con ambos > 0
+    uint8_t dondeSalto;
+};
+
+static Cuantizacion analizar(const uint16_t *tabla) {
+    Cuantizacion c = {nivelesDistintos(tabla), 0, 1, 0};
+    for (uint8_t i = 1; i <= 100; i++) {
+        if (!c.primerEncendido && tabla[i] > 0) c.primerEncendido = i;
+        if (tabla[i - 1] > 0 && (double)tabla[i] / tabla[i - 1] > c.saltoMaximo) {
+            c.saltoMaximo = (double)tabla[i] / tabla[i - 1];
+            c.dondeSalto = i;
+        }
+    }
+    return c;
+}
+
+static bool verificarFrecuencia(uint32_t frecuencia) {
+    uint8_t bits = bitsParaFrecuencia(frecuencia);
+    bool ok = true;
+    if (bits) {
+        // Entra en el reloj, y con un bit más no entraría (salvo el tope)
+        ok &= (uint64_t)frecuencia << bits <= PWM_RELOJ_HZ;
+        ok &= bits == PWM_BITS_MAX || ((uint64_t)frecuencia << (bits + 1)) > PWM_RELOJ_HZ;
+        // Divisor de ledcSetup() en punto fijo 10.8, como lo calcula el driver
+        ok &= ((uint64_t)PWM_RELOJ_HZ << 8) / ((uint64_t)frecuencia << bits) <= PWM_DIVISOR_MAX;
+        const uint16_t *tabla = tablaGammaPorcentaje(bits);
+        uint16_t maximo = (1u << bits) - 1;
+        for (int i = 0; i <= 100; i++) {
+            ok &= tabla[i] == (uint16_t)(pow(i / 100.0, 2.2) * maximo);
+        }
+    } else {
+        ok &= frecuencia == 0 || ((uint64_t)frecuencia << PWM_BITS_MIN) > PWM_RELOJ_HZ ||
+              ((uint64_t)PWM_RELOJ_HZ << 8) / ((uint64_t)frecuencia << PWM_BITS_MAX) > PWM_DIVISOR_MAX;
+    }
+    if (!ok) {
+        printf("  FALLA: %u Hz → %u bits\n", (unsigned)frecuencia, bits);
+        fallas++;
+    }
+    return ok;
+}
+
+static void fila(uint32_t frecuencia, const char *nota) {
+    uint8_t bits = bitsParaFrecuencia(frecuencia);
+    if (!bits) {
+        if (frecuencia < frecuenciaMinima(PWM_BITS_MAX)) {
+            printf("  %7u Hz │  --  │ frecuencia demasiado baja (divisor mayor que 1023)\n", (unsigned)frecuencia);
+        } else {
+            printf("  %7u Hz │  --  │ frecuencia demasiado alta (menos de %d bits)\n", (unsigned)frecuencia, PWM_BITS_MIN);
+        }
+        return;
+    }
+    Cuantizacion c = analizar(tablaGammaPorcentaje(bits));
+    printf("  %7u Hz │  %2u  │    %3u/101     │    %2u %%     │ x%.2f en %u %%  %s\n", (unsigned)frecuencia, bits,
+           c.distintos, c.primerEncendido, c.saltoMaximo, c.dondeSalto, nota);
+}
+
+static void detalle(uint32_t frecuencia) {
+    uint8_t bits = bitsParaFrecuencia(frecuencia);
+    if (!bits) {
+        printf("%u Hz fuera de rango (%u Hz a %lu Hz)\n", (unsigned)frecuencia,
+               (unsigned)frecuenciaMinima(PWM_BITS_MAX), PWM_RELOJ_HZ >> PWM_BITS_MIN);
+        return;
+    }
+    const uint16_t *tabla = tablaGammaPorcentaje(bits);
+    printf("%u Hz → %u bits (duty máximo %u)\n\n", (unsigned)frecuencia, bits, (1u << bits) - 1);
+    printf("  Brillo │ Duty   │ 8 bits fijos\n");
+    printf("  ───────┼────────┼─────────────\n");
+    const uint16_t *tabla8 = tablaGammaPorcentaje(8);
+    for (int i = 0; i <= 20; i++) {
+        printf("  %4d %% │ %6u │ %4u%s\n", i, tabla[i], tabla8[i], i > 0 && tabla8[i] == tabla8[i - 1] ? "  (repetido)" : "");
+    }
+    printf("  ...\n\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) detalle((uint32_t)strtoul(argv[1], nullptr, 10));
+
+    printf("Slider 0-100 %% con corrección gamma 2.2:\n\n");
+    printf("  Frecuencia │ Bits │ Duty distintos │ Enciende en │ Mayor salto\n");
+    printf("  ───────────┼──────┼────────────────┼─────────────┼─────────────\n");
+    fila(312500, "(misma cuantización que el ledcSetup(..., 8) anterior)");
+    fila(100000, "");
+    fila(40000, "");
+    fila(19500, "(inaudible)");
+    fila(5000, "(PWM_FRECUENCIA_INICIAL)");
+    fila(1000, "(cerca del parpadeo visible)");
+    fila(500, "(tope de 14 bits)");
+    fila(5, "(mínima: divisor del timer casi 1024)");
+    fila(4, "");
+
+    // Toda la escala de frecuencias, incluidos los bordes de cada resolución
+    for (uint32_t f = 1; f <= 400000; f += f < 1000 ? 1 : 7) verificarFrecuencia(f);
+    for (uint8_t bits = PWM_BITS_MIN; bits <= PWM_BITS_MAX; bits++) {
+        uint32_t borde = (uint32_t)(PWM_RELOJ_HZ >> bits);
+        verificarFrecuencia(borde);
+        verificarFrecuencia(borde + 1);
+    }
+
+    printf("\n%s\n", fallas ? "FALLA: resolución o tabla incorrecta" : "OK: resoluciones y tablas verificadas");
+    return fallas ? 1 : 0;
+}
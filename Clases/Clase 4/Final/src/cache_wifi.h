@@ -0,0 +1,104 @@
+/*
+    Datos de la última conexión WiFi guardados en la NVS (Preferences).
+
+    Con WiFi.begin(ssid, password) el ESP32 escanea todos los canales
+    buscando la red (~2 s) y después pide IP por DHCP (~0.5-1 s más).
+    Si ya se conectó antes, alcanza con repetir lo que funcionó:
+
+        WiFi.config(ip, gateway, mascara, dns);          // Sin DHCP
+        WiFi.begin(ssid, password, canal, bssid);        // Sin escaneo
+
+    Se guardan el BSSID (MAC del AP), el canal y la concesión DHCP
+    (IP, gateway, máscara, DNS), junto con un hash del SSID y la
+    contraseña: si se cambian las credenciales la caché deja de valer.
+    Solo se escribe la flash cuando algo cambió, no en cada conexión.
+
+    La concesión se reutiliza como IP fija hasta el próximo reinicio o
+    reconexión, sin renovarla: conviene reservar esa IP en el router
+    (DHCP estático) o usar RadioArduino::ipFija().
+
+    La usa RadioArduino (conexion_wifi.h); si la conexión rápida falla,
+    la máquina de estados vuelve enseguida al escaneo completo y la
+    caché se reemplaza al conectar.
+
+    4.5 Dashboard Completo y Final tienen este archivo idéntico, junto
+    con conexion_wifi.h: son proyectos de PlatformIO separados. Si se
+    cambia uno hay que cambiar el otro; python3 Clases/verificar_copias.py
+    lo comprueba.
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <Preferences.h>
+
+#define CACHE_WIFI_ESPACIO  "wifi"  // Espacio de nombres en la NVS
+#define CACHE_WIFI_VERSION  1       // Cambiarla si cambia DatosWifi
+
+struct DatosWifi {
+    uint8_t version;
+    uint8_t canal;
+    uint8_t bssid[6];
+    uint32_t red;  // Hash del SSID y la contraseña
+    uint32_t ip, gateway, mascara, dns;
+};
+
+class CacheWifi {
+public:
+    // Lee la NVS. true si hay datos completos de esta red
+    bool cargar(const char *ssid, const char *password) {
+        Preferences prefs;
+        prefs.begin(CACHE_WIFI_ESPACIO, true);  // Solo lectura
+        bool leidos = prefs.getBytesLength("ultima") == sizeof(DatosWifi) &&
+                      prefs.getBytes("ultima", &_datos, sizeof(DatosWifi)) == sizeof(DatosWifi);
+        prefs.end();
+        if (!leidos) memset(&_datos, 0, sizeof(_datos));
+        return leidos && _datos.version == CACHE_WIFI_VERSION && _datos.red == hashRed(ssid, password) &&
+               _datos.canal != 0 && _datos.ip != 0;
+    }
+
+    // Con la conexión establecida: guarda BSSID, canal e IP si cambiaron
+    void guardar(const char *ssid, const char *password) {
+        DatosWifi nuevos = {};
+        nuevos.version = CACHE_WIFI_VERSION;
+        nuevos.canal = WiFi.channel();
+        const uint8_t *bssid = WiFi.BSSID();
+        if (bssid) memcpy(nuevos.bssid, bssid, sizeof(nuevos.bssid));
+        nuevos.red = hashRed(ssid, password);
+        nuevos.ip = WiFi.localIP();
+        nuevos.gateway = WiFi.gatewayIP();
+        nuevos.mascara = WiFi.subnetMask();
+        nuevos.dns = WiFi.dnsIP();
+        if (!bssid || nuevos.ip == 0 || memcmp(&nuevos, &_datos, sizeof(DatosWifi)) == 0) return;
+
+        Preferences prefs;
+        prefs.begin(CACHE_WIFI_ESPACIO, false);
+        prefs.putBytes("ultima", &nuevos, sizeof(DatosWifi));
+        prefs.end();
+        _datos = nuevos;
+    }
+
+    // La próxima conexión escanea y pide DHCP
+    void olvidar() {
+        Preferences prefs;
+        prefs.begin(CACHE_WIFI_ESPACIO, false);
+        prefs.remove("ultima");
+        prefs.end();
+        memset(&_datos, 0, sizeof(_datos));
+    }
+
+    const DatosWifi &datos() const { return _datos; }
+
+private:
+    // FNV-1a del SSID, un separador y la contraseña
+    static uint32_t hashRed(const char *ssid, const char *password) {
+        uint32_t h = 2166136261u;
+        for (const char *c = ssid; *c; c++) h = (h ^ (uint8_t)*c) * 16777619u;
+        h = (h ^ 0xFF) * 16777619u;
+        for (const char *c = password; *c; c++) h = (h ^ (uint8_t)*c) * 16777619u;
+        return h;
+    }
+
+    DatosWifi _datos = {};
+};
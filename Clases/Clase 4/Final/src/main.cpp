@@ -4,6 +4,10 @@
 #include <WebServer.h>
 #include <ArduinoJson.h>
 #include <LittleFS.h>
+#include "route_table.h"  // Generado por tools/gen_route_table.py
+#include "archivos_estaticos.h"
+#include "planificador.h"
+#include "conexion_wifi.h"
 
 // Configuración WiFi
 const char *ssid = "VERA AP 5";
@@ -14,6 +18,46 @@ const char* ssid = "welectronica";
 const char* password = "electro@23";
 */
 
+// Conexión WiFi como máquina de estados (conexion_wifi.h), sin esperas
+RadioArduino radioWifi(ssid, password);
+ConexionWifi<RadioArduino> wifi(radioWifi);
+
+// IP fija opcional: con 0.0.0.0 se usa DHCP, y al arrancar la última
+// concesión guardada (cache_wifi.h)
+const IPAddress ipFija(0, 0, 0, 0);
+const IPAddress gatewayFijo(192, 168, 1, 1);
+const IPAddress mascaraFija(255, 255, 255, 0);
+const IPAddress dnsFijo(192, 168, 1, 1);
+
+// Marcas de tiempo del arranque en us (micros(); el bootloader no se
+// cuenta). Se muestran con la primera respuesta de /api/sensors
+enum FaseArranque : uint8_t {
+    ARRANQUE_SETUP,
+    ARRANQUE_WIFI,
+    ARRANQUE_SERVIDOR,
+    ARRANQUE_IP,
+    ARRANQUE_PRIMERA_API,
+    ARRANQUE_FASES
+};
+uint32_t marcasArranque[ARRANQUE_FASES];
+bool arranqueRapido = false;  // La primera conexión usó la caché
+
+// Guarda el instante de la fase solo la primera vez. true si fue esta
+bool marcarArranque(FaseArranque fase) {
+    if (marcasArranque[fase]) return false;
+    marcasArranque[fase] = micros();
+    return true;
+}
+
+void mostrarArranque() {
+    static const char *const nombres[ARRANQUE_FASES] = {"setup", "WiFi iniciado", "servidor", "IP", "primera /api/sensors"};
+    Serial.print("Arranque (ms):");
+    for (uint8_t i = 0; i < ARRANQUE_FASES; i++) {
+        Serial.printf(" %s %.1f |", nombres[i], marcasArranque[i] / 1000.0);
+    }
+    Serial.println(arranqueRapido ? " conexión rápida" : " conexión completa");
+}
+
 // Servidor
 WebServer server(80);
 
@@ -44,73 +88,94 @@ int brightnessToGammaPWM(int brightness) {
     return dutyGamma;
 }
 
-// Timing para lecturas de sensores
-uint32_t lastSensorRead = 0;
-const uint32_t sensorInterval = 2000; // 2 segundos
-
-// Timing para mostrar IP
-uint32_t lastIpShow = 0;
-const uint32_t ipShowInterval = 30000; // 30 segundos
-
-// Timing para verificar WiFi
-uint32_t lastWiFiCheck = 0;
-const uint32_t wifiCheckInterval = 10000; // 10 segundos
-
-// Función para verificar y mantener conexión WiFi
-void checkWiFiConnection() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("WiFi desconectado, intentando reconectar...");
-        WiFi.reconnect();
-
-        // Esperar un poco para la reconexión
-        int attempts = 0;
-        while (WiFi.status() != WL_CONNECTED && attempts < 10) {
-            delay(500);
-            Serial.print(".");
-            attempts++;
-        }
+// Períodos de las tareas de loop() (planificador.h)
+const uint32_t httpInterval = 10;         // 10 ms (server.handleClient())
+const uint32_t sensorInterval = 2000;     // 2 segundos
+const uint32_t ipShowInterval = 30000;    // 30 segundos
+const uint32_t wifiTickInterval = 100;    // 100 ms (máquina de estados, no bloquea)
 
-        if (WiFi.status() == WL_CONNECTED) {
-            Serial.println();
-            Serial.println("WiFi reconectado!");
-            Serial.println("IP: " + WiFi.localIP().toString());
-        } else {
-            Serial.println();
-            Serial.println("No se pudo reconectar WiFi");
-        }
+Planificador<RelojArduino> planificador;
+
+// Eventos del driver WiFi: solo se marcan, actualizarWifi() los procesa
+void onWifiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+        wifi.alConectar();
+    } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+        wifi.alDesconectar(info.wifi_sta_disconnected.reason);
+    }
+}
+
+// Log de los cambios de estado de la conexión y banner con la IP
+void alCambiarWifi(EstadoWifi anterior, EstadoWifi nuevo) {
+    // La verificación periódica (CONECTADO -> VERIFICANDO -> CONECTADO) no se muestra
+    if (nuevo == WIFI_VERIFICANDO || (anterior == WIFI_VERIFICANDO && nuevo == WIFI_CONECTADO)) return;
+
+    Serial.printf("WiFi: %s -> %s", nombreEstadoWifi(anterior), nombreEstadoWifi(nuevo));
+    if (nuevo == WIFI_REINTENTANDO) Serial.printf(" (intento %u)", wifi.intentos());
+    if (nuevo == WIFI_CONEXION_PERDIDA) Serial.printf(" (razón %u)", wifi.ultimaRazon());
+    Serial.println();
+
+    if (nuevo == WIFI_CONECTADO) {
+        if (marcarArranque(ARRANQUE_IP)) arranqueRapido = wifi.rapido();
+        Serial.println("===========================================");
+        Serial.print("IP del dispositivo: ");
+        Serial.println(WiFi.localIP());
+        Serial.println("===========================================");
+        Serial.println("Abrir en el navegador:");
+        Serial.print("   http://");
+        Serial.println(WiFi.localIP());
+        Serial.println("===========================================");
     }
 }
 
-// Función para obtener el tipo MIME de un archivo
-String getContentType(String filename) {
-    if (filename.endsWith(".html")) return "text/html";
-    else if (filename.endsWith(".css")) return "text/css";
-    else if (filename.endsWith(".js")) return "application/javascript";
-    else if (filename.endsWith(".png")) return "image/png";
-    else if (filename.endsWith(".jpg")) return "image/jpeg";
-    else if (filename.endsWith(".gif")) return "image/gif";
-    else if (filename.endsWith(".ico")) return "image/x-icon";
-    return "text/plain";
+// Avanza la conexión WiFi: como mucho inicia un intento, nunca lo espera
+void actualizarWifi() {
+    wifi.actualizar(millis());
 }
 
-// Función para servir archivos estáticos desde LittleFS
-bool handleFileRead(String path) {
-    Serial.println("Solicitado: " + path);
+// Cabeceras HTTP que WebServer debe guardar para poder consultarlas
+const char *headerKeys[] = {"If-None-Match", "Accept-Encoding"};
 
-    if (path.endsWith("/")) path += "index.html";
+// true si LittleFS se montó correctamente
+bool fsMounted = false;
 
-    String contentType = getContentType(path);
+// Tamaño y ETag de cada archivo de la tabla de rutas, medidos al montar
+ArchivosEstaticos archivos;
 
-    if (LittleFS.exists(path)) {
-        File file = LittleFS.open(path, "r");
-        server.streamFile(file, contentType);
-        file.close();
-        Serial.println("Archivo servido: " + path);
+// Función para servir un archivo estático: la variante y el ETag salen de
+// lo medido al montar LittleFS, sin preguntarle a la flash si existe. Solo
+// se abre el archivo cuando hay que enviar el contenido
+bool handleFileRead(const Route &route) {
+    Serial.printf("Solicitado: %s\n", route.path);
+
+    if (!fsMounted) return false;
+
+    String ifNoneMatch = server.header("If-None-Match");
+    RespuestaArchivo elegida = archivos.elegir(route, server.header("Accept-Encoding").indexOf("gzip") >= 0,
+                                               ifNoneMatch.c_str());
+    if (elegida.codigo == 404) return false;
+
+    server.sendHeader("ETag", elegida.etag);
+    server.sendHeader("Cache-Control", "no-cache");  // Revalidar siempre (responde 304)
+    server.sendHeader("Vary", "Accept-Encoding");
+
+    // El navegador ya tiene esta versión: 304 sin abrir el archivo
+    if (elegida.codigo == 304) {
+        server.send(304);
+        Serial.printf("No modificado (304): %s\n", route.path);
         return true;
     }
 
-    Serial.println("Archivo no encontrado: " + path);
-    return false;
+    File file = LittleFS.open(elegida.archivo, "r");
+    if (!file) return false;
+
+    if (elegida.gzip) server.sendHeader("Content-Encoding", "gzip");
+    server.setContentLength(file.size());  // El archivo que se envía, no uno medido antes
+    server.send(200, route.mime, "");
+    server.client().write(file);
+    file.close();
+    Serial.printf("Archivo servido: %s%s\n", route.path, elegida.gzip ? " (gzip)" : "");
+    return true;
 }
 
 void readSensors() {
@@ -127,19 +192,16 @@ void readSensors() {
     }
 }
 
-// Función para servir la página principal
-void handleRoot() {
-    if (!handleFileRead("/index.html")) {
-        // Fallback: servir página básica si LittleFS no está disponible
-        String basicPage = "<!DOCTYPE html><html><head><title>ESP32 IoT</title></head><body>";
-        basicPage += "<h1>ESP32 IoT Dashboard</h1>";
-        basicPage += "<p>Temperatura: <span id='temp'>--</span>°C</p>";
-        basicPage += "<p>Sistema funcionando sin archivos LittleFS</p>";
-        basicPage += "<script>setInterval(()=>{fetch('/api/sensors').then(r=>r.json()).then(d=>{document.getElementById('temp').innerHTML=d.temperature.toFixed(1)})},3000)</script>";
-        basicPage += "</body></html>";
-        server.send(200, "text/html", basicPage);
-        Serial.println("Sirviendo página básica (fallback)");
-    }
+// Página básica si LittleFS no está disponible o no tiene index.html
+void handleFallbackPage() {
+    String basicPage = "<!DOCTYPE html><html><head><title>ESP32 IoT</title></head><body>";
+    basicPage += "<h1>ESP32 IoT Dashboard</h1>";
+    basicPage += "<p>Temperatura: <span id='temp'>--</span>°C</p>";
+    basicPage += "<p>Sistema funcionando sin archivos LittleFS</p>";
+    basicPage += "<script>setInterval(()=>{fetch('/api/sensors').then(r=>r.json()).then(d=>{document.getElementById('temp').innerHTML=d.temperature.toFixed(1)})},3000)</script>";
+    basicPage += "</body></html>";
+    server.send(200, "text/html", basicPage);
+    Serial.println("Sirviendo página básica (fallback)");
 }
 
 // API REST para sensores
@@ -151,6 +213,7 @@ void handleApiSensors() {
     serializeJson(doc, response);
     server.send(200, "application/json", response);
     Serial.println("API sensores consultada");
+    if (marcarArranque(ARRANQUE_PRIMERA_API)) mostrarArranque();
 }
 
 // API para estado del LED (GET)
@@ -222,14 +285,72 @@ void handleApiLedPost() {
     }
 }
 
-// Manejar 404 y archivos estáticos
-void handleNotFound() {
-    if (!handleFileRead(server.uri())) {
-        server.send(404, "text/plain", "Archivo no encontrado");
+// Handlers de la API indexados por ApiId (ver api_routes.h)
+struct ApiHandlers {
+    void (*get)();
+    void (*post)();
+};
+
+const ApiHandlers apiHandlers[API_COUNT] = {
+    {handleApiSensors, nullptr},          // API_SENSORS
+    {handleApiLedGet, handleApiLedPost},  // API_LED
+};
+
+// Punto de entrada único: busca la URI en la tabla de rutas con hash
+// perfecto y despacha a la API o al archivo estático correspondiente
+void handleRequest() {
+    const Route *route = findRoute(server.uri().c_str());
+
+    if (route && route->api >= 0) {
+        const ApiHandlers &api = apiHandlers[route->api];
+        void (*handler)() = server.method() == HTTP_POST ? api.post : api.get;
+        if (handler) {
+            handler();
+        } else {
+            server.send(405, "text/plain", "Metodo no permitido");
+        }
+        return;
+    }
+
+    if (route && handleFileRead(*route)) return;
+
+    // Sin index.html en LittleFS (sin montar o vacío) la raíz muestra la
+    // página básica
+    if (route && esPaginaPrincipal(*route)) {
+        handleFallbackPage();
+        return;
     }
+
+    server.send(404, "text/plain", "Archivo no encontrado");
+}
+
+// Manejar clientes del servidor web. WebServer no avisa cuando llega
+// una conexión: hay que consultarlo periódicamente
+void handleHttp() {
+    server.handleClient();
+}
+
+// Mostrar IP y estadísticas del planificador periódicamente
+void showIp() {
+    if (WiFi.status() == WL_CONNECTED) {
+        Serial.println();
+        Serial.println("IP del servidor: http://" + WiFi.localIP().toString());
+    } else {
+        Serial.println();
+        Serial.println("WiFi desconectado - servidor no disponible");
+    }
+
+    // Jitter (atraso respecto del deadline) y desbordes de cada tarea
+    for (uint8_t id = 0; id < planificador.cantidad(); id++) {
+        const EstadisticasTarea &e = planificador.estadisticas(id);
+        Serial.printf("  %-9s %6u ejec. | jitter máx %5u us | duración máx %6u us | desbordes %u\n",
+                      planificador.nombre(id), e.ejecuciones, e.jitterMaxUs, e.duracionMaxUs, e.desbordes);
+    }
+    planificador.reiniciarEstadisticas();
 }
 
 void setup() {
+    marcarArranque(ARRANQUE_SETUP);
     Serial.begin(115200);
     delay(1000);  // Dar tiempo al Serial para inicializar
 
@@ -248,53 +369,43 @@ void setup() {
     ledcWrite(PWM_CHANNEL, offValue);
     ledState = false;
 
-    // Conectar WiFi PRIMERO
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(ssid, password);
-    Serial.print("Conectando a WiFi");
-
-    int wifiAttempts = 0;
-    while (WiFi.status() != WL_CONNECTED && wifiAttempts < 30) {
-        delay(1000);
-        Serial.print(".");
-        wifiAttempts++;
-    }
-
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println();
-        Serial.println("WiFi conectado!");
-        Serial.println("===========================================");
-        Serial.print("IP del dispositivo: ");
-        Serial.println(WiFi.localIP());
-        Serial.println("===========================================");
-        Serial.println("Abrir en el navegador:");
-        Serial.print("   http://");
-        Serial.println(WiFi.localIP());
-        Serial.println("===========================================");
-    } else {
-        Serial.println();
-        Serial.println("Error: No se pudo conectar a WiFi");
-        Serial.println("Continuando sin conexión...");
-        return;  // Salir si no hay WiFi
-    }
-
-    // Inicializar LittleFS DESPUÉS de WiFi
-    if (!LittleFS.begin(true)) {  // true = formatear si es necesario
+    // Tareas de loop(); sensores, HTTP y WiFi (fase 0) corren en la
+    // primera pasada de loop()
+    planificador.agregar("http", handleHttp, httpInterval * 1000);
+    planificador.agregar("sensores", readSensors, sensorInterval * 1000);
+    planificador.agregar("wifi", actualizarWifi, wifiTickInterval * 1000);
+    planificador.agregar("ip", showIp, ipShowInterval * 1000, ipShowInterval * 1000);
+
+    // Iniciar la conexión WiFi sin esperarla: la tarea "wifi" la sigue y
+    // alCambiarWifi() muestra la IP al conectar
+    Serial.println("Conectando a WiFi " + String(ssid) + "...");
+    wifi.alCambiar(alCambiarWifi);
+    WiFi.onEvent(onWifiEvent);
+    if ((uint32_t)ipFija != 0) radioWifi.ipFija(ipFija, gatewayFijo, mascaraFija, dnsFijo);
+    wifi.iniciar(millis());
+    marcarArranque(ARRANQUE_WIFI);
+    if (wifi.rapido()) Serial.println("Conexión rápida con el AP y la IP guardados");
+
+    // Inicializar LittleFS y el servidor aunque todavía no haya WiFi:
+    // empiezan a atender apenas llega la IP
+    fsMounted = LittleFS.begin(true);  // true = formatear si es necesario
+    if (!fsMounted) {
         Serial.println("Error montando LittleFS, usando modo básico");
         // Continuar sin LittleFS
     } else {
         Serial.println("LittleFS montado correctamente");
+        archivos.cargar(LittleFS);  // Lee cada archivo una vez (ETag de la imagen subida)
     };
 
-    // Configurar rutas del servidor
-    server.on("/", handleRoot);
-    server.on("/api/sensors", HTTP_GET, handleApiSensors);
-    server.on("/api/led", HTTP_GET, handleApiLedGet);
-    server.on("/api/led", HTTP_POST, handleApiLedPost);
-    server.onNotFound(handleNotFound);
+    // Todas las rutas se resuelven con la tabla generada (route_table.h)
+    server.onNotFound(handleRequest);
+
+    // Guardar las cabeceras necesarias para ETag y gzip
+    server.collectHeaders(headerKeys, 2);
 
     // Iniciar servidor
     server.begin();
+    marcarArranque(ARRANQUE_SERVIDOR);
     Serial.println("Servidor web iniciado en puerto 80");
 
     // Mostrar información de conexión de manera prominente
@@ -302,46 +413,21 @@ void setup() {
     Serial.println(String('=', 50));
     Serial.println("SERVIDOR WEB INICIADO");
     Serial.println(String('=', 50));
-    Serial.println("IP Local: " + WiFi.localIP().toString());
-    Serial.println("URL: http://" + WiFi.localIP().toString());
+    Serial.println("IP: se muestra al conectar el WiFi");
     Serial.println("Puerto: 80");
     Serial.println("SSID: " + String(ssid));
     Serial.println("Sistema de archivos: LittleFS");
     Serial.println(String('=', 50));
     Serial.println();
 
-    // Lectura inicial de sensores
-    readSensors();
+    // La lectura inicial de sensores la hace el planificador en la
+    // primera pasada de loop()
 }
 
 void loop() {
-    // Manejar clientes del servidor web
-    server.handleClient();
-
-    // Leer sensores periódicamente
-    if (millis() - lastSensorRead > sensorInterval) {
-        lastSensorRead = millis();
-        readSensors();
-    }
-
-    // Verificar conexión WiFi periódicamente
-    if (millis() - lastWiFiCheck > wifiCheckInterval) {
-        lastWiFiCheck = millis();
-        checkWiFiConnection();
-    }
-
-    // Mostrar IP periódicamente
-    if (millis() - lastIpShow > ipShowInterval) {
-        lastIpShow = millis();
-        if (WiFi.status() == WL_CONNECTED) {
-            Serial.println();
-            Serial.println("IP del servidor: http://" + WiFi.localIP().toString());
-        } else {
-            Serial.println();
-            Serial.println("WiFi desconectado - servidor no disponible");
-        }
-    }
-
-    // Pequeña pausa para estabilidad
-    delay(10);
+    // Correr las tareas vencidas (HTTP, sensores, WiFi, IP) y dormir hasta
+    // la próxima en lugar de un delay(10) fijo. El redondeo hacia arriba a
+    // ticks de 1 ms evita despertar antes de tiempo
+    uint32_t esperaUs = planificador.ejecutar();
+    vTaskDelay(pdMS_TO_TICKS((esperaUs + 999) / 1000));
 }
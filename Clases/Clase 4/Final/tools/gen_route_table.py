@@ -0,0 +1,182 @@
+"""
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Script de PlatformIO (extra_scripts = pre:tools/gen_route_table.py)
+
+    Genera src/route_table.h con TODAS las rutas del servidor:
+      - Los endpoints de la API declarados en src/api_routes.h
+      - Los archivos de data/ (más "/" como alias de /index.html), con su
+        tipo MIME, el archivo a abrir en LittleFS y el de la variante .gz
+
+    La tabla solo guarda nombres: el tamaño y el ETag de cada archivo se
+    miden en el ESP32 al montar LittleFS (src/archivos_estaticos.h), así
+    subir una imagen LittleFS nueva sin recompilar no deja datos viejos.
+    Agregar o renombrar archivos de data/ sí requiere recompilar.
+
+    Las rutas se ubican en una tabla de tamaño potencia de 2 usando un
+    hash FNV-1a con semilla. El script prueba semillas hasta encontrar una
+    sin colisiones (hash perfecto): en el ESP32 buscar una ruta cuesta un
+    hash + un strcmp, sin memoria dinámica ni accesos a LittleFS.
+
+    Fuera de PlatformIO (herramientas de tools/ en la PC):
+        python3 tools/gen_route_table.py
+
+    Copia idéntica en 4.5 Dashboard Completo y en Final: cada carpeta es
+    un proyecto de PlatformIO independiente. Un cambio va en las dos;
+    python3 Clases/verificar_copias.py avisa si quedaron distintas.
+
+    ─────────────────────────────────────────────────────────────────────
+"""
+
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 (lo inyecta PlatformIO/SCons)
+    data_dir = env.subst("$PROJECT_DATA_DIR")  # noqa: F821
+    src_dir = env.subst("$PROJECT_SRC_DIR")  # noqa: F821
+except NameError:  # Ejecutado con python3 desde la carpeta del proyecto
+    base_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    data_dir = os.path.join(base_dir, "data")
+    src_dir = os.path.join(base_dir, "src")
+
+# Misma tabla que usaba getContentType()
+MIME_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".png": "image/png",
+    ".jpg": "image/jpeg",
+    ".gif": "image/gif",
+    ".ico": "image/x-icon",
+}
+
+# Las mismas que comprime tools/gzip_data.py: solo esas pueden tener .gz
+COMPRIMIBLES = (".html", ".css", ".js", ".json", ".svg", ".txt", ".ico")
+
+MASK32 = 0xFFFFFFFF
+
+
+def fnv1a(data, seed=0):
+    h = (2166136261 ^ seed) & MASK32
+    for b in data:
+        h = ((h ^ b) * 16777619) & MASK32
+    return h
+
+
+def route_index(path, seed, mask):
+    h = fnv1a(path.encode(), seed)
+    return (h ^ (h >> 15)) & mask
+
+
+def c_str(value):
+    if value is None:
+        return "nullptr"
+    return '"%s"' % value.replace("\\", "\\\\").replace('"', '\\"')
+
+
+# --- Endpoints de la API (X-macro en src/api_routes.h) ---
+with open(os.path.join(src_dir, "api_routes.h"), encoding="utf-8") as f:
+    api_routes = re.findall(r'^\s*X\(\s*(\w+)\s*,\s*"([^"]+)"\s*\)', f.read(), re.M)
+
+routes = []
+for api_id, path in api_routes:
+    routes.append({"path": path, "api": api_id})
+
+# --- Archivos estáticos de data/ ---
+for name in sorted(os.listdir(data_dir)):
+    full = os.path.join(data_dir, name)
+    if not os.path.isfile(full) or name.endswith(".gz"):
+        continue
+    asset = {
+        "path": "/" + name,
+        "api": "-1",
+        "mime": MIME_TYPES.get(os.path.splitext(name)[1], "text/plain"),
+        "file": "/" + name,
+        # Si no está en LittleFS (gzip no ganaba nada) se sirve el original
+        "gz_file": "/" + name + ".gz" if name.endswith(COMPRIMIBLES) else None,
+    }
+    routes.append(asset)
+    if name == "index.html":
+        routes.append(dict(asset, path="/"))  # Misma entrada, URL distinta
+
+# --- Búsqueda de la semilla del hash perfecto ---
+size = 1
+while size < len(routes):
+    size *= 2
+
+seed = None
+while seed is None:
+    for candidate in range(1, 200000):
+        slots = {route_index(r["path"], candidate, size - 1) for r in routes}
+        if len(slots) == len(routes):
+            seed = candidate
+            break
+    else:
+        size *= 2  # Muy lleno: agrandar la tabla y volver a intentar
+
+table = [None] * size
+for r in routes:
+    table[route_index(r["path"], seed, size - 1)] = r
+
+# --- Generar el header ---
+lines = [
+    "// Generado por tools/gen_route_table.py - NO EDITAR (se regenera al compilar)",
+    "#pragma once",
+    "",
+    "#include <stdint.h>",
+    "#include <string.h>",
+    '#include "api_routes.h"',
+    "",
+    "struct Route {",
+    "    const char *path;      // URL pedida",
+    "    int8_t api;            // ApiId, o -1 si es un archivo estático",
+    "    const char *mime;",
+    "    const char *file;      // Archivo en LittleFS (\"/\" -> \"/index.html\")",
+    "    const char *gzFile;    // Variante .gz a buscar, o nullptr",
+    "};",
+    "",
+    "const uint32_t ROUTE_SEED = %du;" % seed,
+    "const uint32_t ROUTE_MASK = %du;" % (size - 1),
+    "const uint32_t ROUTE_SIZE = %du;" % size,
+    "",
+    "static const Route ROUTES[%d] = {" % size,
+]
+for r in table:
+    if r is None:
+        lines.append("    {nullptr, -1, nullptr, nullptr, nullptr},")
+    else:
+        lines.append("    {%s, %s, %s, %s, %s}," % (
+            c_str(r["path"]), r["api"], c_str(r.get("mime")),
+            c_str(r.get("file")), c_str(r.get("gz_file"))))
+lines += [
+    "};",
+    "",
+    "// FNV-1a con semilla (mismo algoritmo que tools/gen_route_table.py)",
+    "inline uint32_t routeIndex(const char *path) {",
+    "    uint32_t h = 2166136261u ^ ROUTE_SEED;",
+    "    while (*path) h = (h ^ (uint8_t)*path++) * 16777619u;",
+    "    return (h ^ (h >> 15)) & ROUTE_MASK;",
+    "}",
+    "",
+    "// Búsqueda O(1): un hash y una comparación",
+    "inline const Route *findRoute(const char *path) {",
+    "    const Route &route = ROUTES[routeIndex(path)];",
+    "    if (route.path && strcmp(route.path, path) == 0) return &route;",
+    "    return nullptr;",
+    "}",
+    "",
+]
+
+header = "\n".join(lines)
+out = os.path.join(src_dir, "route_table.h")
+old = open(out, encoding="utf-8").read() if os.path.exists(out) else None
+if header != old:  # No reescribir si no cambió (evita recompilar)
+    with open(out, "w", encoding="utf-8") as f:
+        f.write(header)
+    print("route_table.h: %d rutas, tabla de %d, semilla %d" % (len(routes), size, seed))
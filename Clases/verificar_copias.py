@@ -0,0 +1,76 @@
+"""
+    ─────────────────────────────────────────────────────────────────────
+
+    CURSO: Internet de las Cosas con ESP32
+    INSTITUCIÓN: Universidad Nacional de Santiago del Estero (UNSE)
+
+    ─────────────────────────────────────────────────────────────────────
+
+    Verifica que los archivos repetidos entre sketches sigan iguales.
+
+    Cada carpeta de Código/ y Final/ es un proyecto de PlatformIO que se
+    abre, compila y sube por separado (pio solo ve su propio src/ y
+    tools/), así que los encabezados y scripts que comparten se copian.
+    El costo es que un arreglo hay que hacerlo en todas las copias: este
+    script compara cada grupo y lista las que quedaron distintas.
+
+    Desde la carpeta Clases/ (o desde cualquier lado):
+        python3 verificar_copias.py
+
+    Devuelve 1 si algún grupo tiene copias distintas o faltantes.
+
+    ─────────────────────────────────────────────────────────────────────
+"""
+
+import hashlib
+import os
+import sys
+
+PWM = "Clase 2/Código/2.1 Led con PWM"
+NTC = "Clase 3/Código/3.3 Lectura de NTC"
+NTC_EFUSE = "Clase 3/Código/3.3.1 Lectura de NTC - Calibrado Interno"
+OLED = "Clase 3/Código/3.6 Temperaturas en OLED"
+SENSORES = "Clase 4/Código/4.4 Lectura de Sensores"
+DASHBOARD = "Clase 4/Código/4.5 Dashboard Completo"
+FINAL = "Clase 4/Final"
+
+# Cada grupo: rutas (relativas a Clases/) que deben ser idénticas byte a byte
+COPIAS = [
+    [NTC + "/src/ntc_lut.h", NTC_EFUSE + "/src/ntc_lut.h", SENSORES + "/src/ntc_lut.h"],
+    [PWM + "/src/gamma_lut.h", DASHBOARD + "/src/gamma_lut.h"],
+    [OLED + "/src/punto_fijo.h", DASHBOARD + "/src/punto_fijo.h"],
+    [DASHBOARD + "/src/archivos_estaticos.h", FINAL + "/src/archivos_estaticos.h"],
+    [DASHBOARD + "/tools/gzip_data.py", FINAL + "/tools/gzip_data.py"],
+    [DASHBOARD + "/tools/gen_route_table.py", FINAL + "/tools/gen_route_table.py"],
+    [DASHBOARD + "/src/planificador.h", FINAL + "/src/planificador.h"],
+    [DASHBOARD + "/src/conexion_wifi.h", FINAL + "/src/conexion_wifi.h"],
+    [DASHBOARD + "/src/cache_wifi.h", FINAL + "/src/cache_wifi.h"],
+]
+
+base = os.path.dirname(os.path.abspath(__file__))
+fallas = 0
+
+for grupo in COPIAS:
+    huellas = {}
+    for ruta in grupo:
+        try:
+            with open(os.path.join(base, ruta), "rb") as f:
+                huellas[ruta] = hashlib.sha1(f.read()).hexdigest()
+        except OSError:
+            huellas[ruta] = None
+
+    distintas = len(set(huellas.values())) > 1 or None in huellas.values()
+    nombre = os.path.basename(grupo[0])
+    if not distintas:
+        print("  [ OK ] %s (%d copias)" % (nombre, len(grupo)))
+        continue
+
+    fallas += 1
+    print("  [FALLA] %s: las copias difieren" % nombre)
+    for ruta in grupo:
+        print("          %s  %s" % ((huellas[ruta] or "no existe")[:10].ljust(10), ruta))
+
+if fallas:
+    print("FALLA: igualar las copias marcadas")
+    sys.exit(1)
+print("OK: todas las copias son idénticas")